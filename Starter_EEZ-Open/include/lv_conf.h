@@ -64,10 +64,12 @@
     // #define LV_MEM_CUSTOM_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
     // #define LV_MEM_CUSTOM_FREE(ptr) heap_caps_free(ptr)
 	// #define LV_MEM_CUSTOM_REALLOC(ptr, size) heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
-	#define LV_MEM_CUSTOM_INCLUDE <esp_heap_caps.h>   /*Header for the dynamic memory function*/
-	#define LV_MEM_CUSTOM_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_8BIT)
-	#define LV_MEM_CUSTOM_FREE(ptr) heap_caps_free(ptr)
-	#define LV_MEM_CUSTOM_REALLOC(ptr, size) heap_caps_realloc(ptr, size, MALLOC_CAP_8BIT)
+	/*Small objects in internal SRAM, large ones in PSRAM, see tiered_alloc.h.
+	 *The EEZ flow engine allocates through lv_mem_alloc() too.*/
+	#define LV_MEM_CUSTOM_INCLUDE "tiered_alloc.h"   /*Header for the dynamic memory function*/
+	#define LV_MEM_CUSTOM_ALLOC(size) tiered_malloc(size)
+	#define LV_MEM_CUSTOM_FREE(ptr) tiered_free(ptr)
+	#define LV_MEM_CUSTOM_REALLOC(ptr, size) tiered_realloc(ptr, size)
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -148,7 +150,11 @@
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 0
+/*Entries, not bytes. The pixels of decoded images are kept within a byte budget by
+ *src/images/image_cache (IMAGE_CACHE_BUDGET), open images count against it. An image
+ *held in one of these entries is open and can't be evicted, so up to this many decoded
+ *images stay in PSRAM even when together they take more than IMAGE_CACHE_BUDGET.*/
+#define LV_IMG_CACHE_DEF_SIZE 8
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -159,7 +165,8 @@
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
-#define LV_GRAD_CACHE_DEF_SIZE 0
+/*Allocated through tiered_alloc, so the cache lives in PSRAM*/
+#define LV_GRAD_CACHE_DEF_SIZE (16 * 1024)
 
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
  *LV_DITHER_GRADIENT implies allocating one or two more lines of the object's rendering surface
@@ -356,28 +363,46 @@
  *===================*/
 
 /*Montserrat fonts with ASCII range and some symbols using bpp = 4
- *https://fonts.google.com/specimen/Montserrat*/
-#define LV_FONT_MONTSERRAT_8  1
-#define LV_FONT_MONTSERRAT_10 1
-#define LV_FONT_MONTSERRAT_12 1
+ *https://fonts.google.com/specimen/Montserrat
+ *Only the sizes screens.c uses (and 14, the default font) are enabled, add a size here
+ *when the EEZ project starts using it.
+ *tools/subset_fonts.py can replace them with fonts cut down to the characters the project
+ *needs; it lists them in lv_font_subset.h, which turns the built-in ones off.*/
+#if defined(__has_include)
+#if __has_include("lv_font_subset.h")
+#include "lv_font_subset.h"
+#endif
+#endif
+
+#define LV_FONT_MONTSERRAT_8  0
+#define LV_FONT_MONTSERRAT_10 0
+#define LV_FONT_MONTSERRAT_12 0
+#ifndef LV_FONT_MONTSERRAT_14
 #define LV_FONT_MONTSERRAT_14 1
-#define LV_FONT_MONTSERRAT_16 1
+#endif
+#define LV_FONT_MONTSERRAT_16 0
+#ifndef LV_FONT_MONTSERRAT_18
 #define LV_FONT_MONTSERRAT_18 1
-#define LV_FONT_MONTSERRAT_20 1
-#define LV_FONT_MONTSERRAT_22 1
-#define LV_FONT_MONTSERRAT_24 1
-#define LV_FONT_MONTSERRAT_26 1
+#endif
+#define LV_FONT_MONTSERRAT_20 0
+#define LV_FONT_MONTSERRAT_22 0
+#define LV_FONT_MONTSERRAT_24 0
+#define LV_FONT_MONTSERRAT_26 0
+#ifndef LV_FONT_MONTSERRAT_28
 #define LV_FONT_MONTSERRAT_28 1
-#define LV_FONT_MONTSERRAT_30 1
-#define LV_FONT_MONTSERRAT_32 1
-#define LV_FONT_MONTSERRAT_34 1
-#define LV_FONT_MONTSERRAT_36 1
+#endif
+#define LV_FONT_MONTSERRAT_30 0
+#define LV_FONT_MONTSERRAT_32 0
+#define LV_FONT_MONTSERRAT_34 0
+#define LV_FONT_MONTSERRAT_36 0
+#ifndef LV_FONT_MONTSERRAT_38
 #define LV_FONT_MONTSERRAT_38 1
-#define LV_FONT_MONTSERRAT_40 1
-#define LV_FONT_MONTSERRAT_42 1
-#define LV_FONT_MONTSERRAT_44 1
-#define LV_FONT_MONTSERRAT_46 1
-#define LV_FONT_MONTSERRAT_48 1
+#endif
+#define LV_FONT_MONTSERRAT_40 0
+#define LV_FONT_MONTSERRAT_42 0
+#define LV_FONT_MONTSERRAT_44 0
+#define LV_FONT_MONTSERRAT_46 0
+#define LV_FONT_MONTSERRAT_48 0
 
 /*Demonstrate special features*/
 #define LV_FONT_MONTSERRAT_12_SUBPX      0
@@ -392,7 +417,11 @@
 /*Optionally declare custom fonts here.
  *You can use these fonts as default font too and they will be available globally.
  *E.g. #define LV_FONT_CUSTOM_DECLARE   LV_FONT_DECLARE(my_font_1) LV_FONT_DECLARE(my_font_2)*/
+#ifdef LV_FONT_SUBSET_DECLARE
+#define LV_FONT_CUSTOM_DECLARE LV_FONT_SUBSET_DECLARE
+#else
 #define LV_FONT_CUSTOM_DECLARE
+#endif
 
 /*Always set a default font*/
 #define LV_FONT_DEFAULT &lv_font_montserrat_14
@@ -684,7 +713,7 @@
  *----------*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
@@ -0,0 +1,77 @@
+#ifndef TIERED_ALLOC_H
+#define TIERED_ALLOC_H
+
+/*
+ * Heap routing between internal SRAM and PSRAM, used by LVGL (LV_MEM_CUSTOM_ALLOC in
+ * lv_conf.h) and through it by the EEZ flow engine.
+ *
+ * - draw buffers go to DMA capable internal SRAM,
+ * - small, frequently used objects go to internal SRAM,
+ * - everything of TIERED_ALLOC_PSRAM_THRESHOLD bytes or more (image caches, decompressed
+ *   assets, chart buffers) goes to PSRAM.
+ *
+ * Each tier falls back to the other one when it is exhausted, and small objects also move
+ * to PSRAM once internal free memory drops below TIERED_ALLOC_INTERNAL_RESERVE so WiFi,
+ * task stacks and DMA keep some room.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef TIERED_ALLOC_PSRAM_THRESHOLD
+#define TIERED_ALLOC_PSRAM_THRESHOLD 2048
+#endif
+
+#ifndef TIERED_ALLOC_INTERNAL_RESERVE
+#define TIERED_ALLOC_INTERNAL_RESERVE (48 * 1024)
+#endif
+
+/* Small allocations between two reads of the internal free size, see tiered_alloc.cpp. */
+#ifndef TIERED_ALLOC_FREE_REFRESH
+#define TIERED_ALLOC_FREE_REFRESH 32
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    TIERED_ALLOC_AUTO,  /*route by size*/
+    TIERED_ALLOC_HOT,   /*internal SRAM*/
+    TIERED_ALLOC_DRAW,  /*DMA capable internal SRAM, never PSRAM*/
+    TIERED_ALLOC_BULK,  /*PSRAM*/
+} tiered_alloc_category_t;
+
+typedef enum {
+    TIERED_ALLOC_TIER_INTERNAL,
+    TIERED_ALLOC_TIER_PSRAM,
+    TIERED_ALLOC_TIER_COUNT
+} tiered_alloc_tier_t;
+
+typedef struct {
+    uint32_t allocs;        /*successful allocations in this tier*/
+    uint32_t frees;
+    uint32_t fallbacks;     /*allocations that landed here because the preferred tier was full*/
+    uint32_t failures;      /*allocations that preferred this tier and failed in both*/
+    uint64_t bytesAllocated; /*sum of requested sizes*/
+    size_t totalSize;       /*the rest comes from heap_caps at the time of the query*/
+    size_t freeSize;
+    size_t minFreeSize;
+    size_t largestFreeBlock;
+} tiered_alloc_stats_t;
+
+void *tiered_malloc(size_t size);
+void *tiered_malloc_category(size_t size, tiered_alloc_category_t category);
+void *tiered_realloc(void *ptr, size_t size);
+void tiered_free(void *ptr);
+
+void tiered_alloc_get_stats(tiered_alloc_tier_t tier, tiered_alloc_stats_t *stats);
+
+#ifdef __cplusplus
+}
+
+#include <Print.h>
+void tiered_alloc_print_stats(Print &out);
+#endif
+
+#endif /*TIERED_ALLOC_H*/
@@ -56,6 +56,21 @@ bool touch_touched_flag = true, touch_released_flag = true;
 #include <Wire.h>
 #include <TAMC_GT911.h>
 TAMC_GT911 ts = TAMC_GT911(TOUCH_GT911_SDA, TOUCH_GT911_SCL, TOUCH_GT911_INT, TOUCH_GT911_RST, max(TOUCH_MAP_X1, TOUCH_MAP_X2), max(TOUCH_MAP_Y1, TOUCH_MAP_Y2));
+// The GT911 shares Wire with the other I2C devices, all its transfers go through i2cBus.
+int touch_i2c_device = -1;
+
+int touch_gt911_begin(TwoWire &wire, void *userData)
+{
+  ts.begin();
+  ts.setRotation(TOUCH_GT911_ROTATION);
+  return I2C_BUS_OK;
+}
+
+int touch_gt911_read(TwoWire &wire, void *userData)
+{
+  ts.read();
+  return I2C_BUS_OK;
+}
 
 #elif defined(TOUCH_XPT2046)
 #include <XPT2046_Touchscreen.h>
@@ -116,9 +131,9 @@ void touch_init()
   ts.registerTouchHandler(touch);
 
 #elif defined(TOUCH_GT911)
-  Wire.begin(TOUCH_GT911_SDA, TOUCH_GT911_SCL);
-  ts.begin();
-  ts.setRotation(TOUCH_GT911_ROTATION);
+  i2cBus.begin(&Wire, TOUCH_GT911_SDA, TOUCH_GT911_SCL);
+  touch_i2c_device = i2cBus.addDevice(GT911_ADDR1, "GT911", 2);
+  i2cBus.runSync(touch_i2c_device, touch_gt911_begin, NULL, I2C_PRIORITY_TOUCH);
 
 #elif defined(TOUCH_XPT2046)
   SPI.begin(TOUCH_XPT2046_SCK, TOUCH_XPT2046_MISO, TOUCH_XPT2046_MOSI, TOUCH_XPT2046_CS);
@@ -159,7 +174,7 @@ bool touch_touched()
   }
 
 #elif defined(TOUCH_GT911)
-  ts.read();
+  i2cBus.runSync(touch_i2c_device, touch_gt911_read, NULL, I2C_PRIORITY_TOUCH);
   if (ts.isTouched)
   {
 #if defined(TOUCH_SWAP_XY)
@@ -1,15 +1,31 @@
 #include <Crowbits_DHT20.h>
 
+// The sensor needs 80 ms to finish a measurement, give up on it after MEASURE_TIMEOUT.
+#define MEASURE_TIME 80
+#define MEASURE_TIMEOUT 200
+#define DEFAULT_SAMPLE_INTERVAL 2000
+
 
 Crowbits_DHT20::Crowbits_DHT20(TwoWire * pWire,uint8_t address)
   : _pWire(pWire) {
   _address = address;
+  _state = STATE_IDLE;
+  _sampleInterval = DEFAULT_SAMPLE_INTERVAL;
+  _triggerTime = 0;
+  _triggered = false;
+  _errorCount = 0;
+  _historyHead = 0;
+  _historyCount = 0;
 }
 
 int Crowbits_DHT20::begin() {
+  delay(100);
+  return probe();
+}
+
+int Crowbits_DHT20::probe() {
   uint8_t readCMD[3]={0x71};
   uint8_t data;
-  delay(100);
   //_pWire->begin(14, 12);
   //check if the IIC communication works 
   writeCommand(readCMD,1);
@@ -23,59 +39,137 @@ int Crowbits_DHT20::begin() {
   return 0;
 }
 
-int Crowbits_DHT20::getTemperature() {
-  uint8_t readCMD[3]={0xac,0x33,0x00};
-  uint8_t data[6] = {0};
-  int retries = 10;
-  int temperature;
-  // when the returned data is wrong, request to get data again until the data is correct. 
-  writeCommand(readCMD, 3);
-  while(retries--) {
-    delay(10);
-    readData(data,6);
-    if((data[0] >> 7) == 0){
-      // DBG("bus not busy");
-       break;
+void Crowbits_DHT20::setSampleInterval(uint32_t intervalMs) {
+  _sampleInterval = intervalMs;
+}
+
+bool Crowbits_DHT20::update() {
+  uint32_t now = millis();
+  if (_state == STATE_IDLE) {
+    if (!_triggered || now - _triggerTime >= _sampleInterval) {
+      triggerMeasurement(now);
     }
+    return false;
+  }
+
+  if (now - _triggerTime < MEASURE_TIME) {
+    return false;
+  }
+  int result = collectMeasurement(now);
+  if (result == 0 && now - _triggerTime >= MEASURE_TIMEOUT) {
+    _errorCount++;
+    _state = STATE_IDLE;
+  }
+  return result == 1;
+}
+
+bool Crowbits_DHT20::hasReading() const {
+  return _historyCount > 0;
+}
+
+const DHT20Reading &Crowbits_DHT20::getReading() const {
+  return _history[(_historyHead + DHT20_HISTORY_SIZE - 1) % DHT20_HISTORY_SIZE];
+}
+
+uint8_t Crowbits_DHT20::getHistory(DHT20Reading *pBuf, uint8_t size) const {
+  uint8_t count = _historyCount < size ? _historyCount : size;
+  uint8_t first = (_historyHead + DHT20_HISTORY_SIZE - count) % DHT20_HISTORY_SIZE;
+  for (uint8_t i = 0; i < count; i++) {
+    pBuf[i] = _history[(first + i) % DHT20_HISTORY_SIZE];
+  }
+  return count;
+}
+
+uint32_t Crowbits_DHT20::getErrorCount() const {
+  return _errorCount;
+}
+
+int Crowbits_DHT20::getTemperature() {
+  measureBlocking();
+  if (!hasReading()) {
+    return 0;
   }
-  uint32_t temp = data[3] & 0xff;
-  uint32_t temp1 = data[4] & 0xff;
-  uint32_t rawData = 0;
-  rawData = ((temp&0xf)<<16)+(temp1<<8)+(data[5]);
-  //DBG(rawData);
-  //DBG((temp&0xf)<<16);
-  temperature = (int)rawData/5242 -50;
-  //DBG(temperature)
-  return temperature;
+  return getReading().temperature / 100;
 }
 
 int Crowbits_DHT20::getHumidity() {
+  measureBlocking();
+  if (!hasReading()) {
+    return 0;
+  }
+  return getReading().humidity / 100;
+}
+
+void Crowbits_DHT20::triggerMeasurement(uint32_t now) {
   uint8_t readCMD[3]={0xac,0x33,0x00};
-  uint8_t data[6] = {0};
-  int retries = 10;
-  float humidity_f;
-  int humidity_i;
-  // when the returned data is wrong, request to get data again until the data is correct. 
   writeCommand(readCMD, 3);
-  while(retries--) {
+  _triggerTime = now;
+  _triggered = true;
+  _state = STATE_MEASURING;
+}
+
+int Crowbits_DHT20::collectMeasurement(uint32_t now) {
+  uint8_t data[7] = {0};
+  if (!readData(data, 7)) {
+    _errorCount++;
+    _state = STATE_IDLE;
+    return -1;
+  }
+  if (data[0] & 0x80) {
+    // still busy, poll again on the next update()
+    return 0;
+  }
+  _state = STATE_IDLE;
+  if (crc8(data, 6) != data[6]) {
+    _errorCount++;
+    return -1;
+  }
+
+  uint32_t rawHumidity = ((uint32_t)data[1] << 12) | ((uint32_t)data[2] << 4) | (data[3] >> 4);
+  uint32_t rawTemperature = (((uint32_t)data[3] & 0x0f) << 16) | ((uint32_t)data[4] << 8) | data[5];
+
+  // RH = raw / 2^20 * 100 %, T = raw / 2^20 * 200 - 50 °C, both scaled by 100;
+  // 10000 / 2^20 = 625 / 2^16 keeps the products within 32 bits.
+  DHT20Reading &reading = _history[_historyHead];
+  reading.humidity = (uint16_t)((rawHumidity * 625) >> 16);
+  reading.temperature = (int16_t)((int32_t)((rawTemperature * 625) >> 15) - 5000);
+  reading.timestamp = now;
+
+  _historyHead = (_historyHead + 1) % DHT20_HISTORY_SIZE;
+  if (_historyCount < DHT20_HISTORY_SIZE) {
+    _historyCount++;
+  }
+  return 1;
+}
+
+void Crowbits_DHT20::measureBlocking() {
+  // Legacy callers never call update(), so take a fresh reading once the cached one
+  // is older than the sample interval, like the old driver did on every call.
+  update();
+  if (hasReading() && millis() - getReading().timestamp < _sampleInterval) {
+    return;
+  }
+  if (_state == STATE_IDLE) {
+    triggerMeasurement(millis());
+  }
+  while (_state == STATE_MEASURING) {
     delay(10);
-    readData(data,6);
-    if((data[0] >> 7) == 0){
-       //DBG("bus not busy");
-       break;
+    update();
+  }
+}
+
+uint8_t Crowbits_DHT20::crc8(const uint8_t *pBuf, size_t size) {
+  // polynomial x^8 + x^5 + x^4 + 1, initial value 0xFF
+  uint8_t crc = 0xFF;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= pBuf[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
     }
   }
-  uint32_t temp = data[1] & 0xff;
-  uint32_t temp1 = data[2] & 0xff;
-  uint32_t rawData = 0;
-  rawData = (temp<<12)+(temp1<<4)+((data[3]&0xf0)>>4);
-  //DBG(rawData);
-  //DBG(temp<<12);
-  humidity_f = (float)rawData/0x100000;
-  humidity_i = (int)(humidity_f*100);
-  //DBG(humidity)
-  return humidity_i;
+  return crc;
 }
+
 void Crowbits_DHT20::writeCommand(const void *pBuf, size_t size) {
   if (pBuf == NULL) {
    // DBG("pBuf ERROR!! : null pointer");
@@ -92,18 +186,18 @@ void Crowbits_DHT20::writeCommand(const void *pBuf, size_t size) {
 }
 
 uint8_t Crowbits_DHT20::readData(void *pBuf, size_t size) {
-  delay(10);
   if (pBuf == NULL) {
    // DBG("pBuf ERROR!! : null pointer");
   }
   uint8_t * _pBuf = (uint8_t *)pBuf;
   //read the data returned by the chip
-  _pWire->requestFrom(_address, size);
-  //uint8_t i = 0;
+  if (_pWire->requestFrom(_address, size) != size) {
+    return 0;
+  }
   for (uint8_t i = 0 ; i < size; i++) {
     _pBuf[i] = _pWire->read();
    // DBG(_pBuf[i]);
   }
   return 1;
   
-}
\ No newline at end of file
+}
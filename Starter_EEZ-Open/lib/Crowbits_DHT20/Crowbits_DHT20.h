@@ -12,6 +12,20 @@
 //#define DBG(...)
 //#endif
 //extern Stream *dbg;
+
+#ifndef DHT20_HISTORY_SIZE
+#define DHT20_HISTORY_SIZE 8
+#endif
+
+/**
+ * @brief One measurement, both values decoded from the same frame.
+ */
+struct DHT20Reading {
+  int16_t temperature;  ///< 0.01 °C
+  uint16_t humidity;    ///< 0.01 %RH
+  uint32_t timestamp;   ///< millis() when the frame was read
+};
+
 class Crowbits_DHT20
 {
 public:
@@ -27,20 +41,72 @@ public:
    * @return Return 0 if initialization succeeds, otherwise return non-zero and error code.
    */
   int begin(void);
+
+  /**
+   * @brief begin() without the 100 ms power-up wait, for callers that wait themselves.
+   * @return Return 0 if the sensor answers, otherwise return non-zero and error code.
+   */
+  int probe(void);
     
+  /**
+   * @brief Set how often update() starts a new measurement, 2000 ms in default.
+   * @n The sensor self-heats when sampled faster than about once per second.
+   * @param intervalMs Time between measurement triggers in ms.
+   */
+  void setSampleInterval(uint32_t intervalMs);
+
+  /**
+   * @brief Advance the measurement state machine, call it from loop().
+   * @n Never waits for the sensor: it either triggers a measurement, polls a
+   * @n running one or does nothing, so each call costs at most one short I2C transfer.
+   * @return true when a new reading has been stored.
+   */
+  bool update();
+
+  /**
+   * @brief Check if at least one valid reading is available.
+   */
+  bool hasReading() const;
+
+  /**
+   * @brief Get the latest cached reading, valid only when hasReading() is true.
+   */
+  const DHT20Reading &getReading() const;
+
+  /**
+   * @brief Copy the stored readings, oldest first.
+   * @param pBuf  Destination buffer
+   * @param size  Capacity of pBuf, at most DHT20_HISTORY_SIZE readings are kept
+   * @return      The number of readings copied
+   */
+  uint8_t getHistory(DHT20Reading *pBuf, uint8_t size) const;
+
+  /**
+   * @brief Number of frames dropped because of a CRC mismatch, a short read or a timeout.
+   */
+  uint32_t getErrorCount() const;
+
   /**
    * @brief Get ambient temperature, unit: °C
+   * @n Returns the cached value while it is younger than the sample interval, otherwise
+   * @n waits for a new measurement (about 80 ms).
    * @return ambient temperature, measurement range: -40°C ~ 80°C
    */
   int getTemperature();
     
   /**
    * @brief Get relative humidity, unit: %RH. 
+   * @n Returns the cached value while it is younger than the sample interval, otherwise
+   * @n waits for a new measurement (about 80 ms).
    * @return relative humidity, measurement range: 0-100%
    */
   int getHumidity();
 
 private:
+  enum State {
+    STATE_IDLE,
+    STATE_MEASURING
+  };
 
   /**
    * @brief Write command into sensor chip 
@@ -49,15 +115,42 @@ private:
    */
     void  writeCommand(const void *pBuf,size_t size);
   /**
-   * @brief Write command into sensor chip 
-   * @param pBuf  Data included in command
-   * @param size  The number of the byte of command
-   * @return      Return 0 if the reading is done, otherwise return non-zero. 
+   * @brief Read data from sensor chip
+   * @param pBuf  Buffer for the data read
+   * @param size  The number of the byte to read
+   * @return      Return 1 if all the bytes were read, otherwise return 0.
    */
     uint8_t  readData(void *pBuf,size_t size);   
     
+  /**
+   * @brief Send the 0xAC measurement command and enter STATE_MEASURING.
+   */
+    void triggerMeasurement(uint32_t now);
+  /**
+   * @brief Read the 7 byte frame (status, 5 data bytes, CRC) of a finished measurement.
+   * @return 1 if a reading was stored, 0 if the sensor is still busy, -1 on error.
+   */
+    int collectMeasurement(uint32_t now);
+  /**
+   * @brief Make sure a reading no older than the sample interval exists, waiting for
+   * @n one measurement if necessary.
+   */
+    void measureBlocking();
+
+    static uint8_t crc8(const uint8_t *pBuf, size_t size);
+
     TwoWire *_pWire;
     uint8_t _address;
+
+    State _state;
+    uint32_t _sampleInterval;
+    uint32_t _triggerTime;
+    bool _triggered;
+    uint32_t _errorCount;
+
+    DHT20Reading _history[DHT20_HISTORY_SIZE];
+    uint8_t _historyHead;
+    uint8_t _historyCount;
   
 };
 
@@ -0,0 +1,227 @@
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <esp_spi_flash.h>
+#include <esp_rom_crc.h>
+#include "assets_partition.h"
+#include "../ui/eez-flow.h"
+
+// First word of an uncompressed EEZ assets blob ("~EEZ").  Compressed blobs would
+// have to be decompressed into RAM, which is exactly what this loader avoids.
+#define EEZ_ASSETS_HEADER_TAG 0x5A45457E
+
+static const esp_partition_t *g_slots[2];
+static int g_activeSlot = -1;
+static spi_flash_mmap_handle_t g_mmapHandle;
+
+static int g_updateSlot = -1;
+static uint32_t g_updateSequence;
+static uint32_t g_updatePayloadSize;
+static uint32_t g_updateOffset;
+static uint32_t g_updateCrc32;
+static void *g_updateSha256;
+
+static uint32_t headerCrc32(const assets_partition_header_t *header)
+{
+  return esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(assets_partition_header_t, headerCrc32));
+}
+
+static void findSlots()
+{
+  if (!g_slots[0])
+  {
+    g_slots[0] = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSETS_PARTITION_LABEL_A);
+  }
+  if (!g_slots[1])
+  {
+    g_slots[1] = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSETS_PARTITION_LABEL_B);
+  }
+}
+
+// Read and check a slot header; the payload itself is checked only for the slot we map.
+static bool readHeader(int slot, assets_partition_header_t *header)
+{
+  const esp_partition_t *partition = g_slots[slot];
+  if (!partition)
+  {
+    return false;
+  }
+  if (esp_partition_read(partition, 0, header, sizeof(*header)) != ESP_OK)
+  {
+    return false;
+  }
+  if (header->magic != ASSETS_PARTITION_MAGIC || header->version != ASSETS_PARTITION_VERSION ||
+      header->headerSize != sizeof(*header) || header->headerCrc32 != headerCrc32(header))
+  {
+    return false;
+  }
+  if (header->payloadSize < sizeof(uint32_t) || header->payloadSize > partition->size - sizeof(*header))
+  {
+    return false;
+  }
+  return true;
+}
+
+static bool mapSlot(int slot, const assets_partition_header_t *header, const uint8_t **assets, uint32_t *assetsSize)
+{
+  const void *mapped;
+  spi_flash_mmap_handle_t handle;
+  if (esp_partition_mmap(g_slots[slot], 0, sizeof(*header) + header->payloadSize, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK)
+  {
+    return false;
+  }
+
+  const uint8_t *payload = (const uint8_t *)mapped + sizeof(*header);
+  if (*(const uint32_t *)payload != EEZ_ASSETS_HEADER_TAG ||
+      esp_rom_crc32_le(0, payload, header->payloadSize) != header->payloadCrc32)
+  {
+    spi_flash_munmap(handle);
+    return false;
+  }
+
+  g_mmapHandle = handle;
+  g_activeSlot = slot;
+  *assets = payload;
+  *assetsSize = header->payloadSize;
+  return true;
+}
+
+bool assets_partition_map(const uint8_t **assets, uint32_t *assetsSize)
+{
+  findSlots();
+
+  assets_partition_header_t headers[2];
+  bool valid[2] = {readHeader(0, &headers[0]), readHeader(1, &headers[1])};
+
+  // Try the newest slot first and fall back to the other one if its payload is corrupt.
+  int first = (valid[1] && (!valid[0] || (int32_t)(headers[1].sequence - headers[0].sequence) > 0)) ? 1 : 0;
+  for (int i = 0; i < 2; i++)
+  {
+    int slot = i == 0 ? first : 1 - first;
+    if (valid[slot] && mapSlot(slot, &headers[slot], assets, assetsSize))
+    {
+      Serial.printf("Assets loaded from partition %s (sequence %u, %u bytes)\n", g_slots[slot]->label, headers[slot].sequence, headers[slot].payloadSize);
+      return true;
+    }
+  }
+
+  Serial.println("Using embedded assets");
+  return false;
+}
+
+int assets_partition_active_slot()
+{
+  return g_activeSlot;
+}
+
+bool assets_partition_update_begin(uint32_t payloadSize)
+{
+  findSlots();
+
+  // Never touch the mapped slot, the running flow is reading from it.
+  int slot = g_activeSlot == 0 ? 1 : 0;
+  const esp_partition_t *partition = g_slots[slot];
+  if (!partition || payloadSize > partition->size - sizeof(assets_partition_header_t))
+  {
+    return false;
+  }
+
+  uint32_t sequence = 0;
+  assets_partition_header_t header;
+  for (int i = 0; i < 2; i++)
+  {
+    if (readHeader(i, &header) && (int32_t)(header.sequence - sequence) > 0)
+    {
+      sequence = header.sequence;
+    }
+  }
+
+  uint32_t eraseSize = (sizeof(header) + payloadSize + SPI_FLASH_SEC_SIZE - 1) & ~(SPI_FLASH_SEC_SIZE - 1);
+  if (esp_partition_erase_range(partition, 0, eraseSize) != ESP_OK)
+  {
+    return false;
+  }
+
+  g_updateSlot = slot;
+  g_updateSequence = sequence + 1;
+  g_updatePayloadSize = payloadSize;
+  g_updateOffset = 0;
+  g_updateCrc32 = 0;
+  g_updateSha256 = eez_crypto_sha256_begin();
+  return true;
+}
+
+bool assets_partition_update_write(const uint8_t *data, size_t size)
+{
+  if (g_updateSlot == -1 || g_updateOffset + size > g_updatePayloadSize)
+  {
+    assets_partition_update_abort();
+    return false;
+  }
+
+  if (esp_partition_write(g_slots[g_updateSlot], sizeof(assets_partition_header_t) + g_updateOffset, data, size) != ESP_OK)
+  {
+    assets_partition_update_abort();
+    return false;
+  }
+
+  g_updateCrc32 = esp_rom_crc32_le(g_updateCrc32, data, size);
+  if (g_updateSha256)
+  {
+    eez_crypto_sha256_update(g_updateSha256, data, size);
+  }
+  g_updateOffset += size;
+  return true;
+}
+
+bool assets_partition_update_end()
+{
+  if (g_updateSlot == -1 || g_updateOffset != g_updatePayloadSize)
+  {
+    assets_partition_update_abort();
+    return false;
+  }
+
+  assets_partition_header_t header;
+  memset(&header, 0, sizeof(header));
+  header.magic = ASSETS_PARTITION_MAGIC;
+  header.version = ASSETS_PARTITION_VERSION;
+  header.headerSize = sizeof(header);
+  header.sequence = g_updateSequence;
+  header.payloadSize = g_updatePayloadSize;
+  header.payloadCrc32 = g_updateCrc32;
+  header.headerCrc32 = headerCrc32(&header);
+
+  bool ok = esp_partition_write(g_slots[g_updateSlot], 0, &header, sizeof(header)) == ESP_OK;
+  assets_partition_update_abort();
+  return ok;
+}
+
+bool assets_partition_update_end_sha256(const uint8_t *sha256)
+{
+  uint8_t digest[EEZ_CRYPTO_SHA256_SIZE];
+  if (g_updateSlot == -1 || !g_updateSha256 || g_updateOffset != g_updatePayloadSize)
+  {
+    assets_partition_update_abort();
+    return false;
+  }
+  eez_crypto_sha256_end(g_updateSha256, digest);
+  g_updateSha256 = nullptr;
+  if (memcmp(digest, sha256, sizeof(digest)) != 0)
+  {
+    Serial.println("Assets update rejected, SHA-256 mismatch");
+    assets_partition_update_abort();
+    return false;
+  }
+  return assets_partition_update_end();
+}
+
+void assets_partition_update_abort()
+{
+  // The header of the slot being written is still erased, so it stays invalid.
+  g_updateSlot = -1;
+  if (g_updateSha256)
+  {
+    eez_crypto_sha256_end(g_updateSha256, nullptr);
+    g_updateSha256 = nullptr;
+  }
+}
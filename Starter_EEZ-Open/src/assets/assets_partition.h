@@ -0,0 +1,64 @@
+#ifndef _ASSETS_PARTITION_H
+#define _ASSETS_PARTITION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Flow assets can be loaded from one of two flash data partitions ("assets_a" and
+// "assets_b" in huge_app.csv) instead of the assets[] array compiled into ui.c.
+// Each slot holds a header followed by the raw EEZ assets blob (as produced by
+// tools/pack_assets.py).  The slot with a valid header and the highest sequence
+// number wins, and it is memory mapped so the flow engine reads it in place.
+//
+// Only the flow assets are replaced: screens.c is still compiled in, so a blob must
+// come from the same EEZ project layout as the running firmware.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ASSETS_PARTITION_MAGIC 0x53415A45 // "EZAS"
+#define ASSETS_PARTITION_VERSION 1
+
+#define ASSETS_PARTITION_LABEL_A "assets_a"
+#define ASSETS_PARTITION_LABEL_B "assets_b"
+
+typedef struct _assets_partition_header_t
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t headerSize;
+  uint32_t sequence;
+  uint32_t payloadSize;
+  uint32_t payloadCrc32;
+  uint32_t reserved[2];
+  uint32_t headerCrc32; // CRC32 of all the fields above
+} assets_partition_header_t;
+
+// Map the newest valid slot.  On success *assets and *assetsSize are replaced with
+// the mapped blob and true is returned, otherwise they are left untouched so the
+// caller keeps using the embedded array.
+bool assets_partition_map(const uint8_t **assets, uint32_t *assetsSize);
+
+// Slot currently mapped: 0 (A), 1 (B) or -1 when running from the embedded assets.
+int assets_partition_active_slot();
+
+// Write a new blob into the slot that is not mapped.  The header is written last by
+// assets_partition_update_end(), so an interrupted update never produces a valid slot.
+// The new assets are picked up on the next boot.
+bool assets_partition_update_begin(uint32_t payloadSize);
+bool assets_partition_update_write(const uint8_t *data, size_t size);
+bool assets_partition_update_end();
+void assets_partition_update_abort();
+
+// assets_partition_update_end() that also checks the SHA-256 of the payload (as
+// printed by tools/pack_assets.py).  The data is hashed while it is written, so a
+// transfer is verified without holding the blob in RAM.
+bool assets_partition_update_end_sha256(const uint8_t *sha256);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
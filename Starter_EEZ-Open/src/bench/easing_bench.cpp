@@ -0,0 +1,107 @@
+#include "easing_bench.h"
+#include "../ui/eez-flow.h"
+
+static const char *const g_curveNames[eez::NUM_EASING_FUNCS] = {
+    "linear", "inQuad", "outQuad", "inOutQuad", "inCubic", "outCubic", "inOutCubic",
+    "inQuart", "outQuart", "inOutQuart", "inQuint", "outQuint", "inOutQuint",
+    "inSine", "outSine", "inOutSine", "inExpo", "outExpo", "inOutExpo",
+    "inCirc", "outCirc", "inOutCirc", "inBack", "outBack", "inOutBack",
+    "inElastic", "outElastic", "inOutElastic", "inBounce", "outBounce", "inOutBounce"};
+
+static float nsPerSample(uint32_t us, uint32_t count)
+{
+  return us * 1000.0f / count;
+}
+
+void easing_bench_run(Print &out, uint32_t samples, uint32_t rounds)
+{
+  // The inputs are spread over [0, 1] including both ends.
+  if (samples < 2 || rounds < 1)
+  {
+    out.println("easing bench: needs at least 2 samples and 1 round");
+    return;
+  }
+  float *x = (float *)malloc(samples * sizeof(float));
+  float *y = (float *)malloc(samples * sizeof(float));
+  int32_t *fixedX = (int32_t *)malloc(samples * sizeof(int32_t));
+  int32_t *fixedY = (int32_t *)malloc(samples * sizeof(int32_t));
+  if (!x || !y || !fixedX || !fixedY)
+  {
+    out.println("easing bench: out of memory");
+    free(x);
+    free(y);
+    free(fixedX);
+    free(fixedY);
+    return;
+  }
+  for (uint32_t i = 0; i < samples; i++)
+  {
+    x[i] = i / (float)(samples - 1);
+    fixedX[i] = (int32_t)lroundf(x[i] * eez::EASING_FIXED_ONE);
+  }
+
+  uint32_t count = samples * rounds;
+  volatile float sink = 0;
+  float worst = 0;
+  out.printf("%-13s %8s %8s %8s %8s %9s\n", "ns/sample", "formula", "eez_", "batch", "fixed", "max error");
+  for (int f = 0; f < eez::NUM_EASING_FUNCS; f++)
+  {
+    eez::EasingFuncType exact = eez::g_easingExactFuncs[f];
+    eez::EasingFuncType func = eez::g_easingFuncs[f];
+
+    uint32_t start = micros();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+      for (uint32_t i = 0; i < samples; i++)
+      {
+        sink += exact(x[i]);
+      }
+    }
+    uint32_t exactUs = micros() - start;
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+      for (uint32_t i = 0; i < samples; i++)
+      {
+        sink += func(x[i]);
+      }
+    }
+    uint32_t funcUs = micros() - start;
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+      eez::easeBatch(f, x, y, samples);
+      sink += y[r % samples];
+    }
+    uint32_t batchUs = micros() - start;
+
+    start = micros();
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+      eez::easeFixedBatch(f, fixedX, fixedY, samples);
+      sink += fixedY[r % samples];
+    }
+    uint32_t fixedUs = micros() - start;
+
+    float error = 0;
+    for (uint32_t i = 0; i < samples; i++)
+    {
+      float expected = exact(x[i]);
+      error = fmaxf(error, fabsf(func(x[i]) - expected));
+      error = fmaxf(error, fabsf(y[i] - expected));
+      error = fmaxf(error, fabsf(fixedY[i] / (float)eez::EASING_FIXED_ONE - exact(fixedX[i] / (float)eez::EASING_FIXED_ONE)));
+    }
+    worst = fmaxf(worst, error);
+
+    out.printf("%-13s %8.1f %8.1f %8.1f %8.1f %9.5f\n", g_curveNames[f], nsPerSample(exactUs, count),
+               nsPerSample(funcUs, count), nsPerSample(batchUs, count), nsPerSample(fixedUs, count), error);
+  }
+  out.printf("largest deviation %.5f\n", worst);
+
+  free(x);
+  free(y);
+  free(fixedX);
+  free(fixedY);
+}
@@ -0,0 +1,15 @@
+#include <Arduino.h>
+
+#ifndef _EASING_BENCH_H
+#define _EASING_BENCH_H
+
+// Compares the table-driven easing curves (eez_ease*(), eez::easeBatch() and the
+// fixed-point eez::easeFixedBatch()) with the original float formulas kept in
+// eez::g_easingExactFuncs[], and reports the largest deviation of each.
+//
+//   easing_bench_run(Serial);
+//
+// Prints ns per sample for every curve; the timings are only meaningful on the device.
+void easing_bench_run(Print &out, uint32_t samples = 1024, uint32_t rounds = 20);
+
+#endif
@@ -0,0 +1,119 @@
+#include "format_bench.h"
+#include "../ui/eez-flow.h"
+
+using namespace eez;
+
+struct FormatBenchCase
+{
+  const char *name;
+  float value;
+  Unit unit;
+  uint16_t options;
+};
+
+static const FormatBenchCase g_cases[] = {
+    {"plain", 23.456789f, UNIT_UNKNOWN, 0},
+    {"integer", 1024.0f, UNIT_UNKNOWN, 0},
+    {"celsius", 21.5f, UNIT_CELSIUS, 0},
+    {"percent", 48.25f, UNIT_PERCENT, 0},
+    {"volt", 3.3f, UNIT_VOLT, 0},
+    {"millivolt", 0.0125f, UNIT_VOLT, 0},
+    {"watt", 12.5f, UNIT_WATT, 0},
+    {"fixed 2", 9.8765f, UNIT_UNKNOWN, FLOAT_OPTIONS_SET_NUM_FIXED_DECIMALS(2)},
+    {"less than", 0.001f, UNIT_AMPER, FLOAT_OPTIONS_LESS_THEN},
+};
+
+// The FLOAT_value_to_text body before the dedicated formatter, kept as the baseline.
+static void snprintfToText(float floatValue, Unit unit, uint16_t options, char *text, int count)
+{
+  text[0] = 0;
+  bool appendDotZero = unit == UNIT_VOLT || unit == UNIT_VOLT_PP || unit == UNIT_AMPER || unit == UNIT_AMPER_PP || unit == UNIT_WATT;
+  bool fixedDecimals = (options & FLOAT_OPTIONS_FIXED_DECIMALS) != 0;
+  if (floatValue != 0 && !fixedDecimals)
+  {
+    unit = findDerivedUnit(floatValue, unit);
+    floatValue /= getUnitFactor(unit);
+  }
+  if ((options & FLOAT_OPTIONS_LESS_THEN) != 0)
+  {
+    stringAppendString(text, count, "< ");
+    appendDotZero = false;
+  }
+  int n = strlen(text);
+  if (fixedDecimals)
+  {
+    snprintf(text + n, count - n, "%.*f", FLOAT_OPTIONS_GET_NUM_FIXED_DECIMALS(options), floatValue);
+  }
+  else
+  {
+    if (unit == UNIT_WATT || unit == UNIT_MILLI_WATT)
+    {
+      snprintf(text + n, count - n, "%.*f", 2, floatValue);
+    }
+    else
+    {
+      snprintf(text + n, count - n, "%g", floatValue);
+    }
+    n = strlen(text);
+    char *dot = strchr(text, '.');
+    if (!dot)
+    {
+      if (appendDotZero)
+      {
+        stringAppendString(text, count, ".0");
+      }
+    }
+    else
+    {
+      int decimalPointIndex = dot - text;
+      int j = n - 1;
+      while (j > decimalPointIndex + (appendDotZero ? 1 : 0) && text[j] == '0')
+      {
+        text[j--] = 0;
+      }
+      if (j == decimalPointIndex && !appendDotZero)
+      {
+        text[j] = 0;
+      }
+    }
+  }
+  const char *unitName = getUnitName(unit);
+  if (unitName && *unitName)
+  {
+    stringAppendString(text, count, " ");
+    stringAppendString(text, count, unitName);
+  }
+}
+
+void format_bench_run(Print &out, uint32_t iterations)
+{
+  char text[64];
+  char expected[64];
+  volatile uint32_t sink = 0;
+
+  out.println("case          snprintf ns  formatter ns  text");
+  for (size_t i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++)
+  {
+    const FormatBenchCase &c = g_cases[i];
+    Value value(c.value, c.unit, c.options);
+
+    uint32_t start = micros();
+    for (uint32_t j = 0; j < iterations; j++)
+    {
+      snprintfToText(c.value, c.unit, c.options, expected, sizeof(expected));
+      sink += expected[0];
+    }
+    uint32_t baselineUs = micros() - start;
+
+    start = micros();
+    for (uint32_t j = 0; j < iterations; j++)
+    {
+      value.toText(text, sizeof(text));
+      sink += text[0];
+    }
+    uint32_t formatterUs = micros() - start;
+
+    out.printf("%-12s %12u %13u  %s%s\n", c.name, (unsigned)(baselineUs * 1000ULL / iterations), (unsigned)(formatterUs * 1000ULL / iterations),
+               text, strcmp(text, expected) == 0 ? "" : " MISMATCH");
+  }
+}
@@ -0,0 +1,15 @@
+#include <Arduino.h>
+
+#ifndef _FORMAT_BENCH_H
+#define _FORMAT_BENCH_H
+
+// Microbenchmark for the numeric label path: times Value::toText() for float values
+// against the snprintf("%g") + trim code it replaced, on a mix of dashboard-like
+// values and units, and checks both produce the same text.
+//
+//   format_bench_run(Serial);
+//
+// Prints ns per call for each case; the result is only meaningful on the device.
+void format_bench_run(Print &out, uint32_t iterations = 2000);
+
+#endif
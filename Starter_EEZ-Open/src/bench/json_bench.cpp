@@ -0,0 +1,76 @@
+#include "json_bench.h"
+#include "../ui/eez-flow.h"
+
+using namespace eez;
+
+// Looks like what a gateway publishes for a room full of sensors.
+static String makePayload()
+{
+  String payload = "{\"device\":\"gateway\",\"ts\":1767225600,\"readings\":[";
+  for (int i = 0; payload.length() < 1900; i++)
+  {
+    if (i > 0)
+    {
+      payload += ",";
+    }
+    payload += "{\"id\":" + String(i) + ",\"name\":\"sensor " + String(i) + "\",\"value\":" + String(i * 1.5f, 1) + ",\"ok\":true}";
+  }
+  payload += "]}";
+  return payload;
+}
+
+// The substring chain the flows used, kept as the baseline.
+static float stringLookup(const String &payload, int id)
+{
+  int start = payload.indexOf("{\"id\":" + String(id) + ",");
+  if (start < 0)
+  {
+    return NAN;
+  }
+  String reading = payload.substring(start, payload.indexOf("}", start));
+  int value = reading.indexOf("\"value\":");
+  return reading.substring(value + 8, reading.indexOf(",", value)).toFloat();
+}
+
+static float jsonLookup(const Value &payload, int id)
+{
+  Value json = flow::parseJson(payload);
+  char path[24];
+  snprintf(path, sizeof(path), "readings.%d.value", id);
+  return flow::getJsonPath(json, path).toFloat();
+}
+
+void json_bench_run(Print &out, uint32_t iterations)
+{
+  String payload = makePayload();
+  Value payloadValue = Value::makeStringRef(payload.c_str(), payload.length(), 0x4d0c7e15);
+  const int id = 17;
+  volatile float sink = 0;
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    sink += stringLookup(payload, id);
+  }
+  uint32_t baselineUs = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    sink += jsonLookup(payloadValue, id);
+  }
+  uint32_t jsonUs = micros() - start;
+
+  uint32_t tokens = 0;
+  Value json = flow::parseJson(payloadValue);
+  if (json.getType() == VALUE_TYPE_JSON)
+  {
+    tokens = ((JsonValueRef *)json.refValue)->document->numTokens;
+  }
+
+  float expected = stringLookup(payload, id);
+  float value = jsonLookup(payloadValue, id);
+  out.printf("%u byte payload, %u tokens\n", payload.length(), tokens);
+  out.printf("substring chain %8u us\n", (unsigned)(baselineUs / iterations));
+  out.printf("parseJson       %8u us  value %.1f%s\n", (unsigned)(jsonUs / iterations), value, value == expected ? "" : " MISMATCH");
+}
@@ -0,0 +1,15 @@
+#include <Arduino.h>
+
+#ifndef _JSON_BENCH_H
+#define _JSON_BENCH_H
+
+// Microbenchmark for the device JSON values: parses a ~2 KB sensor payload with
+// eez::flow::parseJson() and reads a few members, against the String indexOf/substring
+// chain flows used before, and checks both find the same value.
+//
+//   json_bench_run(Serial);
+//
+// Prints us per payload; the result is only meaningful on the device.
+void json_bench_run(Print &out, uint32_t iterations = 200);
+
+#endif
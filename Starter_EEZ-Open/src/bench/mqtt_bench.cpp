@@ -0,0 +1,193 @@
+#include "mqtt_bench.h"
+#include "../mqtt/mqtt_adapter.h"
+#include "../telemetry/frame_telemetry.h"
+#include "../ui/eez-flow.h"
+#include <algorithm>
+
+using namespace eez::flow;
+
+struct MqttBenchState
+{
+  lv_obj_t *label;
+  uint32_t received;
+  uint32_t outOfOrder;
+  uint32_t lastSequence;
+
+  uint32_t *deliveryUs;
+  uint32_t *labelUs;
+  uint32_t numDelivery;
+  uint32_t numLabel;
+
+  // publish times of messages shown by the label but not yet flushed
+  uint32_t pending[MQTT_BENCH_MAX_IN_FLIGHT * 4];
+  uint32_t numPending;
+};
+
+// Runs on the UI task from processMQTTIngest().
+static bool onBenchMessage(void *userData, const char *topic, const char *payload, size_t payloadLength)
+{
+  MqttBenchState *state = (MqttBenchState *)userData;
+  uint32_t now = micros();
+  uint32_t sequence, published;
+  if (sscanf(payload, "%u %u", &sequence, &published) != 2)
+  {
+    return true;
+  }
+  if (state->received > 0 && sequence != state->lastSequence + 1)
+  {
+    state->outOfOrder++;
+  }
+  state->lastSequence = sequence;
+  state->received++;
+
+  lv_label_set_text(state->label, payload);
+  if (state->numDelivery < MQTT_BENCH_MAX_SAMPLES)
+  {
+    state->deliveryUs[state->numDelivery++] = now - published;
+  }
+  if (state->numPending < sizeof(state->pending) / sizeof(state->pending[0]))
+  {
+    state->pending[state->numPending++] = published;
+  }
+  return true;
+}
+
+static void printPercentiles(Print &out, const char *name, uint32_t *samples, uint32_t count)
+{
+  if (count == 0)
+  {
+    out.printf("%-10s no samples\n", name);
+    return;
+  }
+  std::sort(samples, samples + count);
+  out.printf("%-10s p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f ms (%u samples)\n", name,
+             samples[(count * 50 + 99) / 100 - 1] / 1000.0f, samples[(count * 95 + 99) / 100 - 1] / 1000.0f,
+             samples[(count * 99 + 99) / 100 - 1] / 1000.0f, samples[count - 1] / 1000.0f, count);
+}
+
+// Ticks LVGL and the MQTT ingest ring, and closes the label samples once a frame went out.
+static void pump(MqttBenchState &state)
+{
+  processMQTTIngest();
+  uint32_t frames = frameTelemetry.getFrameCount();
+  lv_timer_handler();
+  if (frameTelemetry.getFrameCount() != frames && state.numPending > 0)
+  {
+    uint32_t now = micros();
+    for (uint32_t i = 0; i < state.numPending && state.numLabel < MQTT_BENCH_MAX_SAMPLES; i++)
+    {
+      state.labelUs[state.numLabel++] = now - state.pending[i];
+    }
+    state.numPending = 0;
+  }
+}
+
+void mqtt_bench_run(Print &out, const char *host, uint16_t port, uint32_t ratePerSecond, uint32_t seconds)
+{
+  void *handle;
+  if (eez_mqtt_init("mqtt", host, port, nullptr, nullptr, &handle) != MQTT_ERROR_OK)
+  {
+    out.println("mqtt bench: init failed, build with -D EEZ_MQTT_ADAPTER");
+    return;
+  }
+  if (!registerMQTTConnection(handle))
+  {
+    out.println("mqtt bench: too many MQTT connections");
+    eez_mqtt_deinit(handle);
+    return;
+  }
+
+  MqttBenchState state = {};
+  state.deliveryUs = (uint32_t *)malloc(MQTT_BENCH_MAX_SAMPLES * sizeof(uint32_t));
+  state.labelUs = (uint32_t *)malloc(MQTT_BENCH_MAX_SAMPLES * sizeof(uint32_t));
+  state.label = lv_label_create(lv_layer_top());
+  lv_obj_align(state.label, LV_ALIGN_BOTTOM_LEFT, 4, -4);
+
+  char topic[40];
+  snprintf(topic, sizeof(topic), "eez/bench/%08x", (uint32_t)esp_random());
+  if (!state.deliveryUs || !state.labelUs || !addMQTTMessageHandler(handle, topic, onBenchMessage, &state))
+  {
+    out.println("mqtt bench: out of memory");
+    goto cleanup;
+  }
+  eez_mqtt_subscribe(handle, topic);
+  eez_mqtt_connect(handle);
+
+  {
+    // the first message that comes back proves the subscription is active
+    char payload[32];
+    uint32_t start = millis();
+    uint32_t lastProbe = 0;
+    while (state.received == 0 && millis() - start < 5000)
+    {
+      if (millis() - lastProbe >= 250)
+      {
+        lastProbe = millis();
+        snprintf(payload, sizeof(payload), "0 %u", micros());
+        eez_mqtt_publish(handle, topic, payload);
+      }
+      pump(state);
+      delay(1);
+    }
+    if (state.received == 0)
+    {
+      out.printf("mqtt bench: no echo from %s:%u\n", host, port);
+      goto cleanup;
+    }
+    pump(state);
+    state.received = 0;
+    state.numDelivery = 0;
+    state.numLabel = 0;
+    state.numPending = 0;
+
+    uint32_t sent = 0;
+    uint32_t publishFailures = 0;
+    start = micros();
+    uint32_t duration = seconds * 1000000;
+    while (micros() - start < duration)
+    {
+      uint32_t elapsed = micros() - start;
+      bool due = ratePerSecond ? (uint64_t)sent * 1000000 / ratePerSecond <= elapsed : sent - state.received < MQTT_BENCH_MAX_IN_FLIGHT;
+      if (due)
+      {
+        snprintf(payload, sizeof(payload), "%u %u", sent + 1, micros());
+        if (eez_mqtt_publish(handle, topic, payload) == MQTT_ERROR_OK)
+        {
+          sent++;
+        }
+        else
+        {
+          publishFailures++;
+        }
+      }
+      pump(state);
+      if (!due)
+      {
+        delay(1);
+      }
+    }
+    // let the last messages arrive
+    uint32_t drainStart = millis();
+    while (state.received < sent && millis() - drainStart < 1000)
+    {
+      pump(state);
+      delay(1);
+    }
+    uint32_t elapsedMs = (micros() - start) / 1000;
+
+    out.printf("mqtt bench %s:%u, %s, %u s\n", host, port, ratePerSecond ? "fixed rate" : "max rate", seconds);
+    out.printf("sent %u (%u failed), received %u, lost %u, out of order %u, %.1f msgs/s\n", sent, publishFailures,
+               state.received, sent - state.received, state.outOfOrder, state.received * 1000.0f / elapsedMs);
+    printPercentiles(out, "delivery", state.deliveryUs, state.numDelivery);
+    printPercentiles(out, "label", state.labelUs, state.numLabel);
+    mqtt_adapter_print_stats(out);
+  }
+
+cleanup:
+  removeMQTTMessageHandler(handle, onBenchMessage, &state);
+  eez_mqtt_disconnect(handle);
+  releaseMQTTConnection(handle);
+  lv_obj_del(state.label);
+  free(state.deliveryUs);
+  free(state.labelUs);
+}
@@ -0,0 +1,32 @@
+#include <Arduino.h>
+
+#ifndef _MQTT_BENCH_H
+#define _MQTT_BENCH_H
+
+// Load test for the MQTT ingest path against a broker on the local network (e.g.
+// mosquitto on the development machine).  The panel subscribes to a test topic and
+// publishes timestamped messages to it, so every message goes
+//
+//   publish -> broker -> esp-mqtt task -> ingest ring -> UI task -> label -> frame
+//
+// and two latencies are recorded per message: until the handler on the UI task set the
+// label text, and until the frame showing that text was flushed (frameTelemetry must be
+// attached to the display driver).
+//
+//   mqtt_bench_run(Serial, "192.168.1.10");               // 100 msgs/s for 10 s
+//   mqtt_bench_run(Serial, "192.168.1.10", 1883, 0, 10);  // as fast as it keeps up
+//
+// WiFi must already be connected.  Blocks while it runs and ticks LVGL itself, the
+// flows are not ticked meanwhile.  A rate of 0 keeps MQTT_BENCH_MAX_IN_FLIGHT messages
+// outstanding, which gives the sustainable throughput.
+#ifndef MQTT_BENCH_MAX_SAMPLES
+#define MQTT_BENCH_MAX_SAMPLES 2048
+#endif
+
+#ifndef MQTT_BENCH_MAX_IN_FLIGHT
+#define MQTT_BENCH_MAX_IN_FLIGHT 16
+#endif
+
+void mqtt_bench_run(Print &out, const char *host, uint16_t port = 1883, uint32_t ratePerSecond = 100, uint32_t seconds = 10);
+
+#endif
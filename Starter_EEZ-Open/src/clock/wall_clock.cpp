@@ -0,0 +1,116 @@
+#include "wall_clock.h"
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <sys/time.h>
+
+WallClock wallClock;
+
+static const char *const g_sourceNames[] = {"not set", "rtc", "ntp", "manual"};
+
+WallClock::WallClock()
+    : _baseEpochMs(0), _baseUs(0), _source(WALL_CLOCK_SOURCE_NONE), _syncCount(0), _lastSync(0),
+      _rtcRead(nullptr), _rtcWrite(nullptr), _rtcUserData(nullptr)
+{
+  _lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void WallClock::begin(int timeZone, eez::flow::date::DstRule dstRule)
+{
+  eez::flow::date::g_timeZone = timeZone;
+  eez::flow::date::g_dstRule = dstRule;
+
+  // keep whatever the system time is, it survives a software reset
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  portENTER_CRITICAL(&_lock);
+  _baseEpochMs = (uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+  _baseUs = esp_timer_get_time();
+  portEXIT_CRITICAL(&_lock);
+
+  eez::flow::getDateNowHook = now;
+}
+
+void WallClock::setRtc(WallClockRtcRead read, WallClockRtcWrite write, void *userData)
+{
+  _rtcRead = read;
+  _rtcWrite = write;
+  _rtcUserData = userData;
+
+  uint64_t epochMs;
+  if (read && _source != WALL_CLOCK_SOURCE_NTP && read(userData, epochMs))
+  {
+    rebase(epochMs, WALL_CLOCK_SOURCE_RTC);
+  }
+}
+
+void WallClock::startNtp(const char *server1, const char *server2)
+{
+  sntp_set_time_sync_notification_cb(onNtpSync);
+  configTime(0, 0, server1, server2);
+}
+
+void WallClock::setTime(uint64_t epochMs)
+{
+  rebase(epochMs, WALL_CLOCK_SOURCE_MANUAL);
+  if (_rtcWrite)
+  {
+    _rtcWrite(_rtcUserData, epochMs);
+  }
+}
+
+uint64_t WallClock::getEpochMs()
+{
+  int64_t nowUs = esp_timer_get_time();
+  portENTER_CRITICAL(&_lock);
+  uint64_t epochMs = _baseEpochMs + (nowUs - _baseUs) / 1000;
+  portEXIT_CRITICAL(&_lock);
+  return epochMs;
+}
+
+void WallClock::printStatus(Print &out)
+{
+  char text[40];
+  eez::flow::date::toString(eez::flow::date::now(), text, sizeof(text));
+  out.printf("wall clock: %s (local), source %s, %u syncs", text, g_sourceNames[_source], _syncCount);
+  if (_syncCount > 0)
+  {
+    out.printf(", last %u s ago", (millis() - _lastSync) / 1000);
+  }
+  out.println();
+}
+
+double WallClock::now()
+{
+  return (double)wallClock.getEpochMs();
+}
+
+// Called on the network task, SNTP already set the system time.
+void WallClock::onNtpSync(struct timeval *tv)
+{
+  uint64_t epochMs = (uint64_t)tv->tv_sec * 1000 + tv->tv_usec / 1000;
+  wallClock.rebase(epochMs, WALL_CLOCK_SOURCE_NTP);
+  if (wallClock._rtcWrite)
+  {
+    wallClock._rtcWrite(wallClock._rtcUserData, epochMs);
+  }
+}
+
+void WallClock::rebase(uint64_t epochMs, WallClockSource source)
+{
+  if (source != WALL_CLOCK_SOURCE_NTP)
+  {
+    // so time() and the TLS certificate checks agree with the flows
+    struct timeval tv = {(time_t)(epochMs / 1000), (suseconds_t)(epochMs % 1000 * 1000)};
+    settimeofday(&tv, nullptr);
+  }
+  portENTER_CRITICAL(&_lock);
+  _baseEpochMs = epochMs;
+  _baseUs = esp_timer_get_time();
+  portEXIT_CRITICAL(&_lock);
+  _source = source;
+  if (source == WALL_CLOCK_SOURCE_NTP)
+  {
+    _syncCount++;
+    _lastSync = millis();
+  }
+}
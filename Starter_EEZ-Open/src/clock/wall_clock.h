@@ -0,0 +1,73 @@
+#include <Arduino.h>
+
+#ifndef _WALL_CLOCK_H
+#define _WALL_CLOCK_H
+
+#include "../ui/eez-flow.h"
+
+// Wall clock behind eez::flow::getDateNowHook, i.e. Date.now() in the flows and every
+// date shown by a label.  The time comes from SNTP once WiFi is up, and from a battery
+// backed RTC until then if one is set; the RTC is written back after every NTP sync.
+//
+//   wallClock.begin(100, eez::flow::date::DST_RULE_EUROPE);  // UTC+01:00, EU summer time
+//   wallClock.setRtc(readRtc, writeRtc, &rtc);                // optional
+//   wallClock.startNtp("pool.ntp.org");                       // after WiFi.begin()
+//
+// The time zone is eez-flow's hhmm integer (-500 is UTC-05:00); libc time stays UTC.
+// The hook reads the high resolution timer against the last sync instead of going
+// through gettimeofday(), so it is cheap enough to call on every flow tick.
+
+enum WallClockSource
+{
+  WALL_CLOCK_SOURCE_NONE,
+  WALL_CLOCK_SOURCE_RTC,
+  WALL_CLOCK_SOURCE_NTP,
+  WALL_CLOCK_SOURCE_MANUAL
+};
+
+// Both are called with the UTC time in milliseconds since 1970.  The write runs on the
+// network task after an NTP sync, queue it on i2cBus rather than waiting for the bus.
+typedef bool (*WallClockRtcRead)(void *userData, uint64_t &epochMs);
+typedef void (*WallClockRtcWrite)(void *userData, uint64_t epochMs);
+
+class WallClock
+{
+public:
+  WallClock();
+
+  void begin(int timeZone = 0, eez::flow::date::DstRule dstRule = eez::flow::date::DST_RULE_OFF);
+
+  // Seeds the clock from the RTC unless NTP already synced.
+  void setRtc(WallClockRtcRead read, WallClockRtcWrite write, void *userData);
+
+  void startNtp(const char *server1 = "pool.ntp.org", const char *server2 = nullptr);
+
+  // For a time that came from elsewhere, e.g. a Date header or an MQTT message.
+  void setTime(uint64_t epochMs);
+
+  uint64_t getEpochMs();
+  bool isSet() const { return _source != WALL_CLOCK_SOURCE_NONE; }
+  WallClockSource getSource() const { return _source; }
+  void printStatus(Print &out);
+
+private:
+  static double now();
+  static void onNtpSync(struct timeval *tv);
+
+  void rebase(uint64_t epochMs, WallClockSource source);
+
+  portMUX_TYPE _lock;
+  uint64_t _baseEpochMs;
+  int64_t _baseUs;
+  volatile WallClockSource _source;
+  uint32_t _syncCount;
+  uint32_t _lastSync;
+
+  WallClockRtcRead _rtcRead;
+  WallClockRtcWrite _rtcWrite;
+  void *_rtcUserData;
+};
+
+extern WallClock wallClock;
+
+#endif
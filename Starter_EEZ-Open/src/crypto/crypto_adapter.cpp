@@ -0,0 +1,132 @@
+#include "crypto_adapter.h"
+#include "../ui/eez-flow.h"
+
+#if defined(EEZ_CRYPTO_ADAPTER) && defined(ESP_PLATFORM)
+
+#include <mbedtls/aes.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/version.h>
+
+// mbedtls 2 (IDF 4.x) only returns errors from the _ret variants
+#if MBEDTLS_VERSION_NUMBER < 0x03000000
+#define mbedtls_sha256_starts mbedtls_sha256_starts_ret
+#define mbedtls_sha256_update mbedtls_sha256_update_ret
+#define mbedtls_sha256_finish mbedtls_sha256_finish_ret
+#define mbedtls_sha256 mbedtls_sha256_ret
+#endif
+
+void *eez_crypto_sha256_begin()
+{
+  mbedtls_sha256_context *ctx = (mbedtls_sha256_context *)malloc(sizeof(mbedtls_sha256_context));
+  if (!ctx)
+  {
+    return nullptr;
+  }
+  mbedtls_sha256_init(ctx);
+  mbedtls_sha256_starts(ctx, 0);
+  return ctx;
+}
+
+void eez_crypto_sha256_update(void *context, const uint8_t *data, size_t length)
+{
+  mbedtls_sha256_update((mbedtls_sha256_context *)context, data, length);
+}
+
+void eez_crypto_sha256_end(void *context, uint8_t *digest)
+{
+  mbedtls_sha256_context *ctx = (mbedtls_sha256_context *)context;
+  if (digest)
+  {
+    mbedtls_sha256_finish(ctx, digest);
+  }
+  mbedtls_sha256_free(ctx);
+  free(ctx);
+}
+
+void eez_crypto_sha256(const uint8_t *data, size_t length, uint8_t *digest)
+{
+  mbedtls_sha256(data, length, digest, 0);
+}
+
+bool eez_crypto_aes_ctr(const uint8_t *key, size_t keyLength, uint8_t *counter, const uint8_t *input, uint8_t *output, size_t length)
+{
+  if (keyLength != 16 && keyLength != 24 && keyLength != 32)
+  {
+    return false;
+  }
+  mbedtls_aes_context ctx;
+  mbedtls_aes_init(&ctx);
+  size_t streamOffset = 0;
+  uint8_t streamBlock[16];
+  bool ok = mbedtls_aes_setkey_enc(&ctx, key, keyLength * 8) == 0 &&
+            mbedtls_aes_crypt_ctr(&ctx, length, &streamOffset, counter, streamBlock, input, output) == 0;
+  mbedtls_aes_free(&ctx);
+  return ok;
+}
+
+#endif
+
+static bool hexEquals(const uint8_t *data, size_t length, const char *hex)
+{
+  char text[3];
+  for (size_t i = 0; i < length; i++)
+  {
+    snprintf(text, sizeof(text), "%02x", data[i]);
+    if (memcmp(text, hex + i * 2, 2) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool crypto_adapter_self_test(Print &out)
+{
+  uint8_t digest[EEZ_CRYPTO_SHA256_SIZE];
+  eez_crypto_sha256((const uint8_t *)"abc", 3, digest);
+  bool shaOk = hexEquals(digest, sizeof(digest), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+  // streamed in uneven pieces, NIST "abcdbcdecdef..." vector
+  const char *message = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  eez::flow::Sha256Stream stream;
+  for (size_t i = 0, n = 1; message[i]; i += n, n = n % 7 + 1)
+  {
+    size_t left = strlen(message + i);
+    stream.update((const uint8_t *)message + i, n < left ? n : left);
+  }
+  shaOk = stream.finish(digest) && shaOk &&
+          hexEquals(digest, sizeof(digest), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+  // NIST SP 800-38A F.5.1, first block
+  static const uint8_t key[16] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+  static const uint8_t plain[16] = {0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a};
+  uint8_t counter[16] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+  uint8_t cipher[16];
+  bool aesOk = eez_crypto_aes_ctr(key, sizeof(key), counter, plain, cipher, sizeof(cipher)) &&
+               hexEquals(cipher, sizeof(cipher), "874d6191b620e3261bef6864990db6ce");
+
+  const size_t bufferSize = 4096;
+  const int rounds = 64;
+  uint8_t *buffer = (uint8_t *)calloc(1, bufferSize);
+  if (buffer)
+  {
+    uint32_t start = micros();
+    for (int i = 0; i < rounds; i++)
+    {
+      eez_crypto_sha256(buffer, bufferSize, digest);
+    }
+    uint32_t shaUs = micros() - start;
+
+    start = micros();
+    for (int i = 0; i < rounds; i++)
+    {
+      eez_crypto_aes_ctr(key, sizeof(key), counter, buffer, buffer, bufferSize);
+    }
+    uint32_t aesUs = micros() - start;
+    free(buffer);
+
+    out.printf("sha256  %s  %.2f MB/s\n", shaOk ? "ok" : "FAILED", bufferSize * rounds / (float)shaUs);
+    out.printf("aes-ctr %s  %.2f MB/s\n", aesOk ? "ok" : "FAILED", bufferSize * rounds / (float)aesUs);
+  }
+  return shaOk && aesOk;
+}
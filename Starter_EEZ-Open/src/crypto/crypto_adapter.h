@@ -0,0 +1,23 @@
+#include <Arduino.h>
+
+#ifndef _CRYPTO_ADAPTER_H
+#define _CRYPTO_ADAPTER_H
+
+// The eez_crypto_* functions behind Crypto.sha256 and eez::flow::Sha256Stream, on the
+// ESP32-S3 SHA and AES peripherals through the IDF mbedtls port.  Build with
+// -D EEZ_CRYPTO_ADAPTER (see platformio.ini) so eez-flow.cpp leaves them to this file;
+// other builds keep the software SHA-256 / AES in eez-flow.cpp.
+//
+// Large data is hashed as it arrives instead of being collected first:
+//
+//   eez::flow::Sha256Stream hash;
+//   while (int n = file.read(chunk, sizeof(chunk)))
+//     hash.update(chunk, n);
+//   hash.finish(digest);
+//
+// Known answer tests and throughput of both engines:
+//
+//   crypto_adapter_self_test(Serial);
+bool crypto_adapter_self_test(Print &out);
+
+#endif
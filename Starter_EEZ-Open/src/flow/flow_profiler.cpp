@@ -0,0 +1,247 @@
+#include "flow_profiler.h"
+#include "../ui/eez-flow.h"
+
+#if EEZ_FLOW_PROFILER
+
+using namespace eez::flow;
+
+static const char *const g_partitionNames[FLOW_NUM_PARTITIONS] = {"ui", "worker"};
+
+static const char *componentTypeName(uint16_t type)
+{
+  using namespace eez::flow::defs_v3;
+  switch (type)
+  {
+  case COMPONENT_TYPE_START_ACTION: return "Start";
+  case COMPONENT_TYPE_END_ACTION: return "End";
+  case COMPONENT_TYPE_INPUT_ACTION: return "Input";
+  case COMPONENT_TYPE_OUTPUT_ACTION: return "Output";
+  case COMPONENT_TYPE_WATCH_VARIABLE_ACTION: return "Watch";
+  case COMPONENT_TYPE_EVAL_EXPR_ACTION: return "Evaluate";
+  case COMPONENT_TYPE_SET_VARIABLE_ACTION: return "SetVariable";
+  case COMPONENT_TYPE_SWITCH_ACTION: return "Switch";
+  case COMPONENT_TYPE_COMPARE_ACTION: return "Compare";
+  case COMPONENT_TYPE_IS_TRUE_ACTION: return "IsTrue";
+  case COMPONENT_TYPE_CONSTANT_ACTION: return "Constant";
+  case COMPONENT_TYPE_LOG_ACTION: return "Log";
+  case COMPONENT_TYPE_CALL_ACTION_ACTION: return "CallAction";
+  case COMPONENT_TYPE_DELAY_ACTION: return "Delay";
+  case COMPONENT_TYPE_ERROR_ACTION: return "Error";
+  case COMPONENT_TYPE_CATCH_ERROR_ACTION: return "CatchError";
+  case COMPONENT_TYPE_COUNTER_ACTION: return "Counter";
+  case COMPONENT_TYPE_LOOP_ACTION: return "Loop";
+  case COMPONENT_TYPE_SHOW_PAGE_ACTION: return "ShowPage";
+  case COMPONENT_TYPE_SELECT_LANGUAGE_ACTION: return "SelectLanguage";
+  case COMPONENT_TYPE_ANIMATE_ACTION: return "Animate";
+  case COMPONENT_TYPE_ON_EVENT_ACTION: return "OnEvent";
+  case COMPONENT_TYPE_LVGL_ACTION: return "LVGL";
+  case COMPONENT_TYPE_SORT_ARRAY_ACTION: return "SortArray";
+  case COMPONENT_TYPE_LVGL_USER_WIDGET_WIDGET: return "UserWidget";
+  case COMPONENT_TYPE_TEST_AND_SET_ACTION: return "TestAndSet";
+  case COMPONENT_TYPE_MQTT_INIT_ACTION: return "MQTTInit";
+  case COMPONENT_TYPE_MQTT_CONNECT_ACTION: return "MQTTConnect";
+  case COMPONENT_TYPE_MQTT_DISCONNECT_ACTION: return "MQTTDisconnect";
+  case COMPONENT_TYPE_MQTT_EVENT_ACTION: return "MQTTEvent";
+  case COMPONENT_TYPE_MQTT_SUBSCRIBE_ACTION: return "MQTTSubscribe";
+  case COMPONENT_TYPE_MQTT_UNSUBSCRIBE_ACTION: return "MQTTUnsubscribe";
+  case COMPONENT_TYPE_MQTT_PUBLISH_ACTION: return "MQTTPublish";
+  case COMPONENT_TYPE_LABEL_IN_ACTION: return "LabelIn";
+  case COMPONENT_TYPE_LABEL_OUT_ACTION: return "LabelOut";
+  default: return nullptr;
+  }
+}
+
+static void printTypeColumn(Print &out, uint16_t type)
+{
+  const char *name = componentTypeName(type);
+  if (name)
+  {
+    out.printf("%-16s", name);
+  }
+  else
+  {
+    out.printf("type %-11u", type);
+  }
+}
+
+static void printProfileColumns(Print &out, const ComponentProfile &profile, uint32_t cyclesPerUs)
+{
+  uint32_t count = profile.count ? profile.count : 1;
+  out.printf(" %8u %10u %8u %8u %8u %8u %7u\n", profile.count, (uint32_t)(profile.totalCycles / cyclesPerUs),
+             (uint32_t)(profile.totalCycles / count / cyclesPerUs), profile.maxCycles / cyclesPerUs,
+             (uint32_t)(profile.totalWaitCycles / count / cyclesPerUs), profile.maxWaitCycles / cyclesPerUs, profile.allocs);
+}
+
+struct InstanceRef
+{
+  uint16_t flowIndex;
+  uint16_t componentIndex;
+  uint16_t type;
+  ComponentProfile profile;
+};
+
+void flow_profiler_print(Print &out)
+{
+  uint32_t cyclesPerUs = getProfilerCyclesPerUs();
+  for (uint8_t partition = 0; partition < FLOW_NUM_PARTITIONS; partition++)
+  {
+    TickProfile tick;
+    getTickProfile(partition, tick);
+    if (tick.count == 0)
+    {
+      continue;
+    }
+    out.printf("flow partition %s: %u ticks, avg %u us, max %u us, %u over budget\n", g_partitionNames[partition], tick.count,
+               (uint32_t)(tick.totalCycles / tick.count / cyclesPerUs), tick.maxCycles / cyclesPerUs, tick.overBudget);
+
+    out.println("type                count   total us   avg us   max us  wait us wait max  allocs");
+    for (int slot = 0; slot < EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES; slot++)
+    {
+      uint16_t type;
+      ComponentProfile profile;
+      if (getComponentTypeProfile(partition, slot, type, profile))
+      {
+        printTypeColumn(out, type);
+        out.print("    ");
+        printProfileColumns(out, profile, cyclesPerUs);
+      }
+    }
+
+    // keep the N most expensive instances, insertion sorted by total cycles
+    InstanceRef top[FLOW_PROFILER_TOP_COMPONENTS];
+    int numTop = 0;
+    for (int flowIndex = 0; flowIndex < getNumProfiledFlows(); flowIndex++)
+    {
+      for (int componentIndex = 0; componentIndex < getNumProfiledComponents(flowIndex); componentIndex++)
+      {
+        InstanceRef ref;
+        if (!getComponentProfile(partition, flowIndex, componentIndex, ref.type, ref.profile) || ref.profile.count == 0)
+        {
+          continue;
+        }
+        ref.flowIndex = flowIndex;
+        ref.componentIndex = componentIndex;
+        int i = numTop < FLOW_PROFILER_TOP_COMPONENTS ? numTop++ : FLOW_PROFILER_TOP_COMPONENTS;
+        while (i > 0 && top[i - 1].profile.totalCycles < ref.profile.totalCycles)
+        {
+          if (i < FLOW_PROFILER_TOP_COMPONENTS)
+          {
+            top[i] = top[i - 1];
+          }
+          i--;
+        }
+        if (i < FLOW_PROFILER_TOP_COMPONENTS)
+        {
+          top[i] = ref;
+        }
+      }
+    }
+
+    out.println("flow comp type            count   total us   avg us   max us  wait us wait max  allocs");
+    for (int i = 0; i < numTop; i++)
+    {
+      out.printf("%4u %4u ", top[i].flowIndex, top[i].componentIndex);
+      printTypeColumn(out, top[i].type);
+      printProfileColumns(out, top[i].profile, cyclesPerUs);
+    }
+  }
+}
+
+static void write16(Print &out, uint16_t value)
+{
+  out.write((const uint8_t *)&value, sizeof(value));
+}
+
+static void write32(Print &out, uint32_t value)
+{
+  out.write((const uint8_t *)&value, sizeof(value));
+}
+
+static void write64(Print &out, uint64_t value)
+{
+  out.write((const uint8_t *)&value, sizeof(value));
+}
+
+static void writeProfile(Print &out, const ComponentProfile &profile)
+{
+  write32(out, profile.count);
+  write32(out, profile.maxCycles);
+  write64(out, profile.totalCycles);
+  write32(out, profile.maxWaitCycles);
+  write64(out, profile.totalWaitCycles);
+  write32(out, profile.allocs);
+}
+
+void flow_profiler_dump(Print &out)
+{
+  out.write((const uint8_t *)"EZPF", 4);
+  out.write((uint8_t)FLOW_PROFILER_DUMP_VERSION);
+  out.write((uint8_t)FLOW_NUM_PARTITIONS);
+  write16(out, 0);
+  write32(out, getProfilerCyclesPerUs());
+
+  for (uint8_t partition = 0; partition < FLOW_NUM_PARTITIONS; partition++)
+  {
+    TickProfile tick;
+    getTickProfile(partition, tick);
+    write32(out, tick.count);
+    write32(out, tick.overBudget);
+    write32(out, tick.maxCycles);
+    write64(out, tick.totalCycles);
+
+    uint16_t type;
+    ComponentProfile profile;
+    uint16_t numTypes = 0;
+    for (int slot = 0; slot < EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES; slot++)
+    {
+      if (getComponentTypeProfile(partition, slot, type, profile))
+      {
+        write16(out, type);
+        writeProfile(out, profile);
+        numTypes++;
+      }
+    }
+    write16(out, FLOW_PROFILER_DUMP_END);
+    write16(out, numTypes);
+
+    uint16_t numInstances = 0;
+    for (int flowIndex = 0; flowIndex < getNumProfiledFlows(); flowIndex++)
+    {
+      for (int componentIndex = 0; componentIndex < getNumProfiledComponents(flowIndex); componentIndex++)
+      {
+        if (getComponentProfile(partition, flowIndex, componentIndex, type, profile) && profile.count > 0)
+        {
+          write16(out, flowIndex);
+          write16(out, componentIndex);
+          write16(out, type);
+          writeProfile(out, profile);
+          numInstances++;
+        }
+      }
+    }
+    write16(out, FLOW_PROFILER_DUMP_END);
+    write16(out, numInstances);
+  }
+}
+
+void flow_profiler_reset()
+{
+  profilerReset();
+}
+
+#else
+
+void flow_profiler_print(Print &out)
+{
+  out.println("flow profiler disabled, build with -D EEZ_FLOW_PROFILER=1");
+}
+
+void flow_profiler_dump(Print &out)
+{
+}
+
+void flow_profiler_reset()
+{
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include <Arduino.h>
+
+#ifndef _FLOW_PROFILER_H
+#define _FLOW_PROFILER_H
+
+// Serial export of the flow engine profiler.  Build with -D EEZ_FLOW_PROFILER=1 (see
+// platformio.ini) and every executeComponent() is timed with the CPU cycle counter:
+// call count, total and max cycles, how long the task sat in the queue and how many
+// eez::alloc() calls it made, per component type and per component instance.  Each
+// tick also records whether it ran out of its FLOW_TICK_MAX_DURATION_MS budget.
+//
+//   flow_profiler_print(Serial);       // readable tables, times in us
+//   flow_profiler_dump(Serial);        // binary, for tools on the host side
+//   flow_profiler_reset();
+//
+// Without the build flag these print a one line notice and the dump is empty.
+
+// Instances shown per partition by flow_profiler_print(), most expensive first.
+#ifndef FLOW_PROFILER_TOP_COMPONENTS
+#define FLOW_PROFILER_TOP_COMPONENTS 16
+#endif
+
+// Binary dump layout, all fields little endian:
+//   header     "EZPF", uint8 version, uint8 partitions, uint16 reserved, uint32 cycles per us
+//   per partition:
+//     tick     uint32 count, uint32 over budget, uint32 max cycles, uint64 total cycles
+//     per type:
+//              uint16 type, profile
+//     uint16 0xFFFF, uint16 number of type records
+//     per instance (only instances that ran):
+//              uint16 flow index, uint16 component index, uint16 type, profile
+//     uint16 0xFFFF, uint16 number of instance records
+//   profile    uint32 count, uint32 max cycles, uint64 total cycles, uint32 max wait cycles,
+//              uint64 total wait cycles, uint32 allocs
+// The records are read from the live profiler while the flows keep running, so each
+// section ends with a marker and the number of records that were actually written.
+#define FLOW_PROFILER_DUMP_VERSION 2
+#define FLOW_PROFILER_DUMP_END 0xFFFF
+
+void flow_profiler_print(Print &out);
+void flow_profiler_dump(Print &out);
+void flow_profiler_reset();
+
+#endif
@@ -0,0 +1,78 @@
+#include "flow_worker.h"
+#include "../ui/eez-flow.h"
+
+FlowWorker flowWorker;
+
+FlowWorker::FlowWorker()
+    : _task(nullptr), _ticked(nullptr), _tickCount(0), _maxTickUs(0)
+{
+}
+
+void FlowWorker::begin()
+{
+  if (_task)
+  {
+    return;
+  }
+  _ticked = xSemaphoreCreateBinary();
+  eez::flow::wakePartitionHook = wake;
+  eez::flow::waitForPartitionHook = waitFor;
+  xTaskCreatePinnedToCore(taskMain, "flow_worker", FLOW_WORKER_STACK_SIZE, this, FLOW_WORKER_PRIORITY, &_task, FLOW_WORKER_CORE);
+}
+
+void FlowWorker::printStats(Print &out)
+{
+  out.printf("flow worker: %u ticks, max tick %u us, queue %u (max %u)\n", _tickCount, _maxTickUs,
+             (unsigned)eez::flow::getQueueSize(FLOW_PARTITION_WORKER), (unsigned)eez::flow::getMaxQueueSize(FLOW_PARTITION_WORKER));
+}
+
+// Called from whichever partition posted to the mailbox.
+void FlowWorker::wake(uint8_t partition)
+{
+  if (partition == FLOW_PARTITION_WORKER && flowWorker._task)
+  {
+    xTaskNotifyGive(flowWorker._task);
+  }
+}
+
+// The loop task waits here while the worker's mailbox is full or while stop() waits for
+// the worker to leave its tick; each finished tick releases it.  The timeout only bounds
+// the wait if the worker is stuck.
+void FlowWorker::waitFor(uint8_t partition)
+{
+  if (partition == FLOW_PARTITION_WORKER && flowWorker._task && xTaskGetCurrentTaskHandle() != flowWorker._task)
+  {
+    xSemaphoreTake(flowWorker._ticked, pdMS_TO_TICKS(FLOW_WORKER_IDLE_MS));
+  }
+  else
+  {
+    taskYIELD();
+  }
+}
+
+void FlowWorker::taskMain(void *arg)
+{
+  FlowWorker *worker = (FlowWorker *)arg;
+  while (true)
+  {
+    uint32_t start = micros();
+    eez::flow::tickPartition(FLOW_PARTITION_WORKER);
+    uint32_t elapsed = micros() - start;
+    xSemaphoreGive(worker->_ticked);
+    worker->_tickCount++;
+    if (elapsed > worker->_maxTickUs)
+    {
+      worker->_maxTickUs = elapsed;
+    }
+
+    if (eez::flow::getQueueSize(FLOW_PARTITION_WORKER) > 0)
+    {
+      // continuous tasks (Delay, Loop) are waiting for time to pass
+      vTaskDelay(1);
+    }
+    else
+    {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FLOW_WORKER_IDLE_MS));
+    }
+  }
+}
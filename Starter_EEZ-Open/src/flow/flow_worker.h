@@ -0,0 +1,73 @@
+#include <Arduino.h>
+
+#ifndef _FLOW_WORKER_H
+#define _FLOW_WORKER_H
+
+// Runs the worker partition of the flow engine on the other S3 core.  Action flows
+// marked with eez::flow::setFlowPartition(flowIndex, FLOW_PARTITION_WORKER) are executed
+// here, so slow data processing doesn't hold up eez_flow_tick() and the LVGL timer
+// handler on the loop task.
+//
+//   ui_init();
+//   eez::flow::setFlowPartition(FLOW_INDEX_PROCESS_SAMPLES, FLOW_PARTITION_WORKER);
+//   flowWorker.begin();
+//   eez::flow::startFlowOnPartition(FLOW_INDEX_PROCESS_SAMPLES, FLOW_PARTITION_WORKER);
+//
+// Worker flows are started detached, from native code or from a widget event that runs
+// the action.  A CallAction component can't call them: it would wait for the action's
+// End and its outputs, which don't cross partitions, so it throws an error instead.
+//
+// Components that touch LVGL, pages or native actions are handed back to the loop task
+// and run there on the next eez_flow_tick(); the rest of that flow waits meanwhile.
+// Worker flows have no inputs or outputs, they talk to the pages through global
+// variables.  Keep those to numbers and booleans: strings and arrays are reference
+// counted without locking.
+
+#ifndef FLOW_WORKER_STACK_SIZE
+#define FLOW_WORKER_STACK_SIZE 8192
+#endif
+
+// There is no idle core to give the worker: loop() and LVGL run on core 1, WiFi and the
+// I2C bus task on core 0.  The worker shares core 0 at a priority below both of them
+// (WiFi 23, i2c_bus 5), so the network and touch reads always preempt it and it only
+// gets their idle time.  Putting it on core 1 instead would take that time from the
+// frames.
+#ifndef FLOW_WORKER_PRIORITY
+#define FLOW_WORKER_PRIORITY 2
+#endif
+
+#ifndef FLOW_WORKER_CORE
+#define FLOW_WORKER_CORE 0
+#endif
+
+// How long the worker sleeps when it has nothing queued and nobody posts to it.
+#ifndef FLOW_WORKER_IDLE_MS
+#define FLOW_WORKER_IDLE_MS 100
+#endif
+
+class FlowWorker
+{
+public:
+  FlowWorker();
+
+  // Call after ui_init(), the flow engine must be started.
+  void begin();
+
+  uint32_t getTickCount() const { return _tickCount; }
+  uint32_t getMaxTickUs() const { return _maxTickUs; }
+  void printStats(Print &out);
+
+private:
+  static void taskMain(void *arg);
+  static void wake(uint8_t partition);
+  static void waitFor(uint8_t partition);
+
+  TaskHandle_t _task;
+  SemaphoreHandle_t _ticked;
+  volatile uint32_t _tickCount;
+  volatile uint32_t _maxTickUs;
+};
+
+extern FlowWorker flowWorker;
+
+#endif
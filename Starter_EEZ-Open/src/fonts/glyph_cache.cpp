@@ -0,0 +1,343 @@
+#include "glyph_cache.h"
+#include "tiered_alloc.h"
+
+#define GLYPH_CACHE_BUCKETS 64
+
+struct GlyphEntry
+{
+  const lv_font_t *font;
+  uint32_t letter;
+  lv_opa_t *mask;
+  uint32_t size;
+  uint32_t lastUsed;
+  int16_t next; // next entry in the same bucket, -1 at the end
+  bool pinned;
+};
+
+static GlyphEntry g_glyphs[GLYPH_CACHE_MAX_GLYPHS];
+static int16_t g_buckets[GLYPH_CACHE_BUCKETS];
+static const lv_font_t *g_fonts[GLYPH_CACHE_MAX_FONTS];
+static uint32_t g_budget = GLYPH_CACHE_BUDGET;
+static uint32_t g_bytes;
+static uint32_t g_useCounter;
+static GlyphCacheStats g_stats;
+static bool g_initialized;
+
+static void (*g_baseDrawCtxInit)(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx);
+static void (*g_baseDrawLetter)(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos, uint32_t letter);
+
+static void initialize()
+{
+  if (!g_initialized)
+  {
+    for (int i = 0; i < GLYPH_CACHE_BUCKETS; i++)
+    {
+      g_buckets[i] = -1;
+    }
+    g_initialized = true;
+  }
+}
+
+static inline uint32_t bucketOf(const lv_font_t *font, uint32_t letter)
+{
+  return ((uint32_t)(uintptr_t)font / sizeof(void *) * 31 + letter) % GLYPH_CACHE_BUCKETS;
+}
+
+static bool isCachedFont(const lv_font_t *font)
+{
+  for (int i = 0; i < GLYPH_CACHE_MAX_FONTS; i++)
+  {
+    if (g_fonts[i] == font)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static GlyphEntry *findGlyph(const lv_font_t *font, uint32_t letter)
+{
+  for (int16_t i = g_buckets[bucketOf(font, letter)]; i >= 0; i = g_glyphs[i].next)
+  {
+    if (g_glyphs[i].font == font && g_glyphs[i].letter == letter)
+    {
+      return &g_glyphs[i];
+    }
+  }
+  return nullptr;
+}
+
+static void removeGlyph(GlyphEntry *entry)
+{
+  int16_t index = entry - g_glyphs;
+  int16_t *link = &g_buckets[bucketOf(entry->font, entry->letter)];
+  while (*link != index)
+  {
+    link = &g_glyphs[*link].next;
+  }
+  *link = entry->next;
+
+  tiered_free(entry->mask);
+  g_bytes -= entry->size;
+  memset(entry, 0, sizeof(GlyphEntry));
+}
+
+// Frees the least recently used glyph that is not pinned, false when there is none.
+static bool evictOldest()
+{
+  GlyphEntry *oldest = nullptr;
+  for (int i = 0; i < GLYPH_CACHE_MAX_GLYPHS; i++)
+  {
+    GlyphEntry &entry = g_glyphs[i];
+    if (entry.font && !entry.pinned && (!oldest || (int32_t)(entry.lastUsed - oldest->lastUsed) < 0))
+    {
+      oldest = &entry;
+    }
+  }
+  if (!oldest)
+  {
+    return false;
+  }
+  removeGlyph(oldest);
+  g_stats.evictions++;
+  return true;
+}
+
+// Unpacks a 1, 2, 4 or 8 bpp glyph bitmap (rows are not padded) to one opacity byte
+// per pixel, with the same shades LVGL's renderer uses.
+static void unpackBitmap(const uint8_t *bitmap, uint8_t bpp, uint32_t pixels, lv_opa_t *mask)
+{
+  if (bpp == 3)
+  {
+    bpp = 4; // compressed fonts are decompressed to 4 bpp
+  }
+  if (bpp == 8)
+  {
+    memcpy(mask, bitmap, pixels);
+    return;
+  }
+  uint8_t max = (1 << bpp) - 1;
+  uint32_t bit = 0;
+  for (uint32_t i = 0; i < pixels; i++, bit += bpp)
+  {
+    uint8_t value = (bitmap[bit >> 3] >> (8 - bpp - (bit & 7))) & max;
+    mask[i] = (lv_opa_t)(value * 255 / max);
+  }
+}
+
+static GlyphEntry *addGlyph(const lv_font_t *font, uint32_t letter, const lv_font_glyph_dsc_t &glyph, bool pinned)
+{
+  uint32_t size = (uint32_t)glyph.box_w * glyph.box_h;
+  if (!pinned)
+  {
+    if (size > g_budget)
+    {
+      return nullptr;
+    }
+    while (g_bytes + size > g_budget && evictOldest())
+    {
+    }
+  }
+
+  GlyphEntry *entry = nullptr;
+  for (int i = 0; i < GLYPH_CACHE_MAX_GLYPHS && !entry; i++)
+  {
+    if (!g_glyphs[i].font)
+    {
+      entry = &g_glyphs[i];
+    }
+  }
+  if (!entry && evictOldest())
+  {
+    return addGlyph(font, letter, glyph, pinned);
+  }
+  if (!entry)
+  {
+    return nullptr;
+  }
+
+  const uint8_t *bitmap = lv_font_get_glyph_bitmap(glyph.resolved_font, letter);
+  if (!bitmap)
+  {
+    return nullptr;
+  }
+  lv_opa_t *mask = (lv_opa_t *)tiered_malloc_category(size, TIERED_ALLOC_BULK);
+  if (!mask)
+  {
+    return nullptr;
+  }
+  unpackBitmap(bitmap, glyph.bpp, size, mask);
+
+  uint32_t bucket = bucketOf(font, letter);
+  entry->font = font;
+  entry->letter = letter;
+  entry->mask = mask;
+  entry->size = size;
+  entry->pinned = pinned;
+  entry->next = g_buckets[bucket];
+  g_buckets[bucket] = entry - g_glyphs;
+  g_bytes += size;
+  return entry;
+}
+
+static void drawLetter(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos, uint32_t letter)
+{
+  const lv_font_t *font = dsc->font;
+  if (!isCachedFont(font) || dsc->opa <= LV_OPA_MIN)
+  {
+    g_baseDrawLetter(draw_ctx, dsc, pos, letter);
+    return;
+  }
+
+  // Placeholders, spaces and letters of fallback fonts are left to LVGL.
+  lv_font_glyph_dsc_t glyph;
+  if (!lv_font_get_glyph_dsc(font, &glyph, letter, '\0') || glyph.resolved_font != font || glyph.box_w == 0 || glyph.box_h == 0)
+  {
+    g_stats.fallbacks++;
+    g_baseDrawLetter(draw_ctx, dsc, pos, letter);
+    return;
+  }
+
+  lv_area_t area;
+  area.x1 = pos->x + glyph.ofs_x;
+  area.y1 = pos->y + (font->line_height - font->base_line) - glyph.box_h - glyph.ofs_y;
+  area.x2 = area.x1 + glyph.box_w - 1;
+  area.y2 = area.y1 + glyph.box_h - 1;
+  lv_area_t clipped;
+  if (!_lv_area_intersect(&clipped, &area, draw_ctx->clip_area))
+  {
+    return;
+  }
+
+#if LV_DRAW_COMPLEX
+  // The masks would have to be applied to a copy of the glyph, LVGL does that anyway.
+  if (lv_draw_mask_is_any(&clipped))
+  {
+    g_stats.fallbacks++;
+    g_baseDrawLetter(draw_ctx, dsc, pos, letter);
+    return;
+  }
+#endif
+
+  GlyphEntry *entry = findGlyph(font, letter);
+  if (entry)
+  {
+    g_stats.hits++;
+  }
+  else
+  {
+    g_stats.misses++;
+    entry = addGlyph(font, letter, glyph, false);
+    if (!entry)
+    {
+      g_stats.fallbacks++;
+      g_baseDrawLetter(draw_ctx, dsc, pos, letter);
+      return;
+    }
+  }
+  entry->lastUsed = ++g_useCounter;
+
+  // The blend clips to draw_ctx->clip_area and indexes the mask through mask_area.
+  lv_draw_sw_blend_dsc_t blend;
+  lv_memset_00(&blend, sizeof(blend));
+  blend.blend_area = &area;
+  blend.mask_area = &area;
+  blend.mask_buf = entry->mask;
+  blend.mask_res = LV_DRAW_MASK_RES_CHANGED;
+  blend.color = dsc->color;
+  blend.opa = dsc->opa;
+  blend.blend_mode = dsc->blend_mode;
+  lv_draw_sw_blend(draw_ctx, &blend);
+}
+
+static void initDrawCtx(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+  g_baseDrawCtxInit(drv, draw_ctx);
+  g_baseDrawLetter = draw_ctx->draw_letter;
+  draw_ctx->draw_letter = drawLetter;
+}
+
+void glyph_cache_attach(lv_disp_drv_t *drv)
+{
+  initialize();
+  g_baseDrawCtxInit = drv->draw_ctx_init;
+  drv->draw_ctx_init = initDrawCtx;
+}
+
+bool glyph_cache_add_font(const lv_font_t *font, const char *pinned)
+{
+  initialize();
+  if (!isCachedFont(font))
+  {
+    int i = 0;
+    while (i < GLYPH_CACHE_MAX_FONTS && g_fonts[i])
+    {
+      i++;
+    }
+    if (i == GLYPH_CACHE_MAX_FONTS)
+    {
+      return false;
+    }
+    g_fonts[i] = font;
+  }
+
+  bool ok = true;
+  uint32_t i = 0;
+  while (pinned && pinned[i])
+  {
+    uint32_t letter = _lv_txt_encoded_next(pinned, &i);
+    lv_font_glyph_dsc_t glyph;
+    if (!lv_font_get_glyph_dsc(font, &glyph, letter, '\0') || glyph.resolved_font != font || glyph.box_w == 0 || glyph.box_h == 0)
+    {
+      continue;
+    }
+    GlyphEntry *entry = findGlyph(font, letter);
+    if (entry)
+    {
+      entry->pinned = true;
+    }
+    else if (!addGlyph(font, letter, glyph, true))
+    {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+void glyph_cache_set_budget(uint32_t bytes)
+{
+  g_budget = bytes;
+  while (g_bytes > g_budget && evictOldest())
+  {
+  }
+}
+
+void glyph_cache_get_stats(GlyphCacheStats &stats)
+{
+  stats = g_stats;
+  stats.glyphs = 0;
+  stats.pinned = 0;
+  for (int i = 0; i < GLYPH_CACHE_MAX_GLYPHS; i++)
+  {
+    if (g_glyphs[i].font)
+    {
+      stats.glyphs++;
+      if (g_glyphs[i].pinned)
+      {
+        stats.pinned++;
+      }
+    }
+  }
+  stats.bytes = g_bytes;
+  stats.budget = g_budget;
+}
+
+void glyph_cache_print_stats(Print &out)
+{
+  GlyphCacheStats stats;
+  glyph_cache_get_stats(stats);
+  uint32_t lookups = stats.hits + stats.misses;
+  out.printf("glyph cache: %u glyphs (%u pinned), %u / %u bytes, %u hits / %u misses (%u%%), %u evictions, %u fallbacks\n",
+             stats.glyphs, stats.pinned, stats.bytes, stats.budget, stats.hits, stats.misses,
+             lookups ? stats.hits * 100 / lookups : 0, stats.evictions, stats.fallbacks);
+}
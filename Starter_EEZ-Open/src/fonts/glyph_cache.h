@@ -0,0 +1,58 @@
+#include <Arduino.h>
+#include <lvgl.h>
+
+#ifndef _GLYPH_CACHE_H
+#define _GLYPH_CACHE_H
+
+// Letters of the fonts registered here are drawn from a cache of glyphs unpacked to
+// one alpha byte per pixel, kept in PSRAM.  LVGL normally unpacks the 4 bpp bitmap of
+// every letter into a mask on every draw and then blends it in chunks; a cached glyph
+// is blended in a single lv_draw_sw_blend() call straight from the cache.  That pays off
+// most for the large value labels (38 px and up), whose glyphs are redrawn whenever the
+// value changes.
+//
+// Letters are sent to LVGL's own renderer when the glyph comes from a fallback font,
+// when a draw mask (rounded clip, line mask, ...) covers it, or when the cache can't
+// hold it, so the output is the same either way.
+//
+//   glyph_cache_attach(&disp_drv);                // before lv_disp_drv_register()
+//   glyph_cache_add_font(&lv_font_montserrat_38, GLYPH_CACHE_NUMERIC);
+//   glyph_cache_print_stats(Serial);
+//
+// The characters given to glyph_cache_add_font() are unpacked right away and never
+// evicted; other letters are cached on first use within GLYPH_CACHE_BUDGET bytes.
+
+#ifndef GLYPH_CACHE_BUDGET
+#define GLYPH_CACHE_BUDGET (64 * 1024)
+#endif
+
+#ifndef GLYPH_CACHE_MAX_GLYPHS
+#define GLYPH_CACHE_MAX_GLYPHS 256
+#endif
+
+#ifndef GLYPH_CACHE_MAX_FONTS
+#define GLYPH_CACHE_MAX_FONTS 4
+#endif
+
+// What numeric readouts draw.
+#define GLYPH_CACHE_NUMERIC "0123456789.,:-+% "
+
+struct GlyphCacheStats
+{
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t evictions;
+  uint32_t fallbacks; // letters drawn by LVGL's renderer
+  uint32_t glyphs;
+  uint32_t pinned;
+  uint32_t bytes;
+  uint32_t budget;
+};
+
+void glyph_cache_attach(lv_disp_drv_t *drv);
+bool glyph_cache_add_font(const lv_font_t *font, const char *pinned);
+void glyph_cache_set_budget(uint32_t bytes);
+void glyph_cache_get_stats(GlyphCacheStats &stats);
+void glyph_cache_print_stats(Print &out);
+
+#endif
@@ -0,0 +1,333 @@
+#include "i2c_bus.h"
+
+#define I2C_BUS_TASK_STACK_SIZE 4096
+#define I2C_BUS_TASK_PRIORITY 5
+#define I2C_BUS_TASK_CORE 0
+
+I2CBus i2cBus;
+
+I2CBus::I2CBus()
+    : _wire(nullptr), _task(nullptr), _numDevices(0)
+{
+  _statsLock = portMUX_INITIALIZER_UNLOCKED;
+  for (int i = 0; i < I2C_PRIORITY_COUNT; i++)
+  {
+    _queues[i] = nullptr;
+  }
+}
+
+void I2CBus::begin(TwoWire *wire, int sda, int scl, uint32_t frequency)
+{
+  _wire = wire;
+  _wire->begin(sda, scl, frequency);
+
+  for (int i = 0; i < I2C_PRIORITY_COUNT; i++)
+  {
+    _queues[i] = xQueueCreate(I2C_BUS_QUEUE_LENGTH, sizeof(Request));
+  }
+  xTaskCreatePinnedToCore(taskMain, "i2c_bus", I2C_BUS_TASK_STACK_SIZE, this, I2C_BUS_TASK_PRIORITY, &_task, I2C_BUS_TASK_CORE);
+}
+
+int I2CBus::addDevice(uint8_t address, const char *name, uint8_t regWidth)
+{
+  if (_numDevices == I2C_BUS_MAX_DEVICES)
+  {
+    return -1;
+  }
+  Device &device = _devices[_numDevices];
+  device.address = address;
+  device.regWidth = regWidth;
+  memset(&device.stats, 0, sizeof(device.stats));
+  device.stats.name = name;
+  device.stats.address = address;
+  return _numDevices++;
+}
+
+// Buffers passed to the asynchronous requests must stay valid until the callback is called.
+
+bool I2CBus::readRegisters(int device, uint16_t reg, uint8_t *buffer, uint8_t length, I2CPriority priority, I2CCompletionCallback callback, void *userData)
+{
+  Request request = {};
+  request.type = REQUEST_READ;
+  request.reg = reg;
+  request.buffer = buffer;
+  request.length = length;
+  request.callback = callback;
+  request.userData = userData;
+  return submit(device, request, priority);
+}
+
+bool I2CBus::writeRegisters(int device, uint16_t reg, const uint8_t *buffer, uint8_t length, I2CPriority priority, I2CCompletionCallback callback, void *userData)
+{
+  Request request = {};
+  request.type = REQUEST_WRITE;
+  request.reg = reg;
+  request.buffer = (uint8_t *)buffer;
+  request.length = length;
+  request.callback = callback;
+  request.userData = userData;
+  return submit(device, request, priority);
+}
+
+bool I2CBus::readBatch(int device, const I2CRegisterRead *reads, uint8_t count, I2CPriority priority, I2CCompletionCallback callback, void *userData)
+{
+  Request request = {};
+  request.type = REQUEST_READ_BATCH;
+  request.reads = reads;
+  request.length = count;
+  request.callback = callback;
+  request.userData = userData;
+  return submit(device, request, priority);
+}
+
+bool I2CBus::run(int device, I2CTransactionFunc func, void *userData, I2CPriority priority, I2CCompletionCallback callback, void *callbackUserData)
+{
+  Request request = {};
+  request.type = REQUEST_RUN;
+  request.func = func;
+  request.funcUserData = userData;
+  request.callback = callback;
+  request.userData = callbackUserData;
+  return submit(device, request, priority);
+}
+
+int I2CBus::runSync(int device, I2CTransactionFunc func, void *userData, I2CPriority priority)
+{
+  if (!isValidDevice(device))
+  {
+    return I2C_BUS_ERROR_INVALID_DEVICE;
+  }
+
+  int result = I2C_BUS_ERROR_QUEUE_FULL;
+
+  Request request = {};
+  request.type = REQUEST_RUN;
+  request.device = device;
+  request.func = func;
+  request.funcUserData = userData;
+  request.result = &result;
+
+  if (!_task || xTaskGetCurrentTaskHandle() == _task)
+  {
+    // not started yet, or called from a callback: we already own the bus
+    request.submitTime = micros();
+    execute(request);
+    return result;
+  }
+
+  request.waiter = xTaskGetCurrentTaskHandle();
+  if (submit(device, request, priority))
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  return result;
+}
+
+bool I2CBus::getStats(int device, I2CDeviceStats &stats)
+{
+  if (!isValidDevice(device))
+  {
+    return false;
+  }
+  portENTER_CRITICAL(&_statsLock);
+  stats = _devices[device].stats;
+  portEXIT_CRITICAL(&_statsLock);
+  return true;
+}
+
+void I2CBus::resetStats()
+{
+  portENTER_CRITICAL(&_statsLock);
+  for (int i = 0; i < _numDevices; i++)
+  {
+    I2CDeviceStats &stats = _devices[i].stats;
+    stats.transactions = 0;
+    stats.errors = 0;
+    stats.lastError = I2C_BUS_OK;
+    stats.totalLatencyUs = 0;
+    stats.maxLatencyUs = 0;
+    stats.totalBusUs = 0;
+    stats.maxBusUs = 0;
+  }
+  portEXIT_CRITICAL(&_statsLock);
+}
+
+void I2CBus::printStats(Print &out)
+{
+  out.println("device     addr  count  errors  last  avg us  max us  bus avg  bus max");
+  for (int i = 0; i < _numDevices; i++)
+  {
+    I2CDeviceStats stats;
+    getStats(i, stats);
+    uint32_t count = stats.transactions ? stats.transactions : 1;
+    out.printf("%-10s 0x%02x %6u %7u %5d %7u %7u %8u %8u\n", stats.name, stats.address, stats.transactions, stats.errors, stats.lastError,
+               (uint32_t)(stats.totalLatencyUs / count), stats.maxLatencyUs, (uint32_t)(stats.totalBusUs / count), stats.maxBusUs);
+  }
+}
+
+bool I2CBus::isValidDevice(int device) const
+{
+  return device >= 0 && device < _numDevices;
+}
+
+bool I2CBus::submit(int device, Request &request, I2CPriority priority)
+{
+  // checked before it is narrowed into the request, so -1 from a failed addDevice() stays invalid
+  if (!isValidDevice(device))
+  {
+    if (request.callback)
+    {
+      request.callback(I2C_BUS_ERROR_INVALID_DEVICE, request.userData);
+    }
+    return false;
+  }
+
+  request.device = device;
+  request.submitTime = micros();
+
+  if (!_task)
+  {
+    execute(request);
+    return true;
+  }
+
+  if (xQueueSend(_queues[priority], &request, 0) != pdTRUE)
+  {
+    portENTER_CRITICAL(&_statsLock);
+    _devices[request.device].stats.errors++;
+    _devices[request.device].stats.lastError = I2C_BUS_ERROR_QUEUE_FULL;
+    portEXIT_CRITICAL(&_statsLock);
+    return false;
+  }
+  xTaskNotifyGive(_task);
+  return true;
+}
+
+bool I2CBus::takeNext(Request &request)
+{
+  // Highest priority first, re-checked after every transfer, so touch never waits
+  // for more than the one transfer that is already on the bus.
+  for (int i = 0; i < I2C_PRIORITY_COUNT; i++)
+  {
+    if (xQueueReceive(_queues[i], &request, 0) == pdTRUE)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void I2CBus::taskMain(void *arg)
+{
+  I2CBus *bus = (I2CBus *)arg;
+  Request request;
+  while (true)
+  {
+    if (bus->takeNext(request))
+    {
+      bus->execute(request);
+    }
+    else
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+  }
+}
+
+void I2CBus::execute(Request &request)
+{
+  Device &device = _devices[request.device];
+
+  uint32_t start = micros();
+  int result = I2C_BUS_OK;
+  switch (request.type)
+  {
+  case REQUEST_READ:
+    result = readRegs(device, request.reg, request.buffer, request.length);
+    break;
+  case REQUEST_WRITE:
+    result = writeRegs(device, request.reg, request.buffer, request.length);
+    break;
+  case REQUEST_READ_BATCH:
+    for (uint8_t i = 0; i < request.length && result == I2C_BUS_OK; i++)
+    {
+      result = readRegs(device, request.reads[i].reg, request.reads[i].buffer, request.reads[i].length);
+    }
+    break;
+  case REQUEST_RUN:
+    result = request.func(*_wire, request.funcUserData);
+    break;
+  }
+  uint32_t end = micros();
+
+  uint32_t latency = end - request.submitTime;
+  uint32_t busTime = end - start;
+  portENTER_CRITICAL(&_statsLock);
+  I2CDeviceStats &stats = device.stats;
+  stats.transactions++;
+  if (result != I2C_BUS_OK)
+  {
+    stats.errors++;
+    stats.lastError = result;
+  }
+  stats.totalLatencyUs += latency;
+  if (latency > stats.maxLatencyUs)
+  {
+    stats.maxLatencyUs = latency;
+  }
+  stats.totalBusUs += busTime;
+  if (busTime > stats.maxBusUs)
+  {
+    stats.maxBusUs = busTime;
+  }
+  portEXIT_CRITICAL(&_statsLock);
+
+  if (request.callback)
+  {
+    request.callback(result, request.userData);
+  }
+  if (request.result)
+  {
+    *request.result = result;
+  }
+  if (request.waiter)
+  {
+    xTaskNotifyGive(request.waiter);
+  }
+}
+
+int I2CBus::readRegs(Device &device, uint16_t reg, uint8_t *buffer, uint8_t length)
+{
+  _wire->beginTransmission(device.address);
+  if (device.regWidth == 2)
+  {
+    _wire->write(reg >> 8);
+  }
+  _wire->write(reg & 0xFF);
+  int result = _wire->endTransmission(false);
+  if (result != I2C_BUS_OK)
+  {
+    return result;
+  }
+  if (_wire->requestFrom(device.address, (size_t)length) != length)
+  {
+    return I2C_BUS_ERROR_SHORT_READ;
+  }
+  for (uint8_t i = 0; i < length; i++)
+  {
+    buffer[i] = _wire->read();
+  }
+  return I2C_BUS_OK;
+}
+
+int I2CBus::writeRegs(Device &device, uint16_t reg, const uint8_t *buffer, uint8_t length)
+{
+  _wire->beginTransmission(device.address);
+  if (device.regWidth == 2)
+  {
+    _wire->write(reg >> 8);
+  }
+  _wire->write(reg & 0xFF);
+  _wire->write(buffer, length);
+  return _wire->endTransmission();
+}
@@ -0,0 +1,146 @@
+#include <Arduino.h>
+#include <Wire.h>
+
+#ifndef _I2C_BUS_H
+#define _I2C_BUS_H
+
+// The touch controller and the DHT20 sit on the same TwoWire.  I2CBus owns that bus:
+// transfers are queued by priority and executed one at a time by a dedicated task, so a
+// touch read waits for at most one transfer already in flight.
+//
+// The PCA9557 on the board shares the wires but is not driven by this firmware, so it
+// doesn't go through I2CBus.  Code that starts using it has to register it with
+// addDevice() and talk to it through run(), or its transfers race the bus task.
+
+#ifndef I2C_BUS_MAX_DEVICES
+#define I2C_BUS_MAX_DEVICES 8
+#endif
+
+#ifndef I2C_BUS_QUEUE_LENGTH
+#define I2C_BUS_QUEUE_LENGTH 8
+#endif
+
+enum I2CPriority
+{
+  I2C_PRIORITY_TOUCH,
+  I2C_PRIORITY_HIGH,
+  I2C_PRIORITY_NORMAL,
+  I2C_PRIORITY_LOW,
+  I2C_PRIORITY_COUNT
+};
+
+// Results passed to the completion callbacks: 0 on success, 1..5 are the
+// TwoWire::endTransmission() error codes.
+#define I2C_BUS_OK 0
+#define I2C_BUS_ERROR_SHORT_READ -1
+#define I2C_BUS_ERROR_QUEUE_FULL -2
+#define I2C_BUS_ERROR_INVALID_DEVICE -3
+
+struct I2CRegisterRead
+{
+  uint16_t reg;
+  uint8_t *buffer;
+  uint8_t length;
+};
+
+struct I2CDeviceStats
+{
+  const char *name;
+  uint8_t address;
+  uint32_t transactions;
+  uint32_t errors;
+  int lastError;
+  uint64_t totalLatencyUs; // from submit to completion, includes the queue wait
+  uint32_t maxLatencyUs;
+  uint64_t totalBusUs;     // time the transfer held the bus
+  uint32_t maxBusUs;
+};
+
+// Called on the bus task when a request completes; keep it short.
+typedef void (*I2CCompletionCallback)(int result, void *userData);
+
+// Runs on the bus task with exclusive use of the bus, for drivers that talk to TwoWire
+// themselves (TAMC_GT911, Crowbits_DHT20).  Returns one of the I2C_BUS_* results.
+typedef int (*I2CTransactionFunc)(TwoWire &wire, void *userData);
+
+class I2CBus
+{
+public:
+  I2CBus();
+
+  // Start the bus and the owner task.  Requests made before begin() run synchronously.
+  void begin(TwoWire *wire, int sda, int scl, uint32_t frequency = 400000);
+
+  // regWidth is the register address size in bytes, GT911 uses 2.
+  int addDevice(uint8_t address, const char *name, uint8_t regWidth = 1);
+
+  bool readRegisters(int device, uint16_t reg, uint8_t *buffer, uint8_t length, I2CPriority priority, I2CCompletionCallback callback = nullptr, void *userData = nullptr);
+  bool writeRegisters(int device, uint16_t reg, const uint8_t *buffer, uint8_t length, I2CPriority priority, I2CCompletionCallback callback = nullptr, void *userData = nullptr);
+
+  // All reads run back to back without another request taking the bus in between.
+  // The reads array must stay valid until the callback is called.
+  bool readBatch(int device, const I2CRegisterRead *reads, uint8_t count, I2CPriority priority, I2CCompletionCallback callback = nullptr, void *userData = nullptr);
+
+  bool run(int device, I2CTransactionFunc func, void *userData, I2CPriority priority, I2CCompletionCallback callback = nullptr, void *callbackUserData = nullptr);
+
+  // Queue a request and wait for it, returns its result, I2C_BUS_ERROR_INVALID_DEVICE for
+  // a device that addDevice() didn't return.
+  int runSync(int device, I2CTransactionFunc func, void *userData, I2CPriority priority);
+
+  bool getStats(int device, I2CDeviceStats &stats);
+  void resetStats();
+  void printStats(Print &out);
+
+private:
+  enum RequestType
+  {
+    REQUEST_READ,
+    REQUEST_WRITE,
+    REQUEST_READ_BATCH,
+    REQUEST_RUN
+  };
+
+  struct Request
+  {
+    uint8_t type;
+    uint8_t device;
+    uint16_t reg;
+    uint8_t length;
+    uint8_t *buffer;
+    const I2CRegisterRead *reads;
+    I2CTransactionFunc func;
+    void *funcUserData;
+    I2CCompletionCallback callback;
+    void *userData;
+    uint32_t submitTime;
+    TaskHandle_t waiter;
+    int *result;
+  };
+
+  struct Device
+  {
+    uint8_t address;
+    uint8_t regWidth;
+    I2CDeviceStats stats;
+  };
+
+  static void taskMain(void *arg);
+  bool isValidDevice(int device) const;
+  bool submit(int device, Request &request, I2CPriority priority);
+  bool takeNext(Request &request);
+  void execute(Request &request);
+  int readRegs(Device &device, uint16_t reg, uint8_t *buffer, uint8_t length);
+  int writeRegs(Device &device, uint16_t reg, const uint8_t *buffer, uint8_t length);
+
+  TwoWire *_wire;
+  TaskHandle_t _task;
+  QueueHandle_t _queues[I2C_PRIORITY_COUNT];
+  portMUX_TYPE _statsLock;
+
+  Device _devices[I2C_BUS_MAX_DEVICES];
+  int _numDevices;
+};
+
+extern I2CBus i2cBus;
+
+#endif
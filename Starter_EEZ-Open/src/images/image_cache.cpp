@@ -0,0 +1,438 @@
+#include "image_cache.h"
+
+#if LV_COLOR_DEPTH != 16
+#error "image_cache decodes to RGB565, set LV_COLOR_DEPTH 16"
+#endif
+
+struct CacheEntry
+{
+  const void *src;
+  uint8_t *pixels;
+  uint32_t size;
+  uint32_t lastUsed;
+  uint16_t refs;
+};
+
+static CacheEntry g_entries[IMAGE_CACHE_MAX_ENTRIES];
+static uint32_t g_budget = IMAGE_CACHE_BUDGET;
+static uint32_t g_bytes;
+static uint32_t g_useCounter;
+static ImageCacheStats g_stats;
+static lv_img_decoder_t *g_decoder;
+
+// RLE of elements of elementSize bytes: a control byte c < 0x80 is followed by c + 1
+// literal elements, c >= 0x80 by one element repeated (c & 0x7F) + 1 times.
+static bool unpackRle(const uint8_t *in, uint32_t inSize, uint8_t *out, uint32_t outSize, uint32_t elementSize)
+{
+  const uint8_t *inEnd = in + inSize;
+  uint8_t *outEnd = out + outSize;
+  while (out < outEnd)
+  {
+    if (in >= inEnd)
+    {
+      return false;
+    }
+    uint8_t control = *in++;
+    uint32_t count = (control & 0x7F) + 1;
+    uint32_t bytes = count * elementSize;
+    if (bytes > (uint32_t)(outEnd - out))
+    {
+      return false;
+    }
+    if (control & 0x80)
+    {
+      if ((uint32_t)(inEnd - in) < elementSize)
+      {
+        return false;
+      }
+      if (elementSize == 1)
+      {
+        memset(out, *in, count);
+        out += count;
+      }
+      else
+      {
+        for (uint32_t i = 0; i < count; i++)
+        {
+          memcpy(out, in, elementSize);
+          out += elementSize;
+        }
+      }
+      in += elementSize;
+    }
+    else
+    {
+      if ((uint32_t)(inEnd - in) < bytes)
+      {
+        return false;
+      }
+      memcpy(out, in, bytes);
+      in += bytes;
+      out += bytes;
+    }
+  }
+  return in == inEnd;
+}
+
+// LZ4 block format (no frame header), as produced by LZ4_compress_default().
+static bool unpackLz4(const uint8_t *in, uint32_t inSize, uint8_t *out, uint32_t outSize)
+{
+  const uint8_t *inEnd = in + inSize;
+  uint8_t *outStart = out;
+  uint8_t *outEnd = out + outSize;
+  while (in < inEnd)
+  {
+    uint8_t token = *in++;
+
+    uint32_t literals = token >> 4;
+    if (literals == 15)
+    {
+      uint8_t b;
+      do
+      {
+        if (in >= inEnd)
+        {
+          return false;
+        }
+        b = *in++;
+        literals += b;
+      } while (b == 255);
+    }
+    if (literals > (uint32_t)(inEnd - in) || literals > (uint32_t)(outEnd - out))
+    {
+      return false;
+    }
+    memcpy(out, in, literals);
+    in += literals;
+    out += literals;
+
+    if (in == inEnd)
+    {
+      break; // the last sequence has no match
+    }
+    if (inEnd - in < 2)
+    {
+      return false;
+    }
+    uint32_t offset = in[0] | (in[1] << 8);
+    in += 2;
+    if (offset == 0 || offset > (uint32_t)(out - outStart))
+    {
+      return false;
+    }
+
+    uint32_t length = (token & 0x0F) + 4;
+    if ((token & 0x0F) == 15)
+    {
+      uint8_t b;
+      do
+      {
+        if (in >= inEnd)
+        {
+          return false;
+        }
+        b = *in++;
+        length += b;
+      } while (b == 255);
+    }
+    if (length > (uint32_t)(outEnd - out))
+    {
+      return false;
+    }
+    // Matches may overlap the bytes they produce, so copy forward one byte at a time.
+    const uint8_t *match = out - offset;
+    while (length--)
+    {
+      *out++ = *match++;
+    }
+  }
+  return out == outEnd;
+}
+
+static bool unpackPlane(uint8_t compression, const uint8_t *in, uint32_t inSize, uint8_t *out, uint32_t outSize, uint32_t elementSize)
+{
+  switch (compression)
+  {
+  case IMAGE_ASSET_NONE:
+    if (inSize != outSize)
+    {
+      return false;
+    }
+    memcpy(out, in, outSize);
+    return true;
+  case IMAGE_ASSET_RLE:
+    return unpackRle(in, inSize, out, outSize, elementSize);
+  case IMAGE_ASSET_LZ4:
+    return unpackLz4(in, inSize, out, outSize);
+  }
+  return false;
+}
+
+static const ImageAssetHeader *getAssetHeader(const void *src)
+{
+  if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE)
+  {
+    return nullptr;
+  }
+  const lv_img_dsc_t *img = (const lv_img_dsc_t *)src;
+  if (img->header.cf != LV_IMG_CF_RAW && img->header.cf != LV_IMG_CF_RAW_ALPHA)
+  {
+    return nullptr;
+  }
+  if (img->data_size < sizeof(ImageAssetHeader))
+  {
+    return nullptr;
+  }
+  const ImageAssetHeader *header = (const ImageAssetHeader *)img->data;
+  if (header->magic != IMAGE_ASSET_MAGIC)
+  {
+    return nullptr;
+  }
+  if (sizeof(ImageAssetHeader) + header->colorSize + header->alphaSize > img->data_size)
+  {
+    return nullptr;
+  }
+  return header;
+}
+
+static uint32_t getDecodedSize(const ImageAssetHeader *header)
+{
+  uint32_t pixels = (uint32_t)header->width * header->height;
+  return pixels * ((header->flags & IMAGE_ASSET_ALPHA) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t));
+}
+
+// Decodes into LV_IMG_CF_TRUE_COLOR, or LV_IMG_CF_TRUE_COLOR_ALPHA where each pixel is
+// the colour followed by its alpha byte.
+static uint8_t *decode(const ImageAssetHeader *header, uint32_t size)
+{
+  uint32_t pixels = (uint32_t)header->width * header->height;
+  const uint8_t *color = (const uint8_t *)(header + 1);
+  bool alpha = header->flags & IMAGE_ASSET_ALPHA;
+
+  // Large buffers land in PSRAM through tiered_alloc (LV_MEM_CUSTOM in lv_conf.h).
+  uint8_t *out = (uint8_t *)lv_mem_alloc(size);
+  if (!out)
+  {
+    return nullptr;
+  }
+
+  // With alpha the colour plane goes to the upper part of the buffer first and is
+  // interleaved with the alpha plane from there.
+  uint8_t *colorPlane = alpha ? out + pixels : out;
+  uint8_t *alphaPlane = nullptr;
+  bool ok = unpackPlane(header->compression, color, header->colorSize, colorPlane, pixels * 2, 2);
+  if (ok && alpha)
+  {
+    alphaPlane = (uint8_t *)lv_mem_alloc(pixels);
+    ok = alphaPlane && unpackPlane(header->compression, color + header->colorSize, header->alphaSize, alphaPlane, pixels, 1);
+  }
+  if (!ok)
+  {
+    lv_mem_free(alphaPlane);
+    lv_mem_free(out);
+    return nullptr;
+  }
+
+  bool swap = ((header->flags & IMAGE_ASSET_SWAPPED) != 0) != (LV_COLOR_16_SWAP != 0);
+  if (alpha)
+  {
+    // Pixel i is written to out[3i..3i+2] and read from out[pixels + 2i..], which is
+    // never behind the write position.
+    for (uint32_t i = 0; i < pixels; i++)
+    {
+      uint8_t lo = colorPlane[2 * i];
+      uint8_t hi = colorPlane[2 * i + 1];
+      out[3 * i] = swap ? hi : lo;
+      out[3 * i + 1] = swap ? lo : hi;
+      out[3 * i + 2] = alphaPlane[i];
+    }
+    lv_mem_free(alphaPlane);
+  }
+  else if (swap)
+  {
+    uint16_t *p = (uint16_t *)out;
+    for (uint32_t i = 0; i < pixels; i++)
+    {
+      p[i] = (uint16_t)((p[i] << 8) | (p[i] >> 8));
+    }
+  }
+  return out;
+}
+
+// Frees the least recently used image that is not open, false when there is none.
+static bool evictOldest()
+{
+  CacheEntry *oldest = nullptr;
+  for (int i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++)
+  {
+    CacheEntry &entry = g_entries[i];
+    if (entry.src && entry.refs == 0 && (!oldest || (int32_t)(entry.lastUsed - oldest->lastUsed) < 0))
+    {
+      oldest = &entry;
+    }
+  }
+  if (!oldest)
+  {
+    return false;
+  }
+  lv_mem_free(oldest->pixels);
+  g_bytes -= oldest->size;
+  g_stats.evictions++;
+  memset(oldest, 0, sizeof(CacheEntry));
+  return true;
+}
+
+static void evict(uint32_t needed)
+{
+  while (g_bytes + needed > g_budget && evictOldest())
+  {
+  }
+}
+
+static CacheEntry *findEntry(const void *src)
+{
+  for (int i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++)
+  {
+    if (g_entries[i].src == src)
+    {
+      return &g_entries[i];
+    }
+  }
+  return nullptr;
+}
+
+static CacheEntry *freeEntry()
+{
+  CacheEntry *entry = findEntry(nullptr);
+  if (!entry && evictOldest())
+  {
+    entry = findEntry(nullptr);
+  }
+  return entry;
+}
+
+static lv_res_t decoderInfo(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+  const ImageAssetHeader *asset = getAssetHeader(src);
+  if (!asset)
+  {
+    return LV_RES_INV;
+  }
+  header->always_zero = 0;
+  header->w = asset->width;
+  header->h = asset->height;
+  header->cf = (asset->flags & IMAGE_ASSET_ALPHA) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+  return LV_RES_OK;
+}
+
+static lv_res_t decoderOpen(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+  const ImageAssetHeader *asset = getAssetHeader(dsc->src);
+  if (!asset)
+  {
+    return LV_RES_INV;
+  }
+
+  CacheEntry *entry = findEntry(dsc->src);
+  if (entry)
+  {
+    g_stats.hits++;
+  }
+  else
+  {
+    g_stats.misses++;
+    uint32_t size = getDecodedSize(asset);
+    evict(size);
+    entry = freeEntry();
+    if (!entry)
+    {
+      g_stats.failures++;
+      return LV_RES_INV;
+    }
+    uint32_t start = micros();
+    uint8_t *pixels = decode(asset, size);
+    uint32_t decodeUs = micros() - start;
+    if (!pixels)
+    {
+      LV_LOG_WARN("image_cache: can't decode %ux%u image", asset->width, asset->height);
+      g_stats.failures++;
+      return LV_RES_INV;
+    }
+    g_stats.decodeUs += decodeUs;
+    dsc->time_to_open = decodeUs / 1000;
+    entry->src = dsc->src;
+    entry->pixels = pixels;
+    entry->size = size;
+    g_bytes += size;
+  }
+
+  entry->refs++;
+  entry->lastUsed = ++g_useCounter;
+  dsc->img_data = entry->pixels;
+  dsc->user_data = entry;
+  return LV_RES_OK;
+}
+
+static void decoderClose(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+  CacheEntry *entry = (CacheEntry *)dsc->user_data;
+  if (entry && entry->refs > 0)
+  {
+    entry->refs--;
+  }
+  dsc->img_data = nullptr;
+  dsc->user_data = nullptr;
+  evict(0);
+}
+
+void image_cache_init()
+{
+  if (g_decoder)
+  {
+    return;
+  }
+  // New decoders go to the head of LVGL's list, so this one sees RAW images before the
+  // built-in decoder rejects them.
+  g_decoder = lv_img_decoder_create();
+  lv_img_decoder_set_info_cb(g_decoder, decoderInfo);
+  lv_img_decoder_set_open_cb(g_decoder, decoderOpen);
+  lv_img_decoder_set_close_cb(g_decoder, decoderClose);
+}
+
+void image_cache_set_budget(uint32_t bytes)
+{
+  g_budget = bytes;
+  evict(0);
+}
+
+void image_cache_flush()
+{
+  while (evictOldest())
+  {
+  }
+}
+
+void image_cache_get_stats(ImageCacheStats &stats)
+{
+  stats = g_stats;
+  stats.entries = 0;
+  for (int i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++)
+  {
+    if (g_entries[i].src)
+    {
+      stats.entries++;
+    }
+  }
+  stats.bytes = g_bytes;
+  stats.budget = g_budget;
+}
+
+void image_cache_print_stats(Print &out)
+{
+  ImageCacheStats stats;
+  image_cache_get_stats(stats);
+  uint32_t lookups = stats.hits + stats.misses;
+  out.printf("image cache: %u images, %u / %u bytes, %u hits / %u misses (%u%%), %u evictions, %u failures, %llu us decoding\n",
+             stats.entries, stats.bytes, stats.budget, stats.hits, stats.misses,
+             lookups ? stats.hits * 100 / lookups : 0, stats.evictions, stats.failures, (unsigned long long)stats.decodeUs);
+}
@@ -0,0 +1,77 @@
+#include <Arduino.h>
+#include <lvgl.h>
+
+#ifndef _IMAGE_CACHE_H
+#define _IMAGE_CACHE_H
+
+// Image decoder for the compressed RGB565 assets written by tools/convert_images.py,
+// with a byte budgeted cache of the decoded pixels in PSRAM.
+//
+// The converter turns PNG/JPEG files into lv_img_dsc_t C arrays that are already in the
+// panel's pixel format (RGB565, byte order from LV_COLOR_16_SWAP).  Uncompressed images
+// are plain LV_IMG_CF_TRUE_COLOR / LV_IMG_CF_RGB565A8 descriptors that LVGL draws in
+// place from flash.  Compressed ones (RLE or LZ4, colour and alpha planes packed
+// separately) are marked LV_IMG_CF_RAW / LV_IMG_CF_RAW_ALPHA and are decoded here on
+// first use; the result stays cached until the budget is needed for another image.
+// Images LVGL has open are never evicted.  LVGL keeps up to LV_IMG_CACHE_DEF_SIZE images
+// open in its own cache (lv_conf.h), so their pixels can take more than the budget.
+//
+//   image_cache_init();                      // after lv_init()
+//   image_cache_set_budget(1024 * 1024);
+//   image_cache_print_stats(Serial);
+
+#ifndef IMAGE_CACHE_BUDGET
+#define IMAGE_CACHE_BUDGET (512 * 1024)
+#endif
+
+#ifndef IMAGE_CACHE_MAX_ENTRIES
+#define IMAGE_CACHE_MAX_ENTRIES 32
+#endif
+
+#define IMAGE_ASSET_MAGIC 0x4D495A45 // "EZIM"
+
+enum ImageAssetFlags
+{
+  IMAGE_ASSET_ALPHA = 0x01,   // an A8 plane follows the colour plane
+  IMAGE_ASSET_SWAPPED = 0x02, // RGB565 stored big endian (LV_COLOR_16_SWAP 1)
+};
+
+enum ImageAssetCompression
+{
+  IMAGE_ASSET_NONE,
+  IMAGE_ASSET_RLE,
+  IMAGE_ASSET_LZ4,
+};
+
+// Start of the data of every compressed image, little endian.
+struct ImageAssetHeader
+{
+  uint32_t magic;
+  uint16_t width;
+  uint16_t height;
+  uint8_t flags;
+  uint8_t compression;
+  uint16_t reserved;
+  uint32_t colorSize; // packed size of the RGB565 plane
+  uint32_t alphaSize; // packed size of the A8 plane, 0 without IMAGE_ASSET_ALPHA
+};
+
+struct ImageCacheStats
+{
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t evictions;
+  uint32_t failures;     // corrupt data or out of memory
+  uint32_t entries;
+  uint32_t bytes;        // decoded pixels held, open ones included
+  uint32_t budget;
+  uint64_t decodeUs;     // total time spent decoding
+};
+
+void image_cache_init();
+void image_cache_set_budget(uint32_t bytes);
+void image_cache_flush(); // drop every image that is not open
+void image_cache_get_stats(ImageCacheStats &stats);
+void image_cache_print_stats(Print &out);
+
+#endif
@@ -1,11 +1,16 @@
 #include <lvgl.h>
 #include "lgfx.h"
+#include "tiered_alloc.h"
 
 
 
 LGFX lcd; //
 // UI
 #define TFT_BL 2
+#include "../i2c/i2c_bus.h"
+#include "../telemetry/frame_telemetry.h"
+#include "../images/image_cache.h"
+#include "../fonts/glyph_cache.h"
 #include "touch.h"
 
 LGFX::LGFX(void)
@@ -76,6 +81,7 @@ void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color
 
   uint32_t w = (area->x2 - area->x1 + 1);
   uint32_t h = (area->y2 - area->y1 + 1);
+  uint32_t start = micros();
 
 // lcd.fillScreen(TFT_WHITE);
 #if (LV_COLOR_16_SWAP != 0)
@@ -84,6 +90,7 @@ void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color
   lcd.pushImageDMA(area->x1, area->y1, w, h, (lgfx::rgb565_t *)&color_p->full); //
 #endif
 
+  frameTelemetry.onFlush(w * h * sizeof(lv_color_t), micros() - start);
   lv_disp_flush_ready(disp);
 }
 
@@ -112,6 +119,7 @@ void my_touchpad_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data)
   {
     data->state = LV_INDEV_STATE_REL;
   }
+  frameTelemetry.onTouch(data->state == LV_INDEV_STATE_PR);
   delay(15);
 }
 
@@ -123,12 +131,27 @@ void LGFX::setup()
   this->setTextSize(2);
   delay(200);
   lv_init();
+  image_cache_init();
   // Init touch device
   touch_init();
 
   screenWidth = this->width();
   screenHeight = this->height();
 
+  // The draw buffer is pushed with DMA, keep it in internal SRAM
+  size_t drawBufSize = screenWidth * screenHeight / 15 * sizeof(lv_color_t);
+  disp_draw_buf = (lv_color_t *)tiered_malloc_category(drawBufSize, TIERED_ALLOC_DRAW);
+  if (!disp_draw_buf)
+  {
+    // Nothing can be drawn without it, stop here rather than crash in the first flush
+    Serial.printf("FATAL: no DMA capable memory for the %u byte draw buffer\n", (unsigned)drawBufSize);
+    this->setCursor(10, 10);
+    this->printf("Out of memory: draw buffer (%u bytes)", (unsigned)drawBufSize);
+    while (true)
+    {
+      delay(1000);
+    }
+  }
   lv_disp_draw_buf_init(&draw_buf, disp_draw_buf, NULL, screenWidth * screenHeight / 15); // 4
 
   /* Initialize the display */
@@ -138,6 +161,8 @@ void LGFX::setup()
   disp_drv.ver_res = screenHeight;
   disp_drv.flush_cb = my_disp_flush;
   disp_drv.draw_buf = &draw_buf;
+  frameTelemetry.attach(&disp_drv);
+  glyph_cache_attach(&disp_drv);
   lv_disp_drv_register(&disp_drv);
 
   /* Initialize the (dummy) input device driver */
@@ -15,8 +15,7 @@ private:
   uint32_t screenWidth;
   uint32_t screenHeight;
   lv_disp_draw_buf_t draw_buf;
-  // static lv_color_t *disp_draw_buf;
-  lv_color_t disp_draw_buf[800 * 480 / 15];
+  lv_color_t *disp_draw_buf;
   lv_disp_drv_t disp_drv;
 
 
@@ -4,10 +4,81 @@
 
 #include <SPI.h>
 #include <Adafruit_GFX.h>
+#include <esp_heap_caps.h>
 #include "ui/ui.h"
+#include "ui/screens.h"
 #include "ui/vars.h"
 #include "ui/actions.h" 
 #include "lgfx/lgfx.h"
+#include "telemetry/frame_telemetry.h"
+#include "clock/wall_clock.h"
+#include "assets/assets_partition.h"
+#include "fonts/glyph_cache.h"
+#include "sensors/sensor_pipeline.h"
+#include "sensors/dht20_sensor.h"
+#include "flow/flow_worker.h"
+
+DHT20Sensor dht20;
+static MedianStage temperatureMedian(5);
+static EmaStage temperatureEma(0.2f);
+static MedianStage humidityMedian(5);
+static EmaStage humidityEma(0.2f);
+
+static float temperature;
+static float humidity;
+
+extern float get_var_temperature()
+{
+  return temperature;
+}
+extern void set_var_temperature(float value)
+{
+  temperature = value;
+}
+
+extern float get_var_humidity()
+{
+  return humidity;
+}
+extern void set_var_humidity(float value)
+{
+  humidity = value;
+}
+
+// The DHT20 starts measuring every two seconds on the I2C bus task, the channels pick up
+// each new reading and only pass changes bigger than the sensor noise on to the temperature
+// and humidity native variables.
+static void setupSensors()
+{
+  if (!dht20.begin())
+  {
+    Serial.println("DHT20: no room on the I2C bus");
+    return;
+  }
+  SensorChannel *channel = sensors.addChannel("temperature", 500, DHT20Sensor::readTemperature, &dht20);
+  channel->addStage(&temperatureMedian).addStage(&temperatureEma);
+  channel->publishToNativeVariable(set_var_temperature, 0.1f);
+
+  channel = sensors.addChannel("humidity", 500, DHT20Sensor::readHumidity, &dht20);
+  channel->addStage(&humidityMedian).addStage(&humidityEma);
+  channel->publishToNativeVariable(set_var_humidity, 0.5f);
+}
+
+// Screens are built on first navigation instead of all at once by create_screens(), and
+// the least recently used ones are deleted again once the cached screens take more than
+// EEZ_LVGL_SCREEN_CACHE_BUDGET.  Keep this list in the order of ScreensEnum in ui/screens.h.
+static const create_screen_func_t screenFactories[] = {
+  create_screen_main,
+};
+
+// LVGL allocates through tiered_alloc, so lv_mem_monitor() has nothing to report.  The size
+// of a screen is the heap growth while its factory runs, which also counts whatever the
+// other tasks (I2C bus, flow worker, WiFi) allocate or free meanwhile, so the cache sizes
+// are estimates and the budget should leave some slack.
+static size_t getUsedHeap()
+{
+  return heap_caps_get_total_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
 
 // Setup the panel.
 void setup()
@@ -23,8 +94,17 @@ void setup()
   // Setup the panel
   lcd.setup();
 
-  // Initialize the UI
+  // Initialize the UI, with the flow assets from the newest valid flash slot if there is one
+  eez_flow_set_assets_loader(assets_partition_map);
+  eez_flow_set_screen_factories(screenFactories, sizeof(screenFactories) / sizeof(screenFactories[0]));
+  eez_flow_set_screen_memory_probe(getUsedHeap);
   ui_init();
+  // Flows marked with eez::flow::setFlowPartition(..., FLOW_PARTITION_WORKER) run on core 0
+  flowWorker.begin();
+  // The click count is drawn in the 38px font, keep its digits unpacked
+  glyph_cache_add_font(&lv_font_montserrat_38, GLYPH_CACHE_NUMERIC);
+  wallClock.begin();
+  setupSensors();
 
   // Run the LVGL timer handler once to get things started
   lv_timer_handler();
@@ -57,7 +137,11 @@ void action_button_click_action(lv_event_t *e)
 // Run Ardunio event loop
 void loop()
 {
+  uint32_t tickStart = micros();
   ui_tick();
+  frameTelemetry.onFlowTick(micros() - tickStart);
+  sensors.tick();
   lv_timer_handler(); /* let the GUI do its work */
+  frameTelemetry.tick();
   delay(10);
 }
@@ -0,0 +1,202 @@
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <soc/soc_memory_layout.h>
+#include "tiered_alloc.h"
+
+#define CAPS_INTERNAL (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define CAPS_DMA (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT)
+#define CAPS_PSRAM (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+struct TierCounters
+{
+  uint32_t allocs;
+  uint32_t frees;
+  uint32_t fallbacks;
+  uint32_t failures;
+  uint64_t bytesAllocated;
+};
+
+static TierCounters g_counters[TIERED_ALLOC_TIER_COUNT];
+static portMUX_TYPE g_countersLock = portMUX_INITIALIZER_UNLOCKED;
+
+static const uint32_t g_tierCaps[TIERED_ALLOC_TIER_COUNT] = {CAPS_INTERNAL, CAPS_PSRAM};
+
+// Counters are bumped from every task that allocates.
+static inline void count(uint32_t &counter)
+{
+  portENTER_CRITICAL(&g_countersLock);
+  counter++;
+  portEXIT_CRITICAL(&g_countersLock);
+}
+
+static inline tiered_alloc_tier_t tierOf(const void *ptr)
+{
+  return esp_ptr_external_ram(ptr) ? TIERED_ALLOC_TIER_PSRAM : TIERED_ALLOC_TIER_INTERNAL;
+}
+
+// heap_caps_get_free_size() walks the heap under its lock, too slow to call for every
+// small allocation.  The free size is read every TIERED_ALLOC_FREE_REFRESH small
+// allocations and counted down in between; frees are ignored until the next read, so the
+// estimate only errs towards PSRAM.
+static size_t g_internalFree;
+static uint32_t g_internalFreeAge;
+
+static bool internalHasRoom(size_t size)
+{
+  portENTER_CRITICAL(&g_countersLock);
+  bool refresh = g_internalFreeAge++ % TIERED_ALLOC_FREE_REFRESH == 0;
+  portEXIT_CRITICAL(&g_countersLock);
+  size_t freeSize = refresh ? heap_caps_get_free_size(CAPS_INTERNAL) : 0;
+
+  portENTER_CRITICAL(&g_countersLock);
+  if (refresh)
+  {
+    g_internalFree = freeSize;
+  }
+  bool room = g_internalFree >= TIERED_ALLOC_INTERNAL_RESERVE + size;
+  if (room)
+  {
+    g_internalFree -= size;
+  }
+  portEXIT_CRITICAL(&g_countersLock);
+  return room;
+}
+
+static tiered_alloc_category_t resolveCategory(size_t size, tiered_alloc_category_t category)
+{
+  if (category != TIERED_ALLOC_AUTO)
+  {
+    return category;
+  }
+  if (size >= TIERED_ALLOC_PSRAM_THRESHOLD)
+  {
+    return TIERED_ALLOC_BULK;
+  }
+  if (!internalHasRoom(size))
+  {
+    return TIERED_ALLOC_BULK;
+  }
+  return TIERED_ALLOC_HOT;
+}
+
+static void countAlloc(void *ptr, size_t size, tiered_alloc_tier_t preferred)
+{
+  tiered_alloc_tier_t tier = tierOf(ptr);
+  portENTER_CRITICAL(&g_countersLock);
+  g_counters[tier].allocs++;
+  if (tier != preferred)
+  {
+    g_counters[tier].fallbacks++;
+  }
+  g_counters[tier].bytesAllocated += size;
+  portEXIT_CRITICAL(&g_countersLock);
+}
+
+void *tiered_malloc_category(size_t size, tiered_alloc_category_t category)
+{
+  if (size == 0)
+  {
+    return NULL;
+  }
+
+  category = resolveCategory(size, category);
+
+  void *ptr;
+  tiered_alloc_tier_t preferred;
+  if (category == TIERED_ALLOC_DRAW)
+  {
+    preferred = TIERED_ALLOC_TIER_INTERNAL;
+    ptr = heap_caps_malloc(size, CAPS_DMA);
+  }
+  else
+  {
+    preferred = category == TIERED_ALLOC_BULK ? TIERED_ALLOC_TIER_PSRAM : TIERED_ALLOC_TIER_INTERNAL;
+    ptr = heap_caps_malloc_prefer(size, 2, g_tierCaps[preferred], g_tierCaps[1 - preferred]);
+  }
+
+  if (!ptr)
+  {
+    count(g_counters[preferred].failures);
+    return NULL;
+  }
+  countAlloc(ptr, size, preferred);
+  return ptr;
+}
+
+void *tiered_malloc(size_t size)
+{
+  return tiered_malloc_category(size, TIERED_ALLOC_AUTO);
+}
+
+void *tiered_realloc(void *ptr, size_t size)
+{
+  if (!ptr)
+  {
+    return tiered_malloc(size);
+  }
+  if (size == 0)
+  {
+    tiered_free(ptr);
+    return NULL;
+  }
+
+  tiered_alloc_tier_t oldTier = tierOf(ptr);
+  tiered_alloc_tier_t preferred = resolveCategory(size, TIERED_ALLOC_AUTO) == TIERED_ALLOC_BULK ? TIERED_ALLOC_TIER_PSRAM : TIERED_ALLOC_TIER_INTERNAL;
+
+  // heap_caps_realloc moves the block when the current one doesn't have the caps
+  void *newPtr = heap_caps_realloc(ptr, size, g_tierCaps[preferred]);
+  if (!newPtr)
+  {
+    newPtr = heap_caps_realloc(ptr, size, g_tierCaps[1 - preferred]);
+  }
+  if (!newPtr)
+  {
+    count(g_counters[preferred].failures);
+    return NULL;
+  }
+
+  count(g_counters[oldTier].frees);
+  countAlloc(newPtr, size, preferred);
+  return newPtr;
+}
+
+void tiered_free(void *ptr)
+{
+  if (!ptr)
+  {
+    return;
+  }
+  count(g_counters[tierOf(ptr)].frees);
+  heap_caps_free(ptr);
+}
+
+void tiered_alloc_get_stats(tiered_alloc_tier_t tier, tiered_alloc_stats_t *stats)
+{
+  portENTER_CRITICAL(&g_countersLock);
+  TierCounters counters = g_counters[tier];
+  portEXIT_CRITICAL(&g_countersLock);
+  stats->allocs = counters.allocs;
+  stats->frees = counters.frees;
+  stats->fallbacks = counters.fallbacks;
+  stats->failures = counters.failures;
+  stats->bytesAllocated = counters.bytesAllocated;
+
+  uint32_t caps = g_tierCaps[tier];
+  stats->totalSize = heap_caps_get_total_size(caps);
+  stats->freeSize = heap_caps_get_free_size(caps);
+  stats->minFreeSize = heap_caps_get_minimum_free_size(caps);
+  stats->largestFreeBlock = heap_caps_get_largest_free_block(caps);
+}
+
+void tiered_alloc_print_stats(Print &out)
+{
+  static const char *names[TIERED_ALLOC_TIER_COUNT] = {"internal", "psram"};
+  out.println("tier      allocs   frees  fallback  failed  total KB  free KB  min free KB  largest KB");
+  for (int i = 0; i < TIERED_ALLOC_TIER_COUNT; i++)
+  {
+    tiered_alloc_stats_t stats;
+    tiered_alloc_get_stats((tiered_alloc_tier_t)i, &stats);
+    out.printf("%-8s %7u %7u %9u %7u %9u %8u %12u %11u\n", names[i], stats.allocs, stats.frees, stats.fallbacks, stats.failures,
+               (unsigned)(stats.totalSize / 1024), (unsigned)(stats.freeSize / 1024), (unsigned)(stats.minFreeSize / 1024), (unsigned)(stats.largestFreeBlock / 1024));
+  }
+}
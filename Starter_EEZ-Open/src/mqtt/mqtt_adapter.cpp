@@ -0,0 +1,863 @@
+#include "mqtt_adapter.h"
+#include "../ui/eez-flow.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include <mqtt_client.h>
+#else
+#include <chrono>
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+#ifdef EEZ_MQTT_ADAPTER
+
+struct AdapterCounters
+{
+  std::atomic<uint32_t> connects;
+  std::atomic<uint32_t> disconnects;
+  std::atomic<uint32_t> messagesIn;
+  std::atomic<uint32_t> bytesIn;
+  std::atomic<uint32_t> messagesOut;
+  std::atomic<uint32_t> bytesOut;
+  std::atomic<uint32_t> publishFailures;
+  std::atomic<uint32_t> oversizedDropped;
+};
+
+static AdapterCounters g_counters;
+
+struct MqttAdapterConnection
+{
+  char *host;
+  int port;
+  char *username;
+  char *password;
+  char *uri;
+
+  // subscriptions are added on the UI task and replayed on the network task
+  std::mutex lock;
+  char *subscriptions[MQTT_ADAPTER_MAX_SUBSCRIPTIONS];
+  int numSubscriptions;
+
+  std::atomic<bool> connected;
+  bool wasConnected;
+
+#if defined(ESP_PLATFORM)
+  esp_mqtt_client_handle_t client;
+  bool started;
+  char *rxBuffer;
+  size_t rxTopicLength;
+#else
+  std::thread thread;
+  std::atomic<bool> running;
+  std::mutex sendLock;
+  int socket;
+  std::atomic<uint16_t> nextPacketId;
+  std::atomic<int64_t> lastSendMs;
+#endif
+};
+
+static char *copyString(const char *str)
+{
+  return str && *str ? strdup(str) : nullptr;
+}
+
+static void postEvent(MqttAdapterConnection *connection, EEZ_MQTT_Event event, const char *error = nullptr)
+{
+  eez_mqtt_on_event_callback(connection, event, (void *)error);
+}
+
+// Holding the network task while the UI task catches up lets TCP flow control slow the
+// broker down, so short bursts are not dropped.
+static void waitForIngestSlot()
+{
+  for (int waited = 0; eez::flow::getNumFreeMQTTIngestSlots() == 0 && waited < MQTT_ADAPTER_INGEST_WAIT_MS; waited++)
+  {
+#if defined(ESP_PLATFORM)
+    vTaskDelay(1);
+#else
+    usleep(1000);
+#endif
+  }
+}
+
+static void postMessage(MqttAdapterConnection *connection, const char *topic, size_t topicLength, const char *payload, size_t payloadLength)
+{
+  waitForIngestSlot();
+  g_counters.messagesIn++;
+  g_counters.bytesIn += payloadLength;
+  eez_mqtt_on_message(connection, topic, topicLength, payload, payloadLength);
+}
+
+static int findSubscription(MqttAdapterConnection *connection, const char *topic)
+{
+  for (int i = 0; i < connection->numSubscriptions; i++)
+  {
+    if (strcmp(connection->subscriptions[i], topic) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static bool sendSubscribe(MqttAdapterConnection *connection, const char *topic);
+static bool sendUnsubscribe(MqttAdapterConnection *connection, const char *topic);
+
+// Runs on the network task right after the broker accepted the connection.  The topics
+// are copied first: esp-mqtt holds its own lock while it calls us, and a subscribe from
+// the UI task takes the two locks in the other order.
+static void resubscribe(MqttAdapterConnection *connection)
+{
+  char *topics[MQTT_ADAPTER_MAX_SUBSCRIPTIONS];
+  int numTopics = 0;
+  {
+    std::lock_guard<std::mutex> guard(connection->lock);
+    for (int i = 0; i < connection->numSubscriptions; i++)
+    {
+      topics[numTopics] = strdup(connection->subscriptions[i]);
+      numTopics += topics[numTopics] != nullptr;
+    }
+  }
+  for (int i = 0; i < numTopics; i++)
+  {
+    sendSubscribe(connection, topics[i]);
+    free(topics[i]);
+  }
+}
+
+static void onConnected(MqttAdapterConnection *connection)
+{
+  g_counters.connects++;
+  connection->connected = true;
+  connection->wasConnected = true;
+  resubscribe(connection);
+  postEvent(connection, EEZ_MQTT_EVENT_CONNECT);
+}
+
+static void onConnectionLost(MqttAdapterConnection *connection)
+{
+  if (connection->connected)
+  {
+    g_counters.disconnects++;
+    connection->connected = false;
+    postEvent(connection, EEZ_MQTT_EVENT_CLOSE);
+    postEvent(connection, EEZ_MQTT_EVENT_OFFLINE);
+  }
+}
+
+#if defined(ESP_PLATFORM)
+
+// esp-mqtt splits messages bigger than its buffer into several DATA events, only the
+// first one carries the topic.
+static void onData(MqttAdapterConnection *connection, esp_mqtt_event_handle_t event)
+{
+  if (event->current_data_offset == 0 && event->data_len == event->total_data_len)
+  {
+    postMessage(connection, event->topic, event->topic_len, event->data, event->data_len);
+    return;
+  }
+
+  if (event->current_data_offset == 0)
+  {
+    free(connection->rxBuffer);
+    connection->rxBuffer = nullptr;
+    if (event->topic_len + event->total_data_len > MQTT_ADAPTER_MAX_MESSAGE_SIZE)
+    {
+      g_counters.oversizedDropped++;
+      return;
+    }
+    connection->rxBuffer = (char *)malloc(event->topic_len + event->total_data_len);
+    if (!connection->rxBuffer)
+    {
+      g_counters.oversizedDropped++;
+      return;
+    }
+    memcpy(connection->rxBuffer, event->topic, event->topic_len);
+    connection->rxTopicLength = event->topic_len;
+  }
+
+  if (!connection->rxBuffer)
+  {
+    return;
+  }
+  memcpy(connection->rxBuffer + connection->rxTopicLength + event->current_data_offset, event->data, event->data_len);
+  if (event->current_data_offset + event->data_len == event->total_data_len)
+  {
+    postMessage(connection, connection->rxBuffer, connection->rxTopicLength,
+                connection->rxBuffer + connection->rxTopicLength, event->total_data_len);
+    free(connection->rxBuffer);
+    connection->rxBuffer = nullptr;
+  }
+}
+
+static void eventHandler(void *arg, esp_event_base_t base, int32_t eventId, void *eventData)
+{
+  MqttAdapterConnection *connection = (MqttAdapterConnection *)arg;
+  esp_mqtt_event_handle_t event = (esp_mqtt_event_handle_t)eventData;
+  switch ((esp_mqtt_event_id_t)eventId)
+  {
+  case MQTT_EVENT_BEFORE_CONNECT:
+    if (connection->wasConnected)
+    {
+      postEvent(connection, EEZ_MQTT_EVENT_RECONNECT);
+    }
+    break;
+  case MQTT_EVENT_CONNECTED:
+    onConnected(connection);
+    break;
+  case MQTT_EVENT_DISCONNECTED:
+    onConnectionLost(connection);
+    break;
+  case MQTT_EVENT_DATA:
+    onData(connection, event);
+    break;
+  case MQTT_EVENT_ERROR:
+  {
+    char error[64];
+    if (event->error_handle->error_type == MQTT_ERROR_TYPE_CONNECTION_REFUSED)
+    {
+      snprintf(error, sizeof(error), "connection refused (%d)", (int)event->error_handle->connect_return_code);
+    }
+    else
+    {
+      snprintf(error, sizeof(error), "transport error (errno %d)", event->error_handle->esp_transport_sock_errno);
+    }
+    postEvent(connection, EEZ_MQTT_EVENT_ERROR, error);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+static bool sendSubscribe(MqttAdapterConnection *connection, const char *topic)
+{
+  return esp_mqtt_client_subscribe(connection->client, topic, 0) >= 0;
+}
+
+static bool sendUnsubscribe(MqttAdapterConnection *connection, const char *topic)
+{
+  return esp_mqtt_client_unsubscribe(connection->client, topic) >= 0;
+}
+
+static int adapterInit(MqttAdapterConnection *connection, const char *protocol)
+{
+  size_t uriSize = strlen(protocol) + strlen(connection->host) + 16;
+  connection->uri = (char *)malloc(uriSize);
+  if (!connection->uri)
+  {
+    return MQTT_ERROR_OTHER;
+  }
+  snprintf(connection->uri, uriSize, "%s://%s:%d", protocol, connection->host, connection->port);
+
+  esp_mqtt_client_config_t config = {};
+  config.uri = connection->uri;
+  config.username = connection->username;
+  config.password = connection->password;
+  config.keepalive = MQTT_ADAPTER_KEEPALIVE_S;
+  config.reconnect_timeout_ms = MQTT_ADAPTER_RECONNECT_MS;
+  connection->client = esp_mqtt_client_init(&config);
+  if (!connection->client)
+  {
+    return MQTT_ERROR_OTHER;
+  }
+  esp_mqtt_client_register_event(connection->client, MQTT_EVENT_ANY, eventHandler, connection);
+  connection->started = false;
+  connection->rxBuffer = nullptr;
+  return MQTT_ERROR_OK;
+}
+
+static void adapterDeinit(MqttAdapterConnection *connection)
+{
+  if (connection->client)
+  {
+    esp_mqtt_client_destroy(connection->client);
+  }
+  free(connection->rxBuffer);
+}
+
+static int adapterConnect(MqttAdapterConnection *connection)
+{
+  if (connection->started)
+  {
+    return esp_mqtt_client_reconnect(connection->client) == ESP_OK ? MQTT_ERROR_OK : MQTT_ERROR_OTHER;
+  }
+  if (esp_mqtt_client_start(connection->client) != ESP_OK)
+  {
+    return MQTT_ERROR_OTHER;
+  }
+  connection->started = true;
+  return MQTT_ERROR_OK;
+}
+
+static int adapterDisconnect(MqttAdapterConnection *connection)
+{
+  if (!connection->started)
+  {
+    return MQTT_ERROR_OK;
+  }
+  // stop() joins the esp-mqtt task, after it returns no more events arrive
+  esp_mqtt_client_stop(connection->client);
+  connection->started = false;
+  onConnectionLost(connection);
+  return MQTT_ERROR_OK;
+}
+
+// enqueue() hands the packet to the esp-mqtt task instead of writing the socket here.
+static bool adapterPublish(MqttAdapterConnection *connection, const char *topic, const char *payload, size_t payloadLength)
+{
+  return esp_mqtt_client_enqueue(connection->client, topic, payload, payloadLength, 0, 0, true) >= 0;
+}
+
+#else
+
+// Minimal MQTT 3.1.1 client: QoS 0 publish, subscribe, keepalive and reconnect.
+
+enum
+{
+  PACKET_CONNECT = 0x10,
+  PACKET_CONNACK = 0x20,
+  PACKET_PUBLISH = 0x30,
+  PACKET_PUBACK = 0x40,
+  PACKET_SUBSCRIBE = 0x82,
+  PACKET_UNSUBSCRIBE = 0xA2,
+  PACKET_PINGREQ = 0xC0,
+  PACKET_DISCONNECT = 0xE0,
+};
+
+static void appendUint16(std::string &body, uint16_t value)
+{
+  body.push_back((char)(value >> 8));
+  body.push_back((char)(value & 0xFF));
+}
+
+static void appendString(std::string &body, const char *str, size_t length)
+{
+  appendUint16(body, (uint16_t)length);
+  body.append(str, length);
+}
+
+static int64_t nowMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool sendAll(int socket, const char *data, size_t length)
+{
+  while (length > 0)
+  {
+    ssize_t n = send(socket, data, length, MSG_NOSIGNAL);
+    if (n <= 0)
+    {
+      if (n < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    length -= n;
+  }
+  return true;
+}
+
+static bool sendPacket(MqttAdapterConnection *connection, uint8_t type, const std::string &body)
+{
+  char header[5];
+  size_t headerLength = 0;
+  header[headerLength++] = (char)type;
+  size_t remaining = body.size();
+  do
+  {
+    uint8_t byte = remaining & 0x7F;
+    remaining >>= 7;
+    header[headerLength++] = (char)(remaining ? byte | 0x80 : byte);
+  } while (remaining);
+
+  std::lock_guard<std::mutex> guard(connection->sendLock);
+  if (connection->socket < 0)
+  {
+    return false;
+  }
+  if (!sendAll(connection->socket, header, headerLength) || !sendAll(connection->socket, body.data(), body.size()))
+  {
+    return false;
+  }
+  connection->lastSendMs = nowMs();
+  return true;
+}
+
+static uint16_t takePacketId(MqttAdapterConnection *connection)
+{
+  uint16_t id = ++connection->nextPacketId;
+  return id ? id : ++connection->nextPacketId;
+}
+
+static bool sendSubscribe(MqttAdapterConnection *connection, const char *topic)
+{
+  std::string body;
+  appendUint16(body, takePacketId(connection));
+  appendString(body, topic, strlen(topic));
+  body.push_back(0);
+  return sendPacket(connection, PACKET_SUBSCRIBE, body);
+}
+
+static bool sendUnsubscribe(MqttAdapterConnection *connection, const char *topic)
+{
+  std::string body;
+  appendUint16(body, takePacketId(connection));
+  appendString(body, topic, strlen(topic));
+  return sendPacket(connection, PACKET_UNSUBSCRIBE, body);
+}
+
+static bool recvAll(int socket, char *data, size_t length)
+{
+  while (length > 0)
+  {
+    ssize_t n = recv(socket, data, length, 0);
+    if (n <= 0)
+    {
+      if (n < 0 && errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    length -= n;
+  }
+  return true;
+}
+
+static bool recvPacket(int socket, uint8_t &type, std::string &body)
+{
+  char byte;
+  if (!recvAll(socket, &byte, 1))
+  {
+    return false;
+  }
+  type = (uint8_t)byte;
+  size_t length = 0;
+  for (int shift = 0; shift < 28; shift += 7)
+  {
+    if (!recvAll(socket, &byte, 1))
+    {
+      return false;
+    }
+    length |= (size_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+    {
+      body.resize(length);
+      return length == 0 || recvAll(socket, &body[0], length);
+    }
+  }
+  return false;
+}
+
+static int openSocket(const char *host, int port)
+{
+  char service[8];
+  snprintf(service, sizeof(service), "%d", port);
+  struct addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *addresses;
+  if (getaddrinfo(host, service, &hints, &addresses) != 0)
+  {
+    return -1;
+  }
+  int result = -1;
+  for (struct addrinfo *address = addresses; address && result < 0; address = address->ai_next)
+  {
+    int s = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (s < 0)
+    {
+      continue;
+    }
+    if (connect(s, address->ai_addr, address->ai_addrlen) == 0)
+    {
+      result = s;
+    }
+    else
+    {
+      close(s);
+    }
+  }
+  freeaddrinfo(addresses);
+  return result;
+}
+
+static bool handshake(MqttAdapterConnection *connection)
+{
+  char clientId[32];
+  snprintf(clientId, sizeof(clientId), "eez-%p", (void *)connection);
+
+  std::string body;
+  appendString(body, "MQTT", 4);
+  body.push_back(4);
+  body.push_back((char)(0x02 | (connection->username ? 0x80 : 0) | (connection->password ? 0x40 : 0)));
+  appendUint16(body, MQTT_ADAPTER_KEEPALIVE_S);
+  appendString(body, clientId, strlen(clientId));
+  if (connection->username)
+  {
+    appendString(body, connection->username, strlen(connection->username));
+  }
+  if (connection->password)
+  {
+    appendString(body, connection->password, strlen(connection->password));
+  }
+  if (!sendPacket(connection, PACKET_CONNECT, body))
+  {
+    return false;
+  }
+
+  uint8_t type;
+  std::string reply;
+  if (!recvPacket(connection->socket, type, reply) || (type & 0xF0) != PACKET_CONNACK || reply.size() < 2)
+  {
+    return false;
+  }
+  if (reply[1] != 0)
+  {
+    char error[64];
+    snprintf(error, sizeof(error), "connection refused (%d)", (int)reply[1]);
+    postEvent(connection, EEZ_MQTT_EVENT_ERROR, error);
+    return false;
+  }
+  return true;
+}
+
+static void onPublish(MqttAdapterConnection *connection, uint8_t type, const std::string &body)
+{
+  if (body.size() < 2)
+  {
+    return;
+  }
+  size_t topicLength = ((uint8_t)body[0] << 8) | (uint8_t)body[1];
+  size_t offset = 2 + topicLength;
+  uint8_t qos = (type >> 1) & 3;
+  if (qos > 0)
+  {
+    if (body.size() < offset + 2)
+    {
+      return;
+    }
+    std::string ack(body, offset, 2);
+    sendPacket(connection, PACKET_PUBACK, ack);
+    offset += 2;
+  }
+  if (body.size() < offset)
+  {
+    return;
+  }
+  postMessage(connection, body.data() + 2, topicLength, body.data() + offset, body.size() - offset);
+}
+
+// Reads until the connection drops, sending a ping when nothing was sent for half the
+// keepalive period.  The broker only counts packets from the client towards the
+// keepalive, so a busy subscription doesn't keep the connection alive.
+static void readLoop(MqttAdapterConnection *connection)
+{
+  const int64_t pingIntervalMs = MQTT_ADAPTER_KEEPALIVE_S * 500;
+  struct pollfd fd;
+  fd.fd = connection->socket;
+  fd.events = POLLIN;
+  while (connection->running)
+  {
+    int64_t idleMs = nowMs() - connection->lastSendMs;
+    if (idleMs >= pingIntervalMs)
+    {
+      if (!sendPacket(connection, PACKET_PINGREQ, std::string()))
+      {
+        return;
+      }
+      continue;
+    }
+    int n = poll(&fd, 1, (int)(pingIntervalMs - idleMs));
+    if (n < 0 && errno != EINTR)
+    {
+      return;
+    }
+    if (n <= 0)
+    {
+      continue;
+    }
+    uint8_t type;
+    std::string body;
+    if (!recvPacket(connection->socket, type, body))
+    {
+      return;
+    }
+    if ((type & 0xF0) == PACKET_PUBLISH)
+    {
+      onPublish(connection, type, body);
+    }
+  }
+}
+
+static void closeSocket(MqttAdapterConnection *connection)
+{
+  std::lock_guard<std::mutex> guard(connection->sendLock);
+  if (connection->socket >= 0)
+  {
+    close(connection->socket);
+    connection->socket = -1;
+  }
+}
+
+static void networkTask(MqttAdapterConnection *connection)
+{
+  while (connection->running)
+  {
+    if (connection->wasConnected)
+    {
+      postEvent(connection, EEZ_MQTT_EVENT_RECONNECT);
+    }
+    int s = openSocket(connection->host, connection->port);
+    if (s >= 0)
+    {
+      {
+        std::lock_guard<std::mutex> guard(connection->sendLock);
+        connection->socket = s;
+      }
+      if (handshake(connection))
+      {
+        onConnected(connection);
+        readLoop(connection);
+        onConnectionLost(connection);
+      }
+      closeSocket(connection);
+    }
+    else
+    {
+      postEvent(connection, EEZ_MQTT_EVENT_ERROR, "connect failed");
+    }
+    for (int waited = 0; connection->running && waited < MQTT_ADAPTER_RECONNECT_MS; waited += 100)
+    {
+      usleep(100 * 1000);
+    }
+  }
+}
+
+static int adapterInit(MqttAdapterConnection *connection, const char *protocol)
+{
+  if (strcmp(protocol, "mqtt") != 0 && strcmp(protocol, "tcp") != 0)
+  {
+    return MQTT_ERROR_NOT_IMPLEMENTED;
+  }
+  connection->uri = nullptr;
+  connection->running = false;
+  connection->socket = -1;
+  connection->nextPacketId = 0;
+  return MQTT_ERROR_OK;
+}
+
+static int adapterDisconnect(MqttAdapterConnection *connection);
+
+static void adapterDeinit(MqttAdapterConnection *connection)
+{
+  adapterDisconnect(connection);
+}
+
+static int adapterConnect(MqttAdapterConnection *connection)
+{
+  if (connection->running)
+  {
+    return MQTT_ERROR_OK;
+  }
+  connection->running = true;
+  connection->thread = std::thread(networkTask, connection);
+  return MQTT_ERROR_OK;
+}
+
+static int adapterDisconnect(MqttAdapterConnection *connection)
+{
+  if (!connection->running)
+  {
+    return MQTT_ERROR_OK;
+  }
+  connection->running = false;
+  sendPacket(connection, PACKET_DISCONNECT, std::string());
+  {
+    std::lock_guard<std::mutex> guard(connection->sendLock);
+    if (connection->socket >= 0)
+    {
+      shutdown(connection->socket, SHUT_RDWR);
+    }
+  }
+  connection->thread.join();
+  return MQTT_ERROR_OK;
+}
+
+static bool adapterPublish(MqttAdapterConnection *connection, const char *topic, const char *payload, size_t payloadLength)
+{
+  std::string body;
+  appendString(body, topic, strlen(topic));
+  body.append(payload, payloadLength);
+  return sendPacket(connection, PACKET_PUBLISH, body);
+}
+
+#endif
+
+extern "C" int eez_mqtt_init(const char *protocol, const char *host, int port, const char *username, const char *password, void **handle)
+{
+  MqttAdapterConnection *connection = new MqttAdapterConnection();
+  connection->host = strdup(host);
+  connection->port = port;
+  connection->username = copyString(username);
+  connection->password = copyString(password);
+  connection->numSubscriptions = 0;
+  connection->connected = false;
+  connection->wasConnected = false;
+  int result = connection->host ? adapterInit(connection, protocol) : MQTT_ERROR_OTHER;
+  if (result != MQTT_ERROR_OK)
+  {
+    free(connection->host);
+    free(connection->username);
+    free(connection->password);
+    free(connection->uri);
+    delete connection;
+    return result;
+  }
+  *handle = connection;
+  return MQTT_ERROR_OK;
+}
+
+extern "C" int eez_mqtt_deinit(void *handle)
+{
+  MqttAdapterConnection *connection = (MqttAdapterConnection *)handle;
+  adapterDeinit(connection);
+  for (int i = 0; i < connection->numSubscriptions; i++)
+  {
+    free(connection->subscriptions[i]);
+  }
+  free(connection->host);
+  free(connection->username);
+  free(connection->password);
+  free(connection->uri);
+  delete connection;
+  return MQTT_ERROR_OK;
+}
+
+extern "C" int eez_mqtt_connect(void *handle)
+{
+  return adapterConnect((MqttAdapterConnection *)handle);
+}
+
+extern "C" int eez_mqtt_disconnect(void *handle)
+{
+  MqttAdapterConnection *connection = (MqttAdapterConnection *)handle;
+  int result = adapterDisconnect(connection);
+  if (result == MQTT_ERROR_OK)
+  {
+    postEvent(connection, EEZ_MQTT_EVENT_END);
+  }
+  return result;
+}
+
+extern "C" int eez_mqtt_subscribe(void *handle, const char *topic)
+{
+  MqttAdapterConnection *connection = (MqttAdapterConnection *)handle;
+  {
+    std::lock_guard<std::mutex> guard(connection->lock);
+    if (findSubscription(connection, topic) < 0)
+    {
+      if (connection->numSubscriptions == MQTT_ADAPTER_MAX_SUBSCRIPTIONS)
+      {
+        return MQTT_ERROR_OTHER;
+      }
+      char *copy = strdup(topic);
+      if (!copy)
+      {
+        return MQTT_ERROR_OTHER;
+      }
+      connection->subscriptions[connection->numSubscriptions++] = copy;
+    }
+  }
+  // while offline the subscription is sent by resubscribe() after connecting
+  if (connection->connected && !sendSubscribe(connection, topic))
+  {
+    return MQTT_ERROR_OTHER;
+  }
+  return MQTT_ERROR_OK;
+}
+
+extern "C" int eez_mqtt_unsubscribe(void *handle, const char *topic)
+{
+  MqttAdapterConnection *connection = (MqttAdapterConnection *)handle;
+  {
+    std::lock_guard<std::mutex> guard(connection->lock);
+    int i = findSubscription(connection, topic);
+    if (i >= 0)
+    {
+      free(connection->subscriptions[i]);
+      connection->subscriptions[i] = connection->subscriptions[--connection->numSubscriptions];
+    }
+  }
+  if (connection->connected && !sendUnsubscribe(connection, topic))
+  {
+    return MQTT_ERROR_OTHER;
+  }
+  return MQTT_ERROR_OK;
+}
+
+extern "C" int eez_mqtt_publish(void *handle, const char *topic, const char *payload)
+{
+  MqttAdapterConnection *connection = (MqttAdapterConnection *)handle;
+  size_t payloadLength = strlen(payload);
+  if (!connection->connected || !adapterPublish(connection, topic, payload, payloadLength))
+  {
+    g_counters.publishFailures++;
+    return MQTT_ERROR_OTHER;
+  }
+  g_counters.messagesOut++;
+  g_counters.bytesOut += payloadLength;
+  return MQTT_ERROR_OK;
+}
+
+void mqtt_adapter_get_stats(MqttAdapterStats &stats)
+{
+  stats.connects = g_counters.connects;
+  stats.disconnects = g_counters.disconnects;
+  stats.messagesIn = g_counters.messagesIn;
+  stats.bytesIn = g_counters.bytesIn;
+  stats.messagesOut = g_counters.messagesOut;
+  stats.bytesOut = g_counters.bytesOut;
+  stats.publishFailures = g_counters.publishFailures;
+  stats.oversizedDropped = g_counters.oversizedDropped;
+}
+
+#else
+
+void mqtt_adapter_get_stats(MqttAdapterStats &stats)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+#endif
+
+#ifdef ARDUINO
+void mqtt_adapter_print_stats(Print &out)
+{
+  MqttAdapterStats stats;
+  mqtt_adapter_get_stats(stats);
+  eez::flow::MQTTIngestStats ingest;
+  eez::flow::getMQTTIngestStats(ingest);
+  out.printf("mqtt: %u connects, %u disconnects, in %u msgs / %u bytes, out %u msgs / %u bytes, %u publish failures, %u oversized\n",
+             stats.connects, stats.disconnects, stats.messagesIn, stats.bytesIn, stats.messagesOut, stats.bytesOut,
+             stats.publishFailures, stats.oversizedDropped);
+  out.printf("mqtt ingest: %u received, %u dropped, %u oversized, %u pending, %u handler overflows\n", ingest.received,
+             ingest.dropped, ingest.oversized, ingest.pending, ingest.eventQueueOverflows);
+}
+#endif
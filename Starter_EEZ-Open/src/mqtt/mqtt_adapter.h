@@ -0,0 +1,71 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+#ifndef _MQTT_ADAPTER_H
+#define _MQTT_ADAPTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The eez_mqtt_* functions behind the MQTT flow components.  On the ESP32 they wrap
+// esp-mqtt, which runs each connection on its own task; on the host a small MQTT 3.1.1
+// client on POSIX sockets runs a thread per connection.  Either way the network side
+// only calls eez_mqtt_on_message() / eez_mqtt_on_event_callback(), which copy into the
+// flow engine's lock-free ingest ring, and the UI task picks the events up on its next
+// flow tick.
+//
+// Build with -D EEZ_MQTT_ADAPTER (see platformio.ini) so eez-flow.cpp leaves the
+// eez_mqtt_* functions to this file.  Subscriptions are remembered and sent again after
+// every reconnect; messages are QoS 0.
+//
+//   mqtt_adapter_print_stats(Serial);
+//
+// Messages are routed to MQTTEvent components through a topic trie per connection.  A
+// component receives everything on its connection unless a filter was set for it (or
+// for all components of its flow, componentIndex -1) before it starts:
+//
+//   eez::flow::setMQTTEventTopicFilter(FLOW_INDEX_ON_TEMPERATURE, -1, "sensors/+/temperature");
+
+// Subscriptions kept per connection for resubscribing.
+#ifndef MQTT_ADAPTER_MAX_SUBSCRIPTIONS
+#define MQTT_ADAPTER_MAX_SUBSCRIPTIONS 16
+#endif
+
+// Largest message reassembled from esp-mqtt fragments, bigger ones are dropped.
+#ifndef MQTT_ADAPTER_MAX_MESSAGE_SIZE
+#define MQTT_ADAPTER_MAX_MESSAGE_SIZE (16 * 1024)
+#endif
+
+// How long the network task waits for a free ingest slot before the message is dropped.
+#ifndef MQTT_ADAPTER_INGEST_WAIT_MS
+#define MQTT_ADAPTER_INGEST_WAIT_MS 100
+#endif
+
+#ifndef MQTT_ADAPTER_KEEPALIVE_S
+#define MQTT_ADAPTER_KEEPALIVE_S 30
+#endif
+
+#ifndef MQTT_ADAPTER_RECONNECT_MS
+#define MQTT_ADAPTER_RECONNECT_MS 2000
+#endif
+
+struct MqttAdapterStats
+{
+  uint32_t connects;
+  uint32_t disconnects;
+  uint32_t messagesIn;
+  uint32_t bytesIn;
+  uint32_t messagesOut;
+  uint32_t bytesOut;
+  uint32_t publishFailures;
+  uint32_t oversizedDropped;
+};
+
+void mqtt_adapter_get_stats(MqttAdapterStats &stats);
+
+#ifdef ARDUINO
+void mqtt_adapter_print_stats(Print &out);
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+#include "dht20_sensor.h"
+#include "../i2c/i2c_bus.h"
+
+// Time the DHT20 needs after power-up before it answers.
+#define DHT20_POWER_UP_TIME 100
+
+DHT20Sensor::DHT20Sensor(uint32_t sampleIntervalMs)
+    : _sampleInterval(sampleIntervalMs), _device(-1), _state(STATE_POWER_UP), _beginTime(0), _stepPending(false), _hasReading(false), _temperatureTimestamp(0), _humidityTimestamp(0)
+{
+  _lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+bool DHT20Sensor::begin()
+{
+  _device = i2cBus.addDevice(0x38, "DHT20");
+  _dht.setSampleInterval(_sampleInterval);
+  _beginTime = millis();
+  _state = STATE_POWER_UP;
+  return _device != -1;
+}
+
+int DHT20Sensor::stepOnBus(TwoWire &wire, void *userData)
+{
+  DHT20Sensor *sensor = (DHT20Sensor *)userData;
+  if (sensor->_state == STATE_POWER_UP)
+  {
+    if (millis() - sensor->_beginTime < DHT20_POWER_UP_TIME)
+    {
+      return I2C_BUS_OK;
+    }
+    if (sensor->_dht.probe() != 0)
+    {
+      sensor->_state = STATE_FAILED;
+      return I2C_BUS_ERROR_SHORT_READ;
+    }
+    sensor->_state = STATE_RUNNING;
+  }
+
+  if (sensor->_dht.update())
+  {
+    portENTER_CRITICAL(&sensor->_lock);
+    sensor->_reading = sensor->_dht.getReading();
+    sensor->_hasReading = true;
+    portEXIT_CRITICAL(&sensor->_lock);
+  }
+  return I2C_BUS_OK;
+}
+
+void DHT20Sensor::onStepDone(int result, void *userData)
+{
+  DHT20Sensor *sensor = (DHT20Sensor *)userData;
+  sensor->_stepPending = false;
+}
+
+void DHT20Sensor::poll()
+{
+  // one step in flight at a time, the bus task does the I2C work
+  if (_device != -1 && _state != STATE_FAILED && !_stepPending)
+  {
+    _stepPending = true;
+    if (!i2cBus.run(_device, stepOnBus, this, I2C_PRIORITY_LOW, onStepDone, this))
+    {
+      _stepPending = false;
+    }
+  }
+}
+
+bool DHT20Sensor::takeReading(uint32_t &lastTimestamp, DHT20Reading &reading)
+{
+  poll();
+
+  bool isNew = false;
+  portENTER_CRITICAL(&_lock);
+  if (_hasReading && _reading.timestamp != lastTimestamp)
+  {
+    reading = _reading;
+    lastTimestamp = reading.timestamp;
+    isNew = true;
+  }
+  portEXIT_CRITICAL(&_lock);
+  return isNew;
+}
+
+bool DHT20Sensor::readTemperature(void *userData, float &value)
+{
+  DHT20Sensor *sensor = (DHT20Sensor *)userData;
+  DHT20Reading reading;
+  if (!sensor->takeReading(sensor->_temperatureTimestamp, reading))
+  {
+    return false;
+  }
+  value = reading.temperature / 100.0f;
+  return true;
+}
+
+bool DHT20Sensor::readHumidity(void *userData, float &value)
+{
+  DHT20Sensor *sensor = (DHT20Sensor *)userData;
+  DHT20Reading reading;
+  if (!sensor->takeReading(sensor->_humidityTimestamp, reading))
+  {
+    return false;
+  }
+  value = reading.humidity / 100.0f;
+  return true;
+}
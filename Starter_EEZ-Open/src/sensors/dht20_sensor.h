@@ -0,0 +1,53 @@
+#include <Arduino.h>
+#include <Crowbits_DHT20.h>
+
+#ifndef _DHT20_SENSOR_H
+#define _DHT20_SENSOR_H
+
+// Sensor pipeline source for the DHT20.  The driver state machine is stepped on the
+// I2C bus task at low priority, readTemperature/readHumidity hand out each new reading
+// once, in °C and %RH with the driver's 0.01 resolution.  The sensor's 100 ms power-up
+// time is one of those steps too, so nothing ever blocks the bus waiting for it.
+class DHT20Sensor
+{
+public:
+  DHT20Sensor(uint32_t sampleIntervalMs = 2000);
+
+  // Call after touch_init(), which starts i2cBus.  Returns false if the bus has no room
+  // for the device; whether the sensor answers is only known after the first steps.
+  bool begin();
+
+  bool isFailed() const { return _state == STATE_FAILED; }
+
+  static bool readTemperature(void *userData, float &value);
+  static bool readHumidity(void *userData, float &value);
+
+private:
+  enum State
+  {
+    STATE_POWER_UP,
+    STATE_RUNNING,
+    STATE_FAILED
+  };
+
+  static int stepOnBus(TwoWire &wire, void *userData);
+  static void onStepDone(int result, void *userData);
+
+  void poll();
+  bool takeReading(uint32_t &lastTimestamp, DHT20Reading &reading);
+
+  Crowbits_DHT20 _dht;
+  uint32_t _sampleInterval;
+  int _device;
+  volatile State _state;
+  uint32_t _beginTime;
+  volatile bool _stepPending;
+
+  portMUX_TYPE _lock;
+  DHT20Reading _reading;
+  bool _hasReading;
+  uint32_t _temperatureTimestamp;
+  uint32_t _humidityTimestamp;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "sensor_pipeline.h"
+#include "../ui/eez-flow.h"
+
+SensorPipeline sensors;
+
+MedianStage::MedianStage(uint8_t window)
+    : _window(window < 1 ? 1 : (window > MEDIAN_STAGE_MAX_WINDOW ? MEDIAN_STAGE_MAX_WINDOW : window)), _count(0), _head(0)
+{
+}
+
+bool MedianStage::process(float &value)
+{
+  _samples[_head] = value;
+  _head = (_head + 1) % _window;
+  if (_count < _window)
+  {
+    _count++;
+  }
+
+  float sorted[MEDIAN_STAGE_MAX_WINDOW];
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    float sample = _samples[i];
+    int8_t j = i - 1;
+    while (j >= 0 && sorted[j] > sample)
+    {
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = sample;
+  }
+  value = sorted[_count / 2];
+  return true;
+}
+
+void MedianStage::reset()
+{
+  _count = 0;
+  _head = 0;
+}
+
+EmaStage::EmaStage(float alpha)
+    : _alpha(alpha), _value(0), _initialized(false)
+{
+}
+
+bool EmaStage::process(float &value)
+{
+  if (!_initialized)
+  {
+    _value = value;
+    _initialized = true;
+  }
+  else
+  {
+    _value += _alpha * (value - _value);
+  }
+  value = _value;
+  return true;
+}
+
+void EmaStage::reset()
+{
+  _initialized = false;
+}
+
+DecimateStage::DecimateStage(uint8_t factor)
+    : _factor(factor < 1 ? 1 : factor), _count(0)
+{
+}
+
+bool DecimateStage::process(float &value)
+{
+  if (++_count < _factor)
+  {
+    return false;
+  }
+  _count = 0;
+  return true;
+}
+
+void DecimateStage::reset()
+{
+  _count = 0;
+}
+
+DeadbandStage::DeadbandStage(float deadband)
+    : _deadband(deadband), _value(0), _initialized(false)
+{
+}
+
+bool DeadbandStage::process(float &value)
+{
+  if (_initialized && fabsf(value - _value) <= _deadband)
+  {
+    value = _value;
+    return true;
+  }
+  _value = value;
+  _initialized = true;
+  return true;
+}
+
+void DeadbandStage::reset()
+{
+  _initialized = false;
+}
+
+SensorChannel &SensorChannel::addStage(SensorStage *stage)
+{
+  stage->next = nullptr;
+  if (_lastStage)
+  {
+    _lastStage->next = stage;
+  }
+  else
+  {
+    _firstStage = stage;
+  }
+  _lastStage = stage;
+  return *this;
+}
+
+void SensorChannel::publishTo(SensorPublishFunc publish, void *userData, float threshold)
+{
+  _publish = publish;
+  _publishUserData = userData;
+  _threshold = threshold;
+  _published = false;
+}
+
+void SensorChannel::publishNative(void *userData, float value)
+{
+  SensorChannel *channel = (SensorChannel *)userData;
+  channel->_nativeSetter(value);
+}
+
+void SensorChannel::publishToNativeVariable(void (*setter)(float), float threshold)
+{
+  _nativeSetter = setter;
+  publishTo(publishNative, this, threshold);
+}
+
+void SensorChannel::publishGlobal(void *userData, float value)
+{
+  SensorChannel *channel = (SensorChannel *)userData;
+  eez::flow::setGlobalVariable(channel->_globalVariableIndex, eez::Value(value, eez::VALUE_TYPE_FLOAT));
+}
+
+void SensorChannel::publishToGlobalVariable(uint32_t globalVariableIndex, float threshold)
+{
+  _globalVariableIndex = globalVariableIndex;
+  publishTo(publishGlobal, this, threshold);
+}
+
+void SensorChannel::sample()
+{
+  float value;
+  if (!_read(_readUserData, value))
+  {
+    return;
+  }
+
+  for (SensorStage *stage = _firstStage; stage; stage = stage->next)
+  {
+    if (!stage->process(value))
+    {
+      return;
+    }
+  }
+
+  if (_published && fabsf(value - _lastPublished) <= _threshold)
+  {
+    return;
+  }
+  _published = true;
+  _lastPublished = value;
+  _publishCount++;
+  if (_publish)
+  {
+    _publish(_publishUserData, value);
+  }
+}
+
+SensorPipeline::SensorPipeline()
+    : _numChannels(0)
+{
+}
+
+SensorChannel *SensorPipeline::addChannel(const char *name, uint32_t periodMs, SensorReadFunc read, void *userData)
+{
+  if (_numChannels == SENSOR_PIPELINE_MAX_CHANNELS)
+  {
+    return nullptr;
+  }
+  SensorChannel *channel = &_channels[_numChannels++];
+  memset((void *)channel, 0, sizeof(*channel));
+  channel->name = name;
+  channel->_period = periodMs;
+  channel->_lastSampleTime = millis() - periodMs;
+  channel->_read = read;
+  channel->_readUserData = userData;
+  return channel;
+}
+
+void SensorPipeline::tick()
+{
+  uint32_t now = millis();
+  for (int i = 0; i < _numChannels; i++)
+  {
+    SensorChannel &channel = _channels[i];
+    if (now - channel._lastSampleTime >= channel._period)
+    {
+      // keep the sampling grid, but don't try to catch up after a long stall
+      channel._lastSampleTime += channel._period;
+      if (now - channel._lastSampleTime >= channel._period)
+      {
+        channel._lastSampleTime = now;
+      }
+      channel.sample();
+    }
+  }
+}
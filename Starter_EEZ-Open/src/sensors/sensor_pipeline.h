@@ -0,0 +1,158 @@
+#include <Arduino.h>
+
+#ifndef _SENSOR_PIPELINE_H
+#define _SENSOR_PIPELINE_H
+
+// Sensor values reach the UI through channels: a source is sampled at a fixed period,
+// each sample runs through a chain of stages (any of them may drop it) and whatever
+// comes out is published to a flow variable, but only when it moved by more than the
+// channel threshold.  That keeps sensor noise from redrawing labels every tick.
+//
+//   static MedianStage median(5);
+//   static EmaStage ema(0.2f);
+//   static DeadbandStage deadband(0.05f);
+//   SensorChannel *channel = sensors.addChannel("temperature", 500, DHT20Sensor::readTemperature, &dht20);
+//   channel->addStage(&median).addStage(&ema).addStage(&deadband);
+//   channel->publishToGlobalVariable(FLOW_GLOBAL_VARIABLE_TEMPERATURE, 0.1f);
+//
+// and call sensors.tick() from loop().
+
+#ifndef SENSOR_PIPELINE_MAX_CHANNELS
+#define SENSOR_PIPELINE_MAX_CHANNELS 8
+#endif
+
+#define MEDIAN_STAGE_MAX_WINDOW 9
+
+class SensorStage
+{
+public:
+  SensorStage() : next(nullptr) {}
+  virtual ~SensorStage() {}
+
+  // Return false to drop the sample, the stages after this one don't see it.
+  virtual bool process(float &value) = 0;
+  virtual void reset() {}
+
+  SensorStage *next;
+};
+
+// Median of the last N samples, removes single sample spikes.
+class MedianStage : public SensorStage
+{
+public:
+  MedianStage(uint8_t window);
+  bool process(float &value) override;
+  void reset() override;
+
+private:
+  float _samples[MEDIAN_STAGE_MAX_WINDOW];
+  uint8_t _window;
+  uint8_t _count;
+  uint8_t _head;
+};
+
+// Exponential moving average, y += alpha * (x - y).
+class EmaStage : public SensorStage
+{
+public:
+  EmaStage(float alpha);
+  bool process(float &value) override;
+  void reset() override;
+
+private:
+  float _alpha;
+  float _value;
+  bool _initialized;
+};
+
+// Passes every Nth sample.
+class DecimateStage : public SensorStage
+{
+public:
+  DecimateStage(uint8_t factor);
+  bool process(float &value) override;
+  void reset() override;
+
+private:
+  uint8_t _factor;
+  uint8_t _count;
+};
+
+// Hysteresis: the output only follows the input once it has moved more than the
+// deadband away from the last value let through.
+class DeadbandStage : public SensorStage
+{
+public:
+  DeadbandStage(float deadband);
+  bool process(float &value) override;
+  void reset() override;
+
+private:
+  float _deadband;
+  float _value;
+  bool _initialized;
+};
+
+// Returns true and sets value when a new sample is available.
+typedef bool (*SensorReadFunc)(void *userData, float &value);
+typedef void (*SensorPublishFunc)(void *userData, float value);
+
+class SensorChannel
+{
+public:
+  SensorChannel &addStage(SensorStage *stage);
+
+  void publishTo(SensorPublishFunc publish, void *userData, float threshold);
+  // Native variable with a float setter, e.g. set_var_temperature().
+  void publishToNativeVariable(void (*setter)(float), float threshold);
+  // Flow global variable, index from enum FlowGlobalVariables in vars.h.
+  void publishToGlobalVariable(uint32_t globalVariableIndex, float threshold);
+
+  bool hasValue() const { return _published; }
+  float getValue() const { return _lastPublished; }
+  uint32_t getPublishCount() const { return _publishCount; }
+
+  const char *name;
+
+private:
+  friend class SensorPipeline;
+
+  void sample();
+  static void publishNative(void *userData, float value);
+  static void publishGlobal(void *userData, float value);
+
+  uint32_t _period;
+  uint32_t _lastSampleTime;
+  SensorReadFunc _read;
+  void *_readUserData;
+  SensorStage *_firstStage;
+  SensorStage *_lastStage;
+
+  SensorPublishFunc _publish;
+  void *_publishUserData;
+  void (*_nativeSetter)(float);
+  uint32_t _globalVariableIndex;
+  float _threshold;
+  bool _published;
+  float _lastPublished;
+  uint32_t _publishCount;
+};
+
+class SensorPipeline
+{
+public:
+  SensorPipeline();
+
+  SensorChannel *addChannel(const char *name, uint32_t periodMs, SensorReadFunc read, void *userData);
+
+  // Call from loop(), on the same task as eez_flow_tick().
+  void tick();
+
+private:
+  SensorChannel _channels[SENSOR_PIPELINE_MAX_CHANNELS];
+  int _numChannels;
+};
+
+extern SensorPipeline sensors;
+
+#endif
@@ -0,0 +1,215 @@
+#include "frame_telemetry.h"
+#include <algorithm>
+
+FrameTelemetry frameTelemetry;
+
+static const char *const g_metricNames[FRAME_METRIC_COUNT] = {
+    "render us", "flush us", "flush bytes", "dirty areas", "dirty px", "touch->flush us", "flow tick us"};
+
+FrameTelemetry::FrameTelemetry()
+    : _overlay(nullptr), _overlayEnabled(false), _lastOverlayUpdate(0), _overlayFrameCount(0),
+      _dumpOut(nullptr), _dumpInterval(0), _lastDump(0)
+{
+  reset();
+}
+
+void FrameTelemetry::attach(lv_disp_drv_t *drv)
+{
+  drv->render_start_cb = renderStart;
+  drv->monitor_cb = monitor;
+}
+
+void FrameTelemetry::reset()
+{
+  memset(_windows, 0, sizeof(_windows));
+  _inFrame = false;
+  _frameFlushUs = 0;
+  _frameBytes = 0;
+  _frameAreas = 0;
+  _frameCount = 0;
+  _touchPressed = false;
+  _touchPending = false;
+}
+
+void FrameTelemetry::addSample(FrameMetric metric, uint32_t value)
+{
+  Window &window = _windows[metric];
+  window.samples[window.head] = value;
+  window.head = (window.head + 1) % FRAME_TELEMETRY_WINDOW;
+  if (window.count < FRAME_TELEMETRY_WINDOW)
+  {
+    window.count++;
+  }
+}
+
+// Called by LVGL after the invalidated areas were joined, just before drawing.
+void FrameTelemetry::renderStart(lv_disp_drv_t *drv)
+{
+  FrameTelemetry &telemetry = frameTelemetry;
+  lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+  uint32_t areas = 0;
+  for (uint16_t i = 0; i < disp->inv_p; i++)
+  {
+    areas += disp->inv_area_joined[i] == 0;
+  }
+  telemetry._inFrame = true;
+  telemetry._frameStart = micros();
+  telemetry._frameFlushUs = 0;
+  telemetry._frameBytes = 0;
+  telemetry._frameAreas = areas;
+}
+
+// Called by LVGL at the end of a refresh that drew something, px is the number of
+// pixels redrawn.
+void FrameTelemetry::monitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+  FrameTelemetry &telemetry = frameTelemetry;
+  if (!telemetry._inFrame)
+  {
+    return;
+  }
+  telemetry._inFrame = false;
+  uint32_t frameUs = micros() - telemetry._frameStart;
+  telemetry.addSample(FRAME_METRIC_RENDER_US, frameUs > telemetry._frameFlushUs ? frameUs - telemetry._frameFlushUs : 0);
+  telemetry.addSample(FRAME_METRIC_FLUSH_US, telemetry._frameFlushUs);
+  telemetry.addSample(FRAME_METRIC_FLUSH_BYTES, telemetry._frameBytes);
+  telemetry.addSample(FRAME_METRIC_DIRTY_AREAS, telemetry._frameAreas);
+  telemetry.addSample(FRAME_METRIC_DIRTY_PIXELS, px);
+  telemetry._frameCount++;
+}
+
+void FrameTelemetry::onFlush(uint32_t bytes, uint32_t flushUs)
+{
+  _frameFlushUs += flushUs;
+  _frameBytes += bytes;
+  if (_touchPending)
+  {
+    // a flush long after the press answers something else, not the touch
+    _touchPending = false;
+    uint32_t touchUs = micros() - _touchTime;
+    if (touchUs <= FRAME_TELEMETRY_TOUCH_TIMEOUT_MS * 1000)
+    {
+      addSample(FRAME_METRIC_TOUCH_TO_FLUSH_US, touchUs);
+    }
+  }
+}
+
+void FrameTelemetry::onTouch(bool pressed)
+{
+  // only the press edge counts, holding a finger down is not a new interaction
+  if (pressed && !_touchPressed)
+  {
+    _touchPending = true;
+    _touchTime = micros();
+  }
+  _touchPressed = pressed;
+}
+
+void FrameTelemetry::onFlowTick(uint32_t tickUs)
+{
+  addSample(FRAME_METRIC_FLOW_TICK_US, tickUs);
+}
+
+bool FrameTelemetry::getPercentiles(FrameMetric metric, FramePercentiles &percentiles)
+{
+  const Window &window = _windows[metric];
+  percentiles.samples = window.count;
+  if (window.count == 0)
+  {
+    percentiles.p50 = percentiles.p95 = percentiles.p99 = percentiles.max = 0;
+    return false;
+  }
+  uint32_t sorted[FRAME_TELEMETRY_WINDOW];
+  memcpy(sorted, window.samples, window.count * sizeof(uint32_t));
+  std::sort(sorted, sorted + window.count);
+  // nearest rank
+  percentiles.p50 = sorted[(window.count * 50 + 99) / 100 - 1];
+  percentiles.p95 = sorted[(window.count * 95 + 99) / 100 - 1];
+  percentiles.p99 = sorted[(window.count * 99 + 99) / 100 - 1];
+  percentiles.max = sorted[window.count - 1];
+  return true;
+}
+
+void FrameTelemetry::printStats(Print &out)
+{
+  out.printf("frames %u, last %u frames / %u touches / %u ticks\n", _frameCount, _windows[FRAME_METRIC_RENDER_US].count,
+             _windows[FRAME_METRIC_TOUCH_TO_FLUSH_US].count, _windows[FRAME_METRIC_FLOW_TICK_US].count);
+  out.println("metric                p50       p95       p99       max");
+  for (int i = 0; i < FRAME_METRIC_COUNT; i++)
+  {
+    FramePercentiles percentiles;
+    if (getPercentiles((FrameMetric)i, percentiles))
+    {
+      out.printf("%-16s %8u  %8u  %8u  %8u\n", g_metricNames[i], percentiles.p50, percentiles.p95, percentiles.p99, percentiles.max);
+    }
+  }
+}
+
+void FrameTelemetry::setOverlay(bool enabled)
+{
+  _overlayEnabled = enabled;
+  if (enabled && !_overlay)
+  {
+    _overlay = lv_label_create(lv_layer_sys());
+    lv_obj_set_style_bg_color(_overlay, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(_overlay, LV_OPA_60, 0);
+    lv_obj_set_style_text_color(_overlay, lv_color_white(), 0);
+    lv_obj_set_style_pad_all(_overlay, 4, 0);
+    lv_obj_align(_overlay, LV_ALIGN_TOP_RIGHT, -4, 4);
+    lv_label_set_text(_overlay, "");
+    _lastOverlayUpdate = millis();
+    _overlayFrameCount = _frameCount;
+  }
+  if (_overlay)
+  {
+    if (enabled)
+    {
+      lv_obj_clear_flag(_overlay, LV_OBJ_FLAG_HIDDEN);
+    }
+    else
+    {
+      lv_obj_add_flag(_overlay, LV_OBJ_FLAG_HIDDEN);
+    }
+  }
+}
+
+void FrameTelemetry::setDumpInterval(uint32_t intervalMs, Print &out)
+{
+  _dumpOut = &out;
+  _dumpInterval = intervalMs;
+  _lastDump = millis();
+}
+
+void FrameTelemetry::updateOverlay()
+{
+  uint32_t now = millis();
+  uint32_t elapsed = now - _lastOverlayUpdate;
+  uint32_t fps = elapsed ? (_frameCount - _overlayFrameCount) * 1000 / elapsed : 0;
+  _lastOverlayUpdate = now;
+  _overlayFrameCount = _frameCount;
+
+  FramePercentiles render, flush, touch;
+  getPercentiles(FRAME_METRIC_RENDER_US, render);
+  getPercentiles(FRAME_METRIC_FLUSH_US, flush);
+  getPercentiles(FRAME_METRIC_TOUCH_TO_FLUSH_US, touch);
+
+  // the overlay redraws itself, so it shows up as one small dirty area in the stats
+  char text[96];
+  snprintf(text, sizeof(text), "%u fps\nrender %u/%u ms\nflush %u/%u ms\ntouch %u/%u ms", fps,
+           render.p50 / 1000, render.p95 / 1000, flush.p50 / 1000, flush.p95 / 1000, touch.p50 / 1000, touch.p95 / 1000);
+  lv_label_set_text(_overlay, text);
+}
+
+void FrameTelemetry::tick()
+{
+  uint32_t now = millis();
+  if (_overlayEnabled && now - _lastOverlayUpdate >= FRAME_TELEMETRY_OVERLAY_MS)
+  {
+    updateOverlay();
+  }
+  if (_dumpOut && _dumpInterval && now - _lastDump >= _dumpInterval)
+  {
+    _lastDump = now;
+    printStats(*_dumpOut);
+  }
+}
@@ -0,0 +1,122 @@
+#include <Arduino.h>
+#include <lvgl.h>
+
+#ifndef _FRAME_TELEMETRY_H
+#define _FRAME_TELEMETRY_H
+
+// Per frame timing of the display pipeline.  A frame is one LVGL refresh that drew
+// something: it starts at render_start_cb and ends at monitor_cb, and in between the
+// flush callback reports every pushImageDMA.  For each frame we keep
+//
+//   render us         refresh time minus the time spent pushing pixels
+//   flush us          time spent in pushImageDMA
+//   flush bytes       bytes pushed to the panel
+//   dirty areas       invalidated areas left after LVGL joined them
+//   dirty pixels      pixels redrawn
+//   touch to flush    press on the panel to the end of the next flush, if that comes
+//                     within FRAME_TELEMETRY_TOUCH_TIMEOUT_MS; presses that redraw
+//                     nothing don't count
+//
+// plus the flow tick time of every loop().  The last FRAME_TELEMETRY_WINDOW samples of
+// each metric are kept for p50/p95/p99.
+//
+//   frameTelemetry.attach(&disp_drv);            // before lv_disp_drv_register()
+//   frameTelemetry.setOverlay(true);             // small label in the top right corner
+//   frameTelemetry.setDumpInterval(5000, Serial);
+//
+// and call frameTelemetry.tick() from loop().  Everything runs on the loop task.
+
+#ifndef FRAME_TELEMETRY_WINDOW
+#define FRAME_TELEMETRY_WINDOW 128
+#endif
+
+#ifndef FRAME_TELEMETRY_OVERLAY_MS
+#define FRAME_TELEMETRY_OVERLAY_MS 500
+#endif
+
+#ifndef FRAME_TELEMETRY_TOUCH_TIMEOUT_MS
+#define FRAME_TELEMETRY_TOUCH_TIMEOUT_MS 500
+#endif
+
+enum FrameMetric
+{
+  FRAME_METRIC_RENDER_US,
+  FRAME_METRIC_FLUSH_US,
+  FRAME_METRIC_FLUSH_BYTES,
+  FRAME_METRIC_DIRTY_AREAS,
+  FRAME_METRIC_DIRTY_PIXELS,
+  FRAME_METRIC_TOUCH_TO_FLUSH_US,
+  FRAME_METRIC_FLOW_TICK_US,
+  FRAME_METRIC_COUNT
+};
+
+struct FramePercentiles
+{
+  uint32_t samples;
+  uint32_t p50;
+  uint32_t p95;
+  uint32_t p99;
+  uint32_t max;
+};
+
+class FrameTelemetry
+{
+public:
+  FrameTelemetry();
+
+  void attach(lv_disp_drv_t *drv);
+
+  // Called from the flush and touch callbacks and from loop().
+  void onFlush(uint32_t bytes, uint32_t flushUs);
+  void onTouch(bool pressed);
+  void onFlowTick(uint32_t tickUs);
+
+  void setOverlay(bool enabled);
+  void setDumpInterval(uint32_t intervalMs, Print &out);
+  void tick();
+
+  uint32_t getFrameCount() const { return _frameCount; }
+  bool getPercentiles(FrameMetric metric, FramePercentiles &percentiles);
+  void printStats(Print &out);
+  void reset();
+
+private:
+  struct Window
+  {
+    uint32_t samples[FRAME_TELEMETRY_WINDOW];
+    uint16_t head;
+    uint16_t count;
+  };
+
+  static void renderStart(lv_disp_drv_t *drv);
+  static void monitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+
+  void addSample(FrameMetric metric, uint32_t value);
+  void updateOverlay();
+
+  Window _windows[FRAME_METRIC_COUNT];
+
+  bool _inFrame;
+  uint32_t _frameStart;
+  uint32_t _frameFlushUs;
+  uint32_t _frameBytes;
+  uint32_t _frameAreas;
+  uint32_t _frameCount;
+
+  bool _touchPressed;
+  bool _touchPending;
+  uint32_t _touchTime;
+
+  lv_obj_t *_overlay;
+  bool _overlayEnabled;
+  uint32_t _lastOverlayUpdate;
+  uint32_t _overlayFrameCount;
+
+  Print *_dumpOut;
+  uint32_t _dumpInterval;
+  uint32_t _lastDump;
+};
+
+extern FrameTelemetry frameTelemetry;
+
+#endif
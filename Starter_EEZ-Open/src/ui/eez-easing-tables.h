@@ -0,0 +1,847 @@
+// Generated by tools/gen_easing_tables.py, do not edit.
+// Easing curves sampled over [0, 1] in Q14, see eez::ease() in eez-flow.cpp.
+#pragma once
+#include <stdint.h>
+
+#define EEZ_EASING_TABLE_ONE 16384
+
+static const int16_t g_easeInQuadTable[257] = {
+    0, 0, 1, 2, 4, 6, 9, 12, 16, 20, 25, 30, 36, 42, 49, 56,
+    64, 72, 81, 90, 100, 110, 121, 132, 144, 156, 169, 182, 196, 210, 225, 240,
+    256, 272, 289, 306, 324, 342, 361, 380, 400, 420, 441, 462, 484, 506, 529, 552,
+    576, 600, 625, 650, 676, 702, 729, 756, 784, 812, 841, 870, 900, 930, 961, 992,
+    1024, 1056, 1089, 1122, 1156, 1190, 1225, 1260, 1296, 1332, 1369, 1406, 1444, 1482, 1521, 1560,
+    1600, 1640, 1681, 1722, 1764, 1806, 1849, 1892, 1936, 1980, 2025, 2070, 2116, 2162, 2209, 2256,
+    2304, 2352, 2401, 2450, 2500, 2550, 2601, 2652, 2704, 2756, 2809, 2862, 2916, 2970, 3025, 3080,
+    3136, 3192, 3249, 3306, 3364, 3422, 3481, 3540, 3600, 3660, 3721, 3782, 3844, 3906, 3969, 4032,
+    4096, 4160, 4225, 4290, 4356, 4422, 4489, 4556, 4624, 4692, 4761, 4830, 4900, 4970, 5041, 5112,
+    5184, 5256, 5329, 5402, 5476, 5550, 5625, 5700, 5776, 5852, 5929, 6006, 6084, 6162, 6241, 6320,
+    6400, 6480, 6561, 6642, 6724, 6806, 6889, 6972, 7056, 7140, 7225, 7310, 7396, 7482, 7569, 7656,
+    7744, 7832, 7921, 8010, 8100, 8190, 8281, 8372, 8464, 8556, 8649, 8742, 8836, 8930, 9025, 9120,
+    9216, 9312, 9409, 9506, 9604, 9702, 9801, 9900, 10000, 10100, 10201, 10302, 10404, 10506, 10609, 10712,
+    10816, 10920, 11025, 11130, 11236, 11342, 11449, 11556, 11664, 11772, 11881, 11990, 12100, 12210, 12321, 12432,
+    12544, 12656, 12769, 12882, 12996, 13110, 13225, 13340, 13456, 13572, 13689, 13806, 13924, 14042, 14161, 14280,
+    14400, 14520, 14641, 14762, 14884, 15006, 15129, 15252, 15376, 15500, 15625, 15750, 15876, 16002, 16129, 16256,
+    16384,
+};
+static const int16_t g_easeOutQuadTable[257] = {
+    0, 128, 255, 382, 508, 634, 759, 884, 1008, 1132, 1255, 1378, 1500, 1622, 1743, 1864,
+    1984, 2104, 2223, 2342, 2460, 2578, 2695, 2812, 2928, 3044, 3159, 3274, 3388, 3502, 3615, 3728,
+    3840, 3952, 4063, 4174, 4284, 4394, 4503, 4612, 4720, 4828, 4935, 5042, 5148, 5254, 5359, 5464,
+    5568, 5672, 5775, 5878, 5980, 6082, 6183, 6284, 6384, 6484, 6583, 6682, 6780, 6878, 6975, 7072,
+    7168, 7264, 7359, 7454, 7548, 7642, 7735, 7828, 7920, 8012, 8103, 8194, 8284, 8374, 8463, 8552,
+    8640, 8728, 8815, 8902, 8988, 9074, 9159, 9244, 9328, 9412, 9495, 9578, 9660, 9742, 9823, 9904,
+    9984, 10064, 10143, 10222, 10300, 10378, 10455, 10532, 10608, 10684, 10759, 10834, 10908, 10982, 11055, 11128,
+    11200, 11272, 11343, 11414, 11484, 11554, 11623, 11692, 11760, 11828, 11895, 11962, 12028, 12094, 12159, 12224,
+    12288, 12352, 12415, 12478, 12540, 12602, 12663, 12724, 12784, 12844, 12903, 12962, 13020, 13078, 13135, 13192,
+    13248, 13304, 13359, 13414, 13468, 13522, 13575, 13628, 13680, 13732, 13783, 13834, 13884, 13934, 13983, 14032,
+    14080, 14128, 14175, 14222, 14268, 14314, 14359, 14404, 14448, 14492, 14535, 14578, 14620, 14662, 14703, 14744,
+    14784, 14824, 14863, 14902, 14940, 14978, 15015, 15052, 15088, 15124, 15159, 15194, 15228, 15262, 15295, 15328,
+    15360, 15392, 15423, 15454, 15484, 15514, 15543, 15572, 15600, 15628, 15655, 15682, 15708, 15734, 15759, 15784,
+    15808, 15832, 15855, 15878, 15900, 15922, 15943, 15964, 15984, 16004, 16023, 16042, 16060, 16078, 16095, 16112,
+    16128, 16144, 16159, 16174, 16188, 16202, 16215, 16228, 16240, 16252, 16263, 16274, 16284, 16294, 16303, 16312,
+    16320, 16328, 16335, 16342, 16348, 16354, 16359, 16364, 16368, 16372, 16375, 16378, 16380, 16382, 16383, 16384,
+    16384,
+};
+static const int16_t g_easeInOutQuadTable[257] = {
+    0, 0, 2, 4, 8, 12, 18, 24, 32, 40, 50, 60, 72, 84, 98, 112,
+    128, 144, 162, 180, 200, 220, 242, 264, 288, 312, 338, 364, 392, 420, 450, 480,
+    512, 544, 578, 612, 648, 684, 722, 760, 800, 840, 882, 924, 968, 1012, 1058, 1104,
+    1152, 1200, 1250, 1300, 1352, 1404, 1458, 1512, 1568, 1624, 1682, 1740, 1800, 1860, 1922, 1984,
+    2048, 2112, 2178, 2244, 2312, 2380, 2450, 2520, 2592, 2664, 2738, 2812, 2888, 2964, 3042, 3120,
+    3200, 3280, 3362, 3444, 3528, 3612, 3698, 3784, 3872, 3960, 4050, 4140, 4232, 4324, 4418, 4512,
+    4608, 4704, 4802, 4900, 5000, 5100, 5202, 5304, 5408, 5512, 5618, 5724, 5832, 5940, 6050, 6160,
+    6272, 6384, 6498, 6612, 6728, 6844, 6962, 7080, 7200, 7320, 7442, 7564, 7688, 7812, 7938, 8064,
+    8192, 8320, 8446, 8572, 8696, 8820, 8942, 9064, 9184, 9304, 9422, 9540, 9656, 9772, 9886, 10000,
+    10112, 10224, 10334, 10444, 10552, 10660, 10766, 10872, 10976, 11080, 11182, 11284, 11384, 11484, 11582, 11680,
+    11776, 11872, 11966, 12060, 12152, 12244, 12334, 12424, 12512, 12600, 12686, 12772, 12856, 12940, 13022, 13104,
+    13184, 13264, 13342, 13420, 13496, 13572, 13646, 13720, 13792, 13864, 13934, 14004, 14072, 14140, 14206, 14272,
+    14336, 14400, 14462, 14524, 14584, 14644, 14702, 14760, 14816, 14872, 14926, 14980, 15032, 15084, 15134, 15184,
+    15232, 15280, 15326, 15372, 15416, 15460, 15502, 15544, 15584, 15624, 15662, 15700, 15736, 15772, 15806, 15840,
+    15872, 15904, 15934, 15964, 15992, 16020, 16046, 16072, 16096, 16120, 16142, 16164, 16184, 16204, 16222, 16240,
+    16256, 16272, 16286, 16300, 16312, 16324, 16334, 16344, 16352, 16360, 16366, 16372, 16376, 16380, 16382, 16384,
+    16384,
+};
+static const int16_t g_easeInCubicTable[257] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 3,
+    4, 5, 6, 7, 8, 9, 10, 12, 14, 15, 17, 19, 21, 24, 26, 29,
+    32, 35, 38, 42, 46, 49, 54, 58, 62, 67, 72, 78, 83, 89, 95, 101,
+    108, 115, 122, 130, 137, 145, 154, 162, 172, 181, 191, 201, 211, 222, 233, 244,
+    256, 268, 281, 294, 307, 321, 335, 350, 364, 380, 396, 412, 429, 446, 463, 481,
+    500, 519, 538, 558, 579, 600, 621, 643, 666, 688, 712, 736, 760, 786, 811, 837,
+    864, 891, 919, 948, 977, 1006, 1036, 1067, 1098, 1130, 1163, 1196, 1230, 1265, 1300, 1336,
+    1372, 1409, 1447, 1485, 1524, 1564, 1605, 1646, 1688, 1730, 1773, 1817, 1862, 1907, 1953, 2000,
+    2048, 2096, 2146, 2195, 2246, 2297, 2350, 2403, 2456, 2511, 2566, 2623, 2680, 2738, 2796, 2856,
+    2916, 2977, 3039, 3102, 3166, 3230, 3296, 3362, 3430, 3498, 3567, 3637, 3707, 3779, 3852, 3925,
+    4000, 4075, 4152, 4229, 4308, 4387, 4467, 4548, 4630, 4714, 4798, 4883, 4969, 5056, 5145, 5234,
+    5324, 5415, 5508, 5601, 5695, 5791, 5887, 5985, 6084, 6183, 6284, 6386, 6489, 6593, 6698, 6805,
+    6912, 7021, 7130, 7241, 7353, 7466, 7580, 7696, 7812, 7930, 8049, 8169, 8291, 8413, 8537, 8662,
+    8788, 8915, 9044, 9174, 9305, 9437, 9571, 9705, 9842, 9979, 10117, 10257, 10398, 10541, 10685, 10830,
+    10976, 11124, 11273, 11423, 11575, 11728, 11882, 12037, 12194, 12353, 12513, 12674, 12836, 13000, 13165, 13332,
+    13500, 13669, 13840, 14013, 14186, 14361, 14538, 14716, 14896, 15076, 15259, 15443, 15628, 15815, 16003, 16193,
+    16384,
+};
+static const int16_t g_easeOutCubicTable[257] = {
+    0, 191, 381, 569, 756, 941, 1125, 1308, 1488, 1668, 1846, 2023, 2198, 2371, 2544, 2715,
+    2884, 3052, 3219, 3384, 3548, 3710, 3871, 4031, 4190, 4347, 4502, 4656, 4809, 4961, 5111, 5260,
+    5408, 5554, 5699, 5843, 5986, 6127, 6267, 6405, 6542, 6679, 6813, 6947, 7079, 7210, 7340, 7469,
+    7596, 7722, 7847, 7971, 8093, 8215, 8335, 8454, 8572, 8688, 8804, 8918, 9031, 9143, 9254, 9363,
+    9472, 9579, 9686, 9791, 9895, 9998, 10100, 10201, 10300, 10399, 10497, 10593, 10689, 10783, 10876, 10969,
+    11060, 11150, 11239, 11328, 11415, 11501, 11586, 11670, 11754, 11836, 11917, 11997, 12076, 12155, 12232, 12309,
+    12384, 12459, 12532, 12605, 12677, 12747, 12817, 12886, 12954, 13022, 13088, 13154, 13218, 13282, 13345, 13407,
+    13468, 13528, 13588, 13646, 13704, 13761, 13818, 13873, 13928, 13981, 14034, 14087, 14138, 14189, 14238, 14288,
+    14336, 14384, 14431, 14477, 14522, 14567, 14611, 14654, 14696, 14738, 14779, 14820, 14860, 14899, 14937, 14975,
+    15012, 15048, 15084, 15119, 15154, 15188, 15221, 15254, 15286, 15317, 15348, 15378, 15407, 15436, 15465, 15493,
+    15520, 15547, 15573, 15598, 15624, 15648, 15672, 15696, 15718, 15741, 15763, 15784, 15805, 15826, 15846, 15865,
+    15884, 15903, 15921, 15938, 15955, 15972, 15988, 16004, 16020, 16034, 16049, 16063, 16077, 16090, 16103, 16116,
+    16128, 16140, 16151, 16162, 16173, 16183, 16193, 16203, 16212, 16222, 16230, 16239, 16247, 16254, 16262, 16269,
+    16276, 16283, 16289, 16295, 16301, 16306, 16312, 16317, 16322, 16326, 16330, 16335, 16338, 16342, 16346, 16349,
+    16352, 16355, 16358, 16360, 16363, 16365, 16367, 16369, 16370, 16372, 16374, 16375, 16376, 16377, 16378, 16379,
+    16380, 16381, 16381, 16382, 16382, 16383, 16383, 16383, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeInOutCubicTable[257] = {
+    0, 0, 0, 0, 0, 0, 1, 1, 2, 3, 4, 5, 7, 9, 11, 13,
+    16, 19, 23, 27, 31, 36, 42, 48, 54, 61, 69, 77, 86, 95, 105, 116,
+    128, 140, 154, 167, 182, 198, 214, 232, 250, 269, 289, 311, 333, 356, 380, 406,
+    432, 460, 488, 518, 549, 582, 615, 650, 686, 723, 762, 802, 844, 887, 931, 977,
+    1024, 1073, 1123, 1175, 1228, 1283, 1340, 1398, 1458, 1520, 1583, 1648, 1715, 1783, 1854, 1926,
+    2000, 2076, 2154, 2234, 2315, 2399, 2485, 2572, 2662, 2754, 2848, 2944, 3042, 3142, 3244, 3349,
+    3456, 3565, 3677, 3790, 3906, 4025, 4145, 4268, 4394, 4522, 4652, 4785, 4921, 5059, 5199, 5342,
+    5488, 5636, 5787, 5941, 6097, 6256, 6418, 6583, 6750, 6920, 7093, 7269, 7448, 7629, 7814, 8001,
+    8192, 8383, 8570, 8755, 8936, 9115, 9291, 9464, 9634, 9801, 9966, 10128, 10287, 10443, 10597, 10748,
+    10896, 11042, 11185, 11325, 11463, 11599, 11732, 11862, 11990, 12116, 12239, 12359, 12478, 12594, 12707, 12819,
+    12928, 13035, 13140, 13242, 13342, 13440, 13536, 13630, 13722, 13812, 13899, 13985, 14069, 14150, 14230, 14308,
+    14384, 14458, 14530, 14601, 14669, 14736, 14801, 14864, 14926, 14986, 15044, 15101, 15156, 15209, 15261, 15311,
+    15360, 15407, 15453, 15497, 15540, 15582, 15622, 15661, 15698, 15734, 15769, 15802, 15835, 15866, 15896, 15924,
+    15952, 15978, 16004, 16028, 16051, 16073, 16095, 16115, 16134, 16152, 16170, 16186, 16202, 16217, 16230, 16244,
+    16256, 16268, 16279, 16289, 16298, 16307, 16315, 16323, 16330, 16336, 16342, 16348, 16353, 16357, 16361, 16365,
+    16368, 16371, 16373, 16375, 16377, 16379, 16380, 16381, 16382, 16383, 16383, 16384, 16384, 16384, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeInQuartTable[257] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 3, 3, 4,
+    4, 5, 5, 6, 6, 7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19,
+    20, 22, 24, 26, 28, 30, 32, 35, 38, 40, 43, 46, 49, 53, 56, 60,
+    64, 68, 72, 77, 82, 86, 92, 97, 103, 108, 114, 121, 127, 134, 141, 149,
+    156, 164, 172, 181, 190, 199, 209, 219, 229, 239, 250, 262, 273, 285, 298, 311,
+    324, 338, 352, 366, 381, 397, 413, 429, 446, 464, 482, 500, 519, 538, 559, 579,
+    600, 622, 644, 667, 691, 715, 740, 765, 791, 818, 845, 873, 902, 931, 961, 992,
+    1024, 1056, 1090, 1123, 1158, 1194, 1230, 1267, 1305, 1344, 1383, 1424, 1465, 1508, 1551, 1595,
+    1640, 1686, 1733, 1781, 1830, 1880, 1931, 1983, 2036, 2090, 2146, 2202, 2259, 2318, 2377, 2438,
+    2500, 2563, 2627, 2693, 2760, 2827, 2897, 2967, 3039, 3112, 3186, 3262, 3339, 3417, 3497, 3578,
+    3660, 3744, 3829, 3916, 4005, 4094, 4185, 4278, 4373, 4468, 4566, 4665, 4765, 4868, 4971, 5077,
+    5184, 5293, 5403, 5516, 5630, 5745, 5863, 5982, 6104, 6227, 6351, 6478, 6607, 6737, 6870, 7004,
+    7140, 7279, 7419, 7561, 7706, 7852, 8000, 8151, 8304, 8459, 8616, 8775, 8936, 9100, 9266, 9434,
+    9604, 9777, 9952, 10129, 10309, 10491, 10675, 10862, 11051, 11243, 11437, 11634, 11833, 12035, 12240, 12447,
+    12656, 12869, 13083, 13301, 13521, 13744, 13970, 14199, 14430, 14664, 14901, 15141, 15384, 15629, 15878, 16129,
+    16384,
+};
+static const int16_t g_easeOutQuartTable[257] = {
+    0, 255, 506, 755, 1000, 1243, 1483, 1720, 1954, 2185, 2414, 2640, 2863, 3083, 3301, 3515,
+    3728, 3937, 4144, 4349, 4551, 4750, 4947, 5141, 5333, 5522, 5709, 5893, 6075, 6255, 6432, 6607,
+    6780, 6950, 7118, 7284, 7448, 7609, 7768, 7925, 8080, 8233, 8384, 8532, 8678, 8823, 8965, 9105,
+    9244, 9380, 9514, 9647, 9777, 9906, 10033, 10157, 10280, 10402, 10521, 10639, 10754, 10868, 10981, 11091,
+    11200, 11307, 11413, 11516, 11619, 11719, 11818, 11916, 12011, 12106, 12199, 12290, 12379, 12468, 12555, 12640,
+    12724, 12806, 12887, 12967, 13045, 13122, 13198, 13272, 13345, 13417, 13487, 13557, 13624, 13691, 13757, 13821,
+    13884, 13946, 14007, 14066, 14125, 14182, 14238, 14294, 14348, 14401, 14453, 14504, 14554, 14603, 14651, 14698,
+    14744, 14789, 14833, 14876, 14919, 14960, 15001, 15040, 15079, 15117, 15154, 15190, 15226, 15261, 15294, 15328,
+    15360, 15392, 15423, 15453, 15482, 15511, 15539, 15566, 15593, 15619, 15644, 15669, 15693, 15717, 15740, 15762,
+    15784, 15805, 15825, 15846, 15865, 15884, 15902, 15920, 15938, 15955, 15971, 15987, 16003, 16018, 16032, 16046,
+    16060, 16073, 16086, 16099, 16111, 16122, 16134, 16145, 16155, 16165, 16175, 16185, 16194, 16203, 16212, 16220,
+    16228, 16235, 16243, 16250, 16257, 16263, 16270, 16276, 16281, 16287, 16292, 16298, 16302, 16307, 16312, 16316,
+    16320, 16324, 16328, 16331, 16335, 16338, 16341, 16344, 16346, 16349, 16352, 16354, 16356, 16358, 16360, 16362,
+    16364, 16365, 16367, 16368, 16370, 16371, 16372, 16373, 16374, 16375, 16376, 16377, 16378, 16378, 16379, 16379,
+    16380, 16380, 16381, 16381, 16382, 16382, 16382, 16383, 16383, 16383, 16383, 16383, 16383, 16384, 16384, 16384,
+    16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeInOutQuartTable[257] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 2,
+    2, 3, 3, 4, 5, 6, 7, 9, 10, 12, 14, 16, 19, 22, 25, 28,
+    32, 36, 41, 46, 51, 57, 64, 71, 78, 86, 95, 104, 114, 125, 137, 149,
+    162, 176, 191, 206, 223, 241, 259, 279, 300, 322, 345, 370, 396, 423, 451, 481,
+    512, 545, 579, 615, 653, 692, 733, 776, 820, 867, 915, 966, 1018, 1073, 1130, 1189,
+    1250, 1314, 1380, 1448, 1519, 1593, 1669, 1748, 1830, 1915, 2002, 2093, 2186, 2283, 2383, 2486,
+    2592, 2702, 2815, 2932, 3052, 3176, 3303, 3435, 3570, 3709, 3853, 4000, 4152, 4308, 4468, 4633,
+    4802, 4976, 5154, 5338, 5526, 5719, 5917, 6120, 6328, 6542, 6761, 6985, 7215, 7451, 7692, 7939,
+    8192, 8445, 8692, 8933, 9169, 9399, 9623, 9842, 10056, 10264, 10467, 10665, 10858, 11046, 11230, 11408,
+    11582, 11751, 11916, 12076, 12232, 12384, 12531, 12675, 12814, 12949, 13081, 13208, 13332, 13452, 13569, 13682,
+    13792, 13898, 14001, 14101, 14198, 14291, 14382, 14469, 14554, 14636, 14715, 14791, 14865, 14936, 15004, 15070,
+    15134, 15195, 15254, 15311, 15366, 15418, 15469, 15517, 15564, 15608, 15651, 15692, 15731, 15769, 15805, 15839,
+    15872, 15903, 15933, 15961, 15988, 16014, 16039, 16062, 16084, 16105, 16125, 16143, 16161, 16178, 16193, 16208,
+    16222, 16235, 16247, 16259, 16270, 16280, 16289, 16298, 16306, 16313, 16320, 16327, 16333, 16338, 16343, 16348,
+    16352, 16356, 16359, 16362, 16365, 16368, 16370, 16372, 16374, 16375, 16377, 16378, 16379, 16380, 16381, 16381,
+    16382, 16382, 16383, 16383, 16383, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeInQuintTable[257] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3,
+    4, 4, 5, 5, 6, 6, 7, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 19, 20, 22, 23, 25, 27, 29, 31, 33, 35, 38, 40, 43, 46,
+    49, 52, 55, 59, 62, 66, 70, 74, 79, 83, 88, 93, 98, 104, 109, 115,
+    122, 128, 135, 142, 149, 157, 165, 173, 181, 190, 199, 209, 219, 229, 240, 251,
+    263, 275, 287, 300, 313, 327, 341, 356, 371, 386, 403, 420, 437, 455, 473, 492,
+    512, 532, 553, 575, 597, 620, 644, 668, 693, 719, 746, 773, 801, 830, 860, 891,
+    923, 955, 989, 1023, 1058, 1094, 1132, 1170, 1209, 1249, 1291, 1333, 1377, 1421, 1467, 1514,
+    1562, 1612, 1663, 1715, 1768, 1822, 1878, 1936, 1994, 2054, 2116, 2179, 2243, 2309, 2377, 2446,
+    2516, 2589, 2663, 2738, 2816, 2895, 2976, 3058, 3143, 3229, 3317, 3407, 3500, 3594, 3690, 3788,
+    3888, 3990, 4095, 4201, 4310, 4421, 4535, 4650, 4768, 4889, 5012, 5137, 5265, 5395, 5528, 5663,
+    5801, 5942, 6086, 6232, 6381, 6533, 6688, 6846, 7006, 7170, 7337, 7507, 7680, 7856, 8035, 8218,
+    8404, 8593, 8785, 8982, 9181, 9384, 9591, 9801, 10015, 10233, 10454, 10680, 10909, 11142, 11379, 11620,
+    11865, 12114, 12368, 12626, 12888, 13154, 13424, 13700, 13979, 14263, 14552, 14845, 15143, 15446, 15754, 16066,
+    16384,
+};
+static const int16_t g_easeOutQuintTable[257] = {
+    0, 318, 630, 938, 1241, 1539, 1832, 2121, 2405, 2684, 2960, 3230, 3496, 3758, 4016, 4270,
+    4519, 4764, 5005, 5242, 5475, 5704, 5930, 6151, 6369, 6583, 6793, 7000, 7203, 7402, 7599, 7791,
+    7980, 8166, 8349, 8528, 8704, 8877, 9047, 9214, 9378, 9538, 9696, 9851, 10003, 10152, 10298, 10442,
+    10583, 10721, 10856, 10989, 11119, 11247, 11372, 11495, 11616, 11734, 11849, 11963, 12074, 12183, 12289, 12394,
+    12496, 12596, 12694, 12790, 12884, 12977, 13067, 13155, 13241, 13326, 13408, 13489, 13568, 13646, 13721, 13795,
+    13868, 13938, 14007, 14075, 14141, 14205, 14268, 14330, 14390, 14448, 14506, 14562, 14616, 14669, 14721, 14772,
+    14822, 14870, 14917, 14963, 15007, 15051, 15093, 15135, 15175, 15214, 15252, 15290, 15326, 15361, 15395, 15429,
+    15461, 15493, 15524, 15554, 15583, 15611, 15638, 15665, 15691, 15716, 15740, 15764, 15787, 15809, 15831, 15852,
+    15872, 15892, 15911, 15929, 15947, 15964, 15981, 15998, 16013, 16028, 16043, 16057, 16071, 16084, 16097, 16109,
+    16121, 16133, 16144, 16155, 16165, 16175, 16185, 16194, 16203, 16211, 16219, 16227, 16235, 16242, 16249, 16256,
+    16262, 16269, 16275, 16280, 16286, 16291, 16296, 16301, 16305, 16310, 16314, 16318, 16322, 16325, 16329, 16332,
+    16335, 16338, 16341, 16344, 16346, 16349, 16351, 16353, 16355, 16357, 16359, 16361, 16362, 16364, 16365, 16367,
+    16368, 16369, 16370, 16371, 16372, 16373, 16374, 16375, 16376, 16377, 16377, 16378, 16378, 16379, 16379, 16380,
+    16380, 16381, 16381, 16381, 16382, 16382, 16382, 16382, 16382, 16383, 16383, 16383, 16383, 16383, 16383, 16383,
+    16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384,
+    16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeInOutQuintTable[257] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 3, 4, 5, 6, 7,
+    8, 9, 11, 13, 14, 17, 19, 22, 24, 28, 31, 35, 39, 44, 49, 55,
+    61, 67, 75, 82, 91, 100, 109, 120, 131, 143, 156, 170, 185, 201, 218, 237,
+    256, 277, 299, 322, 347, 373, 401, 430, 461, 494, 529, 566, 605, 645, 688, 734,
+    781, 831, 884, 939, 997, 1058, 1122, 1188, 1258, 1331, 1408, 1488, 1571, 1659, 1750, 1845,
+    1944, 2047, 2155, 2267, 2384, 2506, 2632, 2764, 2901, 3043, 3191, 3344, 3503, 3668, 3840, 4017,
+    4202, 4393, 4591, 4795, 5008, 5227, 5454, 5690, 5933, 6184, 6444, 6712, 6990, 7276, 7572, 7877,
+    8192, 8507, 8812, 9108, 9394, 9672, 9940, 10200, 10451, 10694, 10930, 11157, 11376, 11589, 11793, 11991,
+    12182, 12367, 12544, 12716, 12881, 13040, 13193, 13341, 13483, 13620, 13752, 13878, 14000, 14117, 14229, 14337,
+    14440, 14539, 14634, 14725, 14813, 14896, 14976, 15053, 15126, 15196, 15262, 15326, 15387, 15445, 15500, 15553,
+    15603, 15650, 15696, 15739, 15779, 15818, 15855, 15890, 15923, 15954, 15983, 16011, 16037, 16062, 16085, 16107,
+    16128, 16147, 16166, 16183, 16199, 16214, 16228, 16241, 16253, 16264, 16275, 16284, 16293, 16302, 16309, 16317,
+    16323, 16329, 16335, 16340, 16345, 16349, 16353, 16356, 16360, 16362, 16365, 16367, 16370, 16371, 16373, 16375,
+    16376, 16377, 16378, 16379, 16380, 16381, 16381, 16382, 16382, 16382, 16383, 16383, 16383, 16383, 16384, 16384,
+    16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeInSineTable[257] = {
+    0, 0, 1, 3, 5, 8, 11, 15, 20, 25, 31, 37, 44, 52, 60, 69,
+    79, 89, 100, 111, 123, 136, 149, 163, 177, 192, 208, 224, 241, 259, 277, 296,
+    315, 335, 355, 376, 398, 420, 443, 467, 491, 516, 541, 567, 593, 621, 648, 677,
+    705, 735, 765, 796, 827, 859, 891, 924, 958, 992, 1027, 1062, 1098, 1134, 1171, 1209,
+    1247, 1286, 1325, 1365, 1406, 1447, 1488, 1530, 1573, 1616, 1660, 1704, 1749, 1795, 1841, 1887,
+    1935, 1982, 2030, 2079, 2128, 2178, 2229, 2280, 2331, 2383, 2435, 2488, 2542, 2596, 2651, 2706,
+    2761, 2817, 2874, 2931, 2989, 3047, 3105, 3165, 3224, 3284, 3345, 3406, 3468, 3530, 3592, 3655,
+    3719, 3783, 3847, 3912, 3978, 4044, 4110, 4177, 4244, 4312, 4380, 4449, 4518, 4587, 4657, 4728,
+    4799, 4870, 4942, 5014, 5087, 5160, 5233, 5307, 5381, 5456, 5531, 5606, 5682, 5759, 5835, 5913,
+    5990, 6068, 6146, 6225, 6304, 6383, 6463, 6543, 6624, 6705, 6786, 6868, 6950, 7032, 7115, 7198,
+    7282, 7365, 7449, 7534, 7619, 7704, 7789, 7875, 7961, 8047, 8134, 8221, 8308, 8396, 8484, 8572,
+    8661, 8749, 8839, 8928, 9018, 9108, 9198, 9288, 9379, 9470, 9561, 9653, 9745, 9837, 9929, 10021,
+    10114, 10207, 10300, 10394, 10487, 10581, 10676, 10770, 10864, 10959, 11054, 11149, 11245, 11340, 11436, 11532,
+    11628, 11724, 11821, 11917, 12014, 12111, 12208, 12306, 12403, 12501, 12598, 12696, 12794, 12892, 12991, 13089,
+    13188, 13286, 13385, 13484, 13583, 13682, 13781, 13881, 13980, 14079, 14179, 14279, 14378, 14478, 14578, 14678,
+    14778, 14878, 14978, 15078, 15179, 15279, 15379, 15480, 15580, 15680, 15781, 15881, 15982, 16082, 16183, 16283,
+    16384,
+};
+static const int16_t g_easeOutSineTable[257] = {
+    0, 101, 201, 302, 402, 503, 603, 704, 804, 904, 1005, 1105, 1205, 1306, 1406, 1506,
+    1606, 1706, 1806, 1906, 2006, 2105, 2205, 2305, 2404, 2503, 2603, 2702, 2801, 2900, 2999, 3098,
+    3196, 3295, 3393, 3492, 3590, 3688, 3786, 3883, 3981, 4078, 4176, 4273, 4370, 4467, 4563, 4660,
+    4756, 4852, 4948, 5044, 5139, 5235, 5330, 5425, 5520, 5614, 5708, 5803, 5897, 5990, 6084, 6177,
+    6270, 6363, 6455, 6547, 6639, 6731, 6823, 6914, 7005, 7096, 7186, 7276, 7366, 7456, 7545, 7635,
+    7723, 7812, 7900, 7988, 8076, 8163, 8250, 8337, 8423, 8509, 8595, 8680, 8765, 8850, 8935, 9019,
+    9102, 9186, 9269, 9352, 9434, 9516, 9598, 9679, 9760, 9841, 9921, 10001, 10080, 10159, 10238, 10316,
+    10394, 10471, 10549, 10625, 10702, 10778, 10853, 10928, 11003, 11077, 11151, 11224, 11297, 11370, 11442, 11514,
+    11585, 11656, 11727, 11797, 11866, 11935, 12004, 12072, 12140, 12207, 12274, 12340, 12406, 12472, 12537, 12601,
+    12665, 12729, 12792, 12854, 12916, 12978, 13039, 13100, 13160, 13219, 13279, 13337, 13395, 13453, 13510, 13567,
+    13623, 13678, 13733, 13788, 13842, 13896, 13949, 14001, 14053, 14104, 14155, 14206, 14256, 14305, 14354, 14402,
+    14449, 14497, 14543, 14589, 14635, 14680, 14724, 14768, 14811, 14854, 14896, 14937, 14978, 15019, 15059, 15098,
+    15137, 15175, 15213, 15250, 15286, 15322, 15357, 15392, 15426, 15460, 15493, 15525, 15557, 15588, 15619, 15649,
+    15679, 15707, 15736, 15763, 15791, 15817, 15843, 15868, 15893, 15917, 15941, 15964, 15986, 16008, 16029, 16049,
+    16069, 16088, 16107, 16125, 16143, 16160, 16176, 16192, 16207, 16221, 16235, 16248, 16261, 16273, 16284, 16295,
+    16305, 16315, 16324, 16332, 16340, 16347, 16353, 16359, 16364, 16369, 16373, 16376, 16379, 16381, 16383, 16384,
+    16384,
+};
+static const int16_t g_easeInOutSineTable[257] = {
+    0, 1, 2, 6, 10, 15, 22, 30, 39, 50, 62, 75, 89, 104, 121, 138,
+    157, 178, 199, 222, 246, 271, 297, 324, 353, 383, 413, 446, 479, 513, 549, 586,
+    624, 663, 703, 744, 787, 830, 875, 920, 967, 1015, 1064, 1114, 1165, 1218, 1271, 1325,
+    1381, 1437, 1494, 1553, 1612, 1673, 1734, 1796, 1859, 1924, 1989, 2055, 2122, 2190, 2259, 2329,
+    2399, 2471, 2543, 2617, 2691, 2765, 2841, 2918, 2995, 3073, 3152, 3232, 3312, 3393, 3475, 3558,
+    3641, 3725, 3809, 3895, 3980, 4067, 4154, 4242, 4330, 4419, 4509, 4599, 4689, 4781, 4872, 4964,
+    5057, 5150, 5244, 5338, 5432, 5527, 5622, 5718, 5814, 5910, 6007, 6104, 6202, 6299, 6397, 6495,
+    6594, 6693, 6791, 6891, 6990, 7090, 7189, 7289, 7389, 7489, 7589, 7690, 7790, 7890, 7991, 8091,
+    8192, 8293, 8393, 8494, 8594, 8694, 8795, 8895, 8995, 9095, 9195, 9294, 9394, 9493, 9593, 9691,
+    9790, 9889, 9987, 10085, 10182, 10280, 10377, 10474, 10570, 10666, 10762, 10857, 10952, 11046, 11140, 11234,
+    11327, 11420, 11512, 11603, 11695, 11785, 11875, 11965, 12054, 12142, 12230, 12317, 12404, 12489, 12575, 12659,
+    12743, 12826, 12909, 12991, 13072, 13152, 13232, 13311, 13389, 13466, 13543, 13619, 13693, 13767, 13841, 13913,
+    13985, 14055, 14125, 14194, 14262, 14329, 14395, 14460, 14525, 14588, 14650, 14711, 14772, 14831, 14890, 14947,
+    15003, 15059, 15113, 15166, 15219, 15270, 15320, 15369, 15417, 15464, 15509, 15554, 15597, 15640, 15681, 15721,
+    15760, 15798, 15835, 15871, 15905, 15938, 15971, 16001, 16031, 16060, 16087, 16113, 16138, 16162, 16185, 16206,
+    16227, 16246, 16263, 16280, 16295, 16309, 16322, 16334, 16345, 16354, 16362, 16369, 16374, 16378, 16382, 16383,
+    16384,
+};
+static const int16_t g_easeInExpoTable[257] = {
+    0, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 22, 22, 23, 23, 24,
+    25, 25, 26, 27, 27, 28, 29, 30, 31, 31, 32, 33, 34, 35, 36, 37,
+    38, 39, 40, 41, 42, 44, 45, 46, 47, 49, 50, 51, 53, 54, 56, 57,
+    59, 60, 62, 64, 65, 67, 69, 71, 73, 75, 77, 79, 81, 83, 86, 88,
+    91, 93, 96, 98, 101, 104, 106, 109, 112, 115, 119, 122, 125, 129, 132, 136,
+    140, 143, 147, 151, 156, 160, 164, 169, 173, 178, 183, 188, 193, 198, 204, 210,
+    215, 221, 227, 233, 240, 246, 253, 260, 267, 275, 282, 290, 298, 306, 314, 323,
+    332, 341, 350, 360, 370, 380, 391, 401, 412, 424, 435, 447, 459, 472, 485, 498,
+    512, 526, 540, 555, 571, 586, 602, 619, 636, 653, 671, 690, 709, 728, 748, 769,
+    790, 811, 834, 856, 880, 904, 929, 954, 981, 1007, 1035, 1064, 1093, 1123, 1154, 1185,
+    1218, 1251, 1286, 1321, 1357, 1394, 1433, 1472, 1512, 1554, 1596, 1640, 1685, 1732, 1779, 1828,
+    1878, 1930, 1983, 2037, 2093, 2150, 2209, 2270, 2332, 2396, 2462, 2530, 2599, 2670, 2744, 2819,
+    2896, 2976, 3057, 3141, 3228, 3316, 3407, 3501, 3597, 3696, 3797, 3901, 4008, 4118, 4231, 4347,
+    4467, 4589, 4715, 4845, 4978, 5114, 5255, 5399, 5547, 5699, 5856, 6016, 6182, 6351, 6526, 6705,
+    6889, 7078, 7272, 7472, 7677, 7887, 8104, 8326, 8555, 8789, 9031, 9279, 9533, 9795, 10064, 10340,
+    10624, 10915, 11215, 11523, 11839, 12164, 12498, 12841, 13193, 13555, 13927, 14310, 14702, 15106, 15520, 15946,
+    16384,
+};
+static const int16_t g_easeOutExpoTable[257] = {
+    0, 438, 864, 1278, 1682, 2074, 2457, 2829, 3191, 3543, 3886, 4220, 4545, 4861, 5169, 5469,
+    5760, 6044, 6320, 6589, 6851, 7105, 7353, 7595, 7829, 8058, 8280, 8497, 8707, 8912, 9112, 9306,
+    9495, 9679, 9858, 10033, 10202, 10368, 10528, 10685, 10837, 10985, 11129, 11270, 11406, 11539, 11669, 11795,
+    11917, 12037, 12153, 12266, 12376, 12483, 12587, 12688, 12787, 12883, 12977, 13068, 13156, 13243, 13327, 13408,
+    13488, 13565, 13640, 13714, 13785, 13854, 13922, 13988, 14052, 14114, 14175, 14234, 14291, 14347, 14401, 14454,
+    14506, 14556, 14605, 14652, 14699, 14744, 14788, 14830, 14872, 14912, 14951, 14990, 15027, 15063, 15098, 15133,
+    15166, 15199, 15230, 15261, 15291, 15320, 15349, 15377, 15403, 15430, 15455, 15480, 15504, 15528, 15550, 15573,
+    15594, 15615, 15636, 15656, 15675, 15694, 15713, 15731, 15748, 15765, 15782, 15798, 15813, 15829, 15844, 15858,
+    15872, 15886, 15899, 15912, 15925, 15937, 15949, 15960, 15972, 15983, 15993, 16004, 16014, 16024, 16034, 16043,
+    16052, 16061, 16070, 16078, 16086, 16094, 16102, 16109, 16117, 16124, 16131, 16138, 16144, 16151, 16157, 16163,
+    16169, 16174, 16180, 16186, 16191, 16196, 16201, 16206, 16211, 16215, 16220, 16224, 16228, 16233, 16237, 16241,
+    16244, 16248, 16252, 16255, 16259, 16262, 16265, 16269, 16272, 16275, 16278, 16280, 16283, 16286, 16288, 16291,
+    16293, 16296, 16298, 16301, 16303, 16305, 16307, 16309, 16311, 16313, 16315, 16317, 16319, 16320, 16322, 16324,
+    16325, 16327, 16328, 16330, 16331, 16333, 16334, 16335, 16337, 16338, 16339, 16340, 16342, 16343, 16344, 16345,
+    16346, 16347, 16348, 16349, 16350, 16351, 16352, 16353, 16353, 16354, 16355, 16356, 16357, 16357, 16358, 16359,
+    16359, 16360, 16361, 16361, 16362, 16362, 16363, 16364, 16364, 16365, 16365, 16366, 16366, 16367, 16367, 16368,
+    16384,
+};
+static const int16_t g_easeInOutExpoTable[257] = {
+    0, 8, 9, 9, 10, 10, 11, 12, 12, 13, 14, 15, 15, 16, 17, 18,
+    19, 20, 21, 22, 24, 25, 26, 28, 29, 31, 33, 35, 36, 38, 41, 43,
+    45, 48, 50, 53, 56, 59, 63, 66, 70, 74, 78, 82, 87, 91, 97, 102,
+    108, 114, 120, 127, 134, 141, 149, 157, 166, 175, 185, 195, 206, 218, 230, 243,
+    256, 270, 285, 301, 318, 336, 354, 374, 395, 417, 440, 464, 490, 518, 546, 577,
+    609, 643, 679, 716, 756, 798, 843, 890, 939, 991, 1046, 1105, 1166, 1231, 1300, 1372,
+    1448, 1529, 1614, 1704, 1798, 1898, 2004, 2116, 2233, 2358, 2489, 2627, 2774, 2928, 3091, 3263,
+    3444, 3636, 3838, 4052, 4277, 4515, 4767, 5032, 5312, 5607, 5919, 6249, 6597, 6964, 7351, 7760,
+    8192, 8624, 9033, 9420, 9787, 10135, 10465, 10777, 11072, 11352, 11617, 11869, 12107, 12332, 12546, 12748,
+    12940, 13121, 13293, 13456, 13610, 13757, 13895, 14026, 14151, 14268, 14380, 14486, 14586, 14680, 14770, 14855,
+    14936, 15012, 15084, 15153, 15218, 15279, 15338, 15393, 15445, 15494, 15541, 15586, 15628, 15668, 15705, 15741,
+    15775, 15807, 15838, 15866, 15894, 15920, 15944, 15967, 15989, 16010, 16030, 16048, 16066, 16083, 16099, 16114,
+    16128, 16141, 16154, 16166, 16178, 16189, 16199, 16209, 16218, 16227, 16235, 16243, 16250, 16257, 16264, 16270,
+    16276, 16282, 16287, 16293, 16297, 16302, 16306, 16310, 16314, 16318, 16321, 16325, 16328, 16331, 16334, 16336,
+    16339, 16341, 16343, 16346, 16348, 16349, 16351, 16353, 16355, 16356, 16358, 16359, 16360, 16362, 16363, 16364,
+    16365, 16366, 16367, 16368, 16369, 16369, 16370, 16371, 16372, 16372, 16373, 16374, 16374, 16375, 16375, 16376,
+    16384,
+};
+static const int16_t g_easeInBackTable[257] = {
+    0, 0, -2, -4, -7, -10, -15, -20, -26, -33, -40, -48, -57, -66, -76, -87,
+    -98, -110, -122, -135, -149, -163, -178, -193, -209, -225, -241, -258, -276, -293, -312, -330,
+    -349, -368, -388, -408, -428, -449, -470, -491, -512, -533, -555, -577, -599, -621, -643, -666,
+    -688, -711, -734, -756, -779, -802, -825, -848, -871, -894, -916, -939, -962, -984, -1006, -1029,
+    -1051, -1073, -1095, -1116, -1137, -1159, -1180, -1200, -1221, -1241, -1260, -1280, -1299, -1318, -1336, -1354,
+    -1372, -1389, -1406, -1422, -1438, -1453, -1468, -1483, -1496, -1510, -1522, -1535, -1546, -1557, -1567, -1577,
+    -1586, -1595, -1602, -1609, -1616, -1621, -1626, -1630, -1633, -1636, -1638, -1638, -1638, -1637, -1636, -1633,
+    -1630, -1625, -1620, -1613, -1606, -1598, -1588, -1578, -1567, -1554, -1541, -1526, -1511, -1494, -1476, -1457,
+    -1437, -1415, -1393, -1369, -1344, -1318, -1290, -1262, -1232, -1200, -1168, -1134, -1098, -1062, -1024, -984,
+    -943, -901, -857, -812, -765, -717, -667, -616, -563, -509, -453, -396, -336, -276, -213, -149,
+    -84, -16, 53, 123, 196, 270, 346, 424, 503, 585, 668, 753, 840, 929, 1019, 1112,
+    1206, 1303, 1401, 1501, 1604, 1708, 1814, 1922, 2033, 2145, 2260, 2376, 2495, 2616, 2739, 2864,
+    2992, 3121, 3253, 3387, 3523, 3661, 3802, 3945, 4090, 4238, 4388, 4540, 4695, 4852, 5011, 5173,
+    5337, 5504, 5673, 5845, 6019, 6195, 6374, 6556, 6740, 6927, 7117, 7309, 7503, 7700, 7900, 8103,
+    8308, 8516, 8726, 8940, 9156, 9375, 9596, 9821, 10048, 10278, 10511, 10747, 10985, 11227, 11471, 11718,
+    11969, 12222, 12478, 12737, 12999, 13264, 13532, 13804, 14078, 14355, 14636, 14919, 15206, 15496, 15789, 16085,
+    16384,
+};
+static const int16_t g_easeOutBackTable[257] = {
+    0, 299, 595, 888, 1178, 1465, 1748, 2029, 2306, 2580, 2852, 3120, 3385, 3647, 3906, 4162,
+    4415, 4666, 4913, 5157, 5399, 5637, 5873, 6106, 6336, 6563, 6788, 7009, 7228, 7444, 7658, 7868,
+    8076, 8281, 8484, 8684, 8881, 9075, 9267, 9457, 9644, 9828, 10010, 10189, 10365, 10539, 10711, 10880,
+    11047, 11211, 11373, 11532, 11689, 11844, 11996, 12146, 12294, 12439, 12582, 12723, 12861, 12997, 13131, 13263,
+    13392, 13520, 13645, 13768, 13889, 14008, 14124, 14239, 14351, 14462, 14570, 14676, 14780, 14883, 14983, 15081,
+    15178, 15272, 15365, 15455, 15544, 15631, 15716, 15799, 15881, 15960, 16038, 16114, 16188, 16261, 16331, 16400,
+    16468, 16533, 16597, 16660, 16720, 16780, 16837, 16893, 16947, 17000, 17051, 17101, 17149, 17196, 17241, 17285,
+    17327, 17368, 17408, 17446, 17482, 17518, 17552, 17584, 17616, 17646, 17674, 17702, 17728, 17753, 17777, 17799,
+    17821, 17841, 17860, 17878, 17895, 17910, 17925, 17938, 17951, 17962, 17972, 17982, 17990, 17997, 18004, 18009,
+    18014, 18017, 18020, 18021, 18022, 18022, 18022, 18020, 18017, 18014, 18010, 18005, 18000, 17993, 17986, 17979,
+    17970, 17961, 17951, 17941, 17930, 17919, 17906, 17894, 17880, 17867, 17852, 17837, 17822, 17806, 17790, 17773,
+    17756, 17738, 17720, 17702, 17683, 17664, 17644, 17625, 17605, 17584, 17564, 17543, 17521, 17500, 17479, 17457,
+    17435, 17413, 17390, 17368, 17346, 17323, 17300, 17278, 17255, 17232, 17209, 17186, 17163, 17140, 17118, 17095,
+    17072, 17050, 17027, 17005, 16983, 16961, 16939, 16917, 16896, 16875, 16854, 16833, 16812, 16792, 16772, 16752,
+    16733, 16714, 16696, 16677, 16660, 16642, 16625, 16609, 16593, 16577, 16562, 16547, 16533, 16519, 16506, 16494,
+    16482, 16471, 16460, 16450, 16441, 16432, 16424, 16417, 16410, 16404, 16399, 16394, 16391, 16388, 16386, 16384,
+    16384,
+};
+static const int16_t g_easeInOutBackTable[257] = {
+    0, -1, -5, -11, -20, -31, -44, -59, -76, -95, -116, -138, -163, -188, -216, -245,
+    -275, -306, -338, -372, -407, -442, -478, -515, -553, -591, -630, -669, -709, -749, -789, -829,
+    -868, -908, -948, -987, -1026, -1065, -1103, -1140, -1177, -1213, -1248, -1283, -1316, -1348, -1379, -1408,
+    -1436, -1463, -1488, -1512, -1534, -1554, -1572, -1588, -1603, -1615, -1625, -1632, -1638, -1640, -1641, -1638,
+    -1633, -1625, -1615, -1601, -1584, -1564, -1541, -1514, -1485, -1451, -1414, -1374, -1330, -1282, -1230, -1174,
+    -1114, -1050, -981, -909, -832, -750, -664, -573, -478, -378, -272, -162, -47, 74, 199, 330,
+    467, 609, 756, 909, 1068, 1233, 1403, 1580, 1763, 1952, 2147, 2348, 2556, 2771, 2992, 3219,
+    3454, 3695, 3943, 4198, 4461, 4730, 5007, 5291, 5582, 5881, 6188, 6502, 6824, 7154, 7492, 7838,
+    8192, 8546, 8892, 9230, 9560, 9882, 10196, 10503, 10802, 11093, 11377, 11654, 11923, 12186, 12441, 12689,
+    12930, 13165, 13392, 13613, 13828, 14036, 14237, 14432, 14621, 14804, 14981, 15151, 15316, 15475, 15628, 15775,
+    15917, 16054, 16185, 16310, 16431, 16546, 16656, 16762, 16862, 16957, 17048, 17134, 17216, 17293, 17365, 17434,
+    17498, 17558, 17614, 17666, 17714, 17758, 17798, 17835, 17869, 17898, 17925, 17948, 17968, 17985, 17999, 18009,
+    18017, 18022, 18025, 18024, 18022, 18016, 18009, 17999, 17987, 17972, 17956, 17938, 17918, 17896, 17872, 17847,
+    17820, 17792, 17763, 17732, 17700, 17667, 17632, 17597, 17561, 17524, 17487, 17449, 17410, 17371, 17332, 17292,
+    17252, 17213, 17173, 17133, 17093, 17053, 17014, 16975, 16937, 16899, 16862, 16826, 16791, 16756, 16722, 16690,
+    16659, 16629, 16600, 16572, 16547, 16522, 16500, 16479, 16460, 16443, 16428, 16415, 16404, 16395, 16389, 16385,
+    16384,
+};
+static const int16_t g_easeInElasticTable[1025] = {
+    0, -8, -8, -7, -7, -7, -7, -6, -6, -6, -5, -5, -5, -4, -4, -4,
+    -3, -3, -3, -2, -2, -2, -1, -1, -1, 0, 0, 1, 1, 1, 2, 2,
+    3, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 7, 8, 8, 9, 9,
+    10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15, 16, 16, 16, 17,
+    17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22, 23, 23, 23, 24, 24,
+    25, 25, 25, 26, 26, 27, 27, 27, 28, 28, 28, 29, 29, 29, 30, 30,
+    30, 31, 31, 31, 31, 32, 32, 32, 32, 33, 33, 33, 33, 33, 33, 33,
+    33, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 33, 33, 33, 33,
+    33, 33, 33, 32, 32, 32, 32, 31, 31, 31, 30, 30, 30, 29, 29, 28,
+    28, 27, 27, 26, 26, 25, 25, 24, 24, 23, 22, 22, 21, 20, 20, 19,
+    18, 17, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 8, 7, 6, 4,
+    3, 2, 1, 0, -1, -2, -3, -4, -5, -7, -8, -9, -10, -11, -13, -14,
+    -15, -16, -18, -19, -20, -22, -23, -24, -26, -27, -28, -30, -31, -32, -34, -35,
+    -36, -38, -39, -40, -42, -43, -44, -46, -47, -49, -50, -51, -53, -54, -55, -57,
+    -58, -59, -60, -62, -63, -64, -65, -67, -68, -69, -70, -71, -73, -74, -75, -76,
+    -77, -78, -79, -80, -81, -82, -83, -84, -85, -85, -86, -87, -88, -89, -89, -90,
+    -91, -91, -92, -92, -93, -93, -94, -94, -94, -95, -95, -95, -95, -95, -95, -96,
+    -96, -95, -95, -95, -95, -95, -95, -94, -94, -93, -93, -93, -92, -91, -91, -90,
+    -89, -88, -87, -87, -86, -85, -83, -82, -81, -80, -79, -77, -76, -74, -73, -71,
+    -70, -68, -66, -64, -63, -61, -59, -57, -55, -52, -50, -48, -46, -43, -41, -39,
+    -36, -34, -31, -28, -26, -23, -20, -17, -14, -12, -9, -6, -2, 1, 4, 7,
+    10, 13, 17, 20, 23, 27, 30, 34, 37, 41, 44, 48, 52, 55, 59, 63,
+    66, 70, 74, 78, 81, 85, 89, 93, 97, 100, 104, 108, 112, 116, 120, 124,
+    127, 131, 135, 139, 143, 146, 150, 154, 158, 161, 165, 169, 172, 176, 179, 183,
+    186, 190, 193, 197, 200, 203, 206, 210, 213, 216, 219, 222, 225, 227, 230, 233,
+    235, 238, 240, 243, 245, 247, 249, 251, 253, 255, 257, 258, 260, 261, 263, 264,
+    265, 266, 267, 268, 268, 269, 270, 270, 270, 270, 270, 270, 270, 269, 269, 268,
+    267, 266, 265, 264, 263, 261, 259, 258, 256, 254, 251, 249, 246, 244, 241, 238,
+    235, 231, 228, 224, 221, 217, 213, 209, 204, 200, 195, 190, 185, 180, 175, 169,
+    164, 158, 152, 146, 140, 133, 127, 120, 113, 106, 99, 92, 85, 77, 70, 62,
+    54, 46, 38, 29, 21, 12, 4, -5, -14, -23, -32, -42, -51, -61, -70, -80,
+    -90, -100, -109, -119, -130, -140, -150, -160, -171, -181, -192, -202, -213, -224, -234, -245,
+    -256, -267, -278, -289, -299, -310, -321, -332, -343, -354, -365, -375, -386, -397, -408, -418,
+    -429, -440, -450, -460, -471, -481, -491, -501, -511, -521, -531, -541, -550, -560, -569, -578,
+    -587, -596, -605, -614, -622, -630, -638, -646, -654, -661, -668, -675, -682, -689, -695, -701,
+    -707, -713, -718, -723, -728, -732, -737, -741, -744, -748, -751, -754, -756, -758, -760, -762,
+    -763, -764, -764, -764, -764, -763, -762, -761, -759, -757, -755, -752, -749, -745, -741, -736,
+    -732, -726, -721, -715, -708, -701, -694, -686, -678, -669, -660, -651, -641, -631, -620, -609,
+    -597, -585, -572, -559, -546, -532, -518, -503, -488, -472, -456, -440, -423, -406, -388, -370,
+    -351, -332, -313, -293, -273, -252, -231, -210, -188, -166, -143, -120, -97, -73, -49, -25,
+    0, 25, 50, 76, 102, 129, 155, 182, 209, 237, 265, 293, 321, 349, 378, 407,
+    436, 466, 495, 525, 555, 585, 615, 645, 675, 706, 736, 767, 798, 828, 859, 890,
+    921, 951, 982, 1013, 1043, 1074, 1105, 1135, 1165, 1195, 1225, 1255, 1285, 1314, 1343, 1372,
+    1401, 1430, 1458, 1486, 1513, 1541, 1568, 1594, 1620, 1646, 1672, 1697, 1721, 1745, 1769, 1792,
+    1814, 1836, 1857, 1878, 1898, 1918, 1937, 1955, 1973, 1990, 2006, 2022, 2037, 2051, 2064, 2077,
+    2088, 2099, 2109, 2119, 2127, 2135, 2141, 2147, 2152, 2155, 2158, 2160, 2161, 2161, 2160, 2158,
+    2155, 2151, 2145, 2139, 2132, 2123, 2113, 2103, 2091, 2078, 2064, 2048, 2032, 2014, 1995, 1975,
+    1954, 1932, 1908, 1883, 1857, 1830, 1801, 1772, 1741, 1708, 1675, 1640, 1604, 1567, 1529, 1489,
+    1448, 1406, 1363, 1318, 1272, 1225, 1177, 1128, 1077, 1025, 972, 918, 863, 806, 748, 690,
+    630, 569, 507, 443, 379, 314, 247, 180, 111, 42, -28, -100, -172, -245, -319, -394,
+    -469, -546, -623, -701, -780, -860, -940, -1021, -1102, -1184, -1267, -1350, -1434, -1518, -1602, -1687,
+    -1773, -1858, -1944, -2031, -2117, -2204, -2291, -2378, -2465, -2552, -2639, -2726, -2813, -2899, -2986, -3072,
+    -3158, -3244, -3330, -3415, -3499, -3584, -3667, -3750, -3833, -3915, -3996, -4076, -4155, -4234, -4312, -4389,
+    -4464, -4539, -4613, -4685, -4756, -4826, -4895, -4962, -5028, -5093, -5156, -5217, -5277, -5335, -5392, -5447,
+    -5500, -5551, -5600, -5647, -5692, -5736, -5777, -5816, -5853, -5887, -5919, -5949, -5977, -6002, -6025, -6045,
+    -6063, -6078, -6090, -6100, -6107, -6111, -6113, -6111, -6107, -6100, -6090, -6077, -6061, -6042, -6020, -5994,
+    -5966, -5934, -5899, -5861, -5820, -5775, -5727, -5676, -5621, -5563, -5502, -5437, -5369, -5297, -5222, -5144,
+    -5062, -4976, -4887, -4794, -4698, -4599, -4496, -4389, -4279, -4166, -4049, -3928, -3804, -3677, -3546, -3412,
+    -3274, -3133, -2988, -2840, -2689, -2534, -2376, -2215, -2051, -1883, -1712, -1538, -1361, -1181, -998, -812,
+    -624, -432, -237, -40, 160, 363, 568, 776, 986, 1199, 1414, 1631, 1851, 2073, 2296, 2522,
+    2750, 2979, 3210, 3443, 3677, 3913, 4150, 4389, 4628, 4869, 5111, 5354, 5597, 5842, 6086, 6332,
+    6577, 6823, 7069, 7316, 7562, 7808, 8053, 8299, 8543, 8787, 9031, 9273, 9514, 9755, 9993, 10231,
+    10467, 10701, 10934, 11164, 11392, 11619, 11843, 12064, 12283, 12499, 12712, 12922, 13129, 13333, 13533, 13729,
+    13922, 14111, 14296, 14477, 14653, 14825, 14993, 15155, 15313, 15466, 15614, 15756, 15893, 16024, 16150, 16270,
+    16384,
+};
+static const int16_t g_easeOutElasticTable[1025] = {
+    0, 114, 234, 360, 491, 628, 770, 918, 1071, 1229, 1391, 1559, 1731, 1907, 2088, 2273,
+    2462, 2655, 2851, 3051, 3255, 3462, 3672, 3885, 4101, 4320, 4541, 4765, 4992, 5220, 5450, 5683,
+    5917, 6153, 6391, 6629, 6870, 7111, 7353, 7597, 7841, 8085, 8331, 8576, 8822, 9068, 9315, 9561,
+    9807, 10052, 10298, 10542, 10787, 11030, 11273, 11515, 11756, 11995, 12234, 12471, 12707, 12941, 13174, 13405,
+    13634, 13862, 14088, 14311, 14533, 14753, 14970, 15185, 15398, 15608, 15816, 16021, 16224, 16424, 16621, 16816,
+    17008, 17196, 17382, 17565, 17745, 17922, 18096, 18267, 18435, 18599, 18760, 18918, 19073, 19224, 19372, 19517,
+    19658, 19796, 19930, 20061, 20188, 20312, 20433, 20550, 20663, 20773, 20880, 20983, 21082, 21178, 21271, 21360,
+    21446, 21528, 21606, 21681, 21753, 21821, 21886, 21947, 22005, 22060, 22111, 22159, 22204, 22245, 22283, 22318,
+    22350, 22378, 22404, 22426, 22445, 22461, 22474, 22484, 22491, 22495, 22497, 22495, 22491, 22484, 22474, 22462,
+    22447, 22429, 22409, 22386, 22361, 22333, 22303, 22271, 22237, 22200, 22161, 22120, 22076, 22031, 21984, 21935,
+    21884, 21831, 21776, 21719, 21661, 21601, 21540, 21477, 21412, 21346, 21279, 21210, 21140, 21069, 20997, 20923,
+    20848, 20773, 20696, 20618, 20539, 20460, 20380, 20299, 20217, 20134, 20051, 19968, 19883, 19799, 19714, 19628,
+    19542, 19456, 19370, 19283, 19197, 19110, 19023, 18936, 18849, 18762, 18675, 18588, 18501, 18415, 18328, 18242,
+    18157, 18071, 17986, 17902, 17818, 17734, 17651, 17568, 17486, 17405, 17324, 17244, 17164, 17085, 17007, 16930,
+    16853, 16778, 16703, 16629, 16556, 16484, 16412, 16342, 16273, 16204, 16137, 16070, 16005, 15941, 15877, 15815,
+    15754, 15694, 15636, 15578, 15521, 15466, 15412, 15359, 15307, 15256, 15207, 15159, 15112, 15066, 15021, 14978,
+    14936, 14895, 14855, 14817, 14780, 14744, 14709, 14676, 14643, 14612, 14583, 14554, 14527, 14501, 14476, 14452,
+    14430, 14409, 14389, 14370, 14352, 14336, 14320, 14306, 14293, 14281, 14271, 14261, 14252, 14245, 14239, 14233,
+    14229, 14226, 14224, 14223, 14223, 14224, 14226, 14229, 14232, 14237, 14243, 14249, 14257, 14265, 14275, 14285,
+    14296, 14307, 14320, 14333, 14347, 14362, 14378, 14394, 14411, 14429, 14447, 14466, 14486, 14506, 14527, 14548,
+    14570, 14592, 14615, 14639, 14663, 14687, 14712, 14738, 14764, 14790, 14816, 14843, 14871, 14898, 14926, 14954,
+    14983, 15012, 15041, 15070, 15099, 15129, 15159, 15189, 15219, 15249, 15279, 15310, 15341, 15371, 15402, 15433,
+    15463, 15494, 15525, 15556, 15586, 15617, 15648, 15678, 15709, 15739, 15769, 15799, 15829, 15859, 15889, 15918,
+    15948, 15977, 16006, 16035, 16063, 16091, 16119, 16147, 16175, 16202, 16229, 16255, 16282, 16308, 16334, 16359,
+    16384, 16409, 16433, 16457, 16481, 16504, 16527, 16550, 16572, 16594, 16615, 16636, 16657, 16677, 16697, 16716,
+    16735, 16754, 16772, 16790, 16807, 16824, 16840, 16856, 16872, 16887, 16902, 16916, 16930, 16943, 16956, 16969,
+    16981, 16993, 17004, 17015, 17025, 17035, 17044, 17053, 17062, 17070, 17078, 17085, 17092, 17099, 17105, 17110,
+    17116, 17120, 17125, 17129, 17133, 17136, 17139, 17141, 17143, 17145, 17146, 17147, 17148, 17148, 17148, 17148,
+    17147, 17146, 17144, 17142, 17140, 17138, 17135, 17132, 17128, 17125, 17121, 17116, 17112, 17107, 17102, 17097,
+    17091, 17085, 17079, 17073, 17066, 17059, 17052, 17045, 17038, 17030, 17022, 17014, 17006, 16998, 16989, 16980,
+    16971, 16962, 16953, 16944, 16934, 16925, 16915, 16905, 16895, 16885, 16875, 16865, 16855, 16844, 16834, 16824,
+    16813, 16802, 16792, 16781, 16770, 16759, 16749, 16738, 16727, 16716, 16705, 16694, 16683, 16673, 16662, 16651,
+    16640, 16629, 16618, 16608, 16597, 16586, 16576, 16565, 16555, 16544, 16534, 16524, 16514, 16503, 16493, 16484,
+    16474, 16464, 16454, 16445, 16435, 16426, 16416, 16407, 16398, 16389, 16380, 16372, 16363, 16355, 16346, 16338,
+    16330, 16322, 16314, 16307, 16299, 16292, 16285, 16278, 16271, 16264, 16257, 16251, 16244, 16238, 16232, 16226,
+    16220, 16215, 16209, 16204, 16199, 16194, 16189, 16184, 16180, 16175, 16171, 16167, 16163, 16160, 16156, 16153,
+    16149, 16146, 16143, 16140, 16138, 16135, 16133, 16130, 16128, 16126, 16125, 16123, 16121, 16120, 16119, 16118,
+    16117, 16116, 16115, 16115, 16114, 16114, 16114, 16114, 16114, 16114, 16114, 16115, 16116, 16116, 16117, 16118,
+    16119, 16120, 16121, 16123, 16124, 16126, 16127, 16129, 16131, 16133, 16135, 16137, 16139, 16141, 16144, 16146,
+    16149, 16151, 16154, 16157, 16159, 16162, 16165, 16168, 16171, 16174, 16178, 16181, 16184, 16187, 16191, 16194,
+    16198, 16201, 16205, 16208, 16212, 16215, 16219, 16223, 16226, 16230, 16234, 16238, 16241, 16245, 16249, 16253,
+    16257, 16260, 16264, 16268, 16272, 16276, 16280, 16284, 16287, 16291, 16295, 16299, 16303, 16306, 16310, 16314,
+    16318, 16321, 16325, 16329, 16332, 16336, 16340, 16343, 16347, 16350, 16354, 16357, 16361, 16364, 16367, 16371,
+    16374, 16377, 16380, 16383, 16386, 16390, 16393, 16396, 16398, 16401, 16404, 16407, 16410, 16412, 16415, 16418,
+    16420, 16423, 16425, 16427, 16430, 16432, 16434, 16436, 16439, 16441, 16443, 16445, 16447, 16448, 16450, 16452,
+    16454, 16455, 16457, 16458, 16460, 16461, 16463, 16464, 16465, 16466, 16467, 16469, 16470, 16471, 16471, 16472,
+    16473, 16474, 16475, 16475, 16476, 16477, 16477, 16477, 16478, 16478, 16479, 16479, 16479, 16479, 16479, 16479,
+    16480, 16480, 16479, 16479, 16479, 16479, 16479, 16479, 16478, 16478, 16478, 16477, 16477, 16476, 16476, 16475,
+    16475, 16474, 16473, 16473, 16472, 16471, 16470, 16469, 16469, 16468, 16467, 16466, 16465, 16464, 16463, 16462,
+    16461, 16460, 16459, 16458, 16457, 16455, 16454, 16453, 16452, 16451, 16449, 16448, 16447, 16446, 16444, 16443,
+    16442, 16441, 16439, 16438, 16437, 16435, 16434, 16433, 16431, 16430, 16428, 16427, 16426, 16424, 16423, 16422,
+    16420, 16419, 16418, 16416, 16415, 16414, 16412, 16411, 16410, 16408, 16407, 16406, 16404, 16403, 16402, 16400,
+    16399, 16398, 16397, 16395, 16394, 16393, 16392, 16391, 16389, 16388, 16387, 16386, 16385, 16384, 16383, 16382,
+    16381, 16380, 16378, 16377, 16376, 16376, 16375, 16374, 16373, 16372, 16371, 16370, 16369, 16368, 16367, 16367,
+    16366, 16365, 16364, 16364, 16363, 16362, 16362, 16361, 16360, 16360, 16359, 16359, 16358, 16358, 16357, 16357,
+    16356, 16356, 16355, 16355, 16354, 16354, 16354, 16353, 16353, 16353, 16352, 16352, 16352, 16352, 16351, 16351,
+    16351, 16351, 16351, 16351, 16351, 16350, 16350, 16350, 16350, 16350, 16350, 16350, 16350, 16350, 16350, 16350,
+    16351, 16351, 16351, 16351, 16351, 16351, 16351, 16351, 16352, 16352, 16352, 16352, 16353, 16353, 16353, 16353,
+    16354, 16354, 16354, 16355, 16355, 16355, 16356, 16356, 16356, 16357, 16357, 16357, 16358, 16358, 16359, 16359,
+    16359, 16360, 16360, 16361, 16361, 16361, 16362, 16362, 16363, 16363, 16364, 16364, 16365, 16365, 16366, 16366,
+    16367, 16367, 16368, 16368, 16368, 16369, 16369, 16370, 16370, 16371, 16371, 16372, 16372, 16373, 16373, 16374,
+    16374, 16375, 16375, 16376, 16376, 16377, 16377, 16377, 16378, 16378, 16379, 16379, 16380, 16380, 16381, 16381,
+    16381, 16382, 16382, 16383, 16383, 16383, 16384, 16384, 16385, 16385, 16385, 16386, 16386, 16386, 16387, 16387,
+    16387, 16388, 16388, 16388, 16389, 16389, 16389, 16390, 16390, 16390, 16391, 16391, 16391, 16391, 16392, 16392,
+    16384,
+};
+static const int16_t g_easeInOutElasticTable[1025] = {
+    0, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 5, 5, 5, 5,
+    6, 6, 6, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 10, 10, 10,
+    11, 11, 11, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 15, 15, 15,
+    15, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18,
+    18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 17, 17, 17, 17,
+    17, 16, 16, 16, 16, 15, 15, 15, 14, 14, 13, 13, 12, 12, 11, 11,
+    10, 9, 9, 8, 7, 7, 6, 5, 4, 3, 3, 2, 1, 0, -1, -2,
+    -3, -4, -5, -6, -8, -9, -10, -11, -12, -13, -15, -16, -17, -19, -20, -21,
+    -23, -24, -25, -27, -28, -30, -31, -33, -34, -36, -37, -39, -40, -42, -43, -45,
+    -46, -48, -49, -51, -52, -53, -55, -56, -58, -59, -61, -62, -63, -65, -66, -67,
+    -69, -70, -71, -72, -74, -75, -76, -77, -78, -79, -80, -80, -81, -82, -83, -83,
+    -84, -84, -85, -85, -85, -85, -86, -86, -86, -86, -85, -85, -85, -84, -84, -83,
+    -82, -82, -81, -80, -79, -77, -76, -75, -73, -71, -70, -68, -66, -64, -61, -59,
+    -56, -54, -51, -48, -45, -42, -39, -36, -32, -29, -25, -21, -17, -13, -9, -4,
+    0, 5, 9, 14, 19, 24, 29, 35, 40, 46, 51, 57, 63, 69, 75, 81,
+    87, 93, 100, 106, 113, 120, 126, 133, 140, 147, 154, 161, 168, 175, 182, 189,
+    196, 203, 210, 218, 225, 232, 239, 246, 253, 260, 267, 274, 281, 287, 294, 301,
+    307, 313, 320, 326, 332, 338, 343, 349, 354, 359, 364, 369, 373, 377, 381, 385,
+    389, 392, 395, 398, 400, 402, 404, 405, 406, 407, 408, 408, 407, 406, 405, 404,
+    402, 399, 396, 393, 389, 385, 380, 375, 369, 363, 356, 349, 341, 333, 324, 314,
+    304, 294, 283, 271, 259, 246, 233, 219, 204, 189, 173, 157, 140, 122, 104, 85,
+    66, 46, 25, 4, -17, -40, -63, -86, -110, -135, -160, -185, -211, -238, -265, -293,
+    -321, -350, -379, -408, -438, -469, -500, -531, -562, -594, -626, -659, -691, -724, -758, -791,
+    -825, -858, -892, -926, -960, -994, -1028, -1062, -1096, -1130, -1164, -1197, -1230, -1263, -1296, -1329,
+    -1361, -1393, -1424, -1455, -1485, -1515, -1544, -1572, -1600, -1627, -1653, -1679, -1703, -1727, -1749, -1771,
+    -1792, -1811, -1829, -1846, -1862, -1876, -1890, -1901, -1911, -1920, -1927, -1933, -1936, -1939, -1939, -1937,
+    -1934, -1929, -1922, -1913, -1901, -1888, -1872, -1855, -1835, -1813, -1788, -1762, -1732, -1701, -1667, -1630,
+    -1591, -1549, -1505, -1458, -1408, -1356, -1301, -1243, -1183, -1120, -1054, -985, -913, -839, -761, -681,
+    -598, -512, -424, -332, -238, -141, -41, 62, 167, 276, 387, 500, 616, 735, 857, 981,
+    1107, 1236, 1367, 1501, 1637, 1775, 1915, 2057, 2201, 2347, 2495, 2644, 2796, 2948, 3102, 3258,
+    3414, 3572, 3731, 3890, 4051, 4211, 4373, 4534, 4696, 4858, 5020, 5181, 5342, 5503, 5662, 5821,
+    5979, 6135, 6290, 6443, 6594, 6743, 6890, 7035, 7177, 7316, 7452, 7585, 7714, 7840, 7961, 8079,
+    8192, 8305, 8423, 8544, 8670, 8799, 8932, 9068, 9207, 9349, 9494, 9641, 9790, 9941, 10094, 10249,
+    10405, 10563, 10722, 10881, 11042, 11203, 11364, 11526, 11688, 11850, 12011, 12173, 12333, 12494, 12653, 12812,
+    12970, 13126, 13282, 13436, 13588, 13740, 13889, 14037, 14183, 14327, 14469, 14609, 14747, 14883, 15017, 15148,
+    15277, 15403, 15527, 15649, 15768, 15884, 15997, 16108, 16217, 16322, 16425, 16525, 16622, 16716, 16808, 16896,
+    16982, 17065, 17145, 17223, 17297, 17369, 17438, 17504, 17567, 17627, 17685, 17740, 17792, 17842, 17889, 17933,
+    17975, 18014, 18051, 18085, 18116, 18146, 18172, 18197, 18219, 18239, 18256, 18272, 18285, 18297, 18306, 18313,
+    18318, 18321, 18323, 18323, 18320, 18317, 18311, 18304, 18295, 18285, 18274, 18260, 18246, 18230, 18213, 18195,
+    18176, 18155, 18133, 18111, 18087, 18063, 18037, 18011, 17984, 17956, 17928, 17899, 17869, 17839, 17808, 17777,
+    17745, 17713, 17680, 17647, 17614, 17581, 17548, 17514, 17480, 17446, 17412, 17378, 17344, 17310, 17276, 17242,
+    17209, 17175, 17142, 17108, 17075, 17043, 17010, 16978, 16946, 16915, 16884, 16853, 16822, 16792, 16763, 16734,
+    16705, 16677, 16649, 16622, 16595, 16569, 16544, 16519, 16494, 16470, 16447, 16424, 16401, 16380, 16359, 16338,
+    16318, 16299, 16280, 16262, 16244, 16227, 16211, 16195, 16180, 16165, 16151, 16138, 16125, 16113, 16101, 16090,
+    16080, 16070, 16060, 16051, 16043, 16035, 16028, 16021, 16015, 16009, 16004, 15999, 15995, 15991, 15988, 15985,
+    15982, 15980, 15979, 15978, 15977, 15976, 15976, 15977, 15978, 15979, 15980, 15982, 15984, 15986, 15989, 15992,
+    15995, 15999, 16003, 16007, 16011, 16015, 16020, 16025, 16030, 16035, 16041, 16046, 16052, 16058, 16064, 16071,
+    16077, 16083, 16090, 16097, 16103, 16110, 16117, 16124, 16131, 16138, 16145, 16152, 16159, 16166, 16174, 16181,
+    16188, 16195, 16202, 16209, 16216, 16223, 16230, 16237, 16244, 16251, 16258, 16264, 16271, 16278, 16284, 16291,
+    16297, 16303, 16309, 16315, 16321, 16327, 16333, 16338, 16344, 16349, 16355, 16360, 16365, 16370, 16375, 16379,
+    16384, 16388, 16393, 16397, 16401, 16405, 16409, 16413, 16416, 16420, 16423, 16426, 16429, 16432, 16435, 16438,
+    16440, 16443, 16445, 16448, 16450, 16452, 16454, 16455, 16457, 16459, 16460, 16461, 16463, 16464, 16465, 16466,
+    16466, 16467, 16468, 16468, 16469, 16469, 16469, 16470, 16470, 16470, 16470, 16469, 16469, 16469, 16469, 16468,
+    16468, 16467, 16467, 16466, 16465, 16464, 16464, 16463, 16462, 16461, 16460, 16459, 16458, 16456, 16455, 16454,
+    16453, 16451, 16450, 16449, 16447, 16446, 16445, 16443, 16442, 16440, 16439, 16437, 16436, 16435, 16433, 16432,
+    16430, 16429, 16427, 16426, 16424, 16423, 16421, 16420, 16418, 16417, 16415, 16414, 16412, 16411, 16409, 16408,
+    16407, 16405, 16404, 16403, 16401, 16400, 16399, 16397, 16396, 16395, 16394, 16393, 16392, 16390, 16389, 16388,
+    16387, 16386, 16385, 16384, 16383, 16382, 16381, 16381, 16380, 16379, 16378, 16377, 16377, 16376, 16375, 16375,
+    16374, 16373, 16373, 16372, 16372, 16371, 16371, 16370, 16370, 16369, 16369, 16369, 16368, 16368, 16368, 16368,
+    16367, 16367, 16367, 16367, 16367, 16366, 16366, 16366, 16366, 16366, 16366, 16366, 16366, 16366, 16366, 16366,
+    16366, 16366, 16366, 16366, 16366, 16367, 16367, 16367, 16367, 16367, 16367, 16368, 16368, 16368, 16368, 16368,
+    16369, 16369, 16369, 16369, 16370, 16370, 16370, 16371, 16371, 16371, 16371, 16372, 16372, 16372, 16373, 16373,
+    16373, 16374, 16374, 16374, 16375, 16375, 16375, 16376, 16376, 16376, 16376, 16377, 16377, 16377, 16378, 16378,
+    16378, 16379, 16379, 16379, 16379, 16380, 16380, 16380, 16381, 16381, 16381, 16381, 16382, 16382, 16382, 16382,
+    16384,
+};
+static const int16_t g_easeInBounceTable[1025] = {
+    0, 11, 22, 32, 42, 52, 62, 71, 80, 89, 98, 107, 115, 123, 131, 138,
+    146, 153, 160, 166, 173, 179, 185, 190, 196, 201, 206, 211, 215, 220, 224, 227,
+    231, 234, 237, 240, 243, 245, 247, 249, 251, 252, 254, 255, 255, 256, 256, 256,
+    256, 255, 255, 254, 252, 251, 249, 248, 245, 243, 240, 238, 235, 231, 228, 224,
+    220, 216, 211, 207, 202, 196, 191, 185, 179, 173, 167, 160, 153, 146, 139, 132,
+    124, 116, 107, 99, 90, 81, 72, 63, 53, 43, 33, 22, 12, 1, 20, 42,
+    63, 84, 105, 126, 146, 167, 187, 206, 226, 245, 264, 283, 302, 320, 338, 356,
+    374, 391, 408, 425, 442, 458, 475, 491, 506, 522, 537, 552, 567, 582, 596, 610,
+    624, 638, 651, 664, 677, 690, 702, 714, 726, 738, 750, 761, 772, 783, 793, 804,
+    814, 824, 833, 843, 852, 861, 869, 878, 886, 894, 902, 909, 916, 923, 930, 937,
+    943, 949, 955, 960, 966, 971, 976, 981, 985, 989, 993, 997, 1000, 1003, 1006, 1009,
+    1012, 1014, 1016, 1018, 1019, 1021, 1022, 1023, 1023, 1024, 1024, 1024, 1024, 1023, 1022, 1021,
+    1020, 1019, 1017, 1015, 1013, 1010, 1007, 1005, 1001, 998, 994, 991, 986, 982, 978, 973,
+    968, 962, 957, 951, 945, 939, 933, 926, 919, 912, 904, 897, 889, 881, 872, 864,
+    855, 846, 837, 827, 817, 807, 797, 787, 776, 765, 754, 742, 731, 719, 707, 694,
+    682, 669, 656, 643, 629, 615, 601, 587, 572, 558, 543, 528, 512, 496, 481, 464,
+    448, 431, 415, 397, 380, 363, 345, 327, 308, 290, 271, 252, 233, 214, 194, 174,
+    154, 133, 113, 92, 71, 49, 28, 6, 32, 76, 119, 162, 205, 248, 291, 333,
+    375, 417, 458, 500, 541, 582, 622, 663, 703, 743, 783, 822, 861, 900, 939, 977,
+    1016, 1054, 1092, 1129, 1166, 1204, 1240, 1277, 1313, 1350, 1385, 1421, 1457, 1492, 1527, 1562,
+    1596, 1630, 1664, 1698, 1732, 1765, 1798, 1831, 1863, 1896, 1928, 1960, 1991, 2023, 2054, 2085,
+    2116, 2146, 2176, 2206, 2236, 2266, 2295, 2324, 2353, 2382, 2410, 2438, 2466, 2493, 2521, 2548,
+    2575, 2602, 2628, 2654, 2680, 2706, 2732, 2757, 2782, 2807, 2831, 2856, 2880, 2904, 2927, 2951,
+    2974, 2997, 3019, 3042, 3064, 3086, 3108, 3129, 3150, 3171, 3192, 3213, 3233, 3253, 3273, 3293,
+    3312, 3331, 3350, 3369, 3387, 3405, 3423, 3441, 3458, 3476, 3493, 3509, 3526, 3542, 3558, 3574,
+    3590, 3605, 3620, 3635, 3650, 3664, 3678, 3692, 3706, 3719, 3733, 3746, 3758, 3771, 3783, 3795,
+    3807, 3819, 3830, 3841, 3852, 3862, 3873, 3883, 3893, 3903, 3912, 3921, 3930, 3939, 3947, 3956,
+    3964, 3972, 3979, 3986, 3993, 4000, 4007, 4013, 4019, 4025, 4031, 4036, 4042, 4047, 4051, 4056,
+    4060, 4064, 4068, 4071, 4075, 4078, 4080, 4083, 4085, 4088, 4089, 4091, 4092, 4094, 4095, 4095,
+    4096, 4096, 4096, 4096, 4095, 4095, 4094, 4092, 4091, 4089, 4087, 4085, 4083, 4080, 4077, 4074,
+    4071, 4067, 4064, 4060, 4055, 4051, 4046, 4041, 4036, 4030, 4025, 4019, 4013, 4006, 4000, 3993,
+    3986, 3978, 3971, 3963, 3955, 3947, 3938, 3929, 3920, 3911, 3902, 3892, 3882, 3872, 3862, 3851,
+    3840, 3829, 3818, 3806, 3794, 3782, 3770, 3757, 3744, 3731, 3718, 3705, 3691, 3677, 3663, 3648,
+    3634, 3619, 3604, 3588, 3573, 3557, 3541, 3524, 3508, 3491, 3474, 3457, 3439, 3422, 3404, 3385,
+    3367, 3348, 3329, 3310, 3291, 3271, 3251, 3231, 3211, 3190, 3170, 3149, 3127, 3106, 3084, 3062,
+    3040, 3017, 2995, 2972, 2948, 2925, 2901, 2878, 2853, 2829, 2804, 2780, 2755, 2729, 2704, 2678,
+    2652, 2626, 2599, 2573, 2546, 2518, 2491, 2463, 2435, 2407, 2379, 2350, 2321, 2292, 2263, 2234,
+    2204, 2174, 2143, 2113, 2082, 2051, 2020, 1989, 1957, 1925, 1893, 1860, 1828, 1795, 1762, 1729,
+    1695, 1661, 1627, 1593, 1558, 1524, 1489, 1453, 1418, 1382, 1346, 1310, 1274, 1237, 1200, 1163,
+    1126, 1088, 1050, 1012, 974, 935, 897, 858, 818, 779, 739, 699, 659, 619, 578, 537,
+    496, 455, 413, 371, 329, 287, 244, 201, 158, 115, 72, 28, 32, 120, 207, 295,
+    382, 469, 555, 642, 728, 814, 899, 985, 1070, 1155, 1240, 1324, 1408, 1492, 1576, 1660,
+    1743, 1826, 1909, 1991, 2074, 2156, 2238, 2320, 2401, 2482, 2563, 2644, 2724, 2804, 2884, 2964,
+    3044, 3123, 3202, 3281, 3359, 3438, 3516, 3594, 3671, 3749, 3826, 3903, 3980, 4056, 4132, 4208,
+    4284, 4360, 4435, 4510, 4585, 4659, 4733, 4808, 4881, 4955, 5028, 5102, 5174, 5247, 5320, 5392,
+    5464, 5535, 5607, 5678, 5749, 5820, 5891, 5961, 6031, 6101, 6170, 6240, 6309, 6378, 6446, 6515,
+    6583, 6651, 6719, 6786, 6853, 6920, 6987, 7054, 7120, 7186, 7252, 7317, 7383, 7448, 7513, 7577,
+    7642, 7706, 7770, 7834, 7897, 7960, 8023, 8086, 8148, 8211, 8273, 8335, 8396, 8457, 8519, 8579,
+    8640, 8700, 8761, 8820, 8880, 8940, 8999, 9058, 9116, 9175, 9233, 9291, 9349, 9407, 9464, 9521,
+    9578, 9634, 9691, 9747, 9803, 9858, 9914, 9969, 10024, 10079, 10133, 10187, 10241, 10295, 10349, 10402,
+    10455, 10508, 10560, 10613, 10665, 10717, 10768, 10820, 10871, 10922, 10973, 11023, 11073, 11123, 11173, 11222,
+    11272, 11321, 11370, 11418, 11466, 11515, 11562, 11610, 11657, 11705, 11751, 11798, 11845, 11891, 11937, 11983,
+    12028, 12073, 12118, 12163, 12208, 12252, 12296, 12340, 12383, 12427, 12470, 12513, 12555, 12598, 12640, 12682,
+    12724, 12765, 12806, 12847, 12888, 12929, 12969, 13009, 13049, 13089, 13128, 13167, 13206, 13244, 13283, 13321,
+    13359, 13397, 13434, 13471, 13508, 13545, 13582, 13618, 13654, 13690, 13725, 13761, 13796, 13831, 13865, 13900,
+    13934, 13968, 14001, 14035, 14068, 14101, 14134, 14166, 14198, 14230, 14262, 14294, 14325, 14356, 14387, 14418,
+    14448, 14478, 14508, 14538, 14567, 14596, 14625, 14654, 14682, 14711, 14739, 14766, 14794, 14821, 14848, 14875,
+    14902, 14928, 14954, 14980, 15006, 15031, 15056, 15081, 15106, 15130, 15155, 15179, 15202, 15226, 15249, 15272,
+    15295, 15318, 15340, 15362, 15384, 15405, 15427, 15448, 15469, 15490, 15510, 15530, 15550, 15570, 15589, 15609,
+    15628, 15647, 15665, 15683, 15701, 15719, 15737, 15754, 15771, 15788, 15805, 15821, 15838, 15854, 15869, 15885,
+    15900, 15915, 15930, 15944, 15959, 15973, 15986, 16000, 16013, 16027, 16039, 16052, 16064, 16077, 16089, 16100,
+    16112, 16123, 16134, 16145, 16155, 16166, 16176, 16185, 16195, 16204, 16213, 16222, 16231, 16239, 16247, 16255,
+    16263, 16270, 16278, 16285, 16291, 16298, 16304, 16310, 16316, 16321, 16327, 16332, 16337, 16341, 16346, 16350,
+    16354, 16357, 16361, 16364, 16367, 16370, 16372, 16374, 16376, 16378, 16380, 16381, 16382, 16383, 16384, 16384,
+    16384,
+};
+static const int16_t g_easeOutBounceTable[1025] = {
+    0, 0, 0, 1, 2, 3, 4, 6, 8, 10, 12, 14, 17, 20, 23, 27,
+    30, 34, 38, 43, 47, 52, 57, 63, 68, 74, 80, 86, 93, 99, 106, 114,
+    121, 129, 137, 145, 153, 162, 171, 180, 189, 199, 208, 218, 229, 239, 250, 261,
+    272, 284, 295, 307, 320, 332, 345, 357, 371, 384, 398, 411, 425, 440, 454, 469,
+    484, 499, 515, 530, 546, 563, 579, 596, 613, 630, 647, 665, 683, 701, 719, 737,
+    756, 775, 795, 814, 834, 854, 874, 894, 915, 936, 957, 979, 1000, 1022, 1044, 1066,
+    1089, 1112, 1135, 1158, 1182, 1205, 1229, 1254, 1278, 1303, 1328, 1353, 1378, 1404, 1430, 1456,
+    1482, 1509, 1536, 1563, 1590, 1618, 1645, 1673, 1702, 1730, 1759, 1788, 1817, 1846, 1876, 1906,
+    1936, 1966, 1997, 2028, 2059, 2090, 2122, 2154, 2186, 2218, 2250, 2283, 2316, 2349, 2383, 2416,
+    2450, 2484, 2519, 2553, 2588, 2623, 2659, 2694, 2730, 2766, 2802, 2839, 2876, 2913, 2950, 2987,
+    3025, 3063, 3101, 3140, 3178, 3217, 3256, 3295, 3335, 3375, 3415, 3455, 3496, 3537, 3578, 3619,
+    3660, 3702, 3744, 3786, 3829, 3871, 3914, 3957, 4001, 4044, 4088, 4132, 4176, 4221, 4266, 4311,
+    4356, 4401, 4447, 4493, 4539, 4586, 4633, 4679, 4727, 4774, 4822, 4869, 4918, 4966, 5014, 5063,
+    5112, 5162, 5211, 5261, 5311, 5361, 5411, 5462, 5513, 5564, 5616, 5667, 5719, 5771, 5824, 5876,
+    5929, 5982, 6035, 6089, 6143, 6197, 6251, 6305, 6360, 6415, 6470, 6526, 6581, 6637, 6693, 6750,
+    6806, 6863, 6920, 6977, 7035, 7093, 7151, 7209, 7268, 7326, 7385, 7444, 7504, 7564, 7623, 7684,
+    7744, 7805, 7865, 7927, 7988, 8049, 8111, 8173, 8236, 8298, 8361, 8424, 8487, 8550, 8614, 8678,
+    8742, 8807, 8871, 8936, 9001, 9067, 9132, 9198, 9264, 9330, 9397, 9464, 9531, 9598, 9665, 9733,
+    9801, 9869, 9938, 10006, 10075, 10144, 10214, 10283, 10353, 10423, 10493, 10564, 10635, 10706, 10777, 10849,
+    10920, 10992, 11064, 11137, 11210, 11282, 11356, 11429, 11503, 11576, 11651, 11725, 11799, 11874, 11949, 12024,
+    12100, 12176, 12252, 12328, 12404, 12481, 12558, 12635, 12713, 12790, 12868, 12946, 13025, 13103, 13182, 13261,
+    13340, 13420, 13500, 13580, 13660, 13740, 13821, 13902, 13983, 14064, 14146, 14228, 14310, 14393, 14475, 14558,
+    14641, 14724, 14808, 14892, 14976, 15060, 15144, 15229, 15314, 15399, 15485, 15570, 15656, 15742, 15829, 15915,
+    16002, 16089, 16177, 16264, 16352, 16356, 16312, 16269, 16226, 16183, 16140, 16097, 16055, 16013, 15971, 15929,
+    15888, 15847, 15806, 15765, 15725, 15685, 15645, 15605, 15566, 15526, 15487, 15449, 15410, 15372, 15334, 15296,
+    15258, 15221, 15184, 15147, 15110, 15074, 15038, 15002, 14966, 14931, 14895, 14860, 14826, 14791, 14757, 14723,
+    14689, 14655, 14622, 14589, 14556, 14524, 14491, 14459, 14427, 14395, 14364, 14333, 14302, 14271, 14241, 14210,
+    14180, 14150, 14121, 14092, 14063, 14034, 14005, 13977, 13949, 13921, 13893, 13866, 13838, 13811, 13785, 13758,
+    13732, 13706, 13680, 13655, 13629, 13604, 13580, 13555, 13531, 13506, 13483, 13459, 13436, 13412, 13389, 13367,
+    13344, 13322, 13300, 13278, 13257, 13235, 13214, 13194, 13173, 13153, 13133, 13113, 13093, 13074, 13055, 13036,
+    13017, 12999, 12980, 12962, 12945, 12927, 12910, 12893, 12876, 12860, 12843, 12827, 12811, 12796, 12780, 12765,
+    12750, 12736, 12721, 12707, 12693, 12679, 12666, 12653, 12640, 12627, 12614, 12602, 12590, 12578, 12566, 12555,
+    12544, 12533, 12522, 12512, 12502, 12492, 12482, 12473, 12464, 12455, 12446, 12437, 12429, 12421, 12413, 12406,
+    12398, 12391, 12384, 12378, 12371, 12365, 12359, 12354, 12348, 12343, 12338, 12333, 12329, 12324, 12320, 12317,
+    12313, 12310, 12307, 12304, 12301, 12299, 12297, 12295, 12293, 12292, 12290, 12289, 12289, 12288, 12288, 12288,
+    12288, 12289, 12289, 12290, 12292, 12293, 12295, 12296, 12299, 12301, 12304, 12306, 12309, 12313, 12316, 12320,
+    12324, 12328, 12333, 12337, 12342, 12348, 12353, 12359, 12365, 12371, 12377, 12384, 12391, 12398, 12405, 12412,
+    12420, 12428, 12437, 12445, 12454, 12463, 12472, 12481, 12491, 12501, 12511, 12522, 12532, 12543, 12554, 12565,
+    12577, 12589, 12601, 12613, 12626, 12638, 12651, 12665, 12678, 12692, 12706, 12720, 12734, 12749, 12764, 12779,
+    12794, 12810, 12826, 12842, 12858, 12875, 12891, 12908, 12926, 12943, 12961, 12979, 12997, 13015, 13034, 13053,
+    13072, 13091, 13111, 13131, 13151, 13171, 13192, 13213, 13234, 13255, 13276, 13298, 13320, 13342, 13365, 13387,
+    13410, 13433, 13457, 13480, 13504, 13528, 13553, 13577, 13602, 13627, 13652, 13678, 13704, 13730, 13756, 13782,
+    13809, 13836, 13863, 13891, 13918, 13946, 13974, 14002, 14031, 14060, 14089, 14118, 14148, 14178, 14208, 14238,
+    14268, 14299, 14330, 14361, 14393, 14424, 14456, 14488, 14521, 14553, 14586, 14619, 14652, 14686, 14720, 14754,
+    14788, 14822, 14857, 14892, 14927, 14963, 14999, 15034, 15071, 15107, 15144, 15180, 15218, 15255, 15292, 15330,
+    15368, 15407, 15445, 15484, 15523, 15562, 15601, 15641, 15681, 15721, 15762, 15802, 15843, 15884, 15926, 15967,
+    16009, 16051, 16093, 16136, 16179, 16222, 16265, 16308, 16352, 16378, 16356, 16335, 16313, 16292, 16271, 16251,
+    16230, 16210, 16190, 16170, 16151, 16132, 16113, 16094, 16076, 16057, 16039, 16021, 16004, 15987, 15969, 15953,
+    15936, 15920, 15903, 15888, 15872, 15856, 15841, 15826, 15812, 15797, 15783, 15769, 15755, 15741, 15728, 15715,
+    15702, 15690, 15677, 15665, 15653, 15642, 15630, 15619, 15608, 15597, 15587, 15577, 15567, 15557, 15547, 15538,
+    15529, 15520, 15512, 15503, 15495, 15487, 15480, 15472, 15465, 15458, 15451, 15445, 15439, 15433, 15427, 15422,
+    15416, 15411, 15406, 15402, 15398, 15393, 15390, 15386, 15383, 15379, 15377, 15374, 15371, 15369, 15367, 15365,
+    15364, 15363, 15362, 15361, 15360, 15360, 15360, 15360, 15361, 15361, 15362, 15363, 15365, 15366, 15368, 15370,
+    15372, 15375, 15378, 15381, 15384, 15387, 15391, 15395, 15399, 15403, 15408, 15413, 15418, 15424, 15429, 15435,
+    15441, 15447, 15454, 15461, 15468, 15475, 15482, 15490, 15498, 15506, 15515, 15523, 15532, 15541, 15551, 15560,
+    15570, 15580, 15591, 15601, 15612, 15623, 15634, 15646, 15658, 15670, 15682, 15694, 15707, 15720, 15733, 15746,
+    15760, 15774, 15788, 15802, 15817, 15832, 15847, 15862, 15878, 15893, 15909, 15926, 15942, 15959, 15976, 15993,
+    16010, 16028, 16046, 16064, 16082, 16101, 16120, 16139, 16158, 16178, 16197, 16217, 16238, 16258, 16279, 16300,
+    16321, 16342, 16364, 16383, 16372, 16362, 16351, 16341, 16331, 16321, 16312, 16303, 16294, 16285, 16277, 16268,
+    16260, 16252, 16245, 16238, 16231, 16224, 16217, 16211, 16205, 16199, 16193, 16188, 16182, 16177, 16173, 16168,
+    16164, 16160, 16156, 16153, 16149, 16146, 16144, 16141, 16139, 16136, 16135, 16133, 16132, 16130, 16129, 16129,
+    16128, 16128, 16128, 16128, 16129, 16129, 16130, 16132, 16133, 16135, 16137, 16139, 16141, 16144, 16147, 16150,
+    16153, 16157, 16160, 16164, 16169, 16173, 16178, 16183, 16188, 16194, 16199, 16205, 16211, 16218, 16224, 16231,
+    16238, 16246, 16253, 16261, 16269, 16277, 16286, 16295, 16304, 16313, 16322, 16332, 16342, 16352, 16362, 16373,
+    16384,
+};
+static const int16_t g_easeInOutBounceTable[1025] = {
+    0, 11, 21, 31, 40, 49, 57, 65, 73, 80, 86, 92, 98, 103, 108, 112,
+    116, 119, 121, 124, 125, 127, 128, 128, 128, 127, 126, 125, 123, 120, 117, 114,
+    110, 106, 101, 95, 90, 83, 77, 70, 62, 54, 45, 36, 26, 16, 6, 10,
+    32, 53, 73, 93, 113, 132, 151, 169, 187, 204, 221, 237, 253, 269, 284, 298,
+    312, 326, 339, 351, 363, 375, 386, 397, 407, 417, 426, 435, 443, 451, 458, 465,
+    472, 477, 483, 488, 492, 497, 500, 503, 506, 508, 510, 511, 512, 512, 512, 511,
+    510, 508, 506, 504, 501, 497, 493, 489, 484, 478, 473, 466, 459, 452, 444, 436,
+    428, 418, 409, 399, 388, 377, 365, 353, 341, 328, 314, 301, 286, 271, 256, 240,
+    224, 207, 190, 172, 154, 136, 116, 97, 77, 56, 35, 14, 16, 60, 103, 145,
+    187, 229, 270, 311, 351, 391, 431, 469, 508, 546, 583, 620, 657, 693, 728, 763,
+    798, 832, 866, 899, 932, 964, 996, 1027, 1058, 1088, 1118, 1148, 1176, 1205, 1233, 1260,
+    1287, 1314, 1340, 1366, 1391, 1416, 1440, 1464, 1487, 1510, 1532, 1554, 1575, 1596, 1617, 1637,
+    1656, 1675, 1694, 1712, 1729, 1746, 1763, 1779, 1795, 1810, 1825, 1839, 1853, 1866, 1879, 1892,
+    1904, 1915, 1926, 1936, 1946, 1956, 1965, 1974, 1982, 1990, 1997, 2003, 2010, 2015, 2021, 2026,
+    2030, 2034, 2037, 2040, 2043, 2045, 2046, 2047, 2048, 2048, 2048, 2047, 2045, 2044, 2041, 2039,
+    2036, 2032, 2028, 2023, 2018, 2012, 2006, 2000, 1993, 1985, 1977, 1969, 1960, 1951, 1941, 1931,
+    1920, 1909, 1897, 1885, 1872, 1859, 1845, 1831, 1817, 1802, 1786, 1770, 1754, 1737, 1720, 1702,
+    1684, 1665, 1645, 1626, 1605, 1585, 1564, 1542, 1520, 1497, 1474, 1451, 1427, 1402, 1377, 1352,
+    1326, 1300, 1273, 1245, 1218, 1189, 1161, 1132, 1102, 1072, 1041, 1010, 978, 946, 914, 881,
+    848, 814, 779, 744, 709, 673, 637, 600, 563, 525, 487, 448, 409, 370, 330, 289,
+    248, 207, 165, 122, 79, 36, 16, 104, 191, 278, 364, 450, 535, 620, 704, 788,
+    872, 954, 1037, 1119, 1200, 1282, 1362, 1442, 1522, 1601, 1680, 1758, 1836, 1913, 1990, 2066,
+    2142, 2217, 2292, 2367, 2441, 2514, 2587, 2660, 2732, 2803, 2875, 2945, 3015, 3085, 3154, 3223,
+    3292, 3359, 3427, 3494, 3560, 3626, 3691, 3756, 3821, 3885, 3948, 4012, 4074, 4136, 4198, 4259,
+    4320, 4380, 4440, 4499, 4558, 4617, 4674, 4732, 4789, 4845, 4901, 4957, 5012, 5067, 5121, 5174,
+    5228, 5280, 5332, 5384, 5435, 5486, 5537, 5586, 5636, 5685, 5733, 5781, 5829, 5876, 5922, 5968,
+    6014, 6059, 6104, 6148, 6192, 6235, 6278, 6320, 6362, 6403, 6444, 6485, 6524, 6564, 6603, 6641,
+    6680, 6717, 6754, 6791, 6827, 6863, 6898, 6933, 6967, 7001, 7034, 7067, 7099, 7131, 7163, 7194,
+    7224, 7254, 7284, 7313, 7341, 7369, 7397, 7424, 7451, 7477, 7503, 7528, 7553, 7577, 7601, 7625,
+    7648, 7670, 7692, 7713, 7734, 7755, 7775, 7795, 7814, 7833, 7851, 7868, 7886, 7902, 7919, 7935,
+    7950, 7965, 7979, 7993, 8007, 8020, 8032, 8044, 8056, 8067, 8078, 8088, 8097, 8107, 8115, 8124,
+    8132, 8139, 8146, 8152, 8158, 8163, 8168, 8173, 8177, 8180, 8183, 8186, 8188, 8190, 8191, 8192,
+    8192, 8192, 8193, 8194, 8196, 8198, 8201, 8204, 8207, 8211, 8216, 8221, 8226, 8232, 8238, 8245,
+    8252, 8260, 8269, 8277, 8287, 8296, 8306, 8317, 8328, 8340, 8352, 8364, 8377, 8391, 8405, 8419,
+    8434, 8449, 8465, 8482, 8498, 8516, 8533, 8551, 8570, 8589, 8609, 8629, 8650, 8671, 8692, 8714,
+    8736, 8759, 8783, 8807, 8831, 8856, 8881, 8907, 8933, 8960, 8987, 9015, 9043, 9071, 9100, 9130,
+    9160, 9190, 9221, 9253, 9285, 9317, 9350, 9383, 9417, 9451, 9486, 9521, 9557, 9593, 9630, 9667,
+    9704, 9743, 9781, 9820, 9860, 9899, 9940, 9981, 10022, 10064, 10106, 10149, 10192, 10236, 10280, 10325,
+    10370, 10416, 10462, 10508, 10555, 10603, 10651, 10699, 10748, 10798, 10847, 10898, 10949, 11000, 11052, 11104,
+    11156, 11210, 11263, 11317, 11372, 11427, 11483, 11539, 11595, 11652, 11710, 11767, 11826, 11885, 11944, 12004,
+    12064, 12125, 12186, 12248, 12310, 12372, 12436, 12499, 12563, 12628, 12693, 12758, 12824, 12890, 12957, 13025,
+    13092, 13161, 13230, 13299, 13369, 13439, 13509, 13581, 13652, 13724, 13797, 13870, 13943, 14017, 14092, 14167,
+    14242, 14318, 14394, 14471, 14548, 14626, 14704, 14783, 14862, 14942, 15022, 15102, 15184, 15265, 15347, 15430,
+    15512, 15596, 15680, 15764, 15849, 15934, 16020, 16106, 16193, 16280, 16368, 16348, 16305, 16262, 16219, 16177,
+    16136, 16095, 16054, 16014, 15975, 15936, 15897, 15859, 15821, 15784, 15747, 15711, 15675, 15640, 15605, 15570,
+    15536, 15503, 15470, 15438, 15406, 15374, 15343, 15312, 15282, 15252, 15223, 15195, 15166, 15139, 15111, 15084,
+    15058, 15032, 15007, 14982, 14957, 14933, 14910, 14887, 14864, 14842, 14820, 14799, 14779, 14758, 14739, 14719,
+    14700, 14682, 14664, 14647, 14630, 14614, 14598, 14582, 14567, 14553, 14539, 14525, 14512, 14499, 14487, 14475,
+    14464, 14453, 14443, 14433, 14424, 14415, 14407, 14399, 14391, 14384, 14378, 14372, 14366, 14361, 14356, 14352,
+    14348, 14345, 14343, 14340, 14339, 14337, 14336, 14336, 14336, 14337, 14338, 14339, 14341, 14344, 14347, 14350,
+    14354, 14358, 14363, 14369, 14374, 14381, 14387, 14394, 14402, 14410, 14419, 14428, 14438, 14448, 14458, 14469,
+    14480, 14492, 14505, 14518, 14531, 14545, 14559, 14574, 14589, 14605, 14621, 14638, 14655, 14672, 14690, 14709,
+    14728, 14747, 14767, 14788, 14809, 14830, 14852, 14874, 14897, 14920, 14944, 14968, 14993, 15018, 15044, 15070,
+    15096, 15124, 15151, 15179, 15208, 15236, 15266, 15296, 15326, 15357, 15388, 15420, 15452, 15485, 15518, 15552,
+    15586, 15621, 15656, 15691, 15727, 15764, 15801, 15838, 15876, 15915, 15953, 15993, 16033, 16073, 16114, 16155,
+    16196, 16239, 16281, 16324, 16368, 16370, 16349, 16328, 16307, 16287, 16268, 16248, 16230, 16212, 16194, 16177,
+    16160, 16144, 16128, 16113, 16098, 16083, 16070, 16056, 16043, 16031, 16019, 16007, 15996, 15985, 15975, 15966,
+    15956, 15948, 15940, 15932, 15925, 15918, 15911, 15906, 15900, 15895, 15891, 15887, 15883, 15880, 15878, 15876,
+    15874, 15873, 15872, 15872, 15872, 15873, 15874, 15876, 15878, 15881, 15884, 15887, 15892, 15896, 15901, 15907,
+    15912, 15919, 15926, 15933, 15941, 15949, 15958, 15967, 15977, 15987, 15998, 16009, 16021, 16033, 16045, 16058,
+    16072, 16086, 16100, 16115, 16131, 16147, 16163, 16180, 16197, 16215, 16233, 16252, 16271, 16291, 16311, 16331,
+    16352, 16374, 16378, 16368, 16358, 16348, 16339, 16330, 16322, 16314, 16307, 16301, 16294, 16289, 16283, 16278,
+    16274, 16270, 16267, 16264, 16261, 16259, 16258, 16257, 16256, 16256, 16256, 16257, 16259, 16260, 16263, 16265,
+    16268, 16272, 16276, 16281, 16286, 16292, 16298, 16304, 16311, 16319, 16327, 16335, 16344, 16353, 16363, 16373,
+    16384,
+};
+
+struct EasingTable {
+    const int16_t *samples;
+    uint8_t bits;
+};
+
+static const EasingTable g_easingTables[31] = {
+    { nullptr, 0 }, // linear
+    { g_easeInQuadTable, 8 },
+    { g_easeOutQuadTable, 8 },
+    { g_easeInOutQuadTable, 8 },
+    { g_easeInCubicTable, 8 },
+    { g_easeOutCubicTable, 8 },
+    { g_easeInOutCubicTable, 8 },
+    { g_easeInQuartTable, 8 },
+    { g_easeOutQuartTable, 8 },
+    { g_easeInOutQuartTable, 8 },
+    { g_easeInQuintTable, 8 },
+    { g_easeOutQuintTable, 8 },
+    { g_easeInOutQuintTable, 8 },
+    { g_easeInSineTable, 8 },
+    { g_easeOutSineTable, 8 },
+    { g_easeInOutSineTable, 8 },
+    { g_easeInExpoTable, 8 },
+    { g_easeOutExpoTable, 8 },
+    { g_easeInOutExpoTable, 8 },
+    { nullptr, 0 }, // easeInCirc
+    { nullptr, 0 }, // easeOutCirc
+    { nullptr, 0 }, // easeInOutCirc
+    { g_easeInBackTable, 8 },
+    { g_easeOutBackTable, 8 },
+    { g_easeInOutBackTable, 8 },
+    { g_easeInElasticTable, 10 },
+    { g_easeOutElasticTable, 10 },
+    { g_easeInOutElasticTable, 10 },
+    { g_easeInBounceTable, 10 },
+    { g_easeOutBounceTable, 10 },
+    { g_easeInOutBounceTable, 10 },
+};
@@ -56,6 +56,9 @@ namespace eez {
 void initAllocHeap(uint8_t *heap, size_t heapSize) {
 }
 void *alloc(size_t size, uint32_t id) {
+#if EEZ_FLOW_PROFILER
+    flow::profilerOnAlloc();
+#endif
 #if LVGL_VERSION_MAJOR >= 9
     return lv_malloc(size);
 #else
@@ -845,7 +848,29 @@ static Unit getDerivedUnit(Unit unit, float factor) {
 	return UNIT_UNKNOWN;
 }
 static const float FACTORS[] = { 1E-12F, 1E-9F, 1E-6F, 1E-3F, 1E0F, 1E3F, 1E6F, 1E9F, 1E12F };
+static const size_t NUM_UNITS = sizeof(g_baseUnit) / sizeof(Unit);
+static bool g_hasDerivedUnitsInitialized;
+static bool g_hasDerivedUnits[NUM_UNITS];
+static bool hasDerivedUnits(Unit unit) {
+	if (unit == UNIT_UNKNOWN) {
+		return false;
+	}
+	if (!g_hasDerivedUnitsInitialized) {
+		for (size_t i = 0; i < NUM_UNITS; i++) {
+			bool hasDerived = g_unitFactor[i] != 1.0f;
+			for (size_t j = 0; j < NUM_UNITS && !hasDerived; j++) {
+				hasDerived = j != i && g_baseUnit[j] == g_baseUnit[i];
+			}
+			g_hasDerivedUnits[i] = hasDerived;
+		}
+		g_hasDerivedUnitsInitialized = true;
+	}
+	return g_hasDerivedUnits[unit];
+}
 Unit findDerivedUnit(float value, Unit unit) {
+	if (!hasDerivedUnits(unit)) {
+		return unit;
+	}
 	Unit result;
 	for (int factorIndex = 1; ; factorIndex++) {
 		float factor = FACTORS[factorIndex];
@@ -962,13 +987,13 @@ float remapOutCubic(float x, float x1, float y1, float x2, float y2) {
 }
 float remapExp(float x, float x1, float y1, float x2, float y2) {
     float t = remap(x, x1, 0, x2, 1);
-    t = t == 0 ? 0 : float(pow(2, 10 * (t - 1)));
+    t = ease(EASING_IN_EXPO, t);
     x = remap(t, 0, x1, 1, x2);
     return remap(x, x1, y1, x2, y2);
 }
 float remapOutExp(float x, float x1, float y1, float x2, float y2) {
     float t = remap(x, x1, 0, x2, 1);
-    t = t == 1 ? 1 : float(1 - pow(2, -10 * t));
+    t = ease(EASING_OUT_EXPO, t);
     x = remap(t, 0, x1, 1, x2);
     return remap(x, x1, y1, x2, y2);
 }
@@ -1018,21 +1043,152 @@ void stringAppendUInt64(char *str, size_t maxStrLength, uint64_t value) {
     auto n = strlen(str);
     snprintf(str + n, maxStrLength - n, "%ju", value);
 }
+static const double g_pow10[] = { 1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8, 1E9, 1E10 };
+static bool scaleAndRound(double x, int numDecimalPlaces, uint64_t &result) {
+    double scaled = numDecimalPlaces >= 0 ? x * g_pow10[numDecimalPlaces] : x / g_pow10[-numDecimalPlaces];
+    if (!(scaled < 9E15)) {
+        return false;
+    }
+    uint64_t u = (uint64_t)scaled;
+    double frac = scaled - (double)u;
+    if (frac == 0.5) {
+        double error = numDecimalPlaces >= 0 ? fma(x, g_pow10[numDecimalPlaces], -scaled) : fma(-scaled, g_pow10[-numDecimalPlaces], x);
+        if (error > 0 || (error == 0 && (u & 1))) {
+            u++;
+        }
+    } else if (frac > 0.5) {
+        u++;
+    }
+    result = u;
+    return true;
+}
+static bool roundToSignificantDigits(double x, uint64_t &u, int &numDecimalPlaces) {
+    if (x == 0) {
+        u = 0;
+        numDecimalPlaces = 0;
+        return true;
+    }
+    int exp2;
+    frexp(x, &exp2);
+    int exp10 = ((exp2 - 1) * 78913) >> 18;
+    for (int i = 0; i < 3; i++) {
+        if (exp10 < -5 || exp10 > 6 || !scaleAndRound(x, 5 - exp10, u)) {
+            return false;
+        }
+        if (u >= 1000000) {
+            exp10++;
+        } else if (u < 100000) {
+            exp10--;
+        } else {
+            break;
+        }
+    }
+    if (u < 100000 || u >= 1000000 || exp10 < -4 || exp10 >= 6) {
+        return false;
+    }
+    numDecimalPlaces = 5 - exp10;
+    return true;
+}
+static size_t formatFloatFallback(char *buffer, size_t bufferSize, double value, int numDecimalPlaces, int flags) {
+    int n = numDecimalPlaces < 0 ? snprintf(buffer, bufferSize, "%g", value) : snprintf(buffer, bufferSize, "%.*f", numDecimalPlaces, value);
+    if (n < 0) {
+        return 0;
+    }
+    if (n >= (int)bufferSize) {
+        n = bufferSize - 1;
+    }
+    if (!(flags & FORMAT_FLOAT_TRIM_ZEROS) || memchr(buffer, 'e', n)) {
+        return n;
+    }
+    const char *dot = (const char *)memchr(buffer, '.', n);
+    if (!dot) {
+        if ((flags & FORMAT_FLOAT_KEEP_ONE_DECIMAL) && n + 2 < (int)bufferSize) {
+            buffer[n++] = '.';
+            buffer[n++] = '0';
+        }
+        return n;
+    }
+    int decimalPointIndex = dot - buffer;
+    int minLength = (flags & FORMAT_FLOAT_KEEP_ONE_DECIMAL) ? decimalPointIndex + 2 : decimalPointIndex;
+    if (n < minLength) {
+        buffer[n++] = '0';
+    }
+    while (n > minLength && buffer[n - 1] == '0') {
+        n--;
+    }
+    if (n == decimalPointIndex + 1 && !(flags & FORMAT_FLOAT_KEEP_ONE_DECIMAL)) {
+        n--;
+    }
+    return n;
+}
+size_t formatFloat(char *str, size_t maxStrLength, double value, int numDecimalPlaces, int flags) {
+    if (maxStrLength == 0) {
+        return 0;
+    }
+    size_t n;
+    uint64_t u;
+    int numDecimals = numDecimalPlaces;
+    double x = fabs(value);
+    bool ok;
+    if (numDecimalPlaces < 0) {
+        ok = roundToSignificantDigits(x, u, numDecimals);
+    } else {
+        ok = numDecimalPlaces <= 10 && scaleAndRound(x, numDecimalPlaces, u);
+    }
+    if (ok) {
+        if (numDecimalPlaces < 0 || (flags & FORMAT_FLOAT_TRIM_ZEROS)) {
+            while (numDecimals > 0 && u % 10 == 0) {
+                u /= 10;
+                numDecimals--;
+            }
+            if (numDecimals == 0 && (flags & FORMAT_FLOAT_KEEP_ONE_DECIMAL)) {
+                u *= 10;
+                numDecimals = 1;
+            }
+        }
+        char buffer[32];
+        char *end = buffer + sizeof(buffer);
+        char *p = end;
+        for (int i = 0; i < numDecimals; i++) {
+            *--p = '0' + u % 10;
+            u /= 10;
+        }
+        if (numDecimals > 0) {
+            *--p = '.';
+        }
+        do {
+            *--p = '0' + u % 10;
+            u /= 10;
+        } while (u);
+        if (signbit(value)) {
+            *--p = '-';
+        }
+        n = end - p;
+        if (n > maxStrLength - 1) {
+            n = maxStrLength - 1;
+        }
+        memcpy(str, p, n);
+    } else {
+        n = formatFloatFallback(str, maxStrLength, value, numDecimalPlaces, flags);
+    }
+    str[n] = 0;
+    return n;
+}
 void stringAppendFloat(char *str, size_t maxStrLength, float value) {
     auto n = strlen(str);
-    snprintf(str + n, maxStrLength - n, "%g", value);
+    formatFloat(str + n, maxStrLength - n, value, -1, 0);
 }
 void stringAppendFloat(char *str, size_t maxStrLength, float value, int numDecimalPlaces) {
     auto n = strlen(str);
-    snprintf(str + n, maxStrLength - n, "%.*f", numDecimalPlaces, value);
+    formatFloat(str + n, maxStrLength - n, value, numDecimalPlaces, 0);
 }
 void stringAppendDouble(char *str, size_t maxStrLength, double value) {
     auto n = strlen(str);
-    snprintf(str + n, maxStrLength - n, "%g", value);
+    formatFloat(str + n, maxStrLength - n, value, -1, 0);
 }
 void stringAppendDouble(char *str, size_t maxStrLength, double value, int numDecimalPlaces) {
     auto n = strlen(str);
-    snprintf(str + n, maxStrLength - n, "%.*f", numDecimalPlaces, value);
+    formatFloat(str + n, maxStrLength - n, value, numDecimalPlaces, 0);
 }
 void stringAppendVoltage(char *str, size_t maxStrLength, float value) {
     auto n = strlen(str);
@@ -1479,61 +1635,61 @@ static const float c2 = c1 * 1.525f;
 static const float c3 = c1 + 1.0f;
 static const float c4 = (2 * PI_FLOAT) / 3;
 static const float c5 = (2 * PI_FLOAT) / 4.5f;
-extern "C" float eez_linear(float x) {
+static float linearExact(float x) {
     return x;
 }
-extern "C" float eez_easeInQuad(float x) {
+static float easeInQuadExact(float x) {
     return x * x;
 }
-extern "C" float eez_easeOutQuad(float x) {
+static float easeOutQuadExact(float x) {
     return 1 - (1 - x) * (1 - x);
 }
-extern "C" float eez_easeInOutQuad(float x) {
+static float easeInOutQuadExact(float x) {
     return x < 0.5f ? 2 * x * x : 1 - powf(-2 * x + 2, 2) / 2;
 }
-extern "C" float eez_easeInCubic(float x) {
+static float easeInCubicExact(float x) {
     return x * x * x;
 }
-extern "C" float eez_easeOutCubic(float x) {
+static float easeOutCubicExact(float x) {
     return 1 - pow(1 - x, 3);
 }
-extern "C" float eez_easeInOutCubic(float x) {
+static float easeInOutCubicExact(float x) {
     return x < 0.5f ? 4 * x * x * x : 1 - powf(-2 * x + 2, 3) / 2;
 }
-extern "C" float eez_easeInQuart(float x) {
+static float easeInQuartExact(float x) {
     return x * x * x * x;
 }
-extern "C" float eez_easeOutQuart(float x) {
+static float easeOutQuartExact(float x) {
     return 1 - powf(1 - x, 4);
 }
-extern "C" float eez_easeInOutQuart(float x) {
+static float easeInOutQuartExact(float x) {
     return x < 0.5 ? 8 * x * x * x * x : 1 - powf(-2 * x + 2, 4) / 2;
 }
-extern "C" float eez_easeInQuint(float x) {
+static float easeInQuintExact(float x) {
     return x * x * x * x * x;
 }
-extern "C" float eez_easeOutQuint(float x) {
+static float easeOutQuintExact(float x) {
     return 1 - powf(1 - x, 5);
 }
-extern "C" float eez_easeInOutQuint(float x) {
+static float easeInOutQuintExact(float x) {
     return x < 0.5f ? 16 * x * x * x * x * x : 1 - powf(-2 * x + 2, 5) / 2;
 }
-extern "C" float eez_easeInSine(float x) {
+static float easeInSineExact(float x) {
     return 1 - cosf((x * PI_FLOAT) / 2);
 }
-extern "C" float eez_easeOutSine(float x) {
+static float easeOutSineExact(float x) {
     return sinf((x * PI_FLOAT) / 2);
 }
-extern "C" float eez_easeInOutSine(float x) {
+static float easeInOutSineExact(float x) {
     return -(cosf(PI_FLOAT * x) - 1) / 2;
 }
-extern "C" float eez_easeInExpo(float x) {
+static float easeInExpoExact(float x) {
     return x == 0 ? 0 : powf(2, 10 * x - 10);
 }
-extern "C" float eez_easeOutExpo(float x) {
+static float easeOutExpoExact(float x) {
     return x == 1 ? 1 : 1 - powf(2, -10 * x);
 }
-extern "C" float eez_easeInOutExpo(float x) {
+static float easeInOutExpoExact(float x) {
     return x == 0
         ? 0
         : x == 1
@@ -1542,43 +1698,43 @@ extern "C" float eez_easeInOutExpo(float x) {
         ? powf(2, 20 * x - 10) / 2
         : (2 - powf(2, -20 * x + 10)) / 2;
 }
-extern "C" float eez_easeInCirc(float x) {
+static float easeInCircExact(float x) {
     return 1 - sqrtf(1 - powf(x, 2));
 }
-extern "C" float eez_easeOutCirc(float x) {
+static float easeOutCircExact(float x) {
     return sqrtf(1 - powf(x - 1, 2));
 }
-extern "C" float eez_easeInOutCirc(float x) {
+static float easeInOutCircExact(float x) {
     return x < 0.5
         ? (1 - sqrtf(1 - pow(2 * x, 2))) / 2
         : (sqrtf(1 - powf(-2 * x + 2, 2)) + 1) / 2;
 }
-extern "C" float eez_easeInBack(float x) {
+static float easeInBackExact(float x) {
     return c3 * x * x * x - c1 * x * x;
 }
-extern "C" float eez_easeOutBack(float x) {
+static float easeOutBackExact(float x) {
     return 1 + c3 * powf(x - 1, 3) + c1 * powf(x - 1, 2);
 }
-extern "C" float eez_easeInOutBack(float x) {
+static float easeInOutBackExact(float x) {
     return x < 0.5
         ? (powf(2 * x, 2) * ((c2 + 1) * 2 * x - c2)) / 2
         : (powf(2 * x - 2, 2) * ((c2 + 1) * (x * 2 - 2) + c2) + 2) / 2;
 }
-extern "C" float eez_easeInElastic(float x) {
+static float easeInElasticExact(float x) {
     return x == 0
         ? 0
         : x == 1
         ? 1
         : -powf(2, 10 * x - 10) * sinf((x * 10 - 10.75f) * c4);
 }
-extern "C" float eez_easeOutElastic(float x) {
+static float easeOutElasticExact(float x) {
     return x == 0
         ? 0
         : x == 1
         ? 1
         : powf(2, -10 * x) * sinf((x * 10 - 0.75f) * c4) + 1;
 }
-extern "C" float eez_easeInOutElastic(float x) {
+static float easeInOutElasticExact(float x) {
     return x == 0
         ? 0
         : x == 1
@@ -1587,11 +1743,11 @@ extern "C" float eez_easeInOutElastic(float x) {
         ? -(powf(2, 20 * x - 10) * sinf((20 * x - 11.125f) * c5)) / 2
         : (powf(2, -20 * x + 10) * sinf((20 * x - 11.125f) * c5)) / 2 + 1;
 }
-extern "C" float eez_easeOutBounce(float x);
-extern "C" float eez_easeInBounce(float x) {
-    return 1 - eez_easeOutBounce(1 - x);
+static float easeOutBounceExact(float x);
+static float easeInBounceExact(float x) {
+    return 1 - easeOutBounceExact(1 - x);
 }
-extern "C" float eez_easeOutBounce(float x) {
+static float easeOutBounceExact(float x) {
     static const float n1 = 7.5625f;
     static const float d1 = 2.75f;
     if (x < 1 / d1) {
@@ -1606,11 +1762,152 @@ extern "C" float eez_easeOutBounce(float x) {
         x -= 2.625f / d1;
         return n1 * x * x + 0.984375f;
     }
-};
-extern "C" float eez_easeInOutBounce(float x) {
+}
+static float easeInOutBounceExact(float x) {
     return x < 0.5
-        ? (1 - eez_easeOutBounce(1 - 2 * x)) / 2
-        : (1 + eez_easeOutBounce(2 * x - 1)) / 2;
+        ? (1 - easeOutBounceExact(1 - 2 * x)) / 2
+        : (1 + easeOutBounceExact(2 * x - 1)) / 2;
+}
+#include "eez-easing-tables.h"
+namespace eez {
+static inline float easeTable(const EasingTable &table, float x) {
+    int n = 1 << table.bits;
+    float position = x * n;
+    int i = (int)position;
+    if (i >= n) {
+        return table.samples[n] * (1.0f / EEZ_EASING_TABLE_ONE);
+    }
+    float a = table.samples[i];
+    return (a + (table.samples[i + 1] - a) * (position - i)) * (1.0f / EEZ_EASING_TABLE_ONE);
+}
+static inline float easeTable(int easingFunc, float x, EasingFuncType exact) {
+    return x >= 0 && x <= 1 ? easeTable(g_easingTables[easingFunc], x) : exact(x);
+}
+}
+extern "C" float eez_linear(float x) {
+    return x;
+}
+extern "C" float eez_easeInQuad(float x) {
+    return x * x;
+}
+extern "C" float eez_easeOutQuad(float x) {
+    return 1 - (1 - x) * (1 - x);
+}
+extern "C" float eez_easeInOutQuad(float x) {
+    if (x < 0.5f) {
+        return 2 * x * x;
+    }
+    float t = -2 * x + 2;
+    return 1 - t * t / 2;
+}
+extern "C" float eez_easeInCubic(float x) {
+    return x * x * x;
+}
+extern "C" float eez_easeOutCubic(float x) {
+    float t = 1 - x;
+    return 1 - t * t * t;
+}
+extern "C" float eez_easeInOutCubic(float x) {
+    if (x < 0.5f) {
+        return 4 * x * x * x;
+    }
+    float t = -2 * x + 2;
+    return 1 - t * t * t / 2;
+}
+extern "C" float eez_easeInQuart(float x) {
+    float x2 = x * x;
+    return x2 * x2;
+}
+extern "C" float eez_easeOutQuart(float x) {
+    float t = (1 - x) * (1 - x);
+    return 1 - t * t;
+}
+extern "C" float eez_easeInOutQuart(float x) {
+    if (x < 0.5f) {
+        float x2 = x * x;
+        return 8 * x2 * x2;
+    }
+    float t = (-2 * x + 2) * (-2 * x + 2);
+    return 1 - t * t / 2;
+}
+extern "C" float eez_easeInQuint(float x) {
+    float x2 = x * x;
+    return x2 * x2 * x;
+}
+extern "C" float eez_easeOutQuint(float x) {
+    float t = 1 - x;
+    float t2 = t * t;
+    return 1 - t2 * t2 * t;
+}
+extern "C" float eez_easeInOutQuint(float x) {
+    if (x < 0.5f) {
+        float x2 = x * x;
+        return 16 * x2 * x2 * x;
+    }
+    float t = -2 * x + 2;
+    float t2 = t * t;
+    return 1 - t2 * t2 * t / 2;
+}
+extern "C" float eez_easeInSine(float x) {
+    return eez::easeTable(eez::EASING_IN_SINE, x, easeInSineExact);
+}
+extern "C" float eez_easeOutSine(float x) {
+    return eez::easeTable(eez::EASING_OUT_SINE, x, easeOutSineExact);
+}
+extern "C" float eez_easeInOutSine(float x) {
+    return eez::easeTable(eez::EASING_IN_OUT_SINE, x, easeInOutSineExact);
+}
+extern "C" float eez_easeInExpo(float x) {
+    return x == 0 ? 0 : eez::easeTable(eez::EASING_IN_EXPO, x, easeInExpoExact);
+}
+extern "C" float eez_easeOutExpo(float x) {
+    return x == 1 ? 1 : eez::easeTable(eez::EASING_OUT_EXPO, x, easeOutExpoExact);
+}
+extern "C" float eez_easeInOutExpo(float x) {
+    return eez::easeTable(eez::EASING_IN_OUT_EXPO, x, easeInOutExpoExact);
+}
+extern "C" float eez_easeInCirc(float x) {
+    return 1 - sqrtf(1 - x * x);
+}
+extern "C" float eez_easeOutCirc(float x) {
+    return sqrtf(1 - (x - 1) * (x - 1));
+}
+extern "C" float eez_easeInOutCirc(float x) {
+    return x < 0.5f
+        ? (1 - sqrtf(1 - 4 * x * x)) / 2
+        : (sqrtf(1 - (-2 * x + 2) * (-2 * x + 2)) + 1) / 2;
+}
+extern "C" float eez_easeInBack(float x) {
+    return c3 * x * x * x - c1 * x * x;
+}
+extern "C" float eez_easeOutBack(float x) {
+    float t = x - 1;
+    return 1 + c3 * t * t * t + c1 * t * t;
+}
+extern "C" float eez_easeInOutBack(float x) {
+    if (x < 0.5f) {
+        return 2 * x * x * ((c2 + 1) * 2 * x - c2);
+    }
+    float t = 2 * x - 2;
+    return (t * t * ((c2 + 1) * t + c2) + 2) / 2;
+}
+extern "C" float eez_easeInElastic(float x) {
+    return eez::easeTable(eez::EASING_IN_ELASTIC, x, easeInElasticExact);
+}
+extern "C" float eez_easeOutElastic(float x) {
+    return eez::easeTable(eez::EASING_OUT_ELASTIC, x, easeOutElasticExact);
+}
+extern "C" float eez_easeInOutElastic(float x) {
+    return eez::easeTable(eez::EASING_IN_OUT_ELASTIC, x, easeInOutElasticExact);
+}
+extern "C" float eez_easeInBounce(float x) {
+    return easeInBounceExact(x);
+}
+extern "C" float eez_easeOutBounce(float x) {
+    return easeOutBounceExact(x);
+}
+extern "C" float eez_easeInOutBounce(float x) {
+    return easeInOutBounceExact(x);
 }
 namespace eez {
 EasingFuncType g_easingFuncs[] = {
@@ -1646,6 +1943,96 @@ EasingFuncType g_easingFuncs[] = {
     eez_easeOutBounce,
     eez_easeInOutBounce,
 };
+EasingFuncType g_easingExactFuncs[] = {
+    linearExact,
+    easeInQuadExact,
+    easeOutQuadExact,
+    easeInOutQuadExact,
+    easeInCubicExact,
+    easeOutCubicExact,
+    easeInOutCubicExact,
+    easeInQuartExact,
+    easeOutQuartExact,
+    easeInOutQuartExact,
+    easeInQuintExact,
+    easeOutQuintExact,
+    easeInOutQuintExact,
+    easeInSineExact,
+    easeOutSineExact,
+    easeInOutSineExact,
+    easeInExpoExact,
+    easeOutExpoExact,
+    easeInOutExpoExact,
+    easeInCircExact,
+    easeOutCircExact,
+    easeInOutCircExact,
+    easeInBackExact,
+    easeOutBackExact,
+    easeInOutBackExact,
+    easeInElasticExact,
+    easeOutElasticExact,
+    easeInOutElasticExact,
+    easeInBounceExact,
+    easeOutBounceExact,
+    easeInOutBounceExact,
+};
+float ease(int easingFunc, float x) {
+    auto &table = g_easingTables[easingFunc];
+    if (table.samples && x >= 0 && x <= 1) {
+        return easeTable(table, x);
+    }
+    return g_easingFuncs[easingFunc](x);
+}
+int32_t easeFixed(int easingFunc, int32_t x) {
+    if (x <= 0) {
+        x = 0;
+    } else if (x >= EASING_FIXED_ONE) {
+        x = EASING_FIXED_ONE;
+    }
+    auto &table = g_easingTables[easingFunc];
+    if (!table.samples) {
+        return easingFunc == EASING_LINEAR ? x : (int32_t)roundf(g_easingFuncs[easingFunc](x * (1.0f / EASING_FIXED_ONE)) * EASING_FIXED_ONE);
+    }
+    int shift = EASING_FIXED_BITS - table.bits;
+    int32_t i = x >> shift;
+    int32_t a = table.samples[i];
+    if (i == (1 << table.bits)) {
+        return a * (EASING_FIXED_ONE / EEZ_EASING_TABLE_ONE);
+    }
+    int32_t fraction = x & ((1 << shift) - 1);
+    return (a * (1 << shift) + (table.samples[i + 1] - a) * fraction) * (EASING_FIXED_ONE / EEZ_EASING_TABLE_ONE) >> shift;
+}
+void easeBatch(int easingFunc, const float *x, float *y, size_t count) {
+    auto &table = g_easingTables[easingFunc];
+    if (!table.samples) {
+        auto func = g_easingFuncs[easingFunc];
+        for (size_t i = 0; i < count; i++) {
+            y[i] = func(x[i]);
+        }
+        return;
+    }
+    auto exact = g_easingExactFuncs[easingFunc];
+    int n = 1 << table.bits;
+    const int16_t *samples = table.samples;
+    const float scale = 1.0f / EEZ_EASING_TABLE_ONE;
+    for (size_t i = 0; i < count; i++) {
+        float xi = x[i];
+        if (xi >= 0 && xi < 1) {
+            float position = xi * n;
+            int j = (int)position;
+            j = j < n ? j : n - 1;
+            float a = samples[j];
+            y[i] = (a + (samples[j + 1] - a) * (position - j)) * scale;
+        } else {
+            y[i] = xi == 1 ? samples[n] * scale : exact(xi);
+        }
+    }
+}
+void easeFixedBatch(int easingFunc, const int32_t *x, int32_t *y, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        y[i] = easeFixed(easingFunc, x[i]);
+    }
+}
 } 
 #ifdef EEZ_PLATFORM_SIMULATOR_WIN32
 char *strnstr(const char *s1, const char *s2, size_t n) {
@@ -1784,6 +2171,30 @@ const char *UINT64_value_type_name(const Value &value) {
 bool compare_FLOAT_value(const Value &a, const Value &b) {
     return a.getUnit() == b.getUnit() && a.getFloat() == b.getFloat() && a.getOptions() == b.getOptions();
 }
+static void numberToText(char *text, int count, double value, Unit unit, uint16_t options, bool appendDotZero) {
+    size_t n = 0;
+    if ((options & FLOAT_OPTIONS_LESS_THEN) != 0) {
+        if (count > 2) {
+            text[n++] = '<';
+            text[n++] = ' ';
+        }
+        appendDotZero = false;
+    }
+    if ((options & FLOAT_OPTIONS_FIXED_DECIMALS) != 0) {
+        n += formatFloat(text + n, count - n, value, FLOAT_OPTIONS_GET_NUM_FIXED_DECIMALS(options), 0);
+    } else {
+        int numDecimalPlaces = unit == UNIT_WATT || unit == UNIT_MILLI_WATT ? 2 : -1;
+        n += formatFloat(text + n, count - n, value, numDecimalPlaces, FORMAT_FLOAT_TRIM_ZEROS | (appendDotZero ? FORMAT_FLOAT_KEEP_ONE_DECIMAL : 0));
+    }
+    const char *unitName = getUnitName(unit);
+    if (unitName && *unitName && n + 1 < (size_t)count) {
+        text[n++] = ' ';
+        while (*unitName && n + 1 < (size_t)count) {
+            text[n++] = *unitName++;
+        }
+        text[n] = 0;
+    }
+}
 void FLOAT_value_to_text(const Value &value, char *text, int count) {
     text[0] = 0;
     float floatValue = value.getFloat();
@@ -1806,54 +2217,7 @@ void FLOAT_value_to_text(const Value &value, char *text, int count) {
         floatValue = 0; 
     }
     if (!isNaN(floatValue)) {
-        if ((value.getOptions() & FLOAT_OPTIONS_LESS_THEN) != 0) {
-            stringAppendString(text, count, "< ");
-			appendDotZero = false;
-        }
-        if (fixedDecimals) {
-            stringAppendFloat(text, count, floatValue, FLOAT_OPTIONS_GET_NUM_FIXED_DECIMALS(options));
-        } else {
-            if (unit == UNIT_WATT || unit == UNIT_MILLI_WATT) {
-                stringAppendFloat(text, count, floatValue, 2);
-            } else {
-                stringAppendFloat(text, count, floatValue);
-            }
-            int n = strlen(text);
-            int decimalPointIndex;
-            for (decimalPointIndex = 0; decimalPointIndex < n; ++decimalPointIndex) {
-                if (text[decimalPointIndex] == '.') {
-                    break;
-                }
-            }
-            if (decimalPointIndex == n) {
-                if (appendDotZero) {
-                    stringAppendString(text, count, ".0");
-                }
-            } else if (decimalPointIndex == n - 1) {
-                if (appendDotZero) {
-                    stringAppendString(text, count, "0");
-                } else {
-                    text[decimalPointIndex] = 0;
-                }
-            } else {
-                if (appendDotZero) {
-                    for (int j = n - 1; j > decimalPointIndex + 1 && text[j] == '0'; j--) {
-                        text[j] = 0;
-                    }
-                } else {
-                    for (int j = n - 1; j >= decimalPointIndex && (text[j] == '0' || text[j] == '.'); j--) {
-                        text[j] = 0;
-                    }
-                }
-            }
-        }
-        const char *unitName = getUnitName(unit);
-        if (unitName && *unitName) {
-            stringAppendString(text, count, " ");
-            stringAppendString(text, count, unitName);
-        }
-    } else {
-        text[0] = 0;
+        numberToText(text, count, floatValue, unit, options, appendDotZero);
     }
 }
 const char *FLOAT_value_type_name(const Value &value) {
@@ -1884,54 +2248,7 @@ void DOUBLE_value_to_text(const Value &value, char *text, int count) {
         doubleValue = 0; 
     }
     if (!isNaN(doubleValue)) {
-        if ((value.getOptions() & FLOAT_OPTIONS_LESS_THEN) != 0) {
-            stringAppendString(text, count, "< ");
-			appendDotZero = false;
-        }
-        if (fixedDecimals) {
-            stringAppendFloat(text, count, doubleValue, FLOAT_OPTIONS_GET_NUM_FIXED_DECIMALS(options));
-        } else {
-            if (unit == UNIT_WATT || unit == UNIT_MILLI_WATT) {
-                stringAppendDouble(text, count, doubleValue, 2);
-            } else {
-                stringAppendDouble(text, count, doubleValue);
-            }
-            int n = strlen(text);
-            int decimalPointIndex;
-            for (decimalPointIndex = 0; decimalPointIndex < n; ++decimalPointIndex) {
-                if (text[decimalPointIndex] == '.') {
-                    break;
-                }
-            }
-            if (decimalPointIndex == n) {
-                if (appendDotZero) {
-                    stringAppendString(text, count, ".0");
-                }
-            } else if (decimalPointIndex == n - 1) {
-                if (appendDotZero) {
-                    stringAppendString(text, count, "0");
-                } else {
-                    text[decimalPointIndex] = 0;
-                }
-            } else {
-                if (appendDotZero) {
-                    for (int j = n - 1; j > decimalPointIndex + 1 && text[j] == '0'; j--) {
-                        text[j] = 0;
-                    }
-                } else {
-                    for (int j = n - 1; j >= decimalPointIndex && (text[j] == '0' || text[j] == '.'); j--) {
-                        text[j] = 0;
-                    }
-                }
-            }
-        }
-        const char *unitName = getUnitName(unit);
-        if (unitName && *unitName) {
-            stringAppendString(text, count, " ");
-            stringAppendString(text, count, unitName);
-        }
-    } else {
-        text[0] = 0;
+        numberToText(text, count, fixedDecimals ? (float)doubleValue : doubleValue, unit, options, appendDotZero);
     }
 }
 const char *DOUBLE_value_type_name(const Value &value) {
@@ -2031,12 +2348,27 @@ void WIDGET_value_to_text(const Value &value, char *text, int count) {
 const char *WIDGET_value_type_name(const Value &value) {
     return "widget";
 }
+#if defined(EEZ_DASHBOARD_API)
 bool compare_JSON_value(const Value &a, const Value &b) {
     return a.int32Value == b.int32Value;
 }
 void JSON_value_to_text(const Value &value, char *text, int count) {
     snprintf(text, count, "json (id=%d)", value.getInt());
 }
+#else
+bool compare_JSON_value(const Value &a, const Value &b) {
+    auto refA = (JsonValueRef *)a.refValue;
+    auto refB = (JsonValueRef *)b.refValue;
+    return refA->document == refB->document && refA->token == refB->token;
+}
+void JSON_value_to_text(const Value &value, char *text, int count) {
+    uint32_t length;
+    const char *json = flow::getJsonText(value, length);
+    if (count > 0) {
+        stringCopyLength(text, count - 1, json, length);
+    }
+}
+#endif
 const char *JSON_value_type_name(const Value &value) {
     return "json";
 }
@@ -2270,11 +2602,17 @@ bool assignValue(Value &dstValue, const Value &srcValue, uint32_t dstValueType)
         } else if (srcValue.isJson() && dstValueType != VALUE_TYPE_JSON) {
             dstValue = flow::convertFromJson(srcValue.getInt(), dstValueType);
         } else {
+#else
+        if (dstValueType == VALUE_TYPE_JSON && srcValue.isString()) {
+            Value jsonValue = flow::parseJson(srcValue);
+            if (jsonValue.isError()) {
+                return false;
+            }
+            dstValue = jsonValue;
+        } else {
 #endif
             dstValue = srcValue;
-#if defined(EEZ_DASHBOARD_API)
         }
-#endif
     }
     return true;
 }
@@ -2615,37 +2953,48 @@ Value Value::toString(uint32_t id) const {
 		return *this;
 	}
     char tempStr[64];
+    const char *str = toStringPtr(tempStr, sizeof(tempStr));
+	return makeStringRef(str, strlen(str), id);
+}
+const char *Value::toStringPtr(char *tempStr, size_t tempStrSize) const {
+	if (isIndirectValueType()) {
+		return getValue().toStringPtr(tempStr, tempStrSize);
+	}
+	if (isString()) {
+        const char *str = getString();
+		return str ? str : "";
+	}
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4474)
 #endif
     if (type == VALUE_TYPE_DOUBLE) {
-        snprintf(tempStr, sizeof(tempStr), "%g", doubleValue);
+        formatFloat(tempStr, tempStrSize, doubleValue, -1, 0);
     } else if (type == VALUE_TYPE_FLOAT) {
-        snprintf(tempStr, sizeof(tempStr), "%g", floatValue);
+        formatFloat(tempStr, tempStrSize, floatValue, -1, 0);
     } else if (type == VALUE_TYPE_INT8) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRId8 "", int8Value);
+        snprintf(tempStr, tempStrSize, "%" PRId8 "", int8Value);
     } else if (type == VALUE_TYPE_UINT8) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRIu8 "", uint8Value);
+        snprintf(tempStr, tempStrSize, "%" PRIu8 "", uint8Value);
     } else if (type == VALUE_TYPE_INT16) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRId16 "", int16Value);
+        snprintf(tempStr, tempStrSize, "%" PRId16 "", int16Value);
     } else if (type == VALUE_TYPE_UINT16) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRIu16 "", uint16Value);
+        snprintf(tempStr, tempStrSize, "%" PRIu16 "", uint16Value);
     } else if (type == VALUE_TYPE_INT32) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRId32 "", int32Value);
+        snprintf(tempStr, tempStrSize, "%" PRId32 "", int32Value);
     } else if (type == VALUE_TYPE_UINT32) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRIu32 "", uint32Value);
+        snprintf(tempStr, tempStrSize, "%" PRIu32 "", uint32Value);
     } else if (type == VALUE_TYPE_INT64) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRId64 "", int64Value);
+        snprintf(tempStr, tempStrSize, "%" PRId64 "", int64Value);
     } else if (type == VALUE_TYPE_UINT64) {
-        snprintf(tempStr, sizeof(tempStr), "%" PRIu64 "", uint64Value);
+        snprintf(tempStr, tempStrSize, "%" PRIu64 "", uint64Value);
     } else {
-        toText(tempStr, sizeof(tempStr));
+        toText(tempStr, tempStrSize);
     }
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
-	return makeStringRef(tempStr, strlen(tempStr), id);
+	return tempStr;
 }
 Value Value::makeStringRef(const char *str, int len, uint32_t id) {
     auto stringRef = ObjectAllocator<StringRef>::allocate(id);
@@ -2670,18 +3019,23 @@ Value Value::makeStringRef(const char *str, int len, uint32_t id) {
 	return value;
 }
 Value Value::concatenateString(const Value &str1, const Value &str2) {
+    const char *s1 = str1.getString();
+    const char *s2 = str2.getString();
+    return concatenateString(s1, strlen(s1), s2, strlen(s2));
+}
+Value Value::concatenateString(const char *str1, size_t len1, const char *str2, size_t len2) {
     auto stringRef = ObjectAllocator<StringRef>::allocate(0xbab14c6a);;
 	if (stringRef == nullptr) {
 		return Value(0, VALUE_TYPE_NULL);
 	}
-    auto newStrLen = strlen(str1.getString()) + strlen(str2.getString()) + 1;
-    stringRef->str = (char *)alloc(newStrLen, 0xb5320162);
+    stringRef->str = (char *)alloc(len1 + len2 + 1, 0xb5320162);
     if (stringRef->str == nullptr) {
         ObjectAllocator<StringRef>::deallocate(stringRef);
         return Value(0, VALUE_TYPE_NULL);
     }
-    stringCopy(stringRef->str, newStrLen, str1.getString());
-    stringAppendString(stringRef->str, newStrLen, str2.getString());
+    memcpy(stringRef->str, str1, len1);
+    memcpy(stringRef->str + len1, str2, len2);
+    stringRef->str[len1 + len2] = 0;
     stringRef->refCounter = 1;
     Value value;
     value.type = VALUE_TYPE_STRING_REF;
@@ -3001,31 +3355,293 @@ void executeComponent(FlowState *flowState, unsigned componentIndex) {
 } 
 } 
 // -----------------------------------------------------------------------------
-// flow/date.cpp
+// flow/crypto.cpp
 // -----------------------------------------------------------------------------
-#include <stdio.h>
+#include <string.h>
 namespace eez {
 namespace flow {
-namespace date {
-#define SECONDS_PER_MINUTE 60UL
-#define SECONDS_PER_HOUR (SECONDS_PER_MINUTE * 60)
-#define SECONDS_PER_DAY (SECONDS_PER_HOUR * 24)
-#define LEAP_YEAR(Y)                                                                               \
-    (((1970 + Y) > 0) && !((1970 + Y) % 4) && (((1970 + Y) % 100) || !((1970 + Y) % 400)))
-static const uint8_t monthDays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-enum Week { Last, First, Second, Third, Fourth };
-enum DayOfWeek { Sun = 1, Mon, Tue, Wed, Thu, Fri, Sat };
-enum Month { Jan = 1, Feb, Mar, Apr, May, Jun, Jul, Aug, Sep, Oct, Nov, Dec };
-struct TimeChangeRule {
-    Week week;
-    DayOfWeek dow;
-    uint8_t month;
-    uint8_t hours;
-};
-static struct {
-    TimeChangeRule dstStart;
-    TimeChangeRule dstEnd;
-} g_dstRules[] = {
+static bool getHashInput(const Value &value, const uint8_t *&data, uint32_t &dataLen) {
+    if (value.isString()) {
+        const char *str = value.getString();
+        data = (const uint8_t *)str;
+        dataLen = strlen(str);
+        return true;
+    }
+    if (value.isBlob()) {
+        auto blobRef = value.getBlob();
+        data = blobRef->blob;
+        dataLen = blobRef->len;
+        return true;
+    }
+    return false;
+}
+bool Sha256Stream::update(const Value &value) {
+    const uint8_t *data;
+    uint32_t dataLen;
+    Value value2 = value.getValue();
+    if (!context || !getHashInput(value2, data, dataLen)) {
+        return false;
+    }
+    eez_crypto_sha256_update(context, data, dataLen);
+    return true;
+}
+bool Sha256Stream::finish(uint8_t *digest) {
+    if (!context) {
+        return false;
+    }
+    eez_crypto_sha256_end(context, digest);
+    context = nullptr;
+    return true;
+}
+Value Sha256Stream::finish() {
+    uint8_t digest[EEZ_CRYPTO_SHA256_SIZE];
+    if (!finish(digest)) {
+        return Value::makeError();
+    }
+    return Value::makeBlobRef(digest, EEZ_CRYPTO_SHA256_SIZE, 0x6c2f5a11);
+}
+} 
+} 
+#if !defined(EEZ_CRYPTO_ADAPTER) || !defined(ESP_PLATFORM)
+namespace eez {
+namespace flow {
+struct Sha256SoftContext {
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t buffer[64];
+};
+static const uint32_t g_sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define SHA256_S0(x) (SHA256_ROTR(x, 2) ^ SHA256_ROTR(x, 13) ^ SHA256_ROTR(x, 22))
+#define SHA256_S1(x) (SHA256_ROTR(x, 6) ^ SHA256_ROTR(x, 11) ^ SHA256_ROTR(x, 25))
+#define SHA256_G0(x) (SHA256_ROTR(x, 7) ^ SHA256_ROTR(x, 18) ^ ((x) >> 3))
+#define SHA256_G1(x) (SHA256_ROTR(x, 17) ^ SHA256_ROTR(x, 19) ^ ((x) >> 10))
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i) \
+    do { \
+        uint32_t t1 = h + SHA256_S1(e) + (g ^ (e & (f ^ g))) + g_sha256K[i] + w[(i) & 15]; \
+        uint32_t t2 = SHA256_S0(a) + ((a & b) | (c & (a | b))); \
+        d += t1; \
+        h = t1 + t2; \
+    } while (0)
+static void sha256ProcessBlocks(uint32_t *state, const uint8_t *data, size_t numBlocks) {
+    uint32_t w[16];
+    while (numBlocks--) {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i += 8) {
+            for (int j = i; j < i + 8; j++) {
+                if (j < 16) {
+                    w[j] = (uint32_t)data[j * 4] << 24 | (uint32_t)data[j * 4 + 1] << 16 | (uint32_t)data[j * 4 + 2] << 8 | data[j * 4 + 3];
+                } else {
+                    w[j & 15] += SHA256_G1(w[(j - 2) & 15]) + w[(j - 7) & 15] + SHA256_G0(w[(j - 15) & 15]);
+                }
+            }
+            SHA256_ROUND(a, b, c, d, e, f, g, h, i);
+            SHA256_ROUND(h, a, b, c, d, e, f, g, i + 1);
+            SHA256_ROUND(g, h, a, b, c, d, e, f, i + 2);
+            SHA256_ROUND(f, g, h, a, b, c, d, e, i + 3);
+            SHA256_ROUND(e, f, g, h, a, b, c, d, i + 4);
+            SHA256_ROUND(d, e, f, g, h, a, b, c, i + 5);
+            SHA256_ROUND(c, d, e, f, g, h, a, b, i + 6);
+            SHA256_ROUND(b, c, d, e, f, g, h, a, i + 7);
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        data += 64;
+    }
+}
+static void sha256Init(Sha256SoftContext &ctx) {
+    static const uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    memcpy(ctx.state, initialState, sizeof(initialState));
+    ctx.length = 0;
+}
+static void sha256Update(Sha256SoftContext &ctx, const uint8_t *data, size_t length) {
+    size_t used = ctx.length & 63;
+    ctx.length += length;
+    if (used) {
+        size_t n = 64 - used < length ? 64 - used : length;
+        memcpy(ctx.buffer + used, data, n);
+        data += n;
+        length -= n;
+        if (used + n < 64) {
+            return;
+        }
+        sha256ProcessBlocks(ctx.state, ctx.buffer, 1);
+    }
+    sha256ProcessBlocks(ctx.state, data, length / 64);
+    memcpy(ctx.buffer, data + (length & ~(size_t)63), length & 63);
+}
+static void sha256Final(Sha256SoftContext &ctx, uint8_t *digest) {
+    uint64_t bits = ctx.length * 8;
+    size_t used = ctx.length & 63;
+    ctx.buffer[used++] = 0x80;
+    if (used > 56) {
+        memset(ctx.buffer + used, 0, 64 - used);
+        sha256ProcessBlocks(ctx.state, ctx.buffer, 1);
+        used = 0;
+    }
+    memset(ctx.buffer + used, 0, 56 - used);
+    for (int i = 0; i < 8; i++) {
+        ctx.buffer[56 + i] = (uint8_t)(bits >> (56 - i * 8));
+    }
+    sha256ProcessBlocks(ctx.state, ctx.buffer, 1);
+    for (int i = 0; i < 8; i++) {
+        digest[i * 4] = ctx.state[i] >> 24;
+        digest[i * 4 + 1] = ctx.state[i] >> 16;
+        digest[i * 4 + 2] = ctx.state[i] >> 8;
+        digest[i * 4 + 3] = ctx.state[i];
+    }
+}
+static const uint8_t g_aesSbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+static inline uint8_t aesXtime(uint8_t x) {
+    return (x << 1) ^ ((x >> 7) * 0x1b);
+}
+static int aesExpandKey(const uint8_t *key, size_t keyLength, uint8_t *roundKeys) {
+    int nk = keyLength / 4;
+    int numRounds = nk + 6;
+    memcpy(roundKeys, key, keyLength);
+    uint8_t rcon = 1;
+    for (int i = nk; i < 4 * (numRounds + 1); i++) {
+        uint8_t t[4];
+        memcpy(t, roundKeys + (i - 1) * 4, 4);
+        if (i % nk == 0) {
+            uint8_t first = t[0];
+            t[0] = g_aesSbox[t[1]] ^ rcon;
+            t[1] = g_aesSbox[t[2]];
+            t[2] = g_aesSbox[t[3]];
+            t[3] = g_aesSbox[first];
+            rcon = aesXtime(rcon);
+        } else if (nk > 6 && i % nk == 4) {
+            for (int j = 0; j < 4; j++) {
+                t[j] = g_aesSbox[t[j]];
+            }
+        }
+        for (int j = 0; j < 4; j++) {
+            roundKeys[i * 4 + j] = roundKeys[(i - nk) * 4 + j] ^ t[j];
+        }
+    }
+    return numRounds;
+}
+static void aesEncryptBlock(const uint8_t *roundKeys, int numRounds, const uint8_t *input, uint8_t *output) {
+    uint8_t s[16];
+    for (int i = 0; i < 16; i++) {
+        s[i] = input[i] ^ roundKeys[i];
+    }
+    for (int round = 1; round <= numRounds; round++) {
+        uint8_t t[16];
+        for (int i = 0; i < 16; i++) {
+            t[i] = g_aesSbox[s[(i + 4 * (i % 4)) % 16]];
+        }
+        if (round < numRounds) {
+            for (int c = 0; c < 16; c += 4) {
+                uint8_t a0 = t[c], a1 = t[c + 1], a2 = t[c + 2], a3 = t[c + 3];
+                uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                t[c] ^= all ^ aesXtime(a0 ^ a1);
+                t[c + 1] ^= all ^ aesXtime(a1 ^ a2);
+                t[c + 2] ^= all ^ aesXtime(a2 ^ a3);
+                t[c + 3] ^= all ^ aesXtime(a3 ^ a0);
+            }
+        }
+        for (int i = 0; i < 16; i++) {
+            s[i] = t[i] ^ roundKeys[round * 16 + i];
+        }
+    }
+    memcpy(output, s, 16);
+}
+} 
+} 
+void *eez_crypto_sha256_begin() {
+    auto ctx = (eez::flow::Sha256SoftContext *)eez::alloc(sizeof(eez::flow::Sha256SoftContext), 0x2b8d4e07);
+    if (ctx) {
+        eez::flow::sha256Init(*ctx);
+    }
+    return ctx;
+}
+void eez_crypto_sha256_update(void *context, const uint8_t *data, size_t length) {
+    eez::flow::sha256Update(*(eez::flow::Sha256SoftContext *)context, data, length);
+}
+void eez_crypto_sha256_end(void *context, uint8_t *digest) {
+    if (digest) {
+        eez::flow::sha256Final(*(eez::flow::Sha256SoftContext *)context, digest);
+    }
+    eez::free(context);
+}
+void eez_crypto_sha256(const uint8_t *data, size_t length, uint8_t *digest) {
+    eez::flow::Sha256SoftContext ctx;
+    eez::flow::sha256Init(ctx);
+    eez::flow::sha256Update(ctx, data, length);
+    eez::flow::sha256Final(ctx, digest);
+}
+bool eez_crypto_aes_ctr(const uint8_t *key, size_t keyLength, uint8_t *counter, const uint8_t *input, uint8_t *output, size_t length) {
+    if (keyLength != 16 && keyLength != 24 && keyLength != 32) {
+        return false;
+    }
+    uint8_t roundKeys[240];
+    int numRounds = eez::flow::aesExpandKey(key, keyLength, roundKeys);
+    uint8_t keyStream[16];
+    for (size_t offset = 0; offset < length; offset += 16) {
+        eez::flow::aesEncryptBlock(roundKeys, numRounds, counter, keyStream);
+        for (int i = 15; i >= 0 && ++counter[i] == 0; i--) {
+        }
+        size_t n = length - offset < 16 ? length - offset : 16;
+        for (size_t i = 0; i < n; i++) {
+            output[offset + i] = input[offset + i] ^ keyStream[i];
+        }
+    }
+    return true;
+}
+#endif
+// -----------------------------------------------------------------------------
+// flow/date.cpp
+// -----------------------------------------------------------------------------
+#include <ctype.h>
+#include <string.h>
+namespace eez {
+namespace flow {
+namespace date {
+#define SECONDS_PER_MINUTE 60UL
+#define SECONDS_PER_HOUR (SECONDS_PER_MINUTE * 60)
+#define SECONDS_PER_DAY (SECONDS_PER_HOUR * 24)
+#define MS_PER_DAY (SECONDS_PER_DAY * 1000)
+enum Week { Last, First, Second, Third, Fourth };
+enum DayOfWeek { Sun = 1, Mon, Tue, Wed, Thu, Fri, Sat };
+enum Month { Jan = 1, Feb, Mar, Apr, May, Jun, Jul, Aug, Sep, Oct, Nov, Dec };
+struct TimeChangeRule {
+    Week week;
+    DayOfWeek dow;
+    uint8_t month;
+    uint8_t hours;
+};
+static struct {
+    TimeChangeRule dstStart;
+    TimeChangeRule dstEnd;
+} g_dstRules[] = {
     { { Last, Sun, Mar, 2 }, { Last, Sun, Oct, 3 } },    
     { { Second, Sun, Mar, 2 }, { First, Sun, Nov, 2 } }, 
     { { First, Sun, Oct, 2 }, { First, Sun, Apr, 3 } },  
@@ -3033,104 +3649,195 @@ static struct {
 Format g_localeFormat = FORMAT_DMY_24;
 int g_timeZone = 0;
 DstRule g_dstRule = DST_RULE_OFF;
+static DateTextCache g_textCaches[FLOW_NUM_PARTITIONS][2];
 static void convertTime24to12(int &hours, bool &am);
 static bool isDst(Date time, DstRule dstRule);
 static uint8_t dayOfWeek(int y, int m, int d);
 static Date timeChangeRuleToLocal(TimeChangeRule &r, int year);
+static int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yearOfEra = (uint32_t)(year - era * 400);
+    uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+static void civilFromDays(int64_t days, int &year, int &month, int &day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    uint32_t dayOfEra = (uint32_t)(days - era * 146097);
+    uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    uint32_t monthPrime = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * monthPrime + 2) / 5 + 1;
+    month = monthPrime < 10 ? monthPrime + 3 : monthPrime - 9;
+    year = (int)(yearOfEra + era * 400) + (month <= 2);
+}
+static char *putDigits(char *p, uint32_t value, int width) {
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    for (; width > n; width--) {
+        *p++ = '0';
+    }
+    while (n) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+static const char *formatDate(DateTextCache &cache, Date time, int layout) {
+    uint64_t allSeconds = time / 1000;
+    uint32_t milliseconds = (uint32_t)(time - allSeconds * 1000);
+    uint32_t days = (uint32_t)(allSeconds / SECONDS_PER_DAY);
+    uint32_t secondOfDay = (uint32_t)(allSeconds - (uint64_t)days * SECONDS_PER_DAY);
+    int hours = secondOfDay / SECONDS_PER_HOUR;
+    int minutes = secondOfDay / SECONDS_PER_MINUTE % 60;
+    int seconds = secondOfDay % 60;
+    bool iso = layout == DATE_TEXT_ISO;
+    if (cache.layout != layout || cache.days != days) {
+        int year, month, day;
+        civilFromDays(days, year, month, day);
+        char *p = cache.text;
+        if (iso) {
+            p = putDigits(p, year, 4);
+            *p++ = '-';
+            p = putDigits(p, month, 2);
+            *p++ = '-';
+            p = putDigits(p, day, 2);
+            *p++ = 'T';
+        } else {
+            bool dmy = layout == FORMAT_DMY_24 || layout == FORMAT_DMY_12;
+            p = putDigits(p, dmy ? day : month, 2);
+            *p++ = '-';
+            p = putDigits(p, dmy ? month : day, 2);
+            *p++ = '-';
+            p = putDigits(p, year, 2);
+            *p++ = ' ';
+        }
+        cache.layout = layout;
+        cache.days = days;
+        cache.timeOffset = p - cache.text;
+        cache.hours = -1;
+    }
+    char *p = cache.text + cache.timeOffset;
+    if (cache.hours != hours) {
+        int displayHours = hours;
+        bool am = true;
+        bool twelveHours = layout == FORMAT_DMY_12 || layout == FORMAT_MDY_12;
+        if (twelveHours) {
+            convertTime24to12(displayHours, am);
+        }
+        putDigits(p, displayHours, 2);
+        p[2] = ':';
+        p[5] = ':';
+        p[8] = '.';
+        char *end = p + (iso ? 15 : 12);
+        if (twelveHours) {
+            memcpy(end, am ? " AM" : " PM", 3);
+            end += 3;
+        }
+        *end = 0;
+        cache.length = end - cache.text;
+        cache.hours = hours;
+        cache.minutes = -1;
+    }
+    if (cache.minutes != minutes) {
+        putDigits(p + 3, minutes, 2);
+        cache.minutes = minutes;
+        cache.seconds = -1;
+    }
+    if (cache.seconds != seconds) {
+        putDigits(p + 6, seconds, 2);
+        cache.seconds = seconds;
+        cache.milliseconds = -1;
+    }
+    if (cache.milliseconds != (int)milliseconds) {
+        putDigits(p + 9, milliseconds, iso ? 6 : 3);
+        cache.milliseconds = milliseconds;
+    }
+    return cache.text;
+}
+static void copyText(const DateTextCache &cache, char *str, uint32_t strLen) {
+    if (strLen == 0) {
+        return;
+    }
+    uint32_t n = cache.length < strLen - 1 ? cache.length : strLen - 1;
+    memcpy(str, cache.text, n);
+    str[n] = 0;
+}
+static const char *parseNumber(const char *p, int &value) {
+    while (isspace((unsigned char)*p)) {
+        p++;
+    }
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+        p++;
+    }
+    if (!isdigit((unsigned char)*p)) {
+        return nullptr;
+    }
+    int result = 0;
+    while (isdigit((unsigned char)*p)) {
+        result = result * 10 + (*p++ - '0');
+    }
+    value = negative ? -result : result;
+    return p;
+}
 Date now() {
     return utcToLocal(getDateNowHook());
 }
 void toString(Date time, char *str, uint32_t strLen) {
-    int year, month, day, hours, minutes, seconds, milliseconds;
-    breakDate(time, year, month, day, hours, minutes, seconds, milliseconds);
-    snprintf(str, strLen, "%04d-%02d-%02dT%02d:%02d:%02d.%06d", year, month, day, hours, minutes, seconds, milliseconds);
+    DateTextCache &cache = g_textCaches[getCurrentPartition()][0];
+    formatDate(cache, time, DATE_TEXT_ISO);
+    copyText(cache, str, strLen);
 }
 void toLocaleString(Date time, char *str, uint32_t strLen) {
-    int year, month, day, hours, minutes, seconds, milliseconds;
-    breakDate(time, year, month, day, hours, minutes, seconds, milliseconds);
-    if (g_localeFormat == FORMAT_DMY_24) {
-        snprintf(str, strLen, "%02d-%02d-%02d %02d:%02d:%02d.%03d", day, month, year, hours, minutes, seconds, milliseconds);
-    } else if (g_localeFormat == FORMAT_MDY_24) {
-        snprintf(str, strLen, "%02d-%02d-%02d %02d:%02d:%02d.%03d", month, day, year, hours, minutes, seconds, milliseconds);
-    } else if (g_localeFormat == FORMAT_DMY_12) {
-        bool am;
-        convertTime24to12(hours, am);
-        snprintf(str, strLen, "%02d-%02d-%02d %02d:%02d:%02d.%03d %s", day, month, year, hours, minutes, seconds, milliseconds, am ? "AM" : "PM");
-    } else if (g_localeFormat == FORMAT_MDY_12) {
-        bool am;
-        convertTime24to12(hours, am);
-        snprintf(str, strLen, "%02d-%02d-%02d %02d:%02d:%02d.%03d %s", month, day, year, hours, minutes, seconds, milliseconds, am ? "AM" : "PM");
-    }
+    DateTextCache &cache = g_textCaches[getCurrentPartition()][1];
+    formatDate(cache, time, g_localeFormat);
+    copyText(cache, str, strLen);
 }
-Date fromString(const char *str) {
-    int year = 0, month = 0, day = 0, hours = 0, minutes = 0, seconds = 0, milliseconds = 0;
-    sscanf(str, "%d-%d-%dT%d:%d:%d.%d", &year, &month, &day, &hours, &minutes, &seconds, &milliseconds);
-    return makeDate(year, month, day, hours, minutes, seconds, milliseconds);
+const char *toString(DateTextCache &cache, Date time) {
+    return formatDate(cache, time, DATE_TEXT_ISO);
 }
-Date makeDate(int year, int month, int day, int hours, int minutes, int seconds, int milliseconds) {
-    year -= 1970;
-    Date time = year * 365 * SECONDS_PER_DAY;
-    for (int i = 0; i < year; i++) {
-        if (LEAP_YEAR(i)) {
-            time += SECONDS_PER_DAY; 
-        }
-    }
-    for (int i = 1; i < month; i++) {
-        if ((i == 2) && LEAP_YEAR(year)) {
-            time += SECONDS_PER_DAY * 29;
-        } else {
-            time += SECONDS_PER_DAY * monthDays[i - 1]; 
+const char *toLocaleString(DateTextCache &cache, Date time) {
+    return formatDate(cache, time, g_localeFormat);
+}
+Date fromString(const char *str) {
+    static const char separators[] = "--T::.";
+    int fields[7] = { 0, 1, 1, 0, 0, 0, 0 };
+    for (int i = 0; i < 7; i++) {
+        str = parseNumber(str, fields[i]);
+        if (!str || i == 6 || *str != separators[i]) {
+            break;
         }
+        str++;
     }
-    time += (day - 1) * SECONDS_PER_DAY;
-    time += hours * SECONDS_PER_HOUR;
-    time += minutes * SECONDS_PER_MINUTE;
+    return makeDate(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], fields[6]);
+}
+Date makeDate(int year, int month, int day, int hours, int minutes, int seconds, int milliseconds) {
+    int monthIndex = month - 1;
+    year += (monthIndex >= 0 ? monthIndex : monthIndex - 11) / 12;
+    month = monthIndex - (monthIndex >= 0 ? monthIndex : monthIndex - 11) / 12 * 12 + 1;
+    int64_t time = (daysFromCivil(year, month, 1) + day - 1) * (int64_t)SECONDS_PER_DAY;
+    time += hours * (int64_t)SECONDS_PER_HOUR;
+    time += minutes * (int64_t)SECONDS_PER_MINUTE;
     time += seconds;
     time *= 1000;
     time += milliseconds;
-    return time;
+    return (Date)time;
 }
 void breakDate(Date time, int &result_year, int &result_month, int &result_day, int &result_hours, int &result_minutes, int &result_seconds, int &result_milliseconds) {
-    uint8_t year;
-    uint8_t month, monthLength;
-    uint32_t days;
-    result_milliseconds = time % 1000;
-    time /= 1000; 
-    result_seconds = time % 60;
-    time /= 60; 
-    result_minutes = time % 60;
-    time /= 60; 
-    result_hours = time % 24;
-    time /= 24; 
-    year = 0;
-    days = 0;
-    while ((unsigned)(days += (LEAP_YEAR(year) ? 366 : 365)) <= time) {
-        year++;
-    }
-    result_year = year + 1970; 
-    days -= LEAP_YEAR(year) ? 366 : 365;
-    time -= days; 
-    days = 0;
-    month = 0;
-    monthLength = 0;
-    for (month = 0; month < 12; ++month) {
-        if (month == 1) { 
-            if (LEAP_YEAR(year)) {
-                monthLength = 29;
-            } else {
-                monthLength = 28;
-            }
-        } else {
-            monthLength = monthDays[month];
-        }
-        if (time >= monthLength) {
-            time -= monthLength;
-        } else {
-            break;
-        }
-    }
-    result_month = month + 1; 
-    result_day = time + 1;    
+    uint64_t allSeconds = time / 1000;
+    result_milliseconds = (int)(time - allSeconds * 1000);
+    uint32_t days = (uint32_t)(allSeconds / SECONDS_PER_DAY);
+    uint32_t secondOfDay = (uint32_t)(allSeconds - (uint64_t)days * SECONDS_PER_DAY);
+    result_hours = secondOfDay / SECONDS_PER_HOUR;
+    result_minutes = secondOfDay / SECONDS_PER_MINUTE % 60;
+    result_seconds = secondOfDay % 60;
+    civilFromDays(days, result_year, result_month, result_day);
 }
 int getYear(Date time) {
     int year, month, day, hours, minutes, seconds, milliseconds;
@@ -3224,9 +3931,9 @@ static Date timeChangeRuleToLocal(TimeChangeRule &r, int year) {
     }
     Date time = makeDate(year, month, 1, r.hours, 0, 0, 0);
     uint8_t dow = dayOfWeek(year, month, 1);
-    time += (7 * (week - 1) + (r.dow - dow + 7) % 7) * SECONDS_PER_DAY;
+    time += (7 * (week - 1) + (r.dow - dow + 7) % 7) * MS_PER_DAY;
     if (r.week == 0) {
-        time -= 7 * SECONDS_PER_DAY; 
+        time -= 7 * MS_PER_DAY; 
     }
     return time;
 }
@@ -3910,13 +4617,84 @@ void onPageChanged(int previousPageId, int activePageId, bool activePageIsFromSt
 // flow/expression.cpp
 // -----------------------------------------------------------------------------
 #include <stdio.h>
+#include <atomic>
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#else
+#include <mutex>
+#endif
 #if EEZ_OPTION_GUI
 using namespace eez::gui;
 #endif
 namespace eez {
 namespace flow {
-EvalStack g_stack;
-static void evalExpression(FlowState *flowState, const uint8_t *instructions, int *numInstructionBytes, const char *errorMessage) {
+static EvalStack g_mainEvalStack;
+static std::atomic_flag g_mainEvalStackClaimed = ATOMIC_FLAG_INIT;
+static thread_local EvalStack *t_evalStack;
+static thread_local int t_evalStackDepth;
+EvalStack *allocEvalStack() {
+    void *ptr = alloc(sizeof(EvalStack), 0x4b2e9a61);
+    return ptr ? new (ptr) EvalStack : nullptr;
+}
+void freeEvalStack(EvalStack *stack) {
+    if (stack && stack != &g_mainEvalStack) {
+        stack->~EvalStack();
+        free(stack);
+    }
+}
+void freeTaskEvalStack() {
+    if (t_evalStackDepth == 0) {
+        if (t_evalStack == &g_mainEvalStack) {
+            g_mainEvalStackClaimed.clear();
+        } else {
+            freeEvalStack(t_evalStack);
+        }
+        t_evalStack = nullptr;
+    }
+}
+static void doArrayElement(EvalStack &stack) {
+    auto elementIndexValue = stack.pop().getValue();
+    auto arrayValue = stack.pop().getValue();
+    if (arrayValue.getType() == VALUE_TYPE_UNDEFINED || arrayValue.getType() == VALUE_TYPE_NULL) {
+        stack.push(Value(0, VALUE_TYPE_UNDEFINED));
+    } else {
+        if (arrayValue.isArray()) {
+            auto array = arrayValue.getArray();
+            int err;
+            auto elementIndex = elementIndexValue.toInt32(&err);
+            if (!err) {
+                if (elementIndex >= 0 && elementIndex < (int)array->arraySize) {
+                    stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
+                } else {
+                    stack.push(Value::makeError());
+                    stack.setErrorMessage("Array element index out of bounds\n");
+                }
+            } else {
+                stack.push(Value::makeError());
+                stack.setErrorMessage("Integer value expected for array element index\n");
+            }
+        } else if (arrayValue.isBlob()) {
+            auto blobRef = arrayValue.getBlob();
+            int err;
+            auto elementIndex = elementIndexValue.toInt32(&err);
+            if (!err) {
+                if (elementIndex >= 0 && elementIndex < (int)blobRef->len) {
+                    stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
+                } else {
+                    stack.push(Value::makeError());
+                    stack.setErrorMessage("Blob element index out of bounds\n");
+                }
+            } else {
+                stack.push(Value::makeError());
+                stack.setErrorMessage("Integer value expected for blob element index\n");
+            }
+        } else {
+            stack.push(Value::makeError());
+            stack.setErrorMessage("Array value expected\n");
+        }
+    }
+}
+static void evalExpression(EvalStack &stack, FlowState *flowState, const uint8_t *instructions, int *numInstructionBytes, const char *errorMessage) {
 	auto flowDefinition = flowState->flowDefinition;
 	auto flow = flowState->flow;
 	int i = 0;
@@ -3925,71 +4703,32 @@ static void evalExpression(FlowState *flowState, const uint8_t *instructions, in
 		auto instructionType = instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK;
 		auto instructionArg = instruction & EXPR_EVAL_INSTRUCTION_PARAM_MASK;
 		if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT) {
-			g_stack.push(*flowDefinition->constants[instructionArg]);
+			stack.push(*flowDefinition->constants[instructionArg]);
 		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_INPUT) {
-			g_stack.push(flowState->values[instructionArg]);
+			stack.push(flowState->values[instructionArg]);
 		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR) {
-			g_stack.push(&flowState->values[flow->componentInputs.count + instructionArg]);
+			stack.push(&flowState->values[flow->componentInputs.count + instructionArg]);
 		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR) {
 			if ((uint32_t)instructionArg < flowDefinition->globalVariables.count) {
                 if (g_globalVariables) {
-				    g_stack.push(g_globalVariables->values + instructionArg);
+				    stack.push(g_globalVariables->values + instructionArg);
                 } else {
-                    g_stack.push(flowDefinition->globalVariables[instructionArg]);
+                    stack.push(flowDefinition->globalVariables[instructionArg]);
                 }
 			} else {
-				g_stack.push(Value((int)(instructionArg - flowDefinition->globalVariables.count + 1), VALUE_TYPE_NATIVE_VARIABLE));
+				stack.push(Value((int)(instructionArg - flowDefinition->globalVariables.count + 1), VALUE_TYPE_NATIVE_VARIABLE));
 			}
 		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_OUTPUT) {
-			g_stack.push(Value((uint16_t)instructionArg, VALUE_TYPE_FLOW_OUTPUT));
+			stack.push(Value((uint16_t)instructionArg, VALUE_TYPE_FLOW_OUTPUT));
 		} else if (instructionType == EXPR_EVAL_INSTRUCTION_ARRAY_ELEMENT) {
-			auto elementIndexValue = g_stack.pop().getValue();
-			auto arrayValue = g_stack.pop().getValue();
-            if (arrayValue.getType() == VALUE_TYPE_UNDEFINED || arrayValue.getType() == VALUE_TYPE_NULL) {
-                g_stack.push(Value(0, VALUE_TYPE_UNDEFINED));
-            } else {
-                if (arrayValue.isArray()) {
-                    auto array = arrayValue.getArray();
-                    int err;
-                    auto elementIndex = elementIndexValue.toInt32(&err);
-                    if (!err) {
-                        if (elementIndex >= 0 && elementIndex < (int)array->arraySize) {
-                            g_stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
-                        } else {
-                            g_stack.push(Value::makeError());
-                            g_stack.setErrorMessage("Array element index out of bounds\n");
-                        }
-                    } else {
-                        g_stack.push(Value::makeError());
-                        g_stack.setErrorMessage("Integer value expected for array element index\n");
-                    }
-                } else if (arrayValue.isBlob()) {
-                    auto blobRef = arrayValue.getBlob();
-                    int err;
-                    auto elementIndex = elementIndexValue.toInt32(&err);
-                    if (!err) {
-                        if (elementIndex >= 0 && elementIndex < (int)blobRef->len) {
-                            g_stack.push(Value::makeArrayElementRef(arrayValue, elementIndex, 0x132e0e2f));
-                        } else {
-                            g_stack.push(Value::makeError());
-                            g_stack.setErrorMessage("Blob element index out of bounds\n");
-                        }
-                    } else {
-                        g_stack.push(Value::makeError());
-                        g_stack.setErrorMessage("Integer value expected for blob element index\n");
-                    }
-                } else {
-                    g_stack.push(Value::makeError());
-                    g_stack.setErrorMessage("Array value expected\n");
-                }
-            }
+			doArrayElement(stack);
 		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_OPERATION) {
-			g_evalOperations[instructionArg](g_stack);
+			g_evalOperations[instructionArg](stack);
 		} else {
             if (instruction == EXPR_EVAL_INSTRUCTION_TYPE_END_WITH_DST_VALUE_TYPE) {
     			i += 2;
-                if (g_stack.sp == 1) {
-                    auto finalResult = g_stack.pop();
+                if (stack.sp == stack.base + 1) {
+                    auto finalResult = stack.pop();
                     if (finalResult.getType() == VALUE_TYPE_VALUE_PTR) {
                         finalResult.dstValueType =
                             instructions[i] +
@@ -3997,7 +4736,7 @@ static void evalExpression(FlowState *flowState, const uint8_t *instructions, in
                             (instructions[i + 2] << 16) +
                             (instructions[i + 3] << 24);
                     }
-                    g_stack.push(finalResult);
+                    stack.push(finalResult);
                 }
                 i += 4;
                 break;
@@ -4012,136 +4751,608 @@ static void evalExpression(FlowState *flowState, const uint8_t *instructions, in
 		*numInstructionBytes = i;
 	}
 }
-#if EEZ_OPTION_GUI
-bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
+enum CompiledInstructionType {
+    COMPILED_PUSH_VALUE,
+    COMPILED_PUSH_INPUT,
+    COMPILED_PUSH_VALUE_PTR,
+    COMPILED_PUSH_LOCAL_VAR,
+    COMPILED_PUSH_NATIVE_VAR,
+    COMPILED_PUSH_OUTPUT,
+    COMPILED_PUSH_TRANSLATION,
+    COMPILED_ARRAY_ELEMENT,
+    COMPILED_OPERATION,
+    COMPILED_BINARY_OPERATION,
+    COMPILED_END,
+    COMPILED_END_WITH_DST_VALUE_TYPE
+};
+struct CompiledInstruction {
+    uint8_t type;
+    uint16_t index;
+    union {
+        const Value *value;
+        EvalOperation operation;
+        uint32_t dstValueType;
+    };
+};
+struct CompiledExpression {
+    const Flow *flow;
+    int numInstructionBytes;
+    CompiledInstruction instructions[1];
+};
+struct CompiledExpressionSlot {
+    const uint8_t *instructions;
+    CompiledExpression *expression;
+};
+static CompiledExpressionSlot *g_compiledExpressions;
+static uint32_t g_compiledExpressionsCapacity;
+static uint32_t g_numCompiledExpressions;
+#if defined(ESP_PLATFORM)
+static portMUX_TYPE g_compiledExpressionsLock = portMUX_INITIALIZER_UNLOCKED;
+static inline void lockCompiledExpressions() {
+    portENTER_CRITICAL(&g_compiledExpressionsLock);
+}
+static inline void unlockCompiledExpressions() {
+    portEXIT_CRITICAL(&g_compiledExpressionsLock);
+}
 #else
-bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
-#endif
-	g_stack.sp = 0;
-	g_stack.flowState = flowState;
-	g_stack.componentIndex = componentIndex;
-	g_stack.iterators = iterators;
-    g_stack.errorMessage[0] = 0;
-	evalExpression(flowState, instructions, numInstructionBytes, errorMessage);
-    if (g_stack.sp == 1) {
-#if EEZ_OPTION_GUI
-        if (operation == DATA_OPERATION_GET_TEXT_REFRESH_RATE) {
-            result = g_stack.pop();
-            if (!result.isError()) {
-                if (result.getType() == VALUE_TYPE_NATIVE_VARIABLE) {
-                    auto nativeVariableId = result.getInt();
-                    result = Value(getTextRefreshRate(g_widgetCursor, nativeVariableId), VALUE_TYPE_UINT32);
-                } else {
-                    result = 0;
-                }
-                return true;
-            }
-        } else if (operation == DATA_OPERATION_GET_TEXT_CURSOR_POSITION) {
-            result = g_stack.pop();
-            if (!result.isError()) {
-                if (result.getType() == VALUE_TYPE_NATIVE_VARIABLE) {
-                    auto nativeVariableId = result.getInt();
-                    result = Value(getTextCursorPosition(g_widgetCursor, nativeVariableId), VALUE_TYPE_INT32);
-                } else {
-                    result = Value();
-                }
-                return true;
-            }
-        } else {
-#endif
-            result = g_stack.pop().getValue();
-            if (!result.isError()) {
-                return true;
-            }
-#if EEZ_OPTION_GUI
-        }
+static std::mutex g_compiledExpressionsLock;
+static inline void lockCompiledExpressions() {
+    g_compiledExpressionsLock.lock();
+}
+static inline void unlockCompiledExpressions() {
+    g_compiledExpressionsLock.unlock();
+}
 #endif
-    }
-    throwError(flowState, componentIndex, errorMessage, *g_stack.errorMessage ? g_stack.errorMessage : nullptr);
-	return false;
+static const uint32_t MIN_COMPILED_EXPRESSIONS_CAPACITY = 64;
+typedef Value (*BinaryOperation)(const Value &a, const Value &b);
+static const BinaryOperation g_binaryOperations[] = {
+    op_add,
+    op_sub,
+    op_mul,
+    op_div,
+    op_mod,
+    op_left_shift,
+    op_right_shift,
+    op_binary_and,
+    op_binary_or,
+    op_binary_xor,
+    op_eq,
+    op_neq,
+    op_less,
+    op_great,
+    op_less_eq,
+    op_great_eq,
+};
+static inline uint32_t hashInstructions(const uint8_t *instructions) {
+    return ((uint32_t)(uintptr_t)instructions >> 1) * 2654435761u;
 }
-bool evalAssignableExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
-	g_stack.sp = 0;
-	g_stack.flowState = flowState;
-	g_stack.componentIndex = componentIndex;
-	g_stack.iterators = iterators;
-    g_stack.errorMessage[0] = 0;
-	evalExpression(flowState, instructions, numInstructionBytes, errorMessage);
-    if (g_stack.sp == 1) {
-        auto finalResult = g_stack.pop();
-        if (
-            finalResult.getType() == VALUE_TYPE_VALUE_PTR ||
-            finalResult.getType() == VALUE_TYPE_NATIVE_VARIABLE ||
-            finalResult.getType() == VALUE_TYPE_FLOW_OUTPUT ||
-            finalResult.getType() == VALUE_TYPE_ARRAY_ELEMENT_VALUE ||
-            finalResult.getType() == VALUE_TYPE_JSON_MEMBER_VALUE
-        ) {
-            result = finalResult;
-            return true;
+static CompiledExpressionSlot *findCompiledExpressionSlot(const uint8_t *instructions) {
+    uint32_t mask = g_compiledExpressionsCapacity - 1;
+    for (uint32_t i = hashInstructions(instructions) & mask; ; i = (i + 1) & mask) {
+        auto slot = g_compiledExpressions + i;
+        auto slotInstructions = __atomic_load_n(&slot->instructions, __ATOMIC_ACQUIRE);
+        if (slotInstructions == instructions || slotInstructions == nullptr) {
+            return slot;
         }
     }
-    throwError(flowState, componentIndex, errorMessage, *g_stack.errorMessage ? g_stack.errorMessage : nullptr);
-	return false;
 }
-#if EEZ_OPTION_GUI
-bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
-#else
-bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
-#endif
-    if (componentIndex < 0 || componentIndex >= (int)flowState->flow->components.count) {
-        char message[256];
-        snprintf(message, sizeof(message), "invalid component index %d in flow at index %d", componentIndex, flowState->flowIndex);
-        throwError(flowState, componentIndex, errorMessage, message);
-        return false;
+static CompiledExpression *lookupCompiledExpression(const uint8_t *instructions) {
+    auto slot = findCompiledExpressionSlot(instructions);
+    return __atomic_load_n(&slot->instructions, __ATOMIC_ACQUIRE) ? slot->expression : nullptr;
+}
+static bool reserveCompiledExpressions(uint32_t numExpressions) {
+    if (g_compiledExpressions && (numExpressions + 1) * 4 <= g_compiledExpressionsCapacity * 3) {
+        return true;
     }
-    auto component = flowState->flow->components[componentIndex];
-    if (propertyIndex < 0 || propertyIndex >= (int)component->properties.count) {
-        char message[256];
-        snprintf(message, sizeof(message), "invalid property index %d at component index %d in flow at index %d", propertyIndex, componentIndex, flowState->flowIndex);
-        throwError(flowState, componentIndex, errorMessage, message);
-        return false;
+    uint32_t capacity = MIN_COMPILED_EXPRESSIONS_CAPACITY;
+    while (capacity * 3 < (numExpressions + 1) * 4) {
+        capacity *= 2;
     }
-#if EEZ_OPTION_GUI
-    return evalExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators, operation);
-#else
-    return evalExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators);
-#endif
-}
-bool evalAssignableProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
-    if (componentIndex < 0 || componentIndex >= (int)flowState->flow->components.count) {
-        char message[256];
-        snprintf(message, sizeof(message), "invalid component index %d in flow at index %d", componentIndex, flowState->flowIndex);
-        throwError(flowState, componentIndex, errorMessage, message);
+    auto slots = (CompiledExpressionSlot *)alloc(capacity * sizeof(CompiledExpressionSlot), 0x5e3f1a07);
+    if (!slots) {
         return false;
     }
-    auto component = flowState->flow->components[componentIndex];
-    if (propertyIndex < 0 || propertyIndex >= (int)component->properties.count) {
-        char message[256];
-        snprintf(message, sizeof(message), "invalid property index %d (max: %d) in component at index %d in flow at index %d", propertyIndex, (int)component->properties.count, componentIndex, flowState->flowIndex);
-        throwError(flowState, componentIndex, errorMessage, message);
-        return false;
+    memset(slots, 0, capacity * sizeof(CompiledExpressionSlot));
+    auto oldSlots = g_compiledExpressions;
+    auto oldCapacity = g_compiledExpressionsCapacity;
+    g_compiledExpressions = slots;
+    g_compiledExpressionsCapacity = capacity;
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].instructions) {
+            *findCompiledExpressionSlot(oldSlots[i].instructions) = oldSlots[i];
+        }
+    }
+    if (oldSlots) {
+        free(oldSlots);
     }
-    return evalAssignableExpression(flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators);
+    return true;
 }
-#if EEZ_OPTION_GUI
-int16_t getNativeVariableId(const WidgetCursor &widgetCursor) {
-	if (widgetCursor.flowState) {
-		FlowState *flowState = widgetCursor.flowState;
-		auto flow = flowState->flow;
-		WidgetDataItem *widgetDataItem = flow->widgetDataItems[-(widgetCursor.widget->data + 1)];
-		if (widgetDataItem && widgetDataItem->componentIndex != -1 && widgetDataItem->propertyValueIndex != -1) {
-			auto component = flow->components[widgetDataItem->componentIndex];
-			auto property = component->properties[widgetDataItem->propertyValueIndex];
-			g_stack.sp = 0;
-			g_stack.flowState = flowState;
-			g_stack.componentIndex = widgetDataItem->componentIndex;
-			g_stack.iterators = widgetCursor.iterators;
-            g_stack.errorMessage[0] = 0;
-			evalExpression(flowState, property->evalInstructions, nullptr, nullptr);
-            if (g_stack.sp == 1) {
-                auto finalResult = g_stack.pop();
-                if (finalResult.getType() == VALUE_TYPE_NATIVE_VARIABLE) {
-                    return finalResult.getInt();
+static bool isFusableOperand(const CompiledInstruction &instruction) {
+    return instruction.type == COMPILED_PUSH_VALUE || instruction.type == COMPILED_PUSH_INPUT || instruction.type == COMPILED_PUSH_VALUE_PTR || instruction.type == COMPILED_PUSH_LOCAL_VAR;
+}
+static CompiledExpression *compileExpression(FlowDefinition *flowDefinition, const Flow *flow, const uint8_t *instructions) {
+    int numInstructions = 0;
+    int i = 0;
+    while (true) {
+		uint16_t instruction = instructions[i] + (instructions[i + 1] << 8);
+        i += 2;
+        numInstructions++;
+        if ((instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK) == EXPR_EVAL_INSTRUCTION_TYPE_END) {
+            if (instruction == EXPR_EVAL_INSTRUCTION_TYPE_END_WITH_DST_VALUE_TYPE) {
+                i += 4;
+            }
+            break;
+        }
+    }
+    auto expression = (CompiledExpression *)alloc(sizeof(CompiledExpression) + (numInstructions - 1) * sizeof(CompiledInstruction), 0x1c9a4d52);
+    if (!expression) {
+        return nullptr;
+    }
+    expression->flow = flow;
+    expression->numInstructionBytes = i;
+    auto dst = expression->instructions;
+    auto firstFusable = dst;
+    i = 0;
+    while (true) {
+		uint16_t instruction = instructions[i] + (instructions[i + 1] << 8);
+		auto instructionType = instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK;
+		auto instructionArg = instruction & EXPR_EVAL_INSTRUCTION_PARAM_MASK;
+        i += 2;
+        dst->index = 0;
+        dst->value = nullptr;
+		if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_CONSTANT) {
+            dst->type = COMPILED_PUSH_VALUE;
+            dst->value = flowDefinition->constants[instructionArg];
+		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_INPUT) {
+            dst->type = COMPILED_PUSH_INPUT;
+            dst->index = instructionArg;
+		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR) {
+            dst->type = COMPILED_PUSH_LOCAL_VAR;
+            dst->index = flow->componentInputs.count + instructionArg;
+		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR) {
+			if ((uint32_t)instructionArg < flowDefinition->globalVariables.count) {
+                if (g_globalVariables) {
+                    dst->type = COMPILED_PUSH_VALUE_PTR;
+                    dst->value = g_globalVariables->values + instructionArg;
+                } else {
+                    dst->type = COMPILED_PUSH_VALUE;
+                    dst->value = flowDefinition->globalVariables[instructionArg];
+                }
+			} else {
+                dst->type = COMPILED_PUSH_NATIVE_VAR;
+                dst->index = instructionArg - flowDefinition->globalVariables.count + 1;
+			}
+		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_OUTPUT) {
+            dst->type = COMPILED_PUSH_OUTPUT;
+            dst->index = instructionArg;
+		} else if (instructionType == EXPR_EVAL_INSTRUCTION_ARRAY_ELEMENT) {
+            dst->type = COMPILED_ARRAY_ELEMENT;
+		} else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_OPERATION) {
+            if (
+                (size_t)instructionArg < sizeof(g_binaryOperations) / sizeof(BinaryOperation) &&
+                dst - 2 >= firstFusable && isFusableOperand(dst[-2]) && isFusableOperand(dst[-1])
+            ) {
+                dst[0] = dst[-1];
+                dst[-1] = dst[-2];
+                dst[-2].type = COMPILED_BINARY_OPERATION;
+                dst[-2].index = instructionArg;
+                dst[-2].value = nullptr;
+                firstFusable = ++dst;
+                continue;
+            }
+            if (instructionArg == defs_v3::OPERATION_TYPE_FLOW_TRANSLATE && dst - 1 >= firstFusable && dst[-1].type == COMPILED_PUSH_VALUE) {
+                int err;
+                int textResourceIndex = dst[-1].value->toInt32(&err);
+                if (!err && textResourceIndex >= 0 && textResourceIndex <= 0xFFFF) {
+                    dst[-1].type = COMPILED_PUSH_TRANSLATION;
+                    dst[-1].index = textResourceIndex;
+                    dst[-1].value = nullptr;
+                    firstFusable = dst;
+                    continue;
+                }
+            }
+            dst->type = COMPILED_OPERATION;
+            dst->operation = g_evalOperations[instructionArg];
+		} else {
+            if (instruction == EXPR_EVAL_INSTRUCTION_TYPE_END_WITH_DST_VALUE_TYPE) {
+                dst->type = COMPILED_END_WITH_DST_VALUE_TYPE;
+                dst->dstValueType = instructions[i] + (instructions[i + 1] << 8) + (instructions[i + 2] << 16) + (instructions[i + 3] << 24);
+            } else {
+                dst->type = COMPILED_END;
+            }
+            break;
+		}
+        dst++;
+    }
+    return expression;
+}
+static inline const Value &getCompiledOperand(FlowState *flowState, const CompiledInstruction &instruction, Value &valuePtr) {
+    switch (instruction.type) {
+    case COMPILED_PUSH_VALUE:
+        return *instruction.value;
+    case COMPILED_PUSH_INPUT:
+        return flowState->values[instruction.index];
+    case COMPILED_PUSH_VALUE_PTR:
+        valuePtr = Value((Value *)instruction.value);
+        return valuePtr;
+    default:
+        valuePtr = Value(&flowState->values[instruction.index]);
+        return valuePtr;
+    }
+}
+static void evalCompiledExpression(EvalStack &stack, FlowState *flowState, const CompiledExpression *expression) {
+    for (auto instruction = expression->instructions; ; instruction++) {
+        switch (instruction->type) {
+        case COMPILED_PUSH_VALUE:
+            stack.push(*instruction->value);
+            break;
+        case COMPILED_PUSH_INPUT:
+            stack.push(flowState->values[instruction->index]);
+            break;
+        case COMPILED_PUSH_VALUE_PTR:
+            stack.push((Value *)instruction->value);
+            break;
+        case COMPILED_PUSH_LOCAL_VAR:
+            stack.push(&flowState->values[instruction->index]);
+            break;
+        case COMPILED_PUSH_NATIVE_VAR:
+            stack.push(Value((int)instruction->index, VALUE_TYPE_NATIVE_VARIABLE));
+            break;
+        case COMPILED_PUSH_OUTPUT:
+            stack.push(Value((uint16_t)instruction->index, VALUE_TYPE_FLOW_OUTPUT));
+            break;
+        case COMPILED_PUSH_TRANSLATION:
+            stack.push(translate(flowState->assets, instruction->index));
+            break;
+        case COMPILED_ARRAY_ELEMENT:
+            doArrayElement(stack);
+            break;
+        case COMPILED_OPERATION:
+            instruction->operation(stack);
+            break;
+        case COMPILED_BINARY_OPERATION: {
+            Value aPtr;
+            Value bPtr;
+            auto result = g_binaryOperations[instruction->index](getCompiledOperand(flowState, instruction[1], aPtr), getCompiledOperand(flowState, instruction[2], bPtr));
+            if (instruction->index < defs_v3::OPERATION_TYPE_EQUAL && result.getType() == VALUE_TYPE_UNDEFINED) {
+                result = Value::makeError();
+            }
+            stack.push(result);
+            instruction += 2;
+            break;
+        }
+        case COMPILED_END_WITH_DST_VALUE_TYPE:
+            if (stack.sp == stack.base + 1 && stack.stack[stack.base].getType() == VALUE_TYPE_VALUE_PTR) {
+                stack.stack[stack.base].dstValueType = instruction->dstValueType;
+            }
+            return;
+        default:
+            return;
+        }
+    }
+}
+static CompiledExpression *insertCompiledExpression(FlowState *flowState, const uint8_t *instructions) {
+    if ((g_numCompiledExpressions + 2) * 4 > g_compiledExpressionsCapacity * 3) {
+        return nullptr;
+    }
+    auto expression = compileExpression(flowState->flowDefinition, flowState->flow, instructions);
+    if (!expression) {
+        return nullptr;
+    }
+    CompiledExpression *result = nullptr;
+    lockCompiledExpressions();
+    auto slot = findCompiledExpressionSlot(instructions);
+    if (slot->instructions) {
+        result = slot->expression;
+    } else if ((g_numCompiledExpressions + 2) * 4 <= g_compiledExpressionsCapacity * 3) {
+        slot->expression = expression;
+        __atomic_store_n(&slot->instructions, instructions, __ATOMIC_RELEASE);
+        g_numCompiledExpressions++;
+        result = expression;
+    }
+    unlockCompiledExpressions();
+    if (result != expression) {
+        free(expression);
+    }
+    return result;
+}
+static void evalExpression(EvalStack &stack, FlowState *flowState, const uint8_t *instructions, int *numInstructionBytes, const char *errorMessage, bool compile) {
+    CompiledExpression *expression = nullptr;
+    if (g_compiledExpressions) {
+        expression = lookupCompiledExpression(instructions);
+        if (!expression && compile) {
+            expression = insertCompiledExpression(flowState, instructions);
+        }
+    }
+    if (!expression || expression->flow != flowState->flow) {
+        evalExpression(stack, flowState, instructions, numInstructionBytes, errorMessage);
+        return;
+    }
+    evalCompiledExpression(stack, flowState, expression);
+    if (numInstructionBytes) {
+        *numInstructionBytes = expression->numInstructionBytes;
+    }
+}
+void compileExpressions(Assets *assets) {
+    freeCompiledExpressions();
+	auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
+    uint32_t numProperties = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            numProperties += flow->components[componentIndex]->properties.count;
+        }
+    }
+    if (!reserveCompiledExpressions(numProperties + MIN_COMPILED_EXPRESSIONS_CAPACITY)) {
+        return;
+    }
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        auto flow = flowDefinition->flows[flowIndex];
+        for (uint32_t componentIndex = 0; componentIndex < flow->components.count; componentIndex++) {
+            auto component = flow->components[componentIndex];
+            for (uint32_t propertyIndex = 0; propertyIndex < component->properties.count; propertyIndex++) {
+                const uint8_t *instructions = component->properties[propertyIndex]->evalInstructions;
+                auto slot = findCompiledExpressionSlot(instructions);
+                if (slot->instructions) {
+                    continue;
+                }
+                auto expression = compileExpression(flowDefinition, flow, instructions);
+                if (!expression) {
+                    return;
+                }
+                slot->instructions = instructions;
+                slot->expression = expression;
+                g_numCompiledExpressions++;
+            }
+        }
+    }
+}
+void freeCompiledExpressions() {
+    for (uint32_t i = 0; i < g_compiledExpressionsCapacity; i++) {
+        if (g_compiledExpressions[i].instructions) {
+            free(g_compiledExpressions[i].expression);
+        }
+    }
+    if (g_compiledExpressions) {
+        free(g_compiledExpressions);
+    }
+    g_compiledExpressions = nullptr;
+    g_compiledExpressionsCapacity = 0;
+    g_numCompiledExpressions = 0;
+}
+#if EEZ_OPTION_GUI
+bool evalExpression(EvalStack &stack, FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
+#else
+bool evalExpression(EvalStack &stack, FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+#endif
+	stack.sp = stack.base;
+	stack.flowState = flowState;
+	stack.componentIndex = componentIndex;
+	stack.iterators = iterators;
+    stack.errorMessage[0] = 0;
+	evalExpression(stack, flowState, instructions, numInstructionBytes, errorMessage, true);
+    if (stack.sp == stack.base + 1) {
+#if EEZ_OPTION_GUI
+        if (operation == DATA_OPERATION_GET_TEXT_REFRESH_RATE) {
+            result = stack.pop();
+            if (!result.isError()) {
+                if (result.getType() == VALUE_TYPE_NATIVE_VARIABLE) {
+                    auto nativeVariableId = result.getInt();
+                    result = Value(getTextRefreshRate(g_widgetCursor, nativeVariableId), VALUE_TYPE_UINT32);
+                } else {
+                    result = 0;
+                }
+                return true;
+            }
+        } else if (operation == DATA_OPERATION_GET_TEXT_CURSOR_POSITION) {
+            result = stack.pop();
+            if (!result.isError()) {
+                if (result.getType() == VALUE_TYPE_NATIVE_VARIABLE) {
+                    auto nativeVariableId = result.getInt();
+                    result = Value(getTextCursorPosition(g_widgetCursor, nativeVariableId), VALUE_TYPE_INT32);
+                } else {
+                    result = Value();
+                }
+                return true;
+            }
+        } else {
+#endif
+            result = stack.pop().getValue();
+            if (!result.isError()) {
+                return true;
+            }
+#if EEZ_OPTION_GUI
+        }
+#endif
+    }
+    throwError(flowState, componentIndex, errorMessage, *stack.errorMessage ? stack.errorMessage : nullptr);
+	return false;
+}
+bool evalAssignableExpression(EvalStack &stack, FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+	stack.sp = stack.base;
+	stack.flowState = flowState;
+	stack.componentIndex = componentIndex;
+	stack.iterators = iterators;
+    stack.errorMessage[0] = 0;
+	evalExpression(stack, flowState, instructions, numInstructionBytes, errorMessage, true);
+    if (stack.sp == stack.base + 1) {
+        auto finalResult = stack.pop();
+        if (
+            finalResult.getType() == VALUE_TYPE_VALUE_PTR ||
+            finalResult.getType() == VALUE_TYPE_NATIVE_VARIABLE ||
+            finalResult.getType() == VALUE_TYPE_FLOW_OUTPUT ||
+            finalResult.getType() == VALUE_TYPE_ARRAY_ELEMENT_VALUE ||
+            finalResult.getType() == VALUE_TYPE_JSON_MEMBER_VALUE
+        ) {
+            result = finalResult;
+            return true;
+        }
+    }
+    throwError(flowState, componentIndex, errorMessage, *stack.errorMessage ? stack.errorMessage : nullptr);
+	return false;
+}
+#if EEZ_OPTION_GUI
+bool evalProperty(EvalStack &stack, FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
+#else
+bool evalProperty(EvalStack &stack, FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+#endif
+    if (componentIndex < 0 || componentIndex >= (int)flowState->flow->components.count) {
+        char message[256];
+        snprintf(message, sizeof(message), "invalid component index %d in flow at index %d", componentIndex, flowState->flowIndex);
+        throwError(flowState, componentIndex, errorMessage, message);
+        return false;
+    }
+    auto component = flowState->flow->components[componentIndex];
+    if (propertyIndex < 0 || propertyIndex >= (int)component->properties.count) {
+        char message[256];
+        snprintf(message, sizeof(message), "invalid property index %d at component index %d in flow at index %d", propertyIndex, componentIndex, flowState->flowIndex);
+        throwError(flowState, componentIndex, errorMessage, message);
+        return false;
+    }
+#if EEZ_OPTION_GUI
+    return evalExpression(stack, flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators, operation);
+#else
+    return evalExpression(stack, flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators);
+#endif
+}
+bool evalAssignableProperty(EvalStack &stack, FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+    if (componentIndex < 0 || componentIndex >= (int)flowState->flow->components.count) {
+        char message[256];
+        snprintf(message, sizeof(message), "invalid component index %d in flow at index %d", componentIndex, flowState->flowIndex);
+        throwError(flowState, componentIndex, errorMessage, message);
+        return false;
+    }
+    auto component = flowState->flow->components[componentIndex];
+    if (propertyIndex < 0 || propertyIndex >= (int)component->properties.count) {
+        char message[256];
+        snprintf(message, sizeof(message), "invalid property index %d (max: %d) in component at index %d in flow at index %d", propertyIndex, (int)component->properties.count, componentIndex, flowState->flowIndex);
+        throwError(flowState, componentIndex, errorMessage, message);
+        return false;
+    }
+    return evalAssignableExpression(stack, flowState, componentIndex, component->properties[propertyIndex]->evalInstructions, result, errorMessage, numInstructionBytes, iterators);
+}
+TaskEvalStack::TaskEvalStack() : stack(t_evalStack), temporary(false), nested(false), savedErrorMessage(nullptr) {
+    if (t_evalStackDepth > 0 && stack && stack->sp <= STACK_SIZE / 2) {
+        nested = true;
+        savedBase = stack->base;
+        savedFlowState = stack->flowState;
+        savedComponentIndex = stack->componentIndex;
+        savedIterators = stack->iterators;
+        if (stack->errorMessage[0]) {
+            size_t size = strlen(stack->errorMessage) + 1;
+            savedErrorMessage = (char *)alloc(size, 0x7d3a51c8);
+            if (savedErrorMessage) {
+                memcpy(savedErrorMessage, stack->errorMessage, size);
+            }
+        }
+        stack->base = stack->sp;
+    } else if (t_evalStackDepth > 0 || !stack) {
+        if (t_evalStackDepth == 0 && !g_mainEvalStackClaimed.test_and_set()) {
+            stack = t_evalStack = &g_mainEvalStack;
+        } else {
+            stack = allocEvalStack();
+            temporary = t_evalStackDepth > 0;
+            if (!temporary) {
+                t_evalStack = stack;
+            }
+        }
+    }
+    t_evalStackDepth++;
+}
+TaskEvalStack::~TaskEvalStack() {
+    t_evalStackDepth--;
+    if (nested) {
+        while (stack->sp > stack->base) {
+            stack->stack[--stack->sp] = Value();
+        }
+        stack->base = savedBase;
+        stack->flowState = savedFlowState;
+        stack->componentIndex = savedComponentIndex;
+        stack->iterators = savedIterators;
+        stack->errorMessage[0] = 0;
+        if (savedErrorMessage) {
+            stringCopy(stack->errorMessage, sizeof(stack->errorMessage), savedErrorMessage);
+            free(savedErrorMessage);
+        }
+    } else if (temporary) {
+        freeEvalStack(stack);
+    }
+}
+#if EEZ_OPTION_GUI
+bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
+    TaskEvalStack taskEvalStack;
+    if (!taskEvalStack.stack) {
+        throwError(flowState, componentIndex, errorMessage, "Out of memory for evaluation stack\n");
+        return false;
+    }
+    return evalExpression(*taskEvalStack.stack, flowState, componentIndex, instructions, result, errorMessage, numInstructionBytes, iterators, operation);
+}
+bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
+    TaskEvalStack taskEvalStack;
+    if (!taskEvalStack.stack) {
+        throwError(flowState, componentIndex, errorMessage, "Out of memory for evaluation stack\n");
+        return false;
+    }
+    return evalProperty(*taskEvalStack.stack, flowState, componentIndex, propertyIndex, result, errorMessage, numInstructionBytes, iterators, operation);
+}
+#else
+bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+    TaskEvalStack taskEvalStack;
+    if (!taskEvalStack.stack) {
+        throwError(flowState, componentIndex, errorMessage, "Out of memory for evaluation stack\n");
+        return false;
+    }
+    return evalExpression(*taskEvalStack.stack, flowState, componentIndex, instructions, result, errorMessage, numInstructionBytes, iterators);
+}
+bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+    TaskEvalStack taskEvalStack;
+    if (!taskEvalStack.stack) {
+        throwError(flowState, componentIndex, errorMessage, "Out of memory for evaluation stack\n");
+        return false;
+    }
+    return evalProperty(*taskEvalStack.stack, flowState, componentIndex, propertyIndex, result, errorMessage, numInstructionBytes, iterators);
+}
+#endif
+bool evalAssignableExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+    TaskEvalStack taskEvalStack;
+    if (!taskEvalStack.stack) {
+        throwError(flowState, componentIndex, errorMessage, "Out of memory for evaluation stack\n");
+        return false;
+    }
+    return evalAssignableExpression(*taskEvalStack.stack, flowState, componentIndex, instructions, result, errorMessage, numInstructionBytes, iterators);
+}
+bool evalAssignableProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+    TaskEvalStack taskEvalStack;
+    if (!taskEvalStack.stack) {
+        throwError(flowState, componentIndex, errorMessage, "Out of memory for evaluation stack\n");
+        return false;
+    }
+    return evalAssignableProperty(*taskEvalStack.stack, flowState, componentIndex, propertyIndex, result, errorMessage, numInstructionBytes, iterators);
+}
+#if EEZ_OPTION_GUI
+int16_t getNativeVariableId(const WidgetCursor &widgetCursor) {
+	if (widgetCursor.flowState) {
+		FlowState *flowState = widgetCursor.flowState;
+		auto flow = flowState->flow;
+		WidgetDataItem *widgetDataItem = flow->widgetDataItems[-(widgetCursor.widget->data + 1)];
+		if (widgetDataItem && widgetDataItem->componentIndex != -1 && widgetDataItem->propertyValueIndex != -1) {
+			auto component = flow->components[widgetDataItem->componentIndex];
+			auto property = component->properties[widgetDataItem->propertyValueIndex];
+            TaskEvalStack taskEvalStack;
+            if (!taskEvalStack.stack) {
+                return DATA_ID_NONE;
+            }
+            EvalStack &stack = *taskEvalStack.stack;
+			stack.sp = stack.base;
+			stack.flowState = flowState;
+			stack.componentIndex = widgetDataItem->componentIndex;
+			stack.iterators = widgetCursor.iterators;
+            stack.errorMessage[0] = 0;
+			evalExpression(stack, flowState, property->evalInstructions, nullptr, nullptr);
+            if (stack.sp == stack.base + 1) {
+                auto finalResult = stack.pop();
+                if (finalResult.getType() == VALUE_TYPE_NATIVE_VARIABLE) {
+                    return finalResult.getInt();
                 }
             }
 		}
@@ -4167,46 +5378,330 @@ uint32_t g_wasmModuleId = 0;
 #endif
 static const uint32_t FLOW_TICK_MAX_DURATION_MS = 5;
 int g_selectedLanguage = 0;
+struct TranslationTable {
+    Assets *assets;
+    int language;
+    uint32_t count;
+    uint32_t capacity;
+    const char **texts;
+};
+static TranslationTable g_translationTables[2];
+static std::atomic<TranslationTable *> g_translationTable(nullptr);
 FlowState *g_firstFlowState;
 FlowState *g_lastFlowState;
-static bool g_isStopping = false;
-static bool g_isStopped = true;
+FlowState *g_firstWorkerFlowState;
+FlowState *g_lastWorkerFlowState;
+static Assets *g_assets;
+static uint8_t *g_flowPartitions;
+static std::atomic<bool> g_isStopping(false);
+static std::atomic<bool> g_isStopped(true);
+static std::atomic<bool> g_isPartitionTicking[FLOW_NUM_PARTITIONS];
+static unsigned g_numMarshalledTasks;
+struct PendingExecutedMessage {
+    uint8_t partition;
+    PartitionMessage message;
+};
+static PendingExecutedMessage g_pendingExecutedMessages[EEZ_FLOW_MAILBOX_SIZE];
+static unsigned g_numPendingExecutedMessages;
 static void doStop();
+static void bindTranslations(Assets *assets);
 unsigned start(Assets *assets) {
 	auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
 	if (flowDefinition->flows.count == 0) {
 		return 0;
 	}
+	queueReset();
+    g_assets = assets;
+    g_numMarshalledTasks = 0;
+    g_numPendingExecutedMessages = 0;
+    g_flowPartitions = (uint8_t *)alloc(flowDefinition->flows.count, 0x1f6c2d93);
+    if (g_flowPartitions) {
+        memset(g_flowPartitions, FLOW_PARTITION_INHERIT, flowDefinition->flows.count);
+    }
     g_isStopped = false;
     g_isStopping = false;
     initGlobalVariables(assets);
-	queueReset();
+    compileExpressions(assets);
+#if EEZ_FLOW_PROFILER
+    profilerStart(assets);
+#endif
     watchListReset();
+    bindTranslations(assets);
 	scpiComponentInitHook();
 	onStarted(assets);
 	return 1;
 }
-void tick() {
-	if (isFlowStopped()) {
-		return;
-	}
-    if (g_isStopping) {
-        doStop();
+static void bindTranslations(Assets *assets) {
+    auto current = g_translationTable.load(std::memory_order_relaxed);
+    auto &table = current == &g_translationTables[0] ? g_translationTables[1] : g_translationTables[0];
+    auto &languages = assets->languages;
+    if (g_selectedLanguage < 0 || g_selectedLanguage >= (int)languages.count) {
         return;
     }
+    auto &translations = languages[g_selectedLanguage]->translations;
+    if (translations.count > table.capacity) {
+        uint32_t capacity = 0;
+        for (uint32_t languageIndex = 0; languageIndex < languages.count; languageIndex++) {
+            if (languages[languageIndex]->translations.count > capacity) {
+                capacity = languages[languageIndex]->translations.count;
+            }
+        }
+        if (table.texts) {
+            free(table.texts);
+        }
+        table.capacity = 0;
+        table.texts = (const char **)alloc(capacity * sizeof(const char *), 0x6d2b8e41);
+        if (!table.texts) {
+            return;
+        }
+        table.capacity = capacity;
+    }
+    for (uint32_t i = 0; i < translations.count; i++) {
+        table.texts[i] = translations[i];
+    }
+    table.count = translations.count;
+    table.assets = assets;
+    table.language = g_selectedLanguage;
+    g_translationTable.store(&table, std::memory_order_release);
+}
+const char *translate(Assets *assets, int textResourceIndex) {
+    if (textResourceIndex < 0) {
+        return "";
+    }
+    auto table = g_translationTable.load(std::memory_order_acquire);
+    if (table && table->language == g_selectedLanguage && table->assets == assets) {
+        return (uint32_t)textResourceIndex < table->count ? table->texts[textResourceIndex] : "";
+    }
+    auto &languages = assets->languages;
+    if (g_selectedLanguage < 0 || g_selectedLanguage >= (int)languages.count) {
+        return "";
+    }
+    auto &translations = languages[g_selectedLanguage]->translations;
+    return (uint32_t)textResourceIndex < translations.count ? translations[textResourceIndex] : "";
+}
+bool selectLanguage(Assets *assets, const char *languageID) {
+    auto &languages = assets->languages;
+    for (uint32_t languageIndex = 0; languageIndex < languages.count; languageIndex++) {
+        if (strcmp(languages[languageIndex]->languageID, languageID) == 0) {
+            auto table = g_translationTable.load(std::memory_order_relaxed);
+            g_selectedLanguage = languageIndex;
+            if (!table || table->language != (int)languageIndex || table->assets != assets) {
+                bindTranslations(assets);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+void freeTranslations() {
+    g_translationTable.store(nullptr, std::memory_order_relaxed);
+    for (auto &table : g_translationTables) {
+        if (table.texts) {
+            free(table.texts);
+        }
+        table.texts = nullptr;
+        table.count = 0;
+        table.capacity = 0;
+        table.language = -1;
+        table.assets = nullptr;
+    }
+}
+static FlowState *getRootFlowState(FlowState *flowState) {
+    while (flowState->parentFlowState) {
+        flowState = flowState->parentFlowState;
+    }
+    return flowState;
+}
+static void freeIdleFlowStates(FlowState *flowState) {
+    do {
+        if (!canFreeFlowState(flowState)) {
+            break;
+        }
+        auto temp = flowState->parentFlowState;
+        freeFlowState(flowState);
+        flowState = temp;
+    } while (flowState);
+}
+static bool isUiAffineComponent(FlowState *flowState, unsigned componentIndex) {
+    auto component = flowState->flow->components[componentIndex];
+    switch (component->type) {
+    case defs_v3::COMPONENT_TYPE_START_ACTION:
+    case defs_v3::COMPONENT_TYPE_END_ACTION:
+    case defs_v3::COMPONENT_TYPE_INPUT_ACTION:
+    case defs_v3::COMPONENT_TYPE_OUTPUT_ACTION:
+    case defs_v3::COMPONENT_TYPE_WATCH_VARIABLE_ACTION:
+    case defs_v3::COMPONENT_TYPE_EVAL_EXPR_ACTION:
+    case defs_v3::COMPONENT_TYPE_SET_VARIABLE_ACTION:
+    case defs_v3::COMPONENT_TYPE_SWITCH_ACTION:
+    case defs_v3::COMPONENT_TYPE_COMPARE_ACTION:
+    case defs_v3::COMPONENT_TYPE_IS_TRUE_ACTION:
+    case defs_v3::COMPONENT_TYPE_CONSTANT_ACTION:
+    case defs_v3::COMPONENT_TYPE_LOG_ACTION:
+    case defs_v3::COMPONENT_TYPE_DELAY_ACTION:
+    case defs_v3::COMPONENT_TYPE_ERROR_ACTION:
+    case defs_v3::COMPONENT_TYPE_CATCH_ERROR_ACTION:
+    case defs_v3::COMPONENT_TYPE_COUNTER_ACTION:
+    case defs_v3::COMPONENT_TYPE_LOOP_ACTION:
+    case defs_v3::COMPONENT_TYPE_NOOP_ACTION:
+    case defs_v3::COMPONENT_TYPE_COMMENT_ACTION:
+    case defs_v3::COMPONENT_TYPE_SORT_ARRAY_ACTION:
+    case defs_v3::COMPONENT_TYPE_TEST_AND_SET_ACTION:
+    case defs_v3::COMPONENT_TYPE_LABEL_IN_ACTION:
+    case defs_v3::COMPONENT_TYPE_LABEL_OUT_ACTION:
+        return false;
+    case defs_v3::COMPONENT_TYPE_CALL_ACTION_ACTION:
+        return ((CallActionActionComponent *)component)->flowIndex >= (int)flowState->flowDefinition->flows.count;
+    default:
+        return true;
+    }
+}
+static bool marshalToUiPartition(FlowState *flowState, unsigned componentIndex, bool continuousTask) {
+    if (g_numMarshalledTasks == EEZ_FLOW_MAILBOX_SIZE) {
+        return false;
+    }
+    PartitionMessage message;
+    message.type = PARTITION_MESSAGE_EXECUTE;
+    message.continuousTask = continuousTask;
+    message.flowIndex = 0;
+    message.flowState = flowState;
+    message.componentIndex = componentIndex;
+    if (!postPartitionMessage(FLOW_PARTITION_UI, message)) {
+        return false;
+    }
+    incRefCounterForFlowState(flowState);
+    getRootFlowState(flowState)->numMarshalledTasks++;
+    g_numMarshalledTasks++;
+    return true;
+}
+static void executeMarshalledTask(uint8_t fromPartition, FlowState *flowState, unsigned componentIndex) {
+    flowState->executingComponentIndex = componentIndex;
+    if (!flowState->error) {
+#if EEZ_FLOW_PROFILER
+        uint32_t allocCount = getProfilerAllocCount();
+        uint32_t startCycles = getProfilerCycles();
+        executeComponent(flowState, componentIndex);
+        profilerRecordComponent(FLOW_PARTITION_UI, flowState, componentIndex, getProfilerCycles() - startCycles, 0, getProfilerAllocCount() - allocCount);
+#else
+        executeComponent(flowState, componentIndex);
+#endif
+    }
+    resetSequenceInputs(flowState);
+    PartitionMessage message;
+    message.type = PARTITION_MESSAGE_EXECUTED;
+    message.continuousTask = false;
+    message.flowIndex = 0;
+    message.flowState = flowState;
+    message.componentIndex = componentIndex;
+    if (g_numPendingExecutedMessages > 0 || !postPartitionMessage(fromPartition, message)) {
+        auto &pending = g_pendingExecutedMessages[g_numPendingExecutedMessages++];
+        pending.partition = fromPartition;
+        pending.message = message;
+    }
+}
+static void postPendingExecutedMessages() {
+    unsigned i = 0;
+    while (i < g_numPendingExecutedMessages && postPartitionMessage(g_pendingExecutedMessages[i].partition, g_pendingExecutedMessages[i].message)) {
+        i++;
+    }
+    if (i > 0) {
+        g_numPendingExecutedMessages -= i;
+        memmove(g_pendingExecutedMessages, g_pendingExecutedMessages + i, g_numPendingExecutedMessages * sizeof(PendingExecutedMessage));
+    }
+}
+static void onMarshalledTaskExecuted(FlowState *flowState) {
+    getRootFlowState(flowState)->numMarshalledTasks--;
+    g_numMarshalledTasks--;
+    decRefCounterForFlowState(flowState);
+    freeIdleFlowStates(flowState);
+}
+static void startFlow(int flowIndex) {
+    auto flowState = initActionFlowState(flowIndex, nullptr, -1);
+    if (flowState && canFreeFlowState(flowState)) {
+        freeFlowState(flowState);
+    }
+}
+static void drainMailboxes(uint8_t partition) {
+    if (partition == FLOW_PARTITION_UI) {
+        postPendingExecutedMessages();
+    }
+    for (uint8_t fromPartition = 0; fromPartition < FLOW_NUM_PARTITIONS; fromPartition++) {
+        if (fromPartition == partition) {
+            continue;
+        }
+        uint32_t numMessages = getNumPartitionMessages(fromPartition, partition);
+        PartitionMessage message;
+        for (uint32_t i = 0; i < numMessages && takePartitionMessage(fromPartition, partition, message); i++) {
+            if (message.type == PARTITION_MESSAGE_ADD_TO_QUEUE) {
+                addToQueue(message.flowState, message.componentIndex, -1, -1, -1, message.continuousTask);
+            } else if (message.type == PARTITION_MESSAGE_EXECUTE) {
+                executeMarshalledTask(fromPartition, message.flowState, message.componentIndex);
+            } else if (message.type == PARTITION_MESSAGE_EXECUTED) {
+                onMarshalledTaskExecuted(message.flowState);
+            } else if (message.type == PARTITION_MESSAGE_START_FLOW) {
+                startFlow(message.flowIndex);
+            }
+            if (isFlowStopped() || g_isStopping) {
+                return;
+            }
+        }
+    }
+}
+#if EEZ_FLOW_PROFILER
+static void executeComponentProfiled(uint8_t partition, FlowState *flowState, unsigned componentIndex, uint32_t enqueueCycles) {
+    uint32_t allocCount = getProfilerAllocCount();
+    uint32_t startCycles = getProfilerCycles();
+    executeComponent(flowState, componentIndex);
+    uint32_t endCycles = getProfilerCycles();
+    profilerRecordComponent(partition, flowState, componentIndex, endCycles - startCycles, startCycles - enqueueCycles, getProfilerAllocCount() - allocCount);
+}
+#define EXECUTE_COMPONENT(flowState, componentIndex) executeComponentProfiled(partition, flowState, componentIndex, enqueueCycles)
+#else
+#define EXECUTE_COMPONENT(flowState, componentIndex) executeComponent(flowState, componentIndex)
+#endif
+static void executeQueue(uint8_t partition) {
 	uint32_t startTickCount = millis();
-    auto n = getQueueSize();
-    for (size_t i = 0; i < n || g_numContinuousTaskInQueue > 0; i++) {
+#if EEZ_FLOW_PROFILER
+    uint32_t startTickCycles = getProfilerCycles();
+    bool overBudget = false;
+#endif
+    drainMailboxes(partition);
+    if (isFlowStopped() || g_isStopping) {
+        return;
+    }
+    auto n = getQueueSize(partition);
+    size_t numDeferred = 0;
+    for (size_t i = 0; i < n || getNumContinuousTaskInQueue(partition) > 0; i++) {
 		FlowState *flowState;
 		unsigned componentIndex;
         bool continuousTask;
-		if (!peekNextTaskFromQueue(flowState, componentIndex, continuousTask)) {
+		if (!peekNextTaskFromQueue(partition, flowState, componentIndex, continuousTask)) {
 			break;
 		}
 		if (!continuousTask && !canExecuteStep(flowState, componentIndex)) {
 			break;
 		}
-		removeNextTaskFromQueue();
+        if (partition != FLOW_PARTITION_UI) {
+            if (getRootFlowState(flowState)->numMarshalledTasks > 0) {
+                if (++numDeferred > getQueueSize(partition)) {
+                    break;
+                }
+                addToQueue(flowState, componentIndex, -1, -1, -1, continuousTask);
+                removeNextTaskFromQueue(partition);
+                continue;
+            }
+            if (isUiAffineComponent(flowState, componentIndex)) {
+                if (!marshalToUiPartition(flowState, componentIndex, continuousTask)) {
+                    break;
+                }
+                removeNextTaskFromQueue(partition);
+                continue;
+            }
+            numDeferred = 0;
+        }
+#if EEZ_FLOW_PROFILER
+        uint32_t enqueueCycles = getNextTaskEnqueueCycles(partition);
+#endif
+		removeNextTaskFromQueue(partition);
         flowState->executingComponentIndex = componentIndex;
         if (flowState->error) {
             deallocateComponentExecutionState(flowState, componentIndex);
@@ -4214,46 +5709,123 @@ void tick() {
             if (continuousTask) {
                 auto componentExecutionState = (ComponenentExecutionState *)flowState->componenentExecutionStates[componentIndex];
                 if (!componentExecutionState) {
-                    executeComponent(flowState, componentIndex);
+                    EXECUTE_COMPONENT(flowState, componentIndex);
                 } else if (componentExecutionState->lastExecutedTime + FLOW_TICK_MAX_DURATION_MS <= startTickCount) {
                     componentExecutionState->lastExecutedTime = startTickCount;
-                    executeComponent(flowState, componentIndex);
+                    EXECUTE_COMPONENT(flowState, componentIndex);
                 } else {
                     addToQueue(flowState, componentIndex, -1, -1, -1, true);
                 }
             } else {
-                executeComponent(flowState, componentIndex);
+                EXECUTE_COMPONENT(flowState, componentIndex);
             }
         }
         if (isFlowStopped() || g_isStopping) {
             break;
         }
         resetSequenceInputs(flowState);
-        if (canFreeFlowState(flowState)) {
+        if (partition != FLOW_PARTITION_UI) {
+            freeIdleFlowStates(flowState);
+        } else if (canFreeFlowState(flowState)) {
             freeFlowState(flowState);
         }
         if ((i + 1) % 5 == 0) {
             if (millis() - startTickCount >= FLOW_TICK_MAX_DURATION_MS) {
+#if EEZ_FLOW_PROFILER
+                overBudget = true;
+#endif
                 break;
             }
         }
 	}
-    visitWatchList();
+#if EEZ_FLOW_PROFILER
+    profilerRecordTick(partition, getProfilerCycles() - startTickCycles, overBudget);
+#endif
+}
+#undef EXECUTE_COMPONENT
+void tickPartition(uint8_t partition) {
+    setCurrentPartition(partition);
+    if (partition != FLOW_PARTITION_UI) {
+        g_isPartitionTicking[partition] = true;
+        if (!isFlowStopped() && !g_isStopping) {
+            executeQueue(partition);
+            visitWatchList(partition);
+        }
+        g_isPartitionTicking[partition] = false;
+        return;
+    }
+	if (isFlowStopped()) {
+		return;
+	}
+    if (g_isStopping) {
+        doStop();
+        return;
+    }
+    processMQTTIngest();
+    executeQueue(partition);
+    visitWatchList(partition);
 	finishToDebuggerMessageHook();
 }
+void tick() {
+    tickPartition(FLOW_PARTITION_UI);
+}
+void setFlowPartition(int flowIndex, uint8_t partition) {
+    if (g_flowPartitions && flowIndex >= 0 && flowIndex < (int)g_assets->flowDefinition->flows.count) {
+        g_flowPartitions[flowIndex] = partition;
+    }
+}
+uint8_t getFlowPartition(int flowIndex) {
+    if (g_flowPartitions && flowIndex >= 0 && flowIndex < (int)g_assets->flowDefinition->flows.count) {
+        return g_flowPartitions[flowIndex];
+    }
+    return FLOW_PARTITION_INHERIT;
+}
+bool startFlowOnPartition(int flowIndex, uint8_t partition) {
+    if (isFlowStopped() || flowIndex < 0 || flowIndex >= (int)g_assets->flowDefinition->flows.count) {
+        return false;
+    }
+    if (partition == getCurrentPartition()) {
+        startFlow(flowIndex);
+        return true;
+    }
+    PartitionMessage message;
+    message.type = PARTITION_MESSAGE_START_FLOW;
+    message.continuousTask = false;
+    message.flowIndex = flowIndex;
+    message.flowState = nullptr;
+    message.componentIndex = 0;
+    return postPartitionMessage(partition, message);
+}
 void stop() {
     g_isStopping = true;
 }
 void doStop() {
+    for (unsigned partition = 0; partition < FLOW_NUM_PARTITIONS; partition++) {
+        while (g_isPartitionTicking[partition]) {
+            waitForPartitionHook(partition);
+        }
+    }
     onStopped();
     finishToDebuggerMessageHook();
     g_debuggerIsConnected = false;
     freeAllChildrenFlowStates(g_firstFlowState);
     g_firstFlowState = nullptr;
     g_lastFlowState = nullptr;
+    freeAllChildrenFlowStates(g_firstWorkerFlowState);
+    g_firstWorkerFlowState = nullptr;
+    g_lastWorkerFlowState = nullptr;
     g_isStopped = true;
 	queueReset();
     watchListReset();
+    freeCompiledExpressions();
+    freeTranslations();
+#if EEZ_FLOW_PROFILER
+    profilerStop();
+#endif
+    if (g_flowPartitions) {
+        free(g_flowPartitions);
+        g_flowPartitions = nullptr;
+    }
 }
 bool isFlowStopped() {
     return g_isStopped;
@@ -4555,6 +6127,7 @@ void onArrayValueFree(ArrayValue *arrayValue) {
 #if EEZ_OPTION_GUI
 #endif
 #include <chrono>
+#include <thread>
 namespace eez {
 namespace flow {
 static void replacePage(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t delay) {
@@ -4606,10 +6179,466 @@ double getDateNowDefaultImplementation() {
     milliseconds ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
     return (double)ms.count();
 }
-double (*getDateNowHook)() = getDateNowDefaultImplementation;
-void (*onFlowErrorHook)(FlowState *flowState, int componentIndex, const char *errorMessage) = nullptr;
+double (*getDateNowHook)() = getDateNowDefaultImplementation;
+void (*onFlowErrorHook)(FlowState *flowState, int componentIndex, const char *errorMessage) = nullptr;
+static void wakePartition(uint8_t) {
+}
+void (*wakePartitionHook)(uint8_t partition) = wakePartition;
+static void waitForPartition(uint8_t) {
+    std::this_thread::yield();
+}
+void (*waitForPartitionHook)(uint8_t partition) = waitForPartition;
+} 
+} 
+// -----------------------------------------------------------------------------
+// flow/json.cpp
+// -----------------------------------------------------------------------------
+#if !defined(EEZ_DASHBOARD_API)
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+namespace eez {
+JsonValueRef::~JsonValueRef() {
+    if (document != this && --document->refCounter == 0) {
+        ObjectAllocator<Ref>::deallocate(document);
+    }
+}
+namespace flow {
+struct JsonTokenizer {
+    const char *text;
+    const char *p;
+    const char *end;
+    JsonToken *tokens;
+    uint32_t numTokens;
+    int depth;
+    void skipWhitespace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+            p++;
+        }
+    }
+    bool skipDigits() {
+        const char *start = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            p++;
+        }
+        return p > start;
+    }
+    bool skipLiteral(const char *literal, size_t length) {
+        if ((size_t)(end - p) < length || memcmp(p, literal, length) != 0) {
+            return false;
+        }
+        p += length;
+        return true;
+    }
+    bool parseValue();
+};
+bool JsonTokenizer::parseValue() {
+    skipWhitespace();
+    if (p == end) {
+        return false;
+    }
+    uint32_t index = numTokens++;
+    const char *start = p;
+    char c = *p;
+    uint8_t type;
+    uint32_t size = 0;
+    uint32_t length;
+    bool escaped = false;
+    if (c == '{' || c == '[') {
+        if (++depth > EEZ_JSON_MAX_DEPTH) {
+            return false;
+        }
+        char close = c == '{' ? '}' : ']';
+        p++;
+        skipWhitespace();
+        if (p < end && *p == close) {
+            p++;
+        } else {
+            while (true) {
+                if (c == '{') {
+                    skipWhitespace();
+                    if (p == end || *p != '"' || !parseValue()) {
+                        return false;
+                    }
+                    skipWhitespace();
+                    if (p == end || *p++ != ':') {
+                        return false;
+                    }
+                }
+                if (!parseValue()) {
+                    return false;
+                }
+                size++;
+                skipWhitespace();
+                if (p == end) {
+                    return false;
+                }
+                c = *p++;
+                if (c == ',') {
+                    c = *start;
+                    continue;
+                }
+                if (c != close) {
+                    return false;
+                }
+                break;
+            }
+        }
+        depth--;
+        type = *start == '{' ? JSON_TOKEN_OBJECT : JSON_TOKEN_ARRAY;
+        length = p - start;
+    } else if (c == '"') {
+        start = ++p;
+        while (p < end && *p != '"') {
+            if ((uint8_t)*p < 0x20) {
+                return false;
+            }
+            if (*p == '\\') {
+                escaped = true;
+                p++;
+            }
+            p++;
+        }
+        if (p >= end) {
+            return false;
+        }
+        type = JSON_TOKEN_STRING;
+        length = p++ - start;
+    } else if (c == '-' || (c >= '0' && c <= '9')) {
+        if (c == '-') {
+            p++;
+        }
+        if (!skipDigits()) {
+            return false;
+        }
+        if (p < end && *p == '.') {
+            p++;
+            if (!skipDigits()) {
+                return false;
+            }
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            p++;
+            if (p < end && (*p == '+' || *p == '-')) {
+                p++;
+            }
+            if (!skipDigits()) {
+                return false;
+            }
+        }
+        type = JSON_TOKEN_NUMBER;
+        length = p - start;
+    } else if (skipLiteral("true", 4)) {
+        type = JSON_TOKEN_TRUE;
+        length = 4;
+    } else if (skipLiteral("false", 5)) {
+        type = JSON_TOKEN_FALSE;
+        length = 5;
+    } else if (skipLiteral("null", 4)) {
+        type = JSON_TOKEN_NULL;
+        length = 4;
+    } else {
+        return false;
+    }
+    if (tokens) {
+        JsonToken &token = tokens[index];
+        token.type = type;
+        token.escaped = escaped;
+        token.offset = start - text;
+        token.length = length;
+        token.size = size;
+        token.next = numTokens;
+    }
+    return true;
+}
+static int32_t tokenizeJson(const char *text, uint32_t length, JsonToken *tokens) {
+    JsonTokenizer tokenizer = { text, text, text + length, tokens, 0, 0 };
+    if (!tokenizer.parseValue()) {
+        return -1;
+    }
+    tokenizer.skipWhitespace();
+    if (tokenizer.p != tokenizer.end) {
+        return -1;
+    }
+    return tokenizer.numTokens;
+}
+static uint32_t hexDigit(char c) {
+    return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+static uint32_t unescapeJsonChar(const char *&src, const char *end, char *dst) {
+    char c = *src++;
+    if (c != '\\' || src == end) {
+        *dst = c;
+        return 1;
+    }
+    c = *src++;
+    switch (c) {
+    case 'b': *dst = '\b'; return 1;
+    case 'f': *dst = '\f'; return 1;
+    case 'n': *dst = '\n'; return 1;
+    case 'r': *dst = '\r'; return 1;
+    case 't': *dst = '\t'; return 1;
+    case 'u': {
+        if (end - src < 4) {
+            src = end;
+            return 0;
+        }
+        uint32_t codePoint = (hexDigit(src[0]) << 12) | (hexDigit(src[1]) << 8) | (hexDigit(src[2]) << 4) | hexDigit(src[3]);
+        src += 4;
+        if (codePoint >= 0xD800 && codePoint < 0xDC00 && end - src >= 6 && src[0] == '\\' && src[1] == 'u') {
+            uint32_t low = (hexDigit(src[2]) << 12) | (hexDigit(src[3]) << 8) | (hexDigit(src[4]) << 4) | hexDigit(src[5]);
+            if (low >= 0xDC00 && low < 0xE000) {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                src += 6;
+            }
+        }
+        if (codePoint < 0x80) {
+            dst[0] = codePoint;
+            return 1;
+        }
+        if (codePoint < 0x800) {
+            dst[0] = 0xC0 | (codePoint >> 6);
+            dst[1] = 0x80 | (codePoint & 0x3F);
+            return 2;
+        }
+        if (codePoint < 0x10000) {
+            dst[0] = 0xE0 | (codePoint >> 12);
+            dst[1] = 0x80 | ((codePoint >> 6) & 0x3F);
+            dst[2] = 0x80 | (codePoint & 0x3F);
+            return 3;
+        }
+        dst[0] = 0xF0 | (codePoint >> 18);
+        dst[1] = 0x80 | ((codePoint >> 12) & 0x3F);
+        dst[2] = 0x80 | ((codePoint >> 6) & 0x3F);
+        dst[3] = 0x80 | (codePoint & 0x3F);
+        return 4;
+    }
+    default: *dst = c; return 1;
+    }
+}
+static uint32_t unescapeJsonString(char *dst, const char *src, uint32_t length) {
+    const char *end = src + length;
+    char *start = dst;
+    while (src < end) {
+        dst += unescapeJsonChar(src, end, dst);
+    }
+    return dst - start;
+}
+static bool jsonKeyEquals(const JsonDocument *document, const JsonToken &key, const char *name, size_t nameLength) {
+    const char *text = document->text + key.offset;
+    if (!key.escaped) {
+        return key.length == nameLength && memcmp(text, name, nameLength) == 0;
+    }
+    if (key.length < nameLength) {
+        return false;
+    }
+    const char *end = text + key.length;
+    size_t i = 0;
+    while (text < end) {
+        char chunk[4];
+        uint32_t n = unescapeJsonChar(text, end, chunk);
+        if (n > nameLength - i || memcmp(chunk, name + i, n) != 0) {
+            return false;
+        }
+        i += n;
+    }
+    return i == nameLength;
+}
+static bool parseJsonIndex(const char *name, size_t nameLength, uint32_t &index) {
+    if (nameLength == 0 || nameLength > 9) {
+        return false;
+    }
+    index = 0;
+    for (size_t i = 0; i < nameLength; i++) {
+        if (name[i] < '0' || name[i] > '9') {
+            return false;
+        }
+        index = index * 10 + (name[i] - '0');
+    }
+    return true;
+}
+static int32_t findJsonElement(const JsonDocument *document, uint32_t token, uint32_t index) {
+    const JsonToken &parent = document->tokens[token];
+    if (parent.type != JSON_TOKEN_ARRAY || index >= parent.size) {
+        return -1;
+    }
+    uint32_t i = token + 1;
+    while (index--) {
+        i = document->tokens[i].next;
+    }
+    return i;
+}
+static int32_t findJsonToken(const JsonDocument *document, uint32_t token, const char *name, size_t nameLength) {
+    const JsonToken &parent = document->tokens[token];
+    uint32_t i = token + 1;
+    if (parent.type == JSON_TOKEN_OBJECT) {
+        for (uint32_t member = 0; member < parent.size; member++) {
+            if (jsonKeyEquals(document, document->tokens[i], name, nameLength)) {
+                return i + 1;
+            }
+            i = document->tokens[i + 1].next;
+        }
+    } else if (parent.type == JSON_TOKEN_ARRAY) {
+        uint32_t index;
+        if (parseJsonIndex(name, nameLength, index)) {
+            return findJsonElement(document, token, index);
+        }
+    }
+    return -1;
+}
+static Value makeJsonValue(JsonDocument *document, uint32_t token, uint32_t id) {
+    const JsonToken &jsonToken = document->tokens[token];
+    const char *text = document->text + jsonToken.offset;
+    if (jsonToken.type == JSON_TOKEN_OBJECT || jsonToken.type == JSON_TOKEN_ARRAY) {
+        JsonValueRef *ref = document;
+        if (token != 0) {
+            ref = ObjectAllocator<JsonValueRef>::allocate(id);
+            if (ref == nullptr) {
+                return Value(0, VALUE_TYPE_NULL);
+            }
+            ref->document = document;
+            ref->token = token;
+            ref->refCounter = 1;
+        }
+        document->refCounter++;
+        Value value;
+        value.type = VALUE_TYPE_JSON;
+        value.options = VALUE_OPTIONS_REF;
+        value.refValue = ref;
+        return value;
+    }
+    if (jsonToken.type == JSON_TOKEN_STRING) {
+        Value value = Value::makeStringRef(text, jsonToken.length, id);
+        if (jsonToken.escaped && value.getType() == VALUE_TYPE_STRING_REF) {
+            auto stringRef = (StringRef *)value.refValue;
+            stringRef->str[unescapeJsonString(stringRef->str, text, jsonToken.length)] = 0;
+        }
+        return value;
+    }
+    if (jsonToken.type == JSON_TOKEN_NUMBER) {
+        if (jsonToken.length <= 10 && !memchr(text, '.', jsonToken.length) && !memchr(text, 'e', jsonToken.length) && !memchr(text, 'E', jsonToken.length)) {
+            int64_t number = strtoll(text, nullptr, 10);
+            if (number >= INT32_MIN && number <= INT32_MAX) {
+                return Value((int)number, VALUE_TYPE_INT32);
+            }
+        }
+        return Value(strtod(text, nullptr), VALUE_TYPE_DOUBLE);
+    }
+    if (jsonToken.type == JSON_TOKEN_TRUE || jsonToken.type == JSON_TOKEN_FALSE) {
+        return Value(jsonToken.type == JSON_TOKEN_TRUE, VALUE_TYPE_BOOLEAN);
+    }
+    return Value(0, VALUE_TYPE_NULL);
+}
+static Value parseJson(const Value &source, const char *text, uint32_t length, bool copy, uint32_t id) {
+    int32_t numTokens = tokenizeJson(text, length, nullptr);
+    if (numTokens <= 0) {
+        return Value::makeError();
+    }
+    size_t tokensOffset = (sizeof(JsonDocument) + 7) & ~7;
+    size_t size = tokensOffset + numTokens * sizeof(JsonToken) + (copy ? length + 1 : 0);
+    auto ptr = (uint8_t *)alloc(size, id);
+    if (ptr == nullptr) {
+        return Value::makeError();
+    }
+    JsonDocument *document = new (ptr) JsonDocument;
+    document->document = document;
+    document->token = 0;
+    document->tokens = (JsonToken *)(ptr + tokensOffset);
+    document->numTokens = numTokens;
+    if (copy) {
+        char *textCopy = (char *)(document->tokens + numTokens);
+        memcpy(textCopy, text, length);
+        textCopy[length] = 0;
+        text = textCopy;
+    } else {
+        document->source = source;
+    }
+    document->text = text;
+    tokenizeJson(text, length, document->tokens);
+    Value documentValue;
+    documentValue.type = VALUE_TYPE_JSON;
+    documentValue.options = VALUE_OPTIONS_REF;
+    documentValue.refValue = document;
+    document->refCounter = 1;
+    if (document->tokens[0].type == JSON_TOKEN_OBJECT || document->tokens[0].type == JSON_TOKEN_ARRAY) {
+        return documentValue;
+    }
+    return makeJsonValue(document, 0, id + 1);
+}
+Value parseJson(const char *text, size_t length) {
+    return parseJson(Value(), text, length, true, 0x5e1d36a2);
+}
+Value parseJson(const Value &text) {
+    Value value = text.getValue();
+    if (!value.isString()) {
+        return Value::makeError();
+    }
+    const char *str = value.getString();
+    bool copy = value.getType() != VALUE_TYPE_STRING_REF;
+    return parseJson(value, str, strlen(str), copy, 0x5e1d36a2);
+}
+Value getJsonMember(const Value &json, const char *name) {
+    if (json.getType() != VALUE_TYPE_JSON) {
+        return Value();
+    }
+    auto ref = (JsonValueRef *)json.refValue;
+    int32_t token = findJsonToken(ref->document, ref->token, name, strlen(name));
+    if (token < 0) {
+        return Value();
+    }
+    return makeJsonValue(ref->document, token, 0x83b5d0e4);
+}
+Value getJsonElement(const Value &json, uint32_t index) {
+    if (json.getType() != VALUE_TYPE_JSON) {
+        return Value();
+    }
+    auto ref = (JsonValueRef *)json.refValue;
+    int32_t token = findJsonElement(ref->document, ref->token, index);
+    if (token < 0) {
+        return Value();
+    }
+    return makeJsonValue(ref->document, token, 0x83b5d0e4);
+}
+Value getJsonPath(const Value &json, const char *path) {
+    if (json.getType() != VALUE_TYPE_JSON) {
+        return Value();
+    }
+    auto ref = (JsonValueRef *)json.refValue;
+    int32_t token = ref->token;
+    while (*path) {
+        const char *dot = strchr(path, '.');
+        size_t nameLength = dot ? (size_t)(dot - path) : strlen(path);
+        token = findJsonToken(ref->document, token, path, nameLength);
+        if (token < 0) {
+            return Value();
+        }
+        path += nameLength;
+        if (*path == '.') {
+            path++;
+        }
+    }
+    return makeJsonValue(ref->document, token, 0x83b5d0e4);
+}
+int getJsonLength(const Value &json) {
+    if (json.getType() != VALUE_TYPE_JSON) {
+        return -1;
+    }
+    auto ref = (JsonValueRef *)json.refValue;
+    return ref->document->tokens[ref->token].size;
+}
+const char *getJsonText(const Value &json, uint32_t &length) {
+    if (json.getType() != VALUE_TYPE_JSON) {
+        length = 0;
+        return nullptr;
+    }
+    auto ref = (JsonValueRef *)json.refValue;
+    const JsonToken &token = ref->document->tokens[ref->token];
+    length = token.length;
+    return ref->document->text + token.offset;
+}
 } 
 } 
+#endif
 // -----------------------------------------------------------------------------
 // flow/lvgl_api.cpp
 // -----------------------------------------------------------------------------
@@ -4676,7 +6705,163 @@ extern "C" void eez_flow_pop_screen(lv_scr_load_anim_t animType, uint32_t speed,
         eez::flow::replacePageHook(g_screenStack[g_screenStackPosition], animType, speed, delay);
     }
 }
+#if !defined(EEZ_LVGL_MAX_SCREENS)
+#define EEZ_LVGL_MAX_SCREENS 64
+#endif
+#if !defined(EEZ_LVGL_SCREEN_CACHE_BUDGET)
+#define EEZ_LVGL_SCREEN_CACHE_BUDGET (256 * 1024)
+#endif
+struct ScreenCacheEntry {
+    uint32_t lastUsed;
+    uint32_t size;
+    int16_t likelyNext;
+};
+static const create_screen_func_t *g_createScreenFuncs;
+static size_t g_numScreens;
+static ScreenCacheEntry g_screenCache[EEZ_LVGL_MAX_SCREENS];
+static uint32_t g_screenUseCounter;
+static size_t g_screenCacheBudget = EEZ_LVGL_SCREEN_CACHE_BUDGET;
+static int16_t g_prewarmScreen = -1;
+static size_t getLvglUsedMemory() {
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    return monitor.total_size - monitor.free_size;
+}
+static size_t (*g_getScreenMemory)() = getLvglUsedMemory;
+extern "C" void eez_flow_set_screen_factories(const create_screen_func_t *createScreenFuncs, size_t numScreens) {
+    g_createScreenFuncs = createScreenFuncs;
+    g_numScreens = numScreens < EEZ_LVGL_MAX_SCREENS ? numScreens : EEZ_LVGL_MAX_SCREENS;
+    for (size_t i = 0; i < EEZ_LVGL_MAX_SCREENS; i++) {
+        g_screenCache[i].lastUsed = 0;
+        g_screenCache[i].size = 0;
+        g_screenCache[i].likelyNext = -1;
+    }
+}
+extern "C" void eez_flow_set_screen_cache_budget(size_t bytes) {
+    g_screenCacheBudget = bytes;
+}
+extern "C" void eez_flow_set_screen_memory_probe(size_t (*getUsedMemory)()) {
+    g_getScreenMemory = getUsedMemory ? getUsedMemory : getLvglUsedMemory;
+}
+static size_t getNumLvglObjects() {
+    return g_numObjects / sizeof(lv_obj_t *);
+}
+extern "C" bool eez_flow_is_screen_created(int16_t screenId) {
+    return screenId >= 1 && (size_t)screenId <= getNumLvglObjects() && g_objects[screenId - 1] != nullptr;
+}
+extern "C" bool eez_flow_create_screen(int16_t screenId) {
+    if (eez_flow_is_screen_created(screenId)) {
+        return true;
+    }
+    if (!g_createScreenFuncs || screenId < 1 || (size_t)screenId > g_numScreens) {
+        return false;
+    }
+    size_t before = g_getScreenMemory();
+    g_createScreenFuncs[screenId - 1]();
+    size_t after = g_getScreenMemory();
+    g_screenCache[screenId - 1].size = after > before ? after - before : 0;
+    g_screenCache[screenId - 1].lastUsed = ++g_screenUseCounter;
+    return eez_flow_is_screen_created(screenId);
+}
+static void releasePageFlowState(int16_t pageIndex) {
+    using namespace eez::flow;
+    if (hasPartitionMessages(FLOW_PARTITION_UI)) {
+        return;
+    }
+    for (auto flowState = g_firstFlowState; flowState; flowState = flowState->nextSibling) {
+        if (flowState->flowIndex == pageIndex && !flowState->isAction) {
+            if (flowState->partition != FLOW_PARTITION_UI || flowState->refCounter > 0) {
+                return;
+            }
+            for (unsigned componentIndex = 0; componentIndex < flowState->flow->components.count; componentIndex++) {
+                if (isInQueue(flowState, componentIndex)) {
+                    return;
+                }
+            }
+            freeFlowState(flowState);
+            return;
+        }
+    }
+}
+extern "C" bool eez_flow_delete_screen(int16_t screenId) {
+    if (!g_createScreenFuncs || !eez_flow_is_screen_created(screenId) || screenId == g_currentScreen + 1) {
+        return false;
+    }
+    lv_obj_t *screen = g_objects[screenId - 1];
+    if (screen == lv_scr_act()) {
+        return false;
+    }
+    for (size_t i = 0, n = getNumLvglObjects(); i < n; i++) {
+        if (g_objects[i] && g_objects[i] != screen && lv_obj_get_screen(g_objects[i]) == screen) {
+            g_objects[i] = nullptr;
+        }
+    }
+    g_objects[screenId - 1] = nullptr;
+    lv_obj_del(screen);
+    releasePageFlowState(screenId - 1);
+    return true;
+}
+extern "C" void eez_flow_prewarm_screen(int16_t screenId) {
+    g_prewarmScreen = screenId;
+}
+extern "C" size_t eez_flow_get_screen_cache_size() {
+    size_t total = 0;
+    for (size_t i = 0; i < g_numScreens; i++) {
+        if (g_objects[i]) {
+            total += g_screenCache[i].size;
+        }
+    }
+    return total;
+}
+static void onScreenLoaded(int16_t fromScreenId, int16_t toScreenId) {
+    if (!g_createScreenFuncs || toScreenId < 1 || (size_t)toScreenId > g_numScreens) {
+        return;
+    }
+    g_screenCache[toScreenId - 1].lastUsed = ++g_screenUseCounter;
+    if (fromScreenId >= 1 && (size_t)fromScreenId <= g_numScreens && fromScreenId != toScreenId) {
+        g_screenCache[fromScreenId - 1].likelyNext = toScreenId;
+    }
+}
+static void evictScreens(size_t budget) {
+    while (eez_flow_get_screen_cache_size() > budget) {
+        int16_t victim = -1;
+        for (size_t i = 0; i < g_numScreens; i++) {
+            if (g_objects[i] && (int16_t)i != g_currentScreen && (victim == -1 || g_screenCache[i].lastUsed < g_screenCache[victim].lastUsed)) {
+                victim = i;
+            }
+        }
+        if (victim == -1 || !eez_flow_delete_screen(victim + 1)) {
+            return;
+        }
+    }
+}
+static void tickScreenCache() {
+    if (!g_createScreenFuncs || lv_anim_count_running() > 0 || eez::flow::getQueueSize(FLOW_PARTITION_UI) > 0 || eez::flow::hasPartitionMessages(FLOW_PARTITION_UI)) {
+        return;
+    }
+    evictScreens(g_screenCacheBudget);
+    int16_t screenId = g_prewarmScreen;
+    if (screenId == -1 && g_currentScreen >= 0 && (size_t)g_currentScreen < g_numScreens) {
+        screenId = g_screenCache[g_currentScreen].likelyNext;
+    }
+    if (screenId != -1 && !eez_flow_is_screen_created(screenId)) {
+        size_t cacheSize = eez_flow_get_screen_cache_size();
+        size_t expectedSize = g_screenCache[screenId - 1].size;
+        if (cacheSize + expectedSize <= g_screenCacheBudget) {
+            eez_flow_create_screen(screenId);
+            g_screenCache[screenId - 1].lastUsed = 0;
+        }
+    }
+    g_prewarmScreen = -1;
+}
+static eez_flow_assets_loader_t g_assetsLoader;
+extern "C" void eez_flow_set_assets_loader(eez_flow_assets_loader_t loader) {
+    g_assetsLoader = loader;
+}
 extern "C" void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj_t **objects, size_t numObjects, const ext_img_desc_t *images, size_t numImages, ActionExecFunc *actions) {
+    if (g_assetsLoader) {
+        g_assetsLoader(&assets, &assetsSize);
+    }
     g_objects = objects;
     g_numObjects = numObjects;
     g_images = images;
@@ -4691,11 +6876,18 @@ extern "C" void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj
     eez::flow::getLvglImageByNameHook = getLvglImageByName;
     eez::flow::executeLvglActionHook = executeLvglAction;
     eez::flow::start(eez::g_mainAssets);
-    create_screens();
+    if (!g_createScreenFuncs) {
+        create_screens();
+    } else {
+        lv_disp_t *dispp = lv_disp_get_default();
+        lv_theme_t *theme = lv_theme_default_init(dispp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED), false, LV_FONT_DEFAULT);
+        lv_disp_set_theme(dispp, theme);
+    }
     replacePageHook(1, 0, 0, 0);
 }
 extern "C" void eez_flow_tick() {
     eez::flow::tick();
+    tickScreenCache();
 }
 extern "C" bool eez_flow_is_stopped() {
     return eez::flow::isFlowStopped();
@@ -4703,10 +6895,145 @@ extern "C" bool eez_flow_is_stopped() {
 namespace eez {
 ActionExecFunc g_actionExecFunctions[] = { 0 };
 }
+#if LV_USE_SNAPSHOT && LVGL_VERSION_MAJOR < 9
+struct ScreenTransition {
+    lv_obj_t *screen;
+    lv_obj_t *fromImage;
+    lv_obj_t *toImage;
+    lv_img_dsc_t *fromSnapshot;
+    lv_img_dsc_t *toSnapshot;
+    lv_obj_t *toScreen;
+    uint32_t animType;
+};
+static ScreenTransition g_screenTransition;
+static const int32_t SCREEN_TRANSITION_STEPS = 256;
+static void endScreenTransition() {
+    auto &transition = g_screenTransition;
+    if (!transition.screen) {
+        return;
+    }
+    lv_anim_del(&transition, nullptr);
+    if (lv_scr_act() == transition.screen) {
+        lv_scr_load(transition.toScreen);
+    }
+    lv_obj_del(transition.screen);
+    lv_img_cache_invalidate_src(transition.fromSnapshot);
+    lv_img_cache_invalidate_src(transition.toSnapshot);
+    lv_snapshot_free(transition.fromSnapshot);
+    lv_snapshot_free(transition.toSnapshot);
+    transition.screen = nullptr;
+}
+static void screenTransitionReadyCallback(lv_anim_t *anim) {
+    LV_UNUSED(anim);
+    endScreenTransition();
+}
+static void screenTransitionExecCallback(void *var, int32_t value) {
+    auto transition = (ScreenTransition *)var;
+    lv_coord_t w = lv_obj_get_width(transition->screen);
+    lv_coord_t h = lv_obj_get_height(transition->screen);
+    lv_coord_t dx = (lv_coord_t)(w * value / SCREEN_TRANSITION_STEPS);
+    lv_coord_t dy = (lv_coord_t)(h * value / SCREEN_TRANSITION_STEPS);
+    lv_opa_t opa = (lv_opa_t)(LV_OPA_COVER * value / SCREEN_TRANSITION_STEPS);
+    switch (transition->animType) {
+    case LV_SCR_LOAD_ANIM_OVER_LEFT: lv_obj_set_x(transition->toImage, w - dx); break;
+    case LV_SCR_LOAD_ANIM_OVER_RIGHT: lv_obj_set_x(transition->toImage, dx - w); break;
+    case LV_SCR_LOAD_ANIM_OVER_TOP: lv_obj_set_y(transition->toImage, h - dy); break;
+    case LV_SCR_LOAD_ANIM_OVER_BOTTOM: lv_obj_set_y(transition->toImage, dy - h); break;
+    case LV_SCR_LOAD_ANIM_MOVE_LEFT: lv_obj_set_x(transition->fromImage, -dx); lv_obj_set_x(transition->toImage, w - dx); break;
+    case LV_SCR_LOAD_ANIM_MOVE_RIGHT: lv_obj_set_x(transition->fromImage, dx); lv_obj_set_x(transition->toImage, dx - w); break;
+    case LV_SCR_LOAD_ANIM_MOVE_TOP: lv_obj_set_y(transition->fromImage, -dy); lv_obj_set_y(transition->toImage, h - dy); break;
+    case LV_SCR_LOAD_ANIM_MOVE_BOTTOM: lv_obj_set_y(transition->fromImage, dy); lv_obj_set_y(transition->toImage, dy - h); break;
+    case LV_SCR_LOAD_ANIM_FADE_IN: lv_obj_set_style_img_opa(transition->toImage, opa, 0); break;
+    case LV_SCR_LOAD_ANIM_FADE_OUT: lv_obj_set_style_img_opa(transition->fromImage, LV_OPA_COVER - opa, 0); break;
+    case LV_SCR_LOAD_ANIM_OUT_LEFT: lv_obj_set_x(transition->fromImage, -dx); break;
+    case LV_SCR_LOAD_ANIM_OUT_RIGHT: lv_obj_set_x(transition->fromImage, dx); break;
+    case LV_SCR_LOAD_ANIM_OUT_TOP: lv_obj_set_y(transition->fromImage, -dy); break;
+    case LV_SCR_LOAD_ANIM_OUT_BOTTOM: lv_obj_set_y(transition->fromImage, dy); break;
+    case EEZ_SCR_LOAD_ANIM_ZOOM_IN:
+        lv_img_set_zoom(transition->toImage, LV_IMG_ZOOM_NONE / 2 + LV_IMG_ZOOM_NONE / 2 * value / SCREEN_TRANSITION_STEPS);
+        lv_obj_set_style_img_opa(transition->toImage, opa, 0);
+        break;
+    case EEZ_SCR_LOAD_ANIM_ZOOM_OUT:
+        lv_img_set_zoom(transition->fromImage, LV_IMG_ZOOM_NONE + LV_IMG_ZOOM_NONE * value / SCREEN_TRANSITION_STEPS);
+        lv_obj_set_style_img_opa(transition->fromImage, LV_OPA_COVER - opa, 0);
+        break;
+    }
+}
+static lv_obj_t *createTransitionImage(lv_obj_t *parent, const lv_img_dsc_t *snapshot) {
+    lv_obj_t *image = lv_img_create(parent);
+    lv_img_set_src(image, snapshot);
+    lv_obj_set_pos(image, 0, 0);
+    lv_img_set_pivot(image, snapshot->header.w / 2, snapshot->header.h / 2);
+    return image;
+}
+static bool startScreenTransition(lv_obj_t *fromScreen, lv_obj_t *toScreen, uint32_t animType, uint32_t speed, uint32_t delay) {
+    endScreenTransition();
+    if (animType == LV_SCR_LOAD_ANIM_NONE || speed == 0 || !fromScreen || !toScreen || fromScreen == toScreen) {
+        return false;
+    }
+    auto &transition = g_screenTransition;
+    lv_obj_update_layout(toScreen);
+    transition.fromSnapshot = lv_snapshot_take(fromScreen, LV_IMG_CF_TRUE_COLOR);
+    if (!transition.fromSnapshot) {
+        return false;
+    }
+    transition.toSnapshot = lv_snapshot_take(toScreen, LV_IMG_CF_TRUE_COLOR);
+    if (!transition.toSnapshot) {
+        lv_img_cache_invalidate_src(transition.fromSnapshot);
+        lv_snapshot_free(transition.fromSnapshot);
+        return false;
+    }
+    transition.screen = lv_obj_create(nullptr);
+    lv_obj_remove_style_all(transition.screen);
+    lv_obj_set_size(transition.screen, lv_obj_get_width(fromScreen), lv_obj_get_height(fromScreen));
+    lv_obj_clear_flag(transition.screen, LV_OBJ_FLAG_SCROLLABLE);
+    bool fromOnTop = animType == LV_SCR_LOAD_ANIM_FADE_OUT || animType == EEZ_SCR_LOAD_ANIM_ZOOM_OUT ||
+        (animType >= LV_SCR_LOAD_ANIM_OUT_LEFT && animType <= LV_SCR_LOAD_ANIM_OUT_BOTTOM);
+    if (fromOnTop) {
+        transition.toImage = createTransitionImage(transition.screen, transition.toSnapshot);
+        transition.fromImage = createTransitionImage(transition.screen, transition.fromSnapshot);
+    } else {
+        transition.fromImage = createTransitionImage(transition.screen, transition.fromSnapshot);
+        transition.toImage = createTransitionImage(transition.screen, transition.toSnapshot);
+    }
+    transition.toScreen = toScreen;
+    transition.animType = animType;
+    screenTransitionExecCallback(&transition, 0);
+    lv_scr_load(transition.screen);
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, &transition);
+    lv_anim_set_exec_cb(&anim, screenTransitionExecCallback);
+    lv_anim_set_ready_cb(&anim, screenTransitionReadyCallback);
+    lv_anim_set_values(&anim, 0, SCREEN_TRANSITION_STEPS);
+    lv_anim_set_time(&anim, speed);
+    lv_anim_set_delay(&anim, delay);
+    lv_anim_set_path_cb(&anim, lv_anim_path_ease_out);
+    lv_anim_start(&anim);
+    return true;
+}
+#endif
 void replacePageHook(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t delay) {
+    if (g_createScreenFuncs && !eez_flow_create_screen(pageId)) {
+        return;
+    }
+    onScreenLoaded(g_currentScreen + 1, pageId);
     eez::flow::onPageChanged(g_currentScreen + 1, pageId);
     g_currentScreen = pageId - 1;
-    lv_scr_load_anim(getLvglObjectFromIndex(g_currentScreen), (lv_scr_load_anim_t)animType, speed, delay, false);
+    lv_obj_t *screen = getLvglObjectFromIndex(g_currentScreen);
+#if LV_USE_SNAPSHOT && LVGL_VERSION_MAJOR < 9
+    lv_obj_t *fromScreen = g_screenTransition.screen ? g_screenTransition.toScreen : lv_scr_act();
+    if (animType != LV_SCR_LOAD_ANIM_NONE && fromScreen && fromScreen != screen) {
+        tick_screen(g_currentScreen);
+        if (startScreenTransition(fromScreen, screen, animType, speed, delay)) {
+            return;
+        }
+    }
+#endif
+    if (animType == EEZ_SCR_LOAD_ANIM_ZOOM_IN || animType == EEZ_SCR_LOAD_ANIM_ZOOM_OUT) {
+        animType = LV_SCR_LOAD_ANIM_FADE_IN;
+    }
+    lv_scr_load_anim(screen, (lv_scr_load_anim_t)animType, speed, delay, false);
 }
 extern "C" void flowOnPageLoaded(unsigned pageIndex) {
     eez::flow::getPageFlowState(eez::g_mainAssets, pageIndex);
@@ -4723,6 +7050,9 @@ extern "C" const char *evalTextProperty(void *flowState, unsigned componentIndex
     if (!eez::flow::evalProperty((eez::flow::FlowState *)flowState, componentIndex, propertyIndex, value, errorMessage)) {
         return "";
     }
+    if (value.getType() == eez::VALUE_TYPE_STRING) {
+        return value.getString();
+    }
     value.toText(textValue, sizeof(textValue));
     return textValue;
 }
@@ -4854,7 +7184,196 @@ using namespace eez::gui;
 int g_eezFlowLvlgMeterTickIndex = 0;
 namespace eez {
 namespace flow {
+enum NumericKind {
+    NUMERIC_KIND_NONE,
+    NUMERIC_KIND_INT32,
+    NUMERIC_KIND_INT64,
+    NUMERIC_KIND_FLOAT,
+    NUMERIC_KIND_DOUBLE,
+    NUMERIC_KIND_COUNT
+};
+static const uint8_t g_binaryNumericKind[NUMERIC_KIND_COUNT][NUMERIC_KIND_COUNT] = {
+    { NUMERIC_KIND_NONE, NUMERIC_KIND_NONE, NUMERIC_KIND_NONE, NUMERIC_KIND_NONE, NUMERIC_KIND_NONE },
+    { NUMERIC_KIND_NONE, NUMERIC_KIND_INT32, NUMERIC_KIND_INT64, NUMERIC_KIND_FLOAT, NUMERIC_KIND_DOUBLE },
+    { NUMERIC_KIND_NONE, NUMERIC_KIND_INT64, NUMERIC_KIND_INT64, NUMERIC_KIND_FLOAT, NUMERIC_KIND_DOUBLE },
+    { NUMERIC_KIND_NONE, NUMERIC_KIND_FLOAT, NUMERIC_KIND_FLOAT, NUMERIC_KIND_FLOAT, NUMERIC_KIND_DOUBLE },
+    { NUMERIC_KIND_NONE, NUMERIC_KIND_DOUBLE, NUMERIC_KIND_DOUBLE, NUMERIC_KIND_DOUBLE, NUMERIC_KIND_DOUBLE },
+};
+static inline const Value &derefOperand(const Value &value) {
+    return value.type == VALUE_TYPE_VALUE_PTR ? *value.pValueValue : value;
+}
+static inline NumericKind getNumericKind(const Value &value) {
+    switch (value.type) {
+    case VALUE_TYPE_BOOLEAN:
+    case VALUE_TYPE_INT8:
+    case VALUE_TYPE_UINT8:
+    case VALUE_TYPE_INT16:
+    case VALUE_TYPE_UINT16:
+    case VALUE_TYPE_INT32:
+    case VALUE_TYPE_UINT32:
+        return NUMERIC_KIND_INT32;
+    case VALUE_TYPE_INT64:
+    case VALUE_TYPE_UINT64:
+        return NUMERIC_KIND_INT64;
+    case VALUE_TYPE_FLOAT:
+        return NUMERIC_KIND_FLOAT;
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_DATE:
+        return NUMERIC_KIND_DOUBLE;
+    default:
+        return NUMERIC_KIND_NONE;
+    }
+}
+static inline NumericKind getBinaryNumericKind(const Value &a, const Value &b) {
+    return (NumericKind)g_binaryNumericKind[getNumericKind(a)][getNumericKind(b)];
+}
+static inline int32_t numericToInt32(const Value &value) {
+    switch (value.type) {
+    case VALUE_TYPE_INT8:
+        return value.int8Value;
+    case VALUE_TYPE_UINT8:
+        return value.uint8Value;
+    case VALUE_TYPE_INT16:
+        return value.int16Value;
+    case VALUE_TYPE_UINT16:
+        return value.uint16Value;
+    default:
+        return value.int32Value;
+    }
+}
+static inline int64_t numericToInt64(const Value &value) {
+    if (value.type == VALUE_TYPE_INT64) {
+        return value.int64Value;
+    }
+    if (value.type == VALUE_TYPE_UINT64) {
+        return (int64_t)value.uint64Value;
+    }
+    if (value.type == VALUE_TYPE_UINT32) {
+        return value.uint32Value;
+    }
+    return numericToInt32(value);
+}
+static inline float numericToFloat(const Value &value) {
+    if (value.type == VALUE_TYPE_FLOAT) {
+        return value.floatValue;
+    }
+    if (value.type == VALUE_TYPE_INT64) {
+        return (float)value.int64Value;
+    }
+    if (value.type == VALUE_TYPE_UINT64) {
+        return (float)value.uint64Value;
+    }
+    if (value.type == VALUE_TYPE_UINT32) {
+        return (float)value.uint32Value;
+    }
+    return (float)numericToInt32(value);
+}
+static inline double numericToDouble(const Value &value) {
+    if (value.type == VALUE_TYPE_DOUBLE || value.type == VALUE_TYPE_DATE) {
+        return value.doubleValue;
+    }
+    if (value.type == VALUE_TYPE_FLOAT) {
+        return value.floatValue;
+    }
+    if (value.type == VALUE_TYPE_INT64) {
+        return (double)value.int64Value;
+    }
+    if (value.type == VALUE_TYPE_UINT64) {
+        return (double)value.uint64Value;
+    }
+    if (value.type == VALUE_TYPE_UINT32) {
+        return value.uint32Value;
+    }
+    return numericToInt32(value);
+}
+struct AddKernel {
+    static Value int32(int32_t a, int32_t b) { return Value((int)(uint32_t)((uint32_t)a + (uint32_t)b), VALUE_TYPE_INT32); }
+    static Value int64(int64_t a, int64_t b) { return Value(a + b, VALUE_TYPE_INT64); }
+    static Value float32(float a, float b) { return Value(a + b, VALUE_TYPE_FLOAT); }
+    static Value float64(double a, double b) { return Value(a + b, VALUE_TYPE_DOUBLE); }
+};
+struct SubKernel {
+    static Value int32(int32_t a, int32_t b) { return Value((int)(uint32_t)((uint32_t)a - (uint32_t)b), VALUE_TYPE_INT32); }
+    static Value int64(int64_t a, int64_t b) { return Value(a - b, VALUE_TYPE_INT64); }
+    static Value float32(float a, float b) { return Value(a - b, VALUE_TYPE_FLOAT); }
+    static Value float64(double a, double b) { return Value(a - b, VALUE_TYPE_DOUBLE); }
+};
+struct MulKernel {
+    static Value int32(int32_t a, int32_t b) { return Value((int)(uint32_t)((uint32_t)a * (uint32_t)b), VALUE_TYPE_INT32); }
+    static Value int64(int64_t a, int64_t b) { return Value(a * b, VALUE_TYPE_INT64); }
+    static Value float32(float a, float b) { return Value(a * b, VALUE_TYPE_FLOAT); }
+    static Value float64(double a, double b) { return Value(a * b, VALUE_TYPE_DOUBLE); }
+};
+struct DivKernel {
+    static Value int32(int32_t a, int32_t b) { return b == 0 ? Value::makeError() : Value(1.0 * a / b, VALUE_TYPE_DOUBLE); }
+    static Value int64(int64_t a, int64_t b) { return b == 0 ? Value::makeError() : Value(1.0 * a / b, VALUE_TYPE_DOUBLE); }
+    static Value float32(float a, float b) { return Value(a / b, VALUE_TYPE_FLOAT); }
+    static Value float64(double a, double b) { return Value(a / b, VALUE_TYPE_DOUBLE); }
+};
+struct ModKernel {
+    static Value int32(int32_t a, int32_t b) { return b == 0 ? Value::makeError() : Value((int)(a % b), VALUE_TYPE_INT32); }
+    static Value int64(int64_t a, int64_t b) { return b == 0 ? Value::makeError() : Value(a % b, VALUE_TYPE_INT64); }
+    static Value float32(float a, float b) { return Value(a - floor(a / b) * b, VALUE_TYPE_FLOAT); }
+    static Value float64(double a, double b) { return Value(a - floor(a / b) * b, VALUE_TYPE_DOUBLE); }
+};
+template <typename Kernel>
+static inline bool numericBinaryOp(const Value &a1, const Value &b1, Value &result) {
+    const Value &a = derefOperand(a1);
+    const Value &b = derefOperand(b1);
+    switch (getBinaryNumericKind(a, b)) {
+    case NUMERIC_KIND_INT32:
+        result = Kernel::int32(numericToInt32(a), numericToInt32(b));
+        return true;
+    case NUMERIC_KIND_INT64:
+        result = Kernel::int64(numericToInt64(a), numericToInt64(b));
+        return true;
+    case NUMERIC_KIND_FLOAT:
+        result = Kernel::float32(numericToFloat(a), numericToFloat(b));
+        return true;
+    case NUMERIC_KIND_DOUBLE:
+        result = Kernel::float64(numericToDouble(a), numericToDouble(b));
+        return true;
+    default:
+        return false;
+    }
+}
+static inline bool numericCompare(const Value &a1, const Value &b1, bool &isLess, bool &isEqual) {
+    const Value &a = derefOperand(a1);
+    const Value &b = derefOperand(b1);
+    switch (getBinaryNumericKind(a, b)) {
+    case NUMERIC_KIND_NONE:
+        return false;
+    case NUMERIC_KIND_INT32: {
+        int32_t aInt = numericToInt32(a);
+        int32_t bInt = numericToInt32(b);
+        if (a.type == VALUE_TYPE_UINT32 || b.type == VALUE_TYPE_UINT32) {
+            break;
+        }
+        isLess = aInt < bInt;
+        isEqual = aInt == bInt;
+        return true;
+    }
+    default:
+        break;
+    }
+    double aDouble = numericToDouble(a);
+    double bDouble = numericToDouble(b);
+    isLess = aDouble < bDouble;
+    isEqual = aDouble == bDouble;
+    return true;
+}
+static Value concatenateOperands(const Value &a, const Value &b) {
+    char aBuffer[64];
+    char bBuffer[64];
+    const char *aStr = a.toStringPtr(aBuffer, sizeof(aBuffer));
+    const char *bStr = b.toStringPtr(bBuffer, sizeof(bBuffer));
+    return Value::concatenateString(aStr, strlen(aStr), bStr, strlen(bStr));
+}
 Value op_add(const Value& a1, const Value& b1) {
+    Value result;
+    if (numericBinaryOp<AddKernel>(a1, b1, result)) {
+        return result;
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -4887,12 +7406,7 @@ Value op_add(const Value& a1, const Value& b1) {
         return Value::makeError();
     }
     if (a.isString() || b.isString()) {
-        Value value1 = a.toString(0x84eafaa8);
-        Value value2 = b.toString(0xd273cab6);
-        auto res = Value::concatenateString(value1, value2);
-        char str1[128];
-        res.toText(str1, sizeof(str1));
-        return res;
+        return concatenateOperands(a, b);
     }
     if (a.isDouble() || b.isDouble()) {
         return Value(a.toDouble() + b.toDouble(), VALUE_TYPE_DOUBLE);
@@ -4906,6 +7420,10 @@ Value op_add(const Value& a1, const Value& b1) {
     return Value((int)(a.int32Value + b.int32Value), VALUE_TYPE_INT32);
 }
 Value op_sub(const Value& a1, const Value& b1) {
+    Value result;
+    if (numericBinaryOp<SubKernel>(a1, b1, result)) {
+        return result;
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -4932,6 +7450,10 @@ Value op_sub(const Value& a1, const Value& b1) {
     return Value((int)(a.int32Value - b.int32Value), VALUE_TYPE_INT32);
 }
 Value op_mul(const Value& a1, const Value& b1) {
+    Value result;
+    if (numericBinaryOp<MulKernel>(a1, b1, result)) {
+        return result;
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -4958,6 +7480,10 @@ Value op_mul(const Value& a1, const Value& b1) {
     return Value((int)(a.int32Value * b.int32Value), VALUE_TYPE_INT32);
 }
 Value op_div(const Value& a1, const Value& b1) {
+    Value result;
+    if (numericBinaryOp<DivKernel>(a1, b1, result)) {
+        return result;
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -4991,6 +7517,10 @@ Value op_div(const Value& a1, const Value& b1) {
     return Value(1.0 * a.int32Value / b.int32Value, VALUE_TYPE_DOUBLE);
 }
 Value op_mod(const Value& a1, const Value& b1) {
+    Value result;
+    if (numericBinaryOp<ModKernel>(a1, b1, result)) {
+        return result;
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5124,6 +7654,10 @@ Value op_binary_xor(const Value& a1, const Value& b1) {
     return Value((int)(a.toInt32() ^ b.toInt32()), VALUE_TYPE_INT32);
 }
 bool is_equal(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return isEqual;
+    }
     auto a = a1.getValue();
     auto b = b1.getValue();
     auto aIsUndefinedOrNull = a.getType() == VALUE_TYPE_UNDEFINED || a.getType() == VALUE_TYPE_NULL;
@@ -5161,6 +7695,10 @@ bool is_equal(const Value& a1, const Value& b1) {
     return a.toDouble() == b.toDouble();
 }
 bool is_less(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return isLess;
+    }
     auto a = a1.getValue();
     auto b = b1.getValue();
     if (a.isString() && b.isString()) {
@@ -5174,9 +7712,17 @@ bool is_less(const Value& a1, const Value& b1) {
     return a.toDouble() < b.toDouble();
 }
 bool is_great(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return !isLess && !isEqual;
+    }
     return !is_less(a1, b1) && !is_equal(a1, b1);
 }
 Value op_eq(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return Value(isEqual, VALUE_TYPE_BOOLEAN);
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5186,6 +7732,10 @@ Value op_eq(const Value& a1, const Value& b1) {
     return Value(is_equal(a1, b1), VALUE_TYPE_BOOLEAN);
 }
 Value op_neq(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return Value(!isEqual, VALUE_TYPE_BOOLEAN);
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5195,6 +7745,10 @@ Value op_neq(const Value& a1, const Value& b1) {
     return Value(!is_equal(a1, b1), VALUE_TYPE_BOOLEAN);
 }
 Value op_less(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return Value(isLess, VALUE_TYPE_BOOLEAN);
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5204,6 +7758,10 @@ Value op_less(const Value& a1, const Value& b1) {
     return Value(is_less(a1, b1), VALUE_TYPE_BOOLEAN);
 }
 Value op_great(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return Value(!isLess && !isEqual, VALUE_TYPE_BOOLEAN);
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5213,6 +7771,10 @@ Value op_great(const Value& a1, const Value& b1) {
     return Value(is_great(a1, b1), VALUE_TYPE_BOOLEAN);
 }
 Value op_less_eq(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return Value(isLess || isEqual, VALUE_TYPE_BOOLEAN);
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5222,6 +7784,10 @@ Value op_less_eq(const Value& a1, const Value& b1) {
     return Value(is_less(a1, b1) || is_equal(a1, b1), VALUE_TYPE_BOOLEAN);
 }
 Value op_great_eq(const Value& a1, const Value& b1) {
+    bool isLess, isEqual;
+    if (numericCompare(a1, b1, isLess, isEqual)) {
+        return Value(!isLess, VALUE_TYPE_BOOLEAN);
+    }
     if (a1.isError()) {
         return a1;
     }
@@ -5619,16 +8185,7 @@ void do_OPERATION_TYPE_FLOW_TRANSLATE(EvalStack &stack) {
         stack.push(Value::makeError());
         return;
     }
-    int languageIndex = g_selectedLanguage;
-    auto &languages = stack.flowState->assets->languages;
-    if (languageIndex >= 0 && languageIndex < (int)languages.count) {
-        auto &translations = languages[languageIndex]->translations;
-        if (textResourceIndex >= 0 && textResourceIndex < (int)translations.count) {
-            stack.push(translations[textResourceIndex]);
-            return;
-        }
-    }
-    stack.push("");
+    stack.push(translate(stack.flowState->assets, textResourceIndex));
 }
 void do_OPERATION_TYPE_FLOW_PARSE_INTEGER(EvalStack &stack) {
     auto str = stack.pop();
@@ -5717,7 +8274,6 @@ void do_OPERATION_TYPE_DATE_NOW(EvalStack &stack) {
     stack.push(Value((double)date::now(), VALUE_TYPE_DATE));
 }
 void do_OPERATION_TYPE_DATE_TO_STRING(EvalStack &stack) {
-#ifndef ARDUINO
     auto a = stack.pop().getValue();
     if (a.isError()) {
         stack.push(a);
@@ -5730,12 +8286,8 @@ void do_OPERATION_TYPE_DATE_TO_STRING(EvalStack &stack) {
     char str[128];
     date::toString(a.getDouble(), str, sizeof(str));
     stack.push(Value::makeStringRef(str, -1, 0xbe440ec8));
-#else
-    stack.push(Value::makeError());
-#endif
 }
 void do_OPERATION_TYPE_DATE_TO_LOCALE_STRING(EvalStack &stack) {
-#ifndef ARDUINO
     auto a = stack.pop().getValue();
     if (a.isError()) {
         stack.push(a);
@@ -5748,12 +8300,8 @@ void do_OPERATION_TYPE_DATE_TO_LOCALE_STRING(EvalStack &stack) {
     char str[128];
     date::toLocaleString(a.getDouble(), str, sizeof(str));
     stack.push(Value::makeStringRef(str, -1, 0xbe440ec8));
-#else
-    stack.push(Value::makeError());
-#endif
 }
 void do_OPERATION_TYPE_DATE_FROM_STRING(EvalStack &stack) {
-#ifndef ARDUINO
     auto a = stack.pop().getValue();
     if (a.isError()) {
         stack.push(a);
@@ -5762,9 +8310,6 @@ void do_OPERATION_TYPE_DATE_FROM_STRING(EvalStack &stack) {
     Value dateStrValue = a.toString(0x99cb1a93);
     auto date = (double)date::fromString(dateStrValue.getString());
     stack.push(Value(date, VALUE_TYPE_DATE));
-#else
-    stack.push(Value::makeError());
-#endif
 }
 void do_OPERATION_TYPE_DATE_GET_YEAR(EvalStack &stack) {
     auto a = stack.pop().getValue();
@@ -6470,6 +9015,11 @@ void do_OPERATION_TYPE_ARRAY_LENGTH(EvalStack &stack) {
             return;
         }
     }
+#else
+    if (a.isJson()) {
+        stack.push(Value(getJsonLength(a), VALUE_TYPE_UINT32));
+        return;
+    }
 #endif
     stack.push(Value::makeError());
 }
@@ -6696,29 +9246,14 @@ void do_OPERATION_TYPE_CRYPTO_SHA256(EvalStack &stack) {
     }
     const uint8_t *data;
     uint32_t dataLen;
-    if (value.isString()) {
-        const char *str = value.getString();
-        data = (uint8_t *)str;
-        dataLen = strlen(str);
-    } else if (value.isBlob()) {
-        auto blobRef = value.getBlob();
-        data = blobRef->blob;
-        dataLen = blobRef->len;
-    } else {
+    if (!getHashInput(value, data, dataLen)) {
         stack.push(Value::makeError());
         return;
     }
-#if EEZ_FOR_LVGL_SHA256_OPTION
-    BYTE buf[SHA256_BLOCK_SIZE];
-    SHA256_CTX ctx;
-    sha256_init(&ctx);
-	sha256_update(&ctx, data, dataLen);
-	sha256_final(&ctx, buf);
-    auto result = Value::makeBlobRef(buf, SHA256_BLOCK_SIZE, 0x1f0c0c0c);
+    uint8_t buf[EEZ_CRYPTO_SHA256_SIZE];
+    eez_crypto_sha256(data, dataLen, buf);
+    auto result = Value::makeBlobRef(buf, EEZ_CRYPTO_SHA256_SIZE, 0x1f0c0c0c);
     stack.push(result);
-#else
-    stack.push(Value::makeError());
-#endif
 }
 void do_OPERATION_TYPE_BLOB_ALLOCATE(EvalStack &stack) {
     auto sizeValue = stack.pop();
@@ -6736,7 +9271,6 @@ void do_OPERATION_TYPE_BLOB_ALLOCATE(EvalStack &stack) {
     stack.push(result);
 }
 void do_OPERATION_TYPE_JSON_GET(EvalStack &stack) {
-#if defined(EEZ_DASHBOARD_API)
     auto jsonValue = stack.pop().getValue();
     auto propertyValue = stack.pop();
     if (jsonValue.isError()) {
@@ -6752,9 +9286,6 @@ void do_OPERATION_TYPE_JSON_GET(EvalStack &stack) {
         return;
     }
     stack.push(Value::makeJsonMemberRef(jsonValue, propertyValue.toString(0xc73d02e7), 0xebcc230a));
-#else
-    stack.push(Value::makeError());
-#endif
 }
 void do_OPERATION_TYPE_JSON_CLONE(EvalStack &stack) {
 #if defined(EEZ_DASHBOARD_API)
@@ -6769,6 +9300,11 @@ void do_OPERATION_TYPE_JSON_CLONE(EvalStack &stack) {
     }
     stack.push(operationJsonClone(jsonValue.getInt()));
 #else
+    auto jsonValue = stack.pop().getValue();
+    if (jsonValue.isError() || jsonValue.type == VALUE_TYPE_JSON) {
+        stack.push(jsonValue);
+        return;
+    }
     stack.push(Value::makeError());
 #endif
 }
@@ -6969,6 +9505,8 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
 	flowState->error = false;
 	flowState->refCounter = 0;
 	flowState->parentFlowState = parentFlowState;
+    flowState->partition = parentFlowState ? parentFlowState->partition : getCurrentPartition();
+    flowState->numMarshalledTasks = 0;
     flowState->executingComponentIndex = NO_COMPONENT_INDEX;
     flowState->timelinePosition = 0;
 #if defined(EEZ_FOR_LVGL)
@@ -6987,14 +9525,16 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
 		flowState->parentComponentIndex = parentComponentIndex;
 		flowState->parentComponent = parentFlowState->flow->components[parentComponentIndex];
 	} else {
-        if (g_lastFlowState) {
-            g_lastFlowState->nextSibling = flowState;
-            flowState->previousSibling = g_lastFlowState;
-            g_lastFlowState = flowState;
+        auto &firstFlowState = flowState->partition == FLOW_PARTITION_UI ? g_firstFlowState : g_firstWorkerFlowState;
+        auto &lastFlowState = flowState->partition == FLOW_PARTITION_UI ? g_lastFlowState : g_lastWorkerFlowState;
+        if (lastFlowState) {
+            lastFlowState->nextSibling = flowState;
+            flowState->previousSibling = lastFlowState;
+            lastFlowState = flowState;
         } else {
             flowState->previousSibling = nullptr;
-            g_firstFlowState = flowState;
-            g_lastFlowState = flowState;
+            firstFlowState = flowState;
+            lastFlowState = flowState;
         }
 		flowState->parentComponentIndex = -1;
 		flowState->parentComponent = nullptr;
@@ -7027,7 +9567,7 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
 	return flowState;
 }
 FlowState *initActionFlowState(int flowIndex, FlowState *parentFlowState, int parentComponentIndex) {
-	auto flowState = initFlowState(parentFlowState->assets, flowIndex, parentFlowState, parentComponentIndex);
+	auto flowState = initFlowState(parentFlowState ? parentFlowState->assets : g_assets, flowIndex, parentFlowState, parentComponentIndex);
 	if (flowState) {
 		flowState->isAction = true;
 	}
@@ -7076,11 +9616,13 @@ void freeFlowState(FlowState *flowState) {
             parentFlowState->lastChild = flowState->previousSibling;
         }
     } else {
-        if (g_firstFlowState == flowState) {
-            g_firstFlowState = flowState->nextSibling;
+        auto &firstFlowState = flowState->partition == FLOW_PARTITION_UI ? g_firstFlowState : g_firstWorkerFlowState;
+        auto &lastFlowState = flowState->partition == FLOW_PARTITION_UI ? g_lastFlowState : g_lastWorkerFlowState;
+        if (firstFlowState == flowState) {
+            firstFlowState = flowState->nextSibling;
         }
-        if (g_lastFlowState == flowState) {
-            g_lastFlowState = flowState->previousSibling;
+        if (lastFlowState == flowState) {
+            lastFlowState = flowState->previousSibling;
         }
     }
     if (flowState->previousSibling) {
@@ -7252,6 +9794,11 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
             }
             return;
         }
+#else
+        else if (dstValue.getType() == VALUE_TYPE_JSON_MEMBER_VALUE) {
+            throwError(flowState, componentIndex, "Can not assign to JSON member, JSON values are read only");
+            return;
+        }
 #endif
         else {
             pDstValue = dstValue.pValueValue;
@@ -7420,16 +9967,17 @@ struct WatchList {
     WatchListNode *first;
     WatchListNode *last;
 };
-static WatchList g_watchList;
+static WatchList g_watchLists[FLOW_NUM_PARTITIONS];
 WatchListNode *watchListAdd(FlowState *flowState, unsigned componentIndex) {
+    auto &watchList = g_watchLists[flowState->partition];
     auto node = (WatchListNode *)alloc(sizeof(WatchListNode), 0x00864d67);
-    node->prev = g_watchList.last;
-    if (g_watchList.last != 0) {
-        g_watchList.last->next = node;
+    node->prev = watchList.last;
+    if (watchList.last != 0) {
+        watchList.last->next = node;
     }
-    g_watchList.last = node;
-    if (g_watchList.first == 0) {
-        g_watchList.first = node;
+    watchList.last = node;
+    if (watchList.first == 0) {
+        watchList.first = node;
     }
     node->next = 0;
     node->flowState = flowState;
@@ -7437,21 +9985,25 @@ WatchListNode *watchListAdd(FlowState *flowState, unsigned componentIndex) {
     incRefCounterForFlowState(flowState);
     return node;
 }
-void watchListRemove(WatchListNode *node) {
+static void watchListRemove(WatchList &watchList, WatchListNode *node) {
     if (node->prev) {
         node->prev->next = node->next;
     } else {
-        g_watchList.first = node->next;
+        watchList.first = node->next;
     }
     if (node->next) {
         node->next->prev = node->prev;
     } else {
-        g_watchList.last = node->prev;
+        watchList.last = node->prev;
     }
     free(node);
 }
-void visitWatchList() {
-    for (auto node = g_watchList.first; node; ) {
+void watchListRemove(WatchListNode *node) {
+    watchListRemove(g_watchLists[node->flowState->partition], node);
+}
+void visitWatchList(uint8_t partition) {
+    auto &watchList = g_watchLists[partition];
+    for (auto node = watchList.first; node; ) {
         auto nextNode = node->next;
         if (canExecuteStep(node->flowState, node->componentIndex)) {
             executeWatchVariableComponent(node->flowState, node->componentIndex);
@@ -7459,7 +10011,7 @@ void visitWatchList() {
         decRefCounterForFlowState(node->flowState);
         if (canFreeFlowState(node->flowState)) {
             freeFlowState(node->flowState);
-            watchListRemove(node);
+            watchListRemove(watchList, node);
         } else {
             incRefCounterForFlowState(node->flowState);
         }
@@ -7467,10 +10019,13 @@ void visitWatchList() {
     }
 }
 void watchListReset() {
-    for (auto node = g_watchList.first; node;) {
-        auto nextNode = node->next;
-        watchListRemove(node);
-        node = nextNode;
+    for (unsigned partition = 0; partition < FLOW_NUM_PARTITIONS; partition++) {
+        auto &watchList = g_watchLists[partition];
+        for (auto node = watchList.first; node;) {
+            auto nextNode = node->next;
+            watchListRemove(watchList, node);
+            node = nextNode;
+        }
     }
 }
 } 
@@ -7483,98 +10038,372 @@ namespace flow {
 #if !defined(EEZ_FLOW_QUEUE_SIZE)
 #define EEZ_FLOW_QUEUE_SIZE 1000
 #endif
-static const unsigned QUEUE_SIZE = EEZ_FLOW_QUEUE_SIZE;
-static struct {
+#if !defined(EEZ_FLOW_WORKER_QUEUE_SIZE)
+#define EEZ_FLOW_WORKER_QUEUE_SIZE 200
+#endif
+struct QueueTask {
 	FlowState *flowState;
 	unsigned componentIndex;
     bool continuousTask;
-} g_queue[QUEUE_SIZE];
-static unsigned g_queueHead;
-static unsigned g_queueTail;
-static unsigned g_queueMax;
-static bool g_queueIsFull = false;
-unsigned g_numContinuousTaskInQueue;
+#if EEZ_FLOW_PROFILER
+    uint32_t enqueueCycles;
+#endif
+};
+struct Queue {
+    QueueTask *tasks;
+    unsigned size;
+    unsigned head;
+    unsigned tail;
+    unsigned max;
+    bool isFull;
+    unsigned numContinuousTaskInQueue;
+};
+static QueueTask g_uiQueueTasks[EEZ_FLOW_QUEUE_SIZE];
+static QueueTask g_workerQueueTasks[EEZ_FLOW_WORKER_QUEUE_SIZE];
+static Queue g_queues[FLOW_NUM_PARTITIONS] = {
+    { g_uiQueueTasks, EEZ_FLOW_QUEUE_SIZE, 0, 0, 0, false, 0 },
+    { g_workerQueueTasks, EEZ_FLOW_WORKER_QUEUE_SIZE, 0, 0, 0, false, 0 },
+};
+static const uint32_t MAILBOX_SIZE = EEZ_FLOW_MAILBOX_SIZE;
+static_assert((MAILBOX_SIZE & (MAILBOX_SIZE - 1)) == 0, "EEZ_FLOW_MAILBOX_SIZE must be a power of two");
+struct Mailbox {
+    PartitionMessage messages[MAILBOX_SIZE];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+};
+static Mailbox g_mailboxes[FLOW_NUM_PARTITIONS][FLOW_NUM_PARTITIONS];
+static thread_local uint8_t t_currentPartition = FLOW_PARTITION_UI;
+uint8_t getCurrentPartition() {
+    return t_currentPartition;
+}
+void setCurrentPartition(uint8_t partition) {
+    t_currentPartition = partition;
+}
 void queueReset() {
-	g_queueHead = 0;
-	g_queueTail = 0;
-	g_queueMax  = 0;
-	g_queueIsFull = false;
-    g_numContinuousTaskInQueue = 0;
-}
-size_t getQueueSize() {
-	if (g_queueHead == g_queueTail) {
-		if (g_queueIsFull) {
-			return QUEUE_SIZE;
+    for (unsigned i = 0; i < FLOW_NUM_PARTITIONS; i++) {
+        auto &queue = g_queues[i];
+	    queue.head = 0;
+	    queue.tail = 0;
+	    queue.max  = 0;
+	    queue.isFull = false;
+        queue.numContinuousTaskInQueue = 0;
+        for (unsigned j = 0; j < FLOW_NUM_PARTITIONS; j++) {
+            g_mailboxes[i][j].head.store(0, std::memory_order_relaxed);
+            g_mailboxes[i][j].tail.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+size_t getQueueSize(uint8_t partition) {
+    auto &queue = g_queues[partition];
+	if (queue.head == queue.tail) {
+		if (queue.isFull) {
+			return queue.size;
 		}
 		return 0;
 	}
-	if (g_queueHead < g_queueTail) {
-		return g_queueTail - g_queueHead;
+	if (queue.head < queue.tail) {
+		return queue.tail - queue.head;
 	}
-	return QUEUE_SIZE - g_queueHead + g_queueTail;
+	return queue.size - queue.head + queue.tail;
+}
+size_t getMaxQueueSize(uint8_t partition) {
+	return g_queues[partition].max;
+}
+unsigned getNumContinuousTaskInQueue(uint8_t partition) {
+    return g_queues[partition].numContinuousTaskInQueue;
+}
+bool postPartitionMessage(uint8_t partition, const PartitionMessage &message) {
+    auto &mailbox = g_mailboxes[t_currentPartition][partition];
+    uint32_t tail = mailbox.tail.load(std::memory_order_relaxed);
+    if (tail - mailbox.head.load(std::memory_order_acquire) == MAILBOX_SIZE) {
+        return false;
+    }
+    mailbox.messages[tail & (MAILBOX_SIZE - 1)] = message;
+    mailbox.tail.store(tail + 1, std::memory_order_release);
+    wakePartitionHook(partition);
+    return true;
+}
+uint32_t getNumPartitionMessages(uint8_t fromPartition, uint8_t partition) {
+    auto &mailbox = g_mailboxes[fromPartition][partition];
+    return mailbox.tail.load(std::memory_order_acquire) - mailbox.head.load(std::memory_order_relaxed);
+}
+bool hasPartitionMessages(uint8_t partition) {
+    for (uint8_t otherPartition = 0; otherPartition < FLOW_NUM_PARTITIONS; otherPartition++) {
+        if (otherPartition != partition && (getNumPartitionMessages(otherPartition, partition) > 0 || getNumPartitionMessages(partition, otherPartition) > 0)) {
+            return true;
+        }
+    }
+    return false;
 }
-size_t getMaxQueueSize() {
-	return g_queueMax;
+bool takePartitionMessage(uint8_t fromPartition, uint8_t partition, PartitionMessage &message) {
+    auto &mailbox = g_mailboxes[fromPartition][partition];
+    uint32_t head = mailbox.head.load(std::memory_order_relaxed);
+    if (head == mailbox.tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    message = mailbox.messages[head & (MAILBOX_SIZE - 1)];
+    mailbox.head.store(head + 1, std::memory_order_release);
+    return true;
 }
 bool addToQueue(FlowState *flowState, unsigned componentIndex, int sourceComponentIndex, int sourceOutputIndex, int targetInputIndex, bool continuousTask) {
-	if (g_queueIsFull) {
+    if (flowState->partition != t_currentPartition) {
+        PartitionMessage message;
+        message.type = PARTITION_MESSAGE_ADD_TO_QUEUE;
+        message.continuousTask = continuousTask;
+        message.flowIndex = 0;
+        message.flowState = flowState;
+        message.componentIndex = componentIndex;
+        if (!postPartitionMessage(flowState->partition, message)) {
+            throwError(flowState, componentIndex, "Partition mailbox is full\n");
+            return false;
+        }
+        return true;
+    }
+    auto &queue = g_queues[flowState->partition];
+	if (queue.isFull) {
         throwError(flowState, componentIndex, "Execution queue is full\n");
 		return false;
 	}
-	g_queue[g_queueTail].flowState = flowState;
-	g_queue[g_queueTail].componentIndex = componentIndex;
-    g_queue[g_queueTail].continuousTask = continuousTask;
-	g_queueTail = (g_queueTail + 1) % QUEUE_SIZE;
-	if (g_queueHead == g_queueTail) {
-		g_queueIsFull = true;
+	queue.tasks[queue.tail].flowState = flowState;
+	queue.tasks[queue.tail].componentIndex = componentIndex;
+    queue.tasks[queue.tail].continuousTask = continuousTask;
+#if EEZ_FLOW_PROFILER
+    queue.tasks[queue.tail].enqueueCycles = getProfilerCycles();
+#endif
+	queue.tail = (queue.tail + 1) % queue.size;
+	if (queue.head == queue.tail) {
+		queue.isFull = true;
 	}
-	size_t queueSize = getQueueSize();
-	g_queueMax = g_queueMax < queueSize ? queueSize : g_queueMax;
+	size_t queueSize = getQueueSize(flowState->partition);
+	queue.max = queue.max < queueSize ? queueSize : queue.max;
     if (!continuousTask) {
-        ++g_numContinuousTaskInQueue;
+        ++queue.numContinuousTaskInQueue;
 	    onAddToQueue(flowState, sourceComponentIndex, sourceOutputIndex, componentIndex, targetInputIndex);
     }
     incRefCounterForFlowState(flowState);
 	return true;
 }
-bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool &continuousTask) {
-	if (g_queueHead == g_queueTail && !g_queueIsFull) {
+bool peekNextTaskFromQueue(uint8_t partition, FlowState *&flowState, unsigned &componentIndex, bool &continuousTask) {
+    auto &queue = g_queues[partition];
+	if (queue.head == queue.tail && !queue.isFull) {
 		return false;
 	}
-	flowState = g_queue[g_queueHead].flowState;
-	componentIndex = g_queue[g_queueHead].componentIndex;
-    continuousTask = g_queue[g_queueHead].continuousTask;
+	flowState = queue.tasks[queue.head].flowState;
+	componentIndex = queue.tasks[queue.head].componentIndex;
+    continuousTask = queue.tasks[queue.head].continuousTask;
 	return true;
 }
-void removeNextTaskFromQueue() {
-	auto flowState = g_queue[g_queueHead].flowState;
-    decRefCounterForFlowState(flowState);
-    auto continuousTask = g_queue[g_queueHead].continuousTask;
-	g_queueHead = (g_queueHead + 1) % QUEUE_SIZE;
-	g_queueIsFull = false;
-    if (!continuousTask) {
-        --g_numContinuousTaskInQueue;
-	    onRemoveFromQueue();
+#if EEZ_FLOW_PROFILER
+uint32_t getNextTaskEnqueueCycles(uint8_t partition) {
+    auto &queue = g_queues[partition];
+    return queue.tasks[queue.head].enqueueCycles;
+}
+#endif
+void removeNextTaskFromQueue(uint8_t partition) {
+    auto &queue = g_queues[partition];
+	auto flowState = queue.tasks[queue.head].flowState;
+    decRefCounterForFlowState(flowState);
+    auto continuousTask = queue.tasks[queue.head].continuousTask;
+	queue.head = (queue.head + 1) % queue.size;
+	queue.isFull = false;
+    if (!continuousTask) {
+        --queue.numContinuousTaskInQueue;
+	    onRemoveFromQueue();
+    }
+}
+bool isInQueue(FlowState *flowState, unsigned componentIndex) {
+    auto &queue = g_queues[flowState->partition];
+	if (queue.head == queue.tail && !queue.isFull) {
+		return false;
+	}
+    unsigned int it = queue.head;
+    while (true) {
+		if (queue.tasks[it].flowState == flowState && queue.tasks[it].componentIndex == componentIndex) {
+            return true;
+		}
+        it = (it + 1) % queue.size;
+        if (it == queue.tail) {
+            break;
+        }
+	}
+    return false;
+}
+} 
+} 
+// -----------------------------------------------------------------------------
+// flow/profiler.cpp
+// -----------------------------------------------------------------------------
+#if EEZ_FLOW_PROFILER
+#if defined(ESP_PLATFORM)
+#include <esp_cpu.h>
+#else
+#include <time.h>
+#endif
+namespace eez {
+namespace flow {
+struct ComponentTypeProfile {
+    uint16_t componentType;
+    ComponentProfile profile;
+};
+struct PartitionProfile {
+    ComponentProfile *components;
+    ComponentTypeProfile types[EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES];
+    TickProfile tick;
+};
+static Assets *g_profilerAssets;
+static uint32_t *g_profilerFlowOffsets;
+static uint32_t g_profilerNumComponents;
+static PartitionProfile g_profiles[FLOW_NUM_PARTITIONS];
+static thread_local uint32_t t_profilerAllocCount;
+uint32_t getProfilerCycles() {
+#if defined(ESP_PLATFORM)
+    return esp_cpu_get_ccount();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+#endif
+}
+uint32_t getProfilerCyclesPerUs() {
+#if defined(ESP_PLATFORM)
+    return getCpuFrequencyMhz();
+#else
+    return 1000;
+#endif
+}
+void profilerStart(Assets *assets) {
+    profilerStop();
+	auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
+    g_profilerFlowOffsets = (uint32_t *)alloc((flowDefinition->flows.count + 1) * sizeof(uint32_t), 0x7a1c4e28);
+    if (!g_profilerFlowOffsets) {
+        return;
+    }
+    uint32_t numComponents = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        g_profilerFlowOffsets[flowIndex] = numComponents;
+        numComponents += flowDefinition->flows[flowIndex]->components.count;
+    }
+    g_profilerFlowOffsets[flowDefinition->flows.count] = numComponents;
+    for (unsigned partition = 0; partition < FLOW_NUM_PARTITIONS; partition++) {
+        g_profiles[partition].components = (ComponentProfile *)alloc(numComponents * sizeof(ComponentProfile), 0x7a1c4e29);
+        if (!g_profiles[partition].components) {
+            profilerStop();
+            return;
+        }
+    }
+    g_profilerAssets = assets;
+    g_profilerNumComponents = numComponents;
+    profilerReset();
+}
+void profilerStop() {
+    g_profilerAssets = nullptr;
+    for (unsigned partition = 0; partition < FLOW_NUM_PARTITIONS; partition++) {
+        if (g_profiles[partition].components) {
+            free(g_profiles[partition].components);
+            g_profiles[partition].components = nullptr;
+        }
+    }
+    if (g_profilerFlowOffsets) {
+        free(g_profilerFlowOffsets);
+        g_profilerFlowOffsets = nullptr;
+    }
+    g_profilerNumComponents = 0;
+}
+void profilerReset() {
+    for (unsigned partition = 0; partition < FLOW_NUM_PARTITIONS; partition++) {
+        auto &partitionProfile = g_profiles[partition];
+        if (partitionProfile.components) {
+            memset(partitionProfile.components, 0, g_profilerNumComponents * sizeof(ComponentProfile));
+        }
+        memset(partitionProfile.types, 0, sizeof(partitionProfile.types));
+        memset(&partitionProfile.tick, 0, sizeof(partitionProfile.tick));
+    }
+}
+void profilerOnAlloc() {
+    t_profilerAllocCount++;
+}
+uint32_t getProfilerAllocCount() {
+    return t_profilerAllocCount;
+}
+static void addSample(ComponentProfile &profile, uint32_t cycles, uint32_t waitCycles, uint32_t allocs) {
+    profile.count++;
+    profile.totalCycles += cycles;
+    if (cycles > profile.maxCycles) {
+        profile.maxCycles = cycles;
+    }
+    profile.totalWaitCycles += waitCycles;
+    if (waitCycles > profile.maxWaitCycles) {
+        profile.maxWaitCycles = waitCycles;
+    }
+    profile.allocs += allocs;
+}
+void profilerRecordComponent(uint8_t partition, FlowState *flowState, unsigned componentIndex, uint32_t cycles, uint32_t waitCycles, uint32_t allocs) {
+    if (!g_profilerAssets || flowState->assets != g_profilerAssets) {
+        return;
+    }
+    auto &partitionProfile = g_profiles[partition];
+    addSample(partitionProfile.components[g_profilerFlowOffsets[flowState->flowIndex] + componentIndex], cycles, waitCycles, allocs);
+    uint16_t componentType = flowState->flow->components[componentIndex]->type;
+    uint32_t mask = EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES - 1;
+    for (uint32_t i = componentType & mask, n = 0; n < EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES; i = (i + 1) & mask, n++) {
+        auto &typeProfile = partitionProfile.types[i];
+        if (typeProfile.componentType == componentType || typeProfile.componentType == 0) {
+            typeProfile.componentType = componentType;
+            addSample(typeProfile.profile, cycles, waitCycles, allocs);
+            return;
+        }
+    }
+}
+void profilerRecordTick(uint8_t partition, uint32_t cycles, bool overBudget) {
+    auto &tick = g_profiles[partition].tick;
+    tick.count++;
+    tick.totalCycles += cycles;
+    if (cycles > tick.maxCycles) {
+        tick.maxCycles = cycles;
+    }
+    if (overBudget) {
+        tick.overBudget++;
+    }
+}
+int getNumProfiledFlows() {
+    return g_profilerAssets ? (int)g_profilerAssets->flowDefinition->flows.count : 0;
+}
+int getNumProfiledComponents(int flowIndex) {
+    if (flowIndex < 0 || flowIndex >= getNumProfiledFlows()) {
+        return 0;
+    }
+    return (int)g_profilerAssets->flowDefinition->flows[flowIndex]->components.count;
+}
+bool getComponentProfile(uint8_t partition, int flowIndex, int componentIndex, uint16_t &componentType, ComponentProfile &profile) {
+    if (componentIndex < 0 || componentIndex >= getNumProfiledComponents(flowIndex)) {
+        return false;
+    }
+    componentType = g_profilerAssets->flowDefinition->flows[flowIndex]->components[componentIndex]->type;
+    profile = g_profiles[partition].components[g_profilerFlowOffsets[flowIndex] + componentIndex];
+    return true;
+}
+bool getComponentTypeProfile(uint8_t partition, int slotIndex, uint16_t &componentType, ComponentProfile &profile) {
+    if (slotIndex < 0 || slotIndex >= EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES) {
+        return false;
+    }
+    auto &typeProfile = g_profiles[partition].types[slotIndex];
+    if (typeProfile.componentType == 0) {
+        return false;
     }
+    componentType = typeProfile.componentType;
+    profile = typeProfile.profile;
+    return true;
 }
-bool isInQueue(FlowState *flowState, unsigned componentIndex) {
-	if (g_queueHead == g_queueTail && !g_queueIsFull) {
-		return false;
-	}
-    unsigned int it = g_queueHead;
-    while (true) {
-		if (g_queue[it].flowState == flowState && g_queue[it].componentIndex == componentIndex) {
-            return true;
-		}
-        it = (it + 1) % QUEUE_SIZE;
-        if (it == g_queueTail) {
-            break;
-        }
-	}
-    return false;
+bool getTickProfile(uint8_t partition, TickProfile &profile) {
+    if (partition >= FLOW_NUM_PARTITIONS) {
+        return false;
+    }
+    profile = g_profiles[partition].tick;
+    return true;
 }
 } 
 } 
+#endif
 // -----------------------------------------------------------------------------
 // flow/components/animate.cpp
 // -----------------------------------------------------------------------------
@@ -7588,6 +10417,28 @@ struct AnimateComponenentExecutionState : public ComponenentExecutionState {
     float endPosition;
     float speed;
     uint32_t startTimestamp;
+#if defined(EEZ_FOR_LVGL)
+    FlowState *flowState;
+    unsigned componentIndex;
+    bool isRunning;
+    ~AnimateComponenentExecutionState() {
+        if (isRunning) {
+            lv_anim_del(this, animateExecCallback);
+        }
+    }
+    static const int32_t ANIMATE_RESOLUTION = 1 << 16;
+    static void animateExecCallback(void *var, int32_t value) {
+        auto state = (AnimateComponenentExecutionState *)var;
+        state->flowState->timelinePosition = state->startPosition + (state->endPosition - state->startPosition) * value / ANIMATE_RESOLUTION;
+        onFlowStateTimelineChanged(state->flowState);
+    }
+    static void animateReadyCallback(lv_anim_t *anim) {
+        auto state = (AnimateComponenentExecutionState *)anim->var;
+        state->isRunning = false;
+        state->flowState->timelinePosition = state->endPosition;
+        addToQueue(state->flowState, state->componentIndex, -1, -1, -1, false);
+    }
+#endif
 };
 void executeAnimateComponent(FlowState *flowState, unsigned componentIndex) {
 	auto state = (AnimateComponenentExecutionState *)flowState->componenentExecutionStates[componentIndex];
@@ -7607,7 +10458,12 @@ void executeAnimateComponent(FlowState *flowState, unsigned componentIndex) {
         float from = fromValue.toFloat();
         float to = toValue.toFloat();
         float speed = speedValue.toFloat();
+#if defined(EEZ_FOR_LVGL)
+        uint32_t duration = speed != 0 ? (uint32_t)roundf(fabsf(to - from) / fabsf(speed) * 1000.0f) : 0;
+        if (duration == 0) {
+#else
         if (speed == 0) {
+#endif
             flowState->timelinePosition = to;
             onFlowStateTimelineChanged(flowState);
             propagateValueThroughSeqout(flowState, componentIndex);
@@ -7617,10 +10473,35 @@ void executeAnimateComponent(FlowState *flowState, unsigned componentIndex) {
             state->endPosition = to;
             state->speed = speed;
             state->startTimestamp = millis();
+#if defined(EEZ_FOR_LVGL)
+            state->flowState = flowState;
+            state->componentIndex = componentIndex;
+            state->isRunning = true;
+            flowState->timelinePosition = from;
+            onFlowStateTimelineChanged(flowState);
+            lv_anim_t anim;
+            lv_anim_init(&anim);
+            lv_anim_set_var(&anim, state);
+            lv_anim_set_exec_cb(&anim, AnimateComponenentExecutionState::animateExecCallback);
+            lv_anim_set_ready_cb(&anim, AnimateComponenentExecutionState::animateReadyCallback);
+            lv_anim_set_values(&anim, 0, AnimateComponenentExecutionState::ANIMATE_RESOLUTION);
+            lv_anim_set_time(&anim, duration);
+            lv_anim_set_path_cb(&anim, lv_anim_path_linear);
+            lv_anim_start(&anim);
+#else
             if (!addToQueue(flowState, componentIndex, -1, -1, -1, true)) {
                 return;
             }
+#endif
         }
+#if defined(EEZ_FOR_LVGL)
+    } else if (!state->isRunning) {
+        flowState->timelinePosition = state->endPosition;
+        onFlowStateTimelineChanged(flowState);
+        deallocateComponentExecutionState(flowState, componentIndex);
+        propagateValueThroughSeqout(flowState, componentIndex);
+    }
+#else
     } else {
         float currentTime;
         if (state->startPosition < state->endPosition) {
@@ -7645,6 +10526,7 @@ void executeAnimateComponent(FlowState *flowState, unsigned componentIndex) {
             }
         }
     }
+#endif
 }
 } 
 } 
@@ -7660,6 +10542,17 @@ void executeCallAction(FlowState *flowState, unsigned componentIndex, int flowIn
 		propagateValueThroughSeqout(flowState, componentIndex);
 		return;
 	}
+    auto partition = getFlowPartition(flowIndex);
+    if (partition != FLOW_PARTITION_INHERIT && partition != flowState->partition) {
+        if ((int)componentIndex != -1) {
+            throwError(flowState, componentIndex, "CallAction can't call an action flow on another partition\n");
+            return;
+        }
+        if (!startFlowOnPartition(flowIndex, partition)) {
+            throwError(flowState, componentIndex, "Partition mailbox is full\n");
+        }
+        return;
+    }
 	FlowState *actionFlowState = initActionFlowState(flowIndex, flowState, componentIndex);
 	if (canFreeFlowState(actionFlowState)) {
         freeFlowState(actionFlowState);
@@ -8503,54 +11396,144 @@ struct MQTTEventActionComponenent : public Component {
 struct MQTTEvent {
     int16_t outputIndex;
     Value value;
-    MQTTEvent *next;
 };
+struct MQTTConnectionEventHandler;
 struct MQTTEventActionComponenentExecutionState : public ComponenentExecutionState {
 	FlowState *flowState;
     unsigned componentIndex;
-    MQTTEvent *firstEvent;
-    MQTTEvent *lastEvent;
-    MQTTEventActionComponenentExecutionState() : firstEvent(nullptr), lastEvent(nullptr) {}
+    MQTTConnectionEventHandler *eventHandler;
+    MQTTEvent events[EEZ_MQTT_EVENT_QUEUE_SIZE];
+    uint16_t eventsHead;
+    uint16_t numEvents;
+    MQTTEventActionComponenentExecutionState() : eventHandler(nullptr), eventsHead(0), numEvents(0) {}
     virtual ~MQTTEventActionComponenentExecutionState() override;
-    void addEvent(int16_t outputIndex, Value value = Value(VALUE_TYPE_NULL)) {
-        auto event = ObjectAllocator<MQTTEvent>::allocate(0xe1b95933);
-        event->outputIndex = outputIndex;
-        event->value = value;
-        event->next = nullptr;
-        if (!firstEvent) {
-            firstEvent = event;
-            lastEvent = event;
-        } else {
-            lastEvent->next = event;
-            lastEvent = event;
-        }
-    }
-    MQTTEvent *removeEvent() {
-        auto event = firstEvent;
-        if (event) {
-            firstEvent = event->next;
-            if (!firstEvent) {
-                lastEvent = nullptr;
-            }
+    void addEvent(int16_t outputIndex, const Value &value);
+    bool removeEvent(int16_t &outputIndex, Value &value) {
+        if (numEvents == 0) {
+            return false;
         }
-        return event;
+        auto &event = events[eventsHead];
+        outputIndex = event.outputIndex;
+        value = event.value;
+        event.value = Value();
+        eventsHead = (eventsHead + 1) % EEZ_MQTT_EVENT_QUEUE_SIZE;
+        numEvents--;
+        return true;
     }
 };
+struct MQTTConnection;
+struct MQTTMessageHandlerEntry;
+struct MQTTTopicNode {
+    MQTTTopicNode *parent;
+    MQTTTopicNode *firstChild;
+    MQTTTopicNode *prevSibling;
+    MQTTTopicNode *nextSibling;
+    MQTTConnectionEventHandler *firstEventHandler;
+    MQTTMessageHandlerEntry *firstMessageHandler;
+    char level[1];
+};
 struct MQTTConnectionEventHandler {
     MQTTEventActionComponenentExecutionState *componentExecutionState;
+    MQTTConnection *connection;
     MQTTConnectionEventHandler *next;
     MQTTConnectionEventHandler *prev;
+    MQTTTopicNode *node;
+    MQTTConnectionEventHandler *nodeNext;
+    MQTTConnectionEventHandler *nodePrev;
+};
+struct MQTTMessageHandlerEntry {
+    MQTTMessageHandler handler;
+    void *userData;
+    MQTTMessageHandlerEntry *next;
+    MQTTMessageHandlerEntry *prev;
+    MQTTTopicNode *node;
+    MQTTMessageHandlerEntry *nodeNext;
+    MQTTMessageHandlerEntry *nodePrev;
+    bool removed;
 };
 struct MQTTConnection {
     void *handle;
     MQTTConnectionEventHandler *firstEventHandler;
     MQTTConnectionEventHandler *lastEventHandler;
-    MQTTConnection *next;
-    MQTTConnection *prev;
+    MQTTMessageHandlerEntry *firstMessageHandler;
+    MQTTTopicNode root;
+    MQTTTopicNode matchAll;
+};
+struct MQTTEventTopicFilter {
+    int16_t flowIndex;
+    int16_t componentIndex;
+    char *topicFilter;
+};
+static MQTTEventTopicFilter g_mqttEventTopicFilters[EEZ_MQTT_MAX_EVENT_TOPIC_FILTERS];
+static int g_numMQTTEventTopicFilters;
+static_assert((EEZ_MQTT_CONNECTION_MAP_SIZE & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1)) == 0, "EEZ_MQTT_CONNECTION_MAP_SIZE must be a power of two");
+static_assert((EEZ_MQTT_INGEST_RING_SIZE & (EEZ_MQTT_INGEST_RING_SIZE - 1)) == 0, "EEZ_MQTT_INGEST_RING_SIZE must be a power of two");
+static MQTTConnection *g_mqttConnectionMap[EEZ_MQTT_CONNECTION_MAP_SIZE];
+static uint32_t g_numMQTTConnections;
+static bool g_mqttDispatching;
+static bool g_mqttPruneDeferred;
+static bool g_mqttRemovalDeferred;
+struct MQTTIngestSlot {
+    std::atomic<uint32_t> sequence;
+    void *handle;
+    uint8_t event;
+    uint16_t topicLength;
+    uint32_t payloadLength;
+    char *heapData;
+    char data[EEZ_MQTT_INGEST_SLOT_SIZE];
 };
-MQTTConnection *g_firstMQTTConnection = nullptr;
-MQTTConnection *g_lastMQTTConnection = nullptr;
+static std::atomic<MQTTIngestSlot *> g_mqttIngestSlots(nullptr);
+static std::atomic<uint32_t> g_mqttIngestHead(0);
+static std::atomic<uint32_t> g_mqttIngestTail(0);
+static std::atomic<uint32_t> g_mqttNumReceived(0);
+static std::atomic<uint32_t> g_mqttNumDropped(0);
+static std::atomic<uint32_t> g_mqttNumOversized(0);
+static uint32_t g_mqttNumEventOverflows;
+void MQTTEventActionComponenentExecutionState::addEvent(int16_t outputIndex, const Value &value) {
+    if (numEvents == EEZ_MQTT_EVENT_QUEUE_SIZE) {
+        eventsHead = (eventsHead + 1) % EEZ_MQTT_EVENT_QUEUE_SIZE;
+        numEvents--;
+        g_mqttNumEventOverflows++;
+    }
+    auto &event = events[(eventsHead + numEvents) % EEZ_MQTT_EVENT_QUEUE_SIZE];
+    event.outputIndex = outputIndex;
+    event.value = value;
+    numEvents++;
+}
+static inline uint32_t hashMQTTHandle(void *handle) {
+    uint32_t hash = (uint32_t)(uintptr_t)handle;
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1);
+}
+static MQTTConnection *findConnection(void *handle) {
+    for (uint32_t i = hashMQTTHandle(handle); g_mqttConnectionMap[i]; i = (i + 1) & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1)) {
+        if (g_mqttConnectionMap[i]->handle == handle) {
+            return g_mqttConnectionMap[i];
+        }
+    }
+    return nullptr;
+}
+static bool allocIngestRing() {
+    if (g_mqttIngestSlots.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    auto slots = (MQTTIngestSlot *)alloc(EEZ_MQTT_INGEST_RING_SIZE * sizeof(MQTTIngestSlot), 0x7a3e41c9);
+    if (!slots) {
+        return false;
+    }
+    for (uint32_t i = 0; i < EEZ_MQTT_INGEST_RING_SIZE; i++) {
+        new (&slots[i].sequence) std::atomic<uint32_t>(i);
+        slots[i].heapData = nullptr;
+    }
+    g_mqttIngestSlots.store(slots, std::memory_order_release);
+    return true;
+}
 static MQTTConnection *addConnection(void *handle) {
+    if ((g_numMQTTConnections + 1) * 2 > EEZ_MQTT_CONNECTION_MAP_SIZE || !allocIngestRing()) {
+        return nullptr;
+    }
     auto connection = ObjectAllocator<MQTTConnection>::allocate(0x95d9f5d1);
     if (!connection) {
         return nullptr;
@@ -8558,26 +11541,197 @@ static MQTTConnection *addConnection(void *handle) {
     connection->handle = handle;
     connection->firstEventHandler = nullptr;
     connection->lastEventHandler = nullptr;
-    if (!g_firstMQTTConnection) {
-        g_firstMQTTConnection = connection;
-        g_lastMQTTConnection = connection;
-        connection->prev = nullptr;
-        connection->next = nullptr;
+    connection->firstMessageHandler = nullptr;
+    memset(&connection->root, 0, sizeof(MQTTTopicNode));
+    memset(&connection->matchAll, 0, sizeof(MQTTTopicNode));
+    uint32_t i = hashMQTTHandle(handle);
+    while (g_mqttConnectionMap[i]) {
+        i = (i + 1) & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1);
+    }
+    g_mqttConnectionMap[i] = connection;
+    g_numMQTTConnections++;
+    return connection;
+}
+static void removeConnectionFromMap(MQTTConnection *connection) {
+    uint32_t i = hashMQTTHandle(connection->handle);
+    while (g_mqttConnectionMap[i] != connection) {
+        if (!g_mqttConnectionMap[i]) {
+            return;
+        }
+        i = (i + 1) & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1);
+    }
+    for (uint32_t j = (i + 1) & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1); g_mqttConnectionMap[j]; j = (j + 1) & (EEZ_MQTT_CONNECTION_MAP_SIZE - 1)) {
+        uint32_t k = hashMQTTHandle(g_mqttConnectionMap[j]->handle);
+        if (i <= j ? (k <= i || k > j) : (k <= i && k > j)) {
+            g_mqttConnectionMap[i] = g_mqttConnectionMap[j];
+            i = j;
+        }
+    }
+    g_mqttConnectionMap[i] = nullptr;
+    g_numMQTTConnections--;
+}
+static bool isTopicLevelEqual(const char *nodeLevel, const char *topicLevel) {
+    while (*nodeLevel && *nodeLevel == *topicLevel) {
+        nodeLevel++;
+        topicLevel++;
+    }
+    return !*nodeLevel && (!*topicLevel || *topicLevel == '/');
+}
+static const char *getNextTopicLevel(const char *level) {
+    auto separator = strchr(level, '/');
+    return separator ? separator + 1 : nullptr;
+}
+static MQTTTopicNode *addTopicNode(MQTTConnection *connection, const char *topicFilter) {
+    auto node = &connection->root;
+    for (const char *level = topicFilter; level; level = getNextTopicLevel(level)) {
+        auto child = node->firstChild;
+        while (child && !isTopicLevelEqual(child->level, level)) {
+            child = child->nextSibling;
+        }
+        if (!child) {
+            auto separator = strchr(level, '/');
+            size_t len = separator ? separator - level : strlen(level);
+            child = (MQTTTopicNode *)alloc(sizeof(MQTTTopicNode) + len, 0x5e2a91c4);
+            if (!child) {
+                return nullptr;
+            }
+            memset(child, 0, sizeof(MQTTTopicNode));
+            memcpy(child->level, level, len);
+            child->level[len] = 0;
+            child->parent = node;
+            child->nextSibling = node->firstChild;
+            if (node->firstChild) {
+                node->firstChild->prevSibling = child;
+            }
+            node->firstChild = child;
+        }
+        node = child;
+    }
+    return node;
+}
+static void unlinkTopicNode(MQTTTopicNode *node) {
+    if (node->prevSibling) {
+        node->prevSibling->nextSibling = node->nextSibling;
     } else {
-        g_lastMQTTConnection->next = connection;
-        connection->prev = g_lastMQTTConnection;
-        connection->next = nullptr;
-        g_lastMQTTConnection = connection;
+        node->parent->firstChild = node->nextSibling;
     }
-    return connection;
+    if (node->nextSibling) {
+        node->nextSibling->prevSibling = node->prevSibling;
+    }
+    free(node);
 }
-static MQTTConnection *findConnection(void *handle) {
-    for (auto connection = g_firstMQTTConnection; connection; connection = connection->next) {
-        if (connection->handle == handle) {
-            return connection;
+static void pruneTopicTree(MQTTTopicNode *node) {
+    MQTTTopicNode *next;
+    for (auto child = node->firstChild; child; child = next) {
+        next = child->nextSibling;
+        pruneTopicTree(child);
+    }
+    if (node->parent && !node->firstChild && !node->firstEventHandler && !node->firstMessageHandler) {
+        unlinkTopicNode(node);
+    }
+}
+static void pruneTopicNode(MQTTTopicNode *node) {
+    if (g_mqttDispatching) {
+        g_mqttPruneDeferred = true;
+        return;
+    }
+    while (node->parent && !node->firstChild && !node->firstEventHandler && !node->firstMessageHandler) {
+        auto parent = node->parent;
+        unlinkTopicNode(node);
+        node = parent;
+    }
+}
+template<typename Visitor> static void matchTopic(MQTTTopicNode *node, const char *level, bool isFirstLevel, Visitor &visit) {
+    bool isSystemTopic = isFirstLevel && *level == '$';
+    for (auto child = node->firstChild; child; child = child->nextSibling) {
+        if (child->level[0] == '#' && !child->level[1]) {
+            if (!isSystemTopic) {
+                visit(child);
+            }
+        } else if (child->level[0] == '+' && !child->level[1] ? !isSystemTopic : isTopicLevelEqual(child->level, level)) {
+            auto nextLevel = getNextTopicLevel(level);
+            if (nextLevel) {
+                matchTopic(child, nextLevel, false, visit);
+            } else {
+                visit(child);
+                for (auto grandChild = child->firstChild; grandChild; grandChild = grandChild->nextSibling) {
+                    if (grandChild->level[0] == '#' && !grandChild->level[1]) {
+                        visit(grandChild);
+                    }
+                }
+            }
         }
     }
-    return nullptr;
+}
+static const char *getEventTopicFilter(FlowState *flowState, unsigned componentIndex) {
+    const char *topicFilter = nullptr;
+    for (int i = 0; i < g_numMQTTEventTopicFilters; i++) {
+        auto &entry = g_mqttEventTopicFilters[i];
+        if (entry.flowIndex == flowState->flowIndex) {
+            if (entry.componentIndex == (int16_t)componentIndex) {
+                return entry.topicFilter;
+            }
+            if (entry.componentIndex == -1) {
+                topicFilter = entry.topicFilter;
+            }
+        }
+    }
+    return topicFilter;
+}
+bool setMQTTEventTopicFilter(int flowIndex, int componentIndex, const char *topicFilter) {
+    for (int i = 0; i < g_numMQTTEventTopicFilters; i++) {
+        auto &entry = g_mqttEventTopicFilters[i];
+        if (entry.flowIndex == flowIndex && entry.componentIndex == componentIndex) {
+            free(entry.topicFilter);
+            entry = g_mqttEventTopicFilters[--g_numMQTTEventTopicFilters];
+            break;
+        }
+    }
+    if (!topicFilter) {
+        return true;
+    }
+    if (g_numMQTTEventTopicFilters == EEZ_MQTT_MAX_EVENT_TOPIC_FILTERS) {
+        return false;
+    }
+    auto len = strlen(topicFilter);
+    auto topicFilterCopy = (char *)alloc(len + 1, 0x1f6b2d83);
+    if (!topicFilterCopy) {
+        return false;
+    }
+    memcpy(topicFilterCopy, topicFilter, len + 1);
+    auto &entry = g_mqttEventTopicFilters[g_numMQTTEventTopicFilters++];
+    entry.flowIndex = flowIndex;
+    entry.componentIndex = componentIndex;
+    entry.topicFilter = topicFilterCopy;
+    return true;
+}
+static void unlinkMessageHandler(MQTTConnection *connection, MQTTMessageHandlerEntry *entry) {
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        connection->firstMessageHandler = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    }
+    if (entry->nodePrev) {
+        entry->nodePrev->nodeNext = entry->nodeNext;
+    } else {
+        entry->node->firstMessageHandler = entry->nodeNext;
+    }
+    if (entry->nodeNext) {
+        entry->nodeNext->nodePrev = entry->nodePrev;
+    }
+    pruneTopicNode(entry->node);
+    ObjectAllocator<MQTTMessageHandlerEntry>::deallocate(entry);
+}
+static void removeMessageHandler(MQTTConnection *connection, MQTTMessageHandlerEntry *entry) {
+    if (g_mqttDispatching) {
+        entry->removed = true;
+        g_mqttRemovalDeferred = true;
+        return;
+    }
+    unlinkMessageHandler(connection, entry);
 }
 static void deleteConnection(void *handle) {
     auto connection = findConnection(handle);
@@ -8590,17 +11744,12 @@ static void deleteConnection(void *handle) {
             connection->firstEventHandler->componentExecutionState->componentIndex
         );
     }
-    eez_mqtt_deinit(connection->handle);
-    if (connection->prev) {
-        connection->prev->next = connection->next;
-    } else {
-        g_firstMQTTConnection = connection->next;
-    }
-    if (connection->next) {
-        connection->next->prev = connection->prev;
-    } else {
-        g_lastMQTTConnection = connection->prev;
+    while (connection->firstMessageHandler) {
+        unlinkMessageHandler(connection, connection->firstMessageHandler);
     }
+    pruneTopicTree(&connection->root);
+    eez_mqtt_deinit(connection->handle);
+    removeConnectionFromMap(connection);
     ObjectAllocator<MQTTConnection>::deallocate(connection);
 }
 MQTTConnectionEventHandler *addConnectionEventHandler(void *handle, MQTTEventActionComponenentExecutionState *componentExecutionState) {
@@ -8608,11 +11757,26 @@ MQTTConnectionEventHandler *addConnectionEventHandler(void *handle, MQTTEventAct
     if (!connection) {
         return nullptr;
     }
+    auto topicFilter = getEventTopicFilter(componentExecutionState->flowState, componentExecutionState->componentIndex);
+    auto node = topicFilter ? addTopicNode(connection, topicFilter) : &connection->matchAll;
+    if (!node) {
+        return nullptr;
+    }
     auto eventHandler = ObjectAllocator<MQTTConnectionEventHandler>::allocate(0x75ccf1eb);
     if (!eventHandler) {
+        pruneTopicNode(node);
         return nullptr;
     }
     eventHandler->componentExecutionState = componentExecutionState;
+    eventHandler->connection = connection;
+    eventHandler->node = node;
+    eventHandler->nodePrev = nullptr;
+    eventHandler->nodeNext = node->firstEventHandler;
+    if (node->firstEventHandler) {
+        node->firstEventHandler->nodePrev = eventHandler;
+    }
+    node->firstEventHandler = eventHandler;
+    componentExecutionState->eventHandler = eventHandler;
     if (!connection->firstEventHandler) {
         connection->firstEventHandler = eventHandler;
         connection->lastEventHandler = eventHandler;
@@ -8627,85 +11791,316 @@ MQTTConnectionEventHandler *addConnectionEventHandler(void *handle, MQTTEventAct
     return eventHandler;
 }
 static void removeEventHandler(MQTTEventActionComponenentExecutionState *componentExecutionState) {
-    for (auto connection = g_firstMQTTConnection; connection; connection = connection->next) {
-        for (auto eventHandler = connection->firstEventHandler; eventHandler; eventHandler = eventHandler->next) {
-            if (eventHandler->componentExecutionState == componentExecutionState) {
-                if (eventHandler->prev) {
-                    eventHandler->prev->next = eventHandler->next;
-                } else {
-                    connection->firstEventHandler = eventHandler->next;
-                }
-                if (eventHandler->next) {
-                    eventHandler->next->prev = eventHandler->prev;
-                } else {
-                    connection->lastEventHandler = eventHandler->prev;
-                }
-                ObjectAllocator<MQTTConnectionEventHandler>::deallocate(eventHandler);
-                return;
+    auto eventHandler = componentExecutionState->eventHandler;
+    if (!eventHandler) {
+        return;
+    }
+    auto connection = eventHandler->connection;
+    if (eventHandler->prev) {
+        eventHandler->prev->next = eventHandler->next;
+    } else {
+        connection->firstEventHandler = eventHandler->next;
+    }
+    if (eventHandler->next) {
+        eventHandler->next->prev = eventHandler->prev;
+    } else {
+        connection->lastEventHandler = eventHandler->prev;
+    }
+    if (eventHandler->nodePrev) {
+        eventHandler->nodePrev->nodeNext = eventHandler->nodeNext;
+    } else {
+        eventHandler->node->firstEventHandler = eventHandler->nodeNext;
+    }
+    if (eventHandler->nodeNext) {
+        eventHandler->nodeNext->nodePrev = eventHandler->nodePrev;
+    }
+    pruneTopicNode(eventHandler->node);
+    ObjectAllocator<MQTTConnectionEventHandler>::deallocate(eventHandler);
+    componentExecutionState->eventHandler = nullptr;
+}
+bool mqttTopicMatchesFilter(const char *topicFilter, const char *topic) {
+    if (*topic == '$' && (*topicFilter == '+' || *topicFilter == '#')) {
+        return false;
+    }
+    while (*topicFilter) {
+        if (*topicFilter == '#') {
+            return true;
+        }
+        if (*topicFilter == '+') {
+            while (*topic && *topic != '/') {
+                topic++;
+            }
+            topicFilter++;
+        } else {
+            if (*topicFilter != *topic) {
+                return !*topic && topicFilter[0] == '/' && topicFilter[1] == '#' && !topicFilter[2];
             }
+            topicFilter++;
+            topic++;
         }
     }
+    return !*topic;
+}
+bool addMQTTMessageHandler(void *handle, const char *topicFilter, MQTTMessageHandler handler, void *userData) {
+    auto connection = findConnection(handle);
+    if (!connection) {
+        return false;
+    }
+    auto node = addTopicNode(connection, topicFilter);
+    if (!node) {
+        return false;
+    }
+    auto entry = ObjectAllocator<MQTTMessageHandlerEntry>::allocate(0x2d94e6b1);
+    if (!entry) {
+        pruneTopicNode(node);
+        return false;
+    }
+    entry->handler = handler;
+    entry->userData = userData;
+    entry->removed = false;
+    entry->prev = nullptr;
+    entry->next = connection->firstMessageHandler;
+    if (connection->firstMessageHandler) {
+        connection->firstMessageHandler->prev = entry;
+    }
+    connection->firstMessageHandler = entry;
+    entry->node = node;
+    entry->nodePrev = nullptr;
+    entry->nodeNext = node->firstMessageHandler;
+    if (node->firstMessageHandler) {
+        node->firstMessageHandler->nodePrev = entry;
+    }
+    node->firstMessageHandler = entry;
+    return true;
 }
-void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData) {
+void removeMQTTMessageHandler(void *handle, MQTTMessageHandler handler, void *userData) {
     auto connection = findConnection(handle);
     if (!connection) {
         return;
     }
-    for (auto eventHandler = connection->firstEventHandler; eventHandler; eventHandler = eventHandler->next) {
-        auto componentExecutionState = eventHandler->componentExecutionState;
-        auto flowState = componentExecutionState->flowState;
-        auto componentIndex = componentExecutionState->componentIndex;
-        auto component = (MQTTEventActionComponenent *)flowState->flow->components[componentIndex];
-        if (event == EEZ_MQTT_EVENT_CONNECT) {
-            if (component->connectEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->connectEventOutputIndex);
+    for (auto entry = connection->firstMessageHandler; entry; entry = entry->next) {
+        if (!entry->removed && entry->handler == handler && entry->userData == userData) {
+            removeMessageHandler(connection, entry);
+            return;
+        }
+    }
+}
+void getMQTTIngestStats(MQTTIngestStats &stats) {
+    stats.received = g_mqttNumReceived.load(std::memory_order_relaxed);
+    stats.dropped = g_mqttNumDropped.load(std::memory_order_relaxed);
+    stats.oversized = g_mqttNumOversized.load(std::memory_order_relaxed);
+    stats.eventQueueOverflows = g_mqttNumEventOverflows;
+    stats.pending = g_mqttIngestHead.load(std::memory_order_relaxed) - g_mqttIngestTail.load(std::memory_order_relaxed);
+}
+uint32_t getNumFreeMQTTIngestSlots() {
+    if (!g_mqttIngestSlots.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    return EEZ_MQTT_INGEST_RING_SIZE - (g_mqttIngestHead.load(std::memory_order_relaxed) - g_mqttIngestTail.load(std::memory_order_relaxed));
+}
+bool postMQTTIngestEvent(void *handle, EEZ_MQTT_Event event, const char *topic, size_t topicLength, const char *payload, size_t payloadLength) {
+    auto slots = g_mqttIngestSlots.load(std::memory_order_acquire);
+    if (!slots) {
+        return false;
+    }
+    g_mqttNumReceived.fetch_add(1, std::memory_order_relaxed);
+    char *heapData = nullptr;
+    size_t size = topicLength + payloadLength + 2;
+    if (size > EEZ_MQTT_INGEST_SLOT_SIZE || topicLength > 0xFFFF) {
+        heapData = topicLength <= 0xFFFF ? (char *)alloc(size, 0x3c1e5a7d) : nullptr;
+        if (!heapData) {
+            g_mqttNumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        g_mqttNumOversized.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint32_t pos = g_mqttIngestHead.load(std::memory_order_relaxed);
+    MQTTIngestSlot *slot;
+    for (;;) {
+        slot = &slots[pos & (EEZ_MQTT_INGEST_RING_SIZE - 1)];
+        int32_t diff = (int32_t)(slot->sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (g_mqttIngestHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
             }
-        } else if (event == EEZ_MQTT_EVENT_RECONNECT) {
-            if (component->reconnectEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->reconnectEventOutputIndex);
+        } else if (diff < 0) {
+            if (heapData) {
+                free(heapData);
             }
-        } else if (event == EEZ_MQTT_EVENT_CLOSE) {
-            if (component->closeEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->closeEventOutputIndex);
+            g_mqttNumDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = g_mqttIngestHead.load(std::memory_order_relaxed);
+        }
+    }
+    char *data = heapData ? heapData : slot->data;
+    if (topicLength) {
+        memcpy(data, topic, topicLength);
+    }
+    data[topicLength] = 0;
+    if (payloadLength) {
+        memcpy(data + topicLength + 1, payload, payloadLength);
+    }
+    data[topicLength + 1 + payloadLength] = 0;
+    slot->handle = handle;
+    slot->event = (uint8_t)event;
+    slot->topicLength = (uint16_t)topicLength;
+    slot->payloadLength = (uint32_t)payloadLength;
+    slot->heapData = heapData;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+struct InlineStringRef : public StringRef {
+    ~InlineStringRef() {
+        str = nullptr;
+    }
+};
+static Value makeInlineStringRef(const char *str, size_t len, uint32_t id) {
+    auto ptr = alloc(sizeof(InlineStringRef) + len + 1, id);
+    if (ptr == nullptr) {
+        return Value(0, VALUE_TYPE_NULL);
+    }
+    auto stringRef = new (ptr) InlineStringRef;
+    stringRef->str = (char *)(stringRef + 1);
+    memcpy(stringRef->str, str, len);
+    stringRef->str[len] = 0;
+    stringRef->refCounter = 1;
+    Value value;
+    value.type = VALUE_TYPE_STRING_REF;
+    value.options = VALUE_OPTIONS_REF;
+    value.refValue = stringRef;
+    return value;
+}
+static int16_t getEventOutputIndex(MQTTEventActionComponenent *component, uint8_t event) {
+    switch (event) {
+    case EEZ_MQTT_EVENT_CONNECT: return component->connectEventOutputIndex;
+    case EEZ_MQTT_EVENT_RECONNECT: return component->reconnectEventOutputIndex;
+    case EEZ_MQTT_EVENT_CLOSE: return component->closeEventOutputIndex;
+    case EEZ_MQTT_EVENT_DISCONNECT: return component->disconnectEventOutputIndex;
+    case EEZ_MQTT_EVENT_OFFLINE: return component->offlineEventOutputIndex;
+    case EEZ_MQTT_EVENT_END: return component->endEventOutputIndex;
+    case EEZ_MQTT_EVENT_ERROR: return component->errorEventOutputIndex;
+    case EEZ_MQTT_EVENT_MESSAGE: return component->messageEventOutputIndex;
+    default: return -1;
+    }
+}
+static void dispatchIngestSlot(MQTTIngestSlot &slot) {
+    auto connection = findConnection(slot.handle);
+    if (!connection) {
+        return;
+    }
+    const char *topic = slot.heapData ? slot.heapData : slot.data;
+    const char *payload = topic + slot.topicLength + 1;
+    if (slot.event != EEZ_MQTT_EVENT_MESSAGE) {
+        Value value(VALUE_TYPE_NULL);
+        if (slot.event == EEZ_MQTT_EVENT_ERROR) {
+            value = makeInlineStringRef(payload, slot.payloadLength, 0x2b7ac31a);
+        }
+        for (auto eventHandler = connection->firstEventHandler; eventHandler; eventHandler = eventHandler->next) {
+            auto componentExecutionState = eventHandler->componentExecutionState;
+            auto component = (MQTTEventActionComponenent *)componentExecutionState->flowState->flow->components[componentExecutionState->componentIndex];
+            auto outputIndex = getEventOutputIndex(component, slot.event);
+            if (outputIndex >= 0) {
+                componentExecutionState->addEvent(outputIndex, value);
             }
-        } else if (event == EEZ_MQTT_EVENT_DISCONNECT) {
-            if (component->disconnectEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->disconnectEventOutputIndex);
+        }
+        return;
+    }
+    bool consumed = false;
+    auto visitMessageHandlers = [&](MQTTTopicNode *node) {
+        MQTTMessageHandlerEntry *next;
+        for (auto entry = node->firstMessageHandler; entry; entry = next) {
+            next = entry->nodeNext;
+            if (!entry->removed && entry->handler(entry->userData, topic, payload, slot.payloadLength)) {
+                consumed = true;
             }
-        } else if (event == EEZ_MQTT_EVENT_OFFLINE) {
-            if (component->offlineEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->offlineEventOutputIndex);
+        }
+    };
+    matchTopic(&connection->root, topic, true, visitMessageHandlers);
+    if (consumed) {
+        return;
+    }
+    Value value(VALUE_TYPE_NULL);
+    auto visitEventHandlers = [&](MQTTTopicNode *node) {
+        for (auto eventHandler = node->firstEventHandler; eventHandler; eventHandler = eventHandler->nodeNext) {
+            auto componentExecutionState = eventHandler->componentExecutionState;
+            auto component = (MQTTEventActionComponenent *)componentExecutionState->flowState->flow->components[componentExecutionState->componentIndex];
+            if (component->messageEventOutputIndex < 0) {
+                continue;
             }
-        } else if (event == EEZ_MQTT_EVENT_END) {
-            if (component->endEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->endEventOutputIndex);
+            if (value.getType() == VALUE_TYPE_NULL) {
+                value = Value::makeArrayRef(defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE_NUM_FIELDS, defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE, 0xe256716a);
+                auto messageArray = value.getArray();
+                messageArray->values[defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE_FIELD_TOPIC] = makeInlineStringRef(topic, slot.topicLength, 0x5bdff567);
+                messageArray->values[defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE_FIELD_PAYLOAD] = makeInlineStringRef(payload, slot.payloadLength, 0xcfa25e4f);
             }
-        } else if (event == EEZ_MQTT_EVENT_ERROR) {
-            if (component->errorEventOutputIndex >= 0) {
-                componentExecutionState->addEvent(component->errorEventOutputIndex, Value::makeStringRef((const char *)eventData, -1, 0x2b7ac31a));
+            componentExecutionState->addEvent(component->messageEventOutputIndex, value);
+        }
+    };
+    matchTopic(&connection->root, topic, true, visitEventHandlers);
+    visitEventHandlers(&connection->matchAll);
+}
+static void removeDeferredMessageHandlers() {
+    for (uint32_t i = 0; i < EEZ_MQTT_CONNECTION_MAP_SIZE; i++) {
+        auto connection = g_mqttConnectionMap[i];
+        if (!connection) {
+            continue;
+        }
+        MQTTMessageHandlerEntry *next;
+        for (auto entry = connection->firstMessageHandler; entry; entry = next) {
+            next = entry->next;
+            if (entry->removed) {
+                unlinkMessageHandler(connection, entry);
             }
-        } else if (event == EEZ_MQTT_EVENT_MESSAGE) {
-            if (component->messageEventOutputIndex >= 0) {
-                auto messageEvent = (EEZ_MQTT_MessageEvent *)eventData;
-                Value messageValue = Value::makeArrayRef(defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE_NUM_FIELDS, defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE, 0xe256716a);
-                auto messageArray = messageValue.getArray();
-                messageArray->values[defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE_FIELD_TOPIC] = Value::makeStringRef(messageEvent->topic, -1, 0x5bdff567);
-                messageArray->values[defs_v3::SYSTEM_STRUCTURE_MQTT_MESSAGE_FIELD_PAYLOAD] = Value::makeStringRef(messageEvent->payload, -1, 0xcfa25e4f);
-                componentExecutionState->addEvent(component->messageEventOutputIndex, messageValue);
+        }
+    }
+}
+void processMQTTIngest() {
+    auto slots = g_mqttIngestSlots.load(std::memory_order_acquire);
+    if (!slots) {
+        return;
+    }
+    uint32_t tail = g_mqttIngestTail.load(std::memory_order_relaxed);
+    for (uint32_t n = 0; n < EEZ_MQTT_INGEST_RING_SIZE; n++) {
+        auto &slot = slots[tail & (EEZ_MQTT_INGEST_RING_SIZE - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            break;
+        }
+        g_mqttDispatching = true;
+        dispatchIngestSlot(slot);
+        g_mqttDispatching = false;
+        if (g_mqttRemovalDeferred) {
+            g_mqttRemovalDeferred = false;
+            removeDeferredMessageHandlers();
+        }
+        if (g_mqttPruneDeferred) {
+            g_mqttPruneDeferred = false;
+            for (uint32_t i = 0; i < EEZ_MQTT_CONNECTION_MAP_SIZE; i++) {
+                if (g_mqttConnectionMap[i]) {
+                    pruneTopicTree(&g_mqttConnectionMap[i]->root);
+                }
             }
         }
+        if (slot.heapData) {
+            free(slot.heapData);
+            slot.heapData = nullptr;
+        }
+        slot.sequence.store(tail + EEZ_MQTT_INGEST_RING_SIZE, std::memory_order_release);
+        g_mqttIngestTail.store(++tail, std::memory_order_relaxed);
     }
 }
+bool registerMQTTConnection(void *handle) {
+    return findConnection(handle) || addConnection(handle);
+}
+void releaseMQTTConnection(void *handle) {
+    deleteConnection(handle);
+}
 void onFreeMQTTConnection(ArrayValue *mqttConnectionValue) {
     void *handle = mqttConnectionValue->values[defs_v3::OBJECT_TYPE_MQTT_CONNECTION_FIELD_ID].getVoidPointer();
     deleteConnection(handle);
 }
 MQTTEventActionComponenentExecutionState::~MQTTEventActionComponenentExecutionState() {
     removeEventHandler(this);
-    while (firstEvent) {
-        auto event = removeEvent();
-        ObjectAllocator<MQTTEvent>::deallocate(event);
-    }
 }
 void executeMQTTInitComponent(FlowState *flowState, unsigned componentIndex) {
     Value connectionDstValue;
@@ -8760,7 +12155,11 @@ void executeMQTTInitComponent(FlowState *flowState, unsigned componentIndex) {
         throwError(flowState, componentIndex, errorMessage);
         return;
     }
-    addConnection(handle);
+    if (!addConnection(handle)) {
+        eez_mqtt_deinit(handle);
+        throwError(flowState, componentIndex, "Too many MQTT connections");
+        return;
+    }
     Value connectionValue = Value::makeArrayRef(defs_v3::OBJECT_TYPE_MQTT_CONNECTION_NUM_FIELDS, defs_v3::OBJECT_TYPE_MQTT_CONNECTION, 0x51ba2203);
     auto connectionArray = connectionValue.getArray();
     connectionArray->values[defs_v3::OBJECT_TYPE_MQTT_CONNECTION_FIELD_PROTOCOL] = protocolValue;
@@ -8840,13 +12239,12 @@ void executeMQTTEventComponent(FlowState *flowState, unsigned componentIndex) {
 	    propagateValueThroughSeqout(flowState, componentIndex);
         addToQueue(flowState, componentIndex, -1, -1, -1, true);
     } else {
-        auto event = componentExecutionState->removeEvent();
-        if (event) {
-            propagateValue(flowState, componentIndex, event->outputIndex, event->value);
-            ObjectAllocator<MQTTEvent>::deallocate(event);
-        } else {
-            addToQueue(flowState, componentIndex, -1, -1, -1, true);
+        int16_t outputIndex;
+        Value value;
+        if (componentExecutionState->removeEvent(outputIndex, value)) {
+            propagateValue(flowState, componentIndex, outputIndex, value);
         }
+        addToQueue(flowState, componentIndex, -1, -1, -1, componentExecutionState->numEvents == 0);
     }
 }
 void executeMQTTSubscribeComponent(FlowState *flowState, unsigned componentIndex) {
@@ -8943,6 +12341,19 @@ void executeMQTTPublishComponent(FlowState *flowState, unsigned componentIndex)
 }
 } 
 } 
+extern "C" void eez_mqtt_on_message(void *handle, const char *topic, size_t topicLength, const char *payload, size_t payloadLength) {
+    eez::flow::postMQTTIngestEvent(handle, EEZ_MQTT_EVENT_MESSAGE, topic, topicLength, payload, payloadLength);
+}
+extern "C" void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData) {
+    if (event == EEZ_MQTT_EVENT_MESSAGE) {
+        auto messageEvent = (EEZ_MQTT_MessageEvent *)eventData;
+        eez_mqtt_on_message(handle, messageEvent->topic, strlen(messageEvent->topic), messageEvent->payload, strlen(messageEvent->payload));
+    } else if (event == EEZ_MQTT_EVENT_ERROR && eventData) {
+        eez::flow::postMQTTIngestEvent(handle, event, nullptr, 0, (const char *)eventData, strlen((const char *)eventData));
+    } else {
+        eez::flow::postMQTTIngestEvent(handle, event, nullptr, 0, nullptr, 0);
+    }
+}
 #ifdef EEZ_STUDIO_FLOW_RUNTIME
 #include <emscripten.h>
 extern "C" {
@@ -8993,11 +12404,11 @@ EM_PORT_API(void) onMqttEvent(void *handle, EEZ_MQTT_Event event, void *eventDat
         EEZ_MQTT_MessageEvent eventData;
         eventData.topic = (const char *)eventDataPtr1;
         eventData.payload = (const char *)eventDataPtr2;
-        eez::flow::eez_mqtt_on_event_callback(handle, event, &eventData);
+        eez_mqtt_on_event_callback(handle, event, &eventData);
     } else if (eventDataPtr1) {
-        eez::flow::eez_mqtt_on_event_callback(handle, event, eventDataPtr1);
+        eez_mqtt_on_event_callback(handle, event, eventDataPtr1);
     } else {
-        eez::flow::eez_mqtt_on_event_callback(handle, event, nullptr);
+        eez_mqtt_on_event_callback(handle, event, nullptr);
     }
 }
 #else
@@ -9092,13 +12503,9 @@ void executeSelectLanguageComponent(FlowState *flowState, unsigned componentInde
 		return;
 	}
 	const char *language = languageValue.getString();
-    auto &languages = flowState->assets->languages;
-    for (uint32_t languageIndex = 0; languageIndex < languages.count; languageIndex++) {
-        if (strcmp(languages[languageIndex]->languageID, language) == 0) {
-            g_selectedLanguage = languageIndex;
-	        propagateValueThroughSeqout(flowState, componentIndex);
-            return;
-        }
+    if (selectLanguage(flowState->assets, language)) {
+        propagateValueThroughSeqout(flowState, componentIndex);
+        return;
     }
     char message[256];
     snprintf(message, sizeof(message), "Unknown language %s", language);
@@ -68,6 +68,9 @@
 #ifndef EEZ_FOR_LVGL_SHA256_OPTION
 #define EEZ_FOR_LVGL_SHA256_OPTION 1
 #endif
+#ifndef EEZ_FLOW_PROFILER
+#define EEZ_FLOW_PROFILER 0
+#endif
 #ifdef __cplusplus
 
 // -----------------------------------------------------------------------------
@@ -1184,8 +1187,10 @@ struct Value {
 	int64_t toInt64(int *err = nullptr) const;
     bool toBool(int *err = nullptr) const;
 	Value toString(uint32_t id) const;
+	const char *toStringPtr(char *tempStr, size_t tempStrSize) const;
 	static Value makeStringRef(const char *str, int len, uint32_t id);
 	static Value concatenateString(const Value &str1, const Value &str2);
+	static Value concatenateString(const char *str1, size_t len1, const char *str2, size_t len2);
     static Value makeArrayRef(int arraySize, int arrayType, uint32_t id);
     static Value makeArrayElementRef(Value arrayValue, int elementIndex, uint32_t id);
     static Value makeJsonMemberRef(Value jsonValue, Value propertyName, uint32_t id);
@@ -1256,6 +1261,40 @@ struct JsonMemberValue : public Ref {
 	Value jsonValue;
     Value propertyName;
 };
+#if !defined(EEZ_DASHBOARD_API)
+#if !defined(EEZ_JSON_MAX_DEPTH)
+#define EEZ_JSON_MAX_DEPTH 32
+#endif
+enum JsonTokenType {
+    JSON_TOKEN_OBJECT,
+    JSON_TOKEN_ARRAY,
+    JSON_TOKEN_STRING,
+    JSON_TOKEN_NUMBER,
+    JSON_TOKEN_TRUE,
+    JSON_TOKEN_FALSE,
+    JSON_TOKEN_NULL
+};
+struct JsonToken {
+    uint8_t type;
+    bool escaped;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t size;
+    uint32_t next;
+};
+struct JsonDocument;
+struct JsonValueRef : public Ref {
+    ~JsonValueRef();
+    JsonDocument *document;
+    uint32_t token;
+};
+struct JsonDocument : public JsonValueRef {
+    Value source;
+    const char *text;
+    uint32_t numTokens;
+    JsonToken *tokens;
+};
+#endif
 #if EEZ_OPTION_GUI
 namespace gui {
     struct WidgetCursor;
@@ -1270,6 +1309,10 @@ void setVar(int16_t id, const Value& value);
 namespace flow {
     extern Value operationJsonGet(int json, const char *property);
 }
+#else
+namespace flow {
+    Value getJsonMember(const Value &json, const char *name);
+}
 #endif
 inline Value Value::getValue() const {
     if (type == VALUE_TYPE_VALUE_PTR) {
@@ -1304,6 +1347,11 @@ inline Value Value::getValue() const {
         auto jsonMemberValue = (JsonMemberValue *)refValue;
         return flow::operationJsonGet(jsonMemberValue->jsonValue.getInt(), jsonMemberValue->propertyName.getString());
     }
+#else
+    else if (type == VALUE_TYPE_JSON_MEMBER_VALUE) {
+        auto jsonMemberValue = (JsonMemberValue *)refValue;
+        return flow::getJsonMember(jsonMemberValue->jsonValue, jsonMemberValue->propertyName.getString());
+    }
 #endif
     return *this;
 }
@@ -2065,6 +2113,9 @@ void stringAppendFloat(char *str, size_t maxStrLength, float value);
 void stringAppendFloat(char *str, size_t maxStrLength, float value, int numDecimalPlaces);
 void stringAppendDouble(char *str, size_t maxStrLength, double value);
 void stringAppendDouble(char *str, size_t maxStrLength, double value, int numDecimalPlaces);
+#define FORMAT_FLOAT_TRIM_ZEROS (1 << 0)
+#define FORMAT_FLOAT_KEEP_ONE_DECIMAL (1 << 1)
+size_t formatFloat(char *str, size_t maxStrLength, double value, int numDecimalPlaces, int flags);
 void stringAppendVoltage(char *str, size_t maxStrLength, float value);
 void stringAppendCurrent(char *str, size_t maxStrLength, float value);
 void stringAppendPower(char *str, size_t maxStrLength, float value);
@@ -2115,6 +2166,47 @@ void getFileName(const char *path, char *fileName, unsigned fileNameSize);
 void getBaseFileName(const char *path, char *baseName, unsigned baseNameSize);
 typedef float (*EasingFuncType)(float x);
 extern EasingFuncType g_easingFuncs[];
+extern EasingFuncType g_easingExactFuncs[];
+enum EasingFunc {
+    EASING_LINEAR,
+    EASING_IN_QUAD,
+    EASING_OUT_QUAD,
+    EASING_IN_OUT_QUAD,
+    EASING_IN_CUBIC,
+    EASING_OUT_CUBIC,
+    EASING_IN_OUT_CUBIC,
+    EASING_IN_QUART,
+    EASING_OUT_QUART,
+    EASING_IN_OUT_QUART,
+    EASING_IN_QUINT,
+    EASING_OUT_QUINT,
+    EASING_IN_OUT_QUINT,
+    EASING_IN_SINE,
+    EASING_OUT_SINE,
+    EASING_IN_OUT_SINE,
+    EASING_IN_EXPO,
+    EASING_OUT_EXPO,
+    EASING_IN_OUT_EXPO,
+    EASING_IN_CIRC,
+    EASING_OUT_CIRC,
+    EASING_IN_OUT_CIRC,
+    EASING_IN_BACK,
+    EASING_OUT_BACK,
+    EASING_IN_OUT_BACK,
+    EASING_IN_ELASTIC,
+    EASING_OUT_ELASTIC,
+    EASING_IN_OUT_ELASTIC,
+    EASING_IN_BOUNCE,
+    EASING_OUT_BOUNCE,
+    EASING_IN_OUT_BOUNCE,
+    NUM_EASING_FUNCS
+};
+static const int EASING_FIXED_BITS = 16;
+static const int32_t EASING_FIXED_ONE = 1 << EASING_FIXED_BITS;
+float ease(int easingFunc, float x);
+int32_t easeFixed(int easingFunc, int32_t x);
+void easeBatch(int easingFunc, const float *x, float *y, size_t count);
+void easeFixedBatch(int easingFunc, const int32_t *x, int32_t *y, size_t count);
 class Interval {
 public:
 	bool test(uint32_t interval) {
@@ -2196,6 +2288,10 @@ struct ComponenentExecutionState {
 struct CatchErrorComponenentExecutionState : public ComponenentExecutionState {
 	Value message;
 };
+#define FLOW_PARTITION_UI 0
+#define FLOW_PARTITION_WORKER 1
+#define FLOW_NUM_PARTITIONS 2
+#define FLOW_PARTITION_INHERIT 0xFF
 struct FlowState {
 	uint32_t flowStateIndex;
 	Assets *assets;
@@ -2204,6 +2300,8 @@ struct FlowState {
 	uint16_t flowIndex;
 	bool isAction;
 	bool error;
+    uint8_t partition;
+    uint16_t numMarshalledTasks;
     uint32_t refCounter;
     FlowState *parentFlowState;
 	Component *parentComponent;
@@ -2223,6 +2321,9 @@ struct FlowState {
     FlowState *nextSibling;
 };
 extern int g_selectedLanguage;
+bool selectLanguage(Assets *assets, const char *languageID);
+const char *translate(Assets *assets, int textResourceIndex);
+void freeTranslations();
 extern FlowState *g_firstFlowState;
 extern FlowState *g_lastFlowState;
 FlowState *initActionFlowState(int flowIndex, FlowState *parentFlowState, int parentComponentIndex);
@@ -2284,6 +2385,48 @@ void executeComponent(FlowState *flowState, unsigned componentIndex);
 } 
 } 
 // -----------------------------------------------------------------------------
+// flow/crypto.h
+// -----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define EEZ_CRYPTO_SHA256_SIZE 32
+void *eez_crypto_sha256_begin();
+void eez_crypto_sha256_update(void *context, const uint8_t *data, size_t length);
+void eez_crypto_sha256_end(void *context, uint8_t *digest);
+void eez_crypto_sha256(const uint8_t *data, size_t length, uint8_t *digest);
+bool eez_crypto_aes_ctr(const uint8_t *key, size_t keyLength, uint8_t *counter, const uint8_t *input, uint8_t *output, size_t length);
+#ifdef __cplusplus
+}
+#endif
+namespace eez {
+namespace flow {
+struct Sha256Stream {
+    Sha256Stream() : context(eez_crypto_sha256_begin()) {}
+    ~Sha256Stream() {
+        if (context) {
+            eez_crypto_sha256_end(context, nullptr);
+        }
+    }
+    bool isValid() const {
+        return context != nullptr;
+    }
+    void update(const uint8_t *data, size_t length) {
+        if (context) {
+            eez_crypto_sha256_update(context, data, length);
+        }
+    }
+    bool update(const Value &value);
+    bool finish(uint8_t *digest);
+    Value finish();
+private:
+    void *context;
+    Sha256Stream(const Sha256Stream &);
+    Sha256Stream &operator=(const Sha256Stream &);
+};
+} 
+} 
+// -----------------------------------------------------------------------------
 // flow/date.h
 // -----------------------------------------------------------------------------
 #include <stdint.h>
@@ -2293,12 +2436,27 @@ namespace date {
 enum DstRule { DST_RULE_OFF, DST_RULE_EUROPE, DST_RULE_USA, DST_RULE_AUSTRALIA };
 enum Format { FORMAT_DMY_24, FORMAT_MDY_24, FORMAT_DMY_12, FORMAT_MDY_12 };
 typedef uint64_t Date;
+#define DATE_TEXT_EMPTY -2
+#define DATE_TEXT_ISO -1
+struct DateTextCache {
+    int8_t layout = DATE_TEXT_EMPTY;
+    uint8_t timeOffset;
+    uint8_t length;
+    uint32_t days;
+    int hours;
+    int minutes;
+    int seconds;
+    int milliseconds;
+    char text[40];
+};
 extern Format g_localeFormat;
 extern int g_timeZone;
 extern DstRule g_dstRule;
 Date now();
 void toString(Date time, char *str, uint32_t strLen);
 void toLocaleString(Date time, char *str, uint32_t strLen);
+const char *toString(DateTextCache &cache, Date time);
+const char *toLocaleString(DateTextCache &cache, Date time);
 Date fromString(const char *str);
 Date makeDate(int year, int month, int day, int hours, int minutes, int seconds, int milliseconds);
 void breakDate(Date time, int &year, int &month, int &day, int &hours, int &minutes, int &seconds, int &milliseconds);
@@ -2364,6 +2522,7 @@ struct EvalStack {
 	const int32_t *iterators;
 	Value stack[STACK_SIZE];
 	size_t sp = 0;
+    size_t base = 0;
     char errorMessage[512];
 	bool push(const Value &value) {
 		if (sp >= STACK_SIZE) {
@@ -2381,7 +2540,7 @@ struct EvalStack {
 		return true;
 	}
 	Value pop() {
-        if (sp == 0) {
+        if (sp == base) {
             return Value::makeError();
         }
 		return stack[--sp];
@@ -2402,6 +2561,32 @@ bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, V
 bool evalProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes = nullptr, const int32_t *iterators = nullptr);
 #endif
 bool evalAssignableProperty(FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes = nullptr, const int32_t *iterators = nullptr);
+#if EEZ_OPTION_GUI
+bool evalExpression(EvalStack &stack, FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, eez::gui::DataOperationEnum operation);
+bool evalProperty(EvalStack &stack, FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators, eez::gui::DataOperationEnum operation);
+#else
+bool evalExpression(EvalStack &stack, FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators);
+bool evalProperty(EvalStack &stack, FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators);
+#endif
+bool evalAssignableExpression(EvalStack &stack, FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators);
+bool evalAssignableProperty(EvalStack &stack, FlowState *flowState, int componentIndex, int propertyIndex, Value &result, const char *errorMessage, int *numInstructionBytes, const int32_t *iterators);
+EvalStack *allocEvalStack();
+void freeEvalStack(EvalStack *stack);
+void freeTaskEvalStack();
+struct TaskEvalStack {
+    TaskEvalStack();
+    ~TaskEvalStack();
+    EvalStack *stack;
+    bool temporary;
+    bool nested;
+    size_t savedBase;
+    FlowState *savedFlowState;
+    int savedComponentIndex;
+    const int32_t *savedIterators;
+    char *savedErrorMessage;
+};
+void compileExpressions(Assets *assets);
+void freeCompiledExpressions();
 } 
 } 
 // -----------------------------------------------------------------------------
@@ -2418,6 +2603,10 @@ extern uint32_t g_wasmModuleId;
 struct FlowState;
 unsigned start(Assets *assets);
 void tick();
+void tickPartition(uint8_t partition);
+void setFlowPartition(int flowIndex, uint8_t partition);
+uint8_t getFlowPartition(int flowIndex);
+bool startFlowOnPartition(int flowIndex, uint8_t partition);
 void stop();
 bool isFlowStopped();
 #if EEZ_OPTION_GUI
@@ -2475,9 +2664,27 @@ extern void (*executeLvglActionHook)(int actionIndex);
 #endif
 extern double (*getDateNowHook)();
 extern void (*onFlowErrorHook)(FlowState *flowState, int componentIndex, const char *errorMessage);
+extern void (*wakePartitionHook)(uint8_t partition);
+extern void (*waitForPartitionHook)(uint8_t partition);
 } 
 } 
 // -----------------------------------------------------------------------------
+// flow/json.h
+// -----------------------------------------------------------------------------
+#if !defined(EEZ_DASHBOARD_API)
+namespace eez {
+namespace flow {
+Value parseJson(const char *text, size_t length);
+Value parseJson(const Value &text);
+Value getJsonMember(const Value &json, const char *name);
+Value getJsonElement(const Value &json, uint32_t index);
+Value getJsonPath(const Value &json, const char *path);
+int getJsonLength(const Value &json);
+const char *getJsonText(const Value &json, uint32_t &length);
+} 
+} 
+#endif
+// -----------------------------------------------------------------------------
 // flow/operations.h
 // -----------------------------------------------------------------------------
 namespace eez {
@@ -2507,18 +2714,83 @@ Value op_great_eq(const Value& a1, const Value& b1);
 // -----------------------------------------------------------------------------
 namespace eez {
 namespace flow {
+#if !defined(EEZ_FLOW_MAILBOX_SIZE)
+#define EEZ_FLOW_MAILBOX_SIZE 64
+#endif
+enum PartitionMessageType {
+    PARTITION_MESSAGE_ADD_TO_QUEUE,
+    PARTITION_MESSAGE_EXECUTE,
+    PARTITION_MESSAGE_EXECUTED,
+    PARTITION_MESSAGE_START_FLOW
+};
+struct PartitionMessage {
+    uint8_t type;
+    bool continuousTask;
+    uint16_t flowIndex;
+    FlowState *flowState;
+    unsigned componentIndex;
+};
+uint8_t getCurrentPartition();
+void setCurrentPartition(uint8_t partition);
 void queueReset();
-size_t getQueueSize();
-size_t getMaxQueueSize();
-extern unsigned g_numContinuousTaskInQueue;
+size_t getQueueSize(uint8_t partition = FLOW_PARTITION_UI);
+size_t getMaxQueueSize(uint8_t partition = FLOW_PARTITION_UI);
+unsigned getNumContinuousTaskInQueue(uint8_t partition);
 bool addToQueue(FlowState *flowState, unsigned componentIndex,
     int sourceComponentIndex, int sourceOutputIndex, int targetInputIndex,
     bool continuousTask);
-bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool &continuousTask);
-void removeNextTaskFromQueue();
+bool peekNextTaskFromQueue(uint8_t partition, FlowState *&flowState, unsigned &componentIndex, bool &continuousTask);
+#if EEZ_FLOW_PROFILER
+uint32_t getNextTaskEnqueueCycles(uint8_t partition);
+#endif
+void removeNextTaskFromQueue(uint8_t partition);
 bool isInQueue(FlowState *flowState, unsigned componentIndex);
+bool postPartitionMessage(uint8_t partition, const PartitionMessage &message);
+uint32_t getNumPartitionMessages(uint8_t fromPartition, uint8_t partition);
+bool hasPartitionMessages(uint8_t partition);
+bool takePartitionMessage(uint8_t fromPartition, uint8_t partition, PartitionMessage &message);
+} 
+} 
+// -----------------------------------------------------------------------------
+// flow/profiler.h
+// -----------------------------------------------------------------------------
+#if EEZ_FLOW_PROFILER
+namespace eez {
+namespace flow {
+#if !defined(EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES)
+#define EEZ_FLOW_PROFILER_MAX_COMPONENT_TYPES 64
+#endif
+struct ComponentProfile {
+    uint32_t count;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t maxWaitCycles;
+    uint64_t totalWaitCycles;
+    uint32_t allocs;
+};
+struct TickProfile {
+    uint32_t count;
+    uint32_t overBudget;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+};
+uint32_t getProfilerCycles();
+uint32_t getProfilerCyclesPerUs();
+void profilerStart(Assets *assets);
+void profilerStop();
+void profilerReset();
+void profilerOnAlloc();
+uint32_t getProfilerAllocCount();
+void profilerRecordComponent(uint8_t partition, FlowState *flowState, unsigned componentIndex, uint32_t cycles, uint32_t waitCycles, uint32_t allocs);
+void profilerRecordTick(uint8_t partition, uint32_t cycles, bool overBudget);
+int getNumProfiledFlows();
+int getNumProfiledComponents(int flowIndex);
+bool getComponentProfile(uint8_t partition, int flowIndex, int componentIndex, uint16_t &componentType, ComponentProfile &profile);
+bool getComponentTypeProfile(uint8_t partition, int slotIndex, uint16_t &componentType, ComponentProfile &profile);
+bool getTickProfile(uint8_t partition, TickProfile &profile);
 } 
 } 
+#endif
 // -----------------------------------------------------------------------------
 // flow/watch_list.h
 // -----------------------------------------------------------------------------
@@ -2527,7 +2799,7 @@ namespace flow {
 struct WatchListNode;
 WatchListNode *watchListAdd(FlowState *flowState, unsigned componentIndex);
 void watchListRemove(WatchListNode *node);
-void visitWatchList();
+void visitWatchList(uint8_t partition);
 void watchListReset();
 } 
 } 
@@ -2658,9 +2930,47 @@ typedef struct {
     const char *payload;
 } EEZ_MQTT_MessageEvent;
 void eez_mqtt_on_event_callback(void *handle, EEZ_MQTT_Event event, void *eventData);
+void eez_mqtt_on_message(void *handle, const char *topic, size_t topicLength, const char *payload, size_t payloadLength);
 #ifdef __cplusplus
 }
 #endif
+#ifndef EEZ_MQTT_INGEST_RING_SIZE
+#define EEZ_MQTT_INGEST_RING_SIZE 32
+#endif
+#ifndef EEZ_MQTT_INGEST_SLOT_SIZE
+#define EEZ_MQTT_INGEST_SLOT_SIZE 256
+#endif
+#ifndef EEZ_MQTT_EVENT_QUEUE_SIZE
+#define EEZ_MQTT_EVENT_QUEUE_SIZE EEZ_MQTT_INGEST_RING_SIZE
+#endif
+#ifndef EEZ_MQTT_CONNECTION_MAP_SIZE
+#define EEZ_MQTT_CONNECTION_MAP_SIZE 16
+#endif
+#ifndef EEZ_MQTT_MAX_EVENT_TOPIC_FILTERS
+#define EEZ_MQTT_MAX_EVENT_TOPIC_FILTERS 64
+#endif
+namespace eez {
+namespace flow {
+typedef bool (*MQTTMessageHandler)(void *userData, const char *topic, const char *payload, size_t payloadLength);
+struct MQTTIngestStats {
+    uint32_t received;
+    uint32_t dropped;
+    uint32_t oversized;
+    uint32_t eventQueueOverflows;
+    uint32_t pending;
+};
+bool registerMQTTConnection(void *handle);
+void releaseMQTTConnection(void *handle);
+void processMQTTIngest();
+bool postMQTTIngestEvent(void *handle, EEZ_MQTT_Event event, const char *topic, size_t topicLength, const char *payload, size_t payloadLength);
+bool mqttTopicMatchesFilter(const char *topicFilter, const char *topic);
+bool addMQTTMessageHandler(void *handle, const char *topicFilter, MQTTMessageHandler handler, void *userData);
+void removeMQTTMessageHandler(void *handle, MQTTMessageHandler handler, void *userData);
+bool setMQTTEventTopicFilter(int flowIndex, int componentIndex, const char *topicFilter);
+void getMQTTIngestStats(MQTTIngestStats &stats);
+uint32_t getNumFreeMQTTIngestSlots();
+} 
+} 
 // -----------------------------------------------------------------------------
 // flow/components/on_event.h
 // -----------------------------------------------------------------------------
@@ -2771,6 +3081,8 @@ typedef struct _ext_img_desc_t {
 } ext_img_desc_t;
 #endif
 typedef void (*ActionExecFunc)(lv_event_t * e);
+typedef bool (*eez_flow_assets_loader_t)(const uint8_t **assets, uint32_t *assetsSize);
+void eez_flow_set_assets_loader(eez_flow_assets_loader_t loader);
 void eez_flow_init(const uint8_t *assets, uint32_t assetsSize, lv_obj_t **objects, size_t numObjects, const ext_img_desc_t *images, size_t numImages, ActionExecFunc *actions);
 void eez_flow_tick();
 bool eez_flow_is_stopped();
@@ -2779,6 +3091,17 @@ int16_t eez_flow_get_current_screen();
 void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay);
 void eez_flow_push_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay);
 void eez_flow_pop_screen(lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay);
+#define EEZ_SCR_LOAD_ANIM_ZOOM_IN 0x80
+#define EEZ_SCR_LOAD_ANIM_ZOOM_OUT 0x81
+typedef void (*create_screen_func_t)();
+void eez_flow_set_screen_factories(const create_screen_func_t *createScreenFuncs, size_t numScreens);
+void eez_flow_set_screen_cache_budget(size_t bytes);
+void eez_flow_set_screen_memory_probe(size_t (*getUsedMemory)());
+bool eez_flow_is_screen_created(int16_t screenId);
+bool eez_flow_create_screen(int16_t screenId);
+bool eez_flow_delete_screen(int16_t screenId);
+void eez_flow_prewarm_screen(int16_t screenId);
+size_t eez_flow_get_screen_cache_size();
 void flowOnPageLoaded(unsigned pageIndex);
 void *getFlowState(void *flowState, unsigned userWidgetComponentIndexOrPageIndex);
 void flowPropagateValue(void *flowState, unsigned componentIndex, unsigned outputIndex);
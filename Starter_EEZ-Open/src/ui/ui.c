@@ -49,6 +49,8 @@ const uint8_t assets[532] = {
 native_var_t native_vars[] = {
     { NATIVE_VAR_TYPE_NONE, 0, 0 },
     { NATIVE_VAR_TYPE_STRING, get_var_label_count_value, set_var_label_count_value }, 
+    { NATIVE_VAR_TYPE_FLOAT, get_var_temperature, set_var_temperature }, 
+    { NATIVE_VAR_TYPE_FLOAT, get_var_humidity, set_var_humidity }, 
 };
 
 
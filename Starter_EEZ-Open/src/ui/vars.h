@@ -22,6 +22,10 @@ enum FlowGlobalVariables {
 
 extern const char *get_var_label_count_value();
 extern void set_var_label_count_value(const char *value);
+extern float get_var_temperature();
+extern void set_var_temperature(float value);
+extern float get_var_humidity();
+extern void set_var_humidity(float value);
 
 
 #ifdef __cplusplus
@@ -0,0 +1,282 @@
+#!/usr/bin/env python3
+"""Convert PNG/JPEG files into RGB565 lv_img_dsc_t C arrays for src/images/image_cache.
+
+The pixels are converted at build time into the format the panel draws, so LVGL never
+has to decode a PNG or JPEG on the device:
+
+  - RGB565 in the byte order of LV_COLOR_16_SWAP (read from include/lv_conf.h),
+  - images with transparency keep a separate A8 plane (alpha split),
+  - optionally RLE or LZ4 compressed, the colour and alpha planes packed separately.
+
+Uncompressed images become LV_IMG_CF_TRUE_COLOR / LV_IMG_CF_RGB565A8 descriptors that
+are drawn straight from flash.  Compressed ones are LV_IMG_CF_RAW(_ALPHA) with an
+ImageAssetHeader (see image_cache.h) and are decoded once into the PSRAM image cache.
+With --compress auto (the default) each image gets whichever of RLE and LZ4 is smaller,
+or no compression when neither saves at least 10%.
+
+    python tools/convert_images.py assets/logo.png assets/background.jpg
+
+writes src/images/assets/img_logo.c, img_background.c and converted_images.h with the
+extern declarations; use them like the images EEZ Studio generates:
+
+    lv_img_set_src(obj, &img_logo);
+
+Needs Pillow (pip install pillow).
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+try:
+    from PIL import Image
+except ImportError:
+    sys.exit("Pillow is required: pip install pillow")
+
+IMAGE_ASSET_MAGIC = 0x4D495A45  # "EZIM"
+HEADER_FORMAT = "<IHHBBHII"
+
+IMAGE_ASSET_ALPHA = 0x01
+IMAGE_ASSET_SWAPPED = 0x02
+
+COMPRESSION_NONE = 0
+COMPRESSION_RLE = 1
+COMPRESSION_LZ4 = 2
+COMPRESSION_NAMES = {"none": COMPRESSION_NONE, "rle": COMPRESSION_RLE, "lz4": COMPRESSION_LZ4}
+
+# Images are addressed with 11 bit sizes in lv_img_header_t.
+MAX_SIZE = 2047
+
+
+def read_color_swap(lv_conf):
+    try:
+        source = open(lv_conf, encoding="utf-8").read()
+    except OSError:
+        return False
+    match = re.search(r"^\s*#define\s+LV_COLOR_16_SWAP\s+(\d+)", source, re.M)
+    return bool(match and int(match.group(1)))
+
+
+def to_rgb565(image, swap):
+    rgb = image.convert("RGB").tobytes()
+    pixels = [((rgb[i] >> 3) << 11) | ((rgb[i + 1] >> 2) << 5) | (rgb[i + 2] >> 3) for i in range(0, len(rgb), 3)]
+    return struct.pack("%s%dH" % (">" if swap else "<", len(pixels)), *pixels)
+
+
+def rle_compress(data, element_size):
+    """Control byte c < 0x80: c + 1 literal elements follow, c >= 0x80: one element repeated (c & 0x7F) + 1 times."""
+    elements = [data[i:i + element_size] for i in range(0, len(data), element_size)]
+    out = bytearray()
+    literals = []
+
+    def flush_literals():
+        while literals:
+            chunk = literals[:128]
+            del literals[:128]
+            out.append(len(chunk) - 1)
+            out.extend(b"".join(chunk))
+
+    i = 0
+    while i < len(elements):
+        j = i + 1
+        while j < len(elements) and j - i < 128 and elements[j] == elements[i]:
+            j += 1
+        if j - i >= 3:
+            flush_literals()
+            out.append(0x80 | (j - i - 1))
+            out.extend(elements[i])
+            i = j
+        else:
+            literals.append(elements[i])
+            i += 1
+    flush_literals()
+    return bytes(out)
+
+
+def lz4_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_sequence(out, literals, offset=0, match_length=0):
+    lit = len(literals)
+    ml = match_length - 4 if match_length else 0
+    out.append((min(lit, 15) << 4) | min(ml, 15))
+    if lit >= 15:
+        lz4_length(out, lit - 15)
+    out.extend(literals)
+    if match_length:
+        out.extend(struct.pack("<H", offset))
+        if ml >= 15:
+            lz4_length(out, ml - 15)
+
+
+def lz4_compress(data):
+    """Greedy LZ4 block compressor, the output is readable by LZ4_decompress_safe()."""
+    n = len(data)
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    # The format wants the last match to start 12 bytes and end 5 bytes before the end.
+    limit = n - 12
+    while i < limit:
+        key = data[i:i + 4]
+        candidate = table.get(key)
+        table[key] = i
+        if candidate is None or i - candidate > 0xFFFF:
+            i += 1
+            continue
+        length = 4
+        max_length = n - 5 - i
+        while length < max_length and data[candidate + length] == data[i + length]:
+            length += 1
+        lz4_sequence(out, data[anchor:i], i - candidate, length)
+        i += length
+        anchor = i
+    lz4_sequence(out, data[anchor:])
+    return bytes(out)
+
+
+def compress(data, element_size, compression):
+    if compression == COMPRESSION_RLE:
+        return rle_compress(data, element_size)
+    if compression == COMPRESSION_LZ4:
+        return lz4_compress(data)
+    return data
+
+
+def c_name(path):
+    name = re.sub(r"\W", "_", os.path.splitext(os.path.basename(path))[0]).lower()
+    return "img_" + name
+
+
+def c_bytes(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def convert(path, args, swap):
+    image = Image.open(path)
+    image.load()
+    width, height = image.size
+    if width > MAX_SIZE or height > MAX_SIZE:
+        sys.exit("%s: %dx%d is larger than %d pixels" % (path, width, height, MAX_SIZE))
+
+    has_alpha = image.mode in ("RGBA", "LA", "PA") or (image.mode == "P" and "transparency" in image.info)
+    alpha = None
+    if has_alpha and not args.no_alpha:
+        alpha = image.convert("RGBA").getchannel("A").tobytes()
+        if all(a == 255 for a in alpha):
+            alpha = None
+
+    color = to_rgb565(image, swap)
+    raw_size = len(color) + (len(alpha) if alpha else 0)
+
+    if args.compress == "auto":
+        compression, packed = COMPRESSION_NONE, None
+        for candidate in (COMPRESSION_RLE, COMPRESSION_LZ4):
+            planes = (compress(color, 2, candidate), compress(alpha, 1, candidate) if alpha else b"")
+            size = len(planes[0]) + len(planes[1])
+            if size < raw_size * 0.9 and (packed is None or size < len(packed[0]) + len(packed[1])):
+                compression, packed = candidate, planes
+    else:
+        compression = COMPRESSION_NAMES[args.compress]
+        packed = (compress(color, 2, compression), compress(alpha, 1, compression) if alpha else b"")
+
+    name = c_name(path)
+    if compression == COMPRESSION_NONE:
+        data = color + (alpha or b"")
+        cf = "LV_IMG_CF_RGB565A8" if alpha else "LV_IMG_CF_TRUE_COLOR"
+    else:
+        flags = (IMAGE_ASSET_ALPHA if alpha else 0) | (IMAGE_ASSET_SWAPPED if swap else 0)
+        header = struct.pack(HEADER_FORMAT, IMAGE_ASSET_MAGIC, width, height, flags, compression, 0,
+                             len(packed[0]), len(packed[1]))
+        data = header + packed[0] + packed[1]
+        cf = "LV_IMG_CF_RAW_ALPHA" if alpha else "LV_IMG_CF_RAW"
+
+    source = "\n".join([
+        "// Generated by tools/convert_images.py from %s, do not edit." % os.path.basename(path),
+        "#include <lvgl.h>",
+        "",
+        "// %dx%d, %s, %s, %d bytes (%d unpacked)" % (width, height, "RGB565 + A8" if alpha else "RGB565",
+                                                   [k for k, v in COMPRESSION_NAMES.items() if v == compression][0],
+                                                   len(data), raw_size),
+        "static const uint8_t %s_data[] __attribute__((aligned(4))) = {" % name,
+        c_bytes(data),
+        "};",
+        "",
+        "const lv_img_dsc_t %s = {" % name,
+        "    .header.cf = %s," % cf,
+        "    .header.always_zero = 0,",
+        "    .header.reserved = 0,",
+        "    .header.w = %d," % width,
+        "    .header.h = %d," % height,
+        "    .data_size = sizeof(%s_data)," % name,
+        "    .data = %s_data," % name,
+        "};",
+        "",
+    ])
+    with open(os.path.join(args.output, name + ".c"), "w", newline="\n") as f:
+        f.write(source)
+    print("%s: %s %dx%d, %d -> %d bytes" % (path, name, width, height, raw_size, len(data)))
+
+
+def write_header(output):
+    names = sorted(os.path.splitext(f)[0] for f in os.listdir(output) if re.match(r"img_\w+\.c$", f))
+    lines = [
+        "// Generated by tools/convert_images.py, do not edit.",
+        "#ifndef _CONVERTED_IMAGES_H",
+        "#define _CONVERTED_IMAGES_H",
+        "",
+        "#include <lvgl.h>",
+        "",
+        "#ifdef __cplusplus",
+        'extern "C" {',
+        "#endif",
+        "",
+    ]
+    lines += ["extern const lv_img_dsc_t %s;" % name for name in names]
+    lines += [
+        "",
+        "#ifdef __cplusplus",
+        "}",
+        "#endif",
+        "",
+        "#endif",
+        "",
+    ]
+    with open(os.path.join(output, "converted_images.h"), "w", newline="\n") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    root = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("inputs", nargs="+", help="PNG or JPEG files")
+    parser.add_argument("-o", "--output", default=os.path.join(root, "src", "images", "assets"))
+    parser.add_argument("-c", "--compress", choices=["auto"] + list(COMPRESSION_NAMES), default="auto")
+    parser.add_argument("--no-alpha", action="store_true", help="drop transparency")
+    parser.add_argument("--swap", choices=["auto", "0", "1"], default="auto",
+                        help="RGB565 byte order, auto follows LV_COLOR_16_SWAP in include/lv_conf.h")
+    args = parser.parse_args()
+
+    if args.swap == "auto":
+        swap = read_color_swap(os.path.join(root, "include", "lv_conf.h"))
+    else:
+        swap = args.swap == "1"
+
+    os.makedirs(args.output, exist_ok=True)
+    for path in args.inputs:
+        convert(path, args, swap)
+    write_header(args.output)
+
+
+if __name__ == "__main__":
+    main()
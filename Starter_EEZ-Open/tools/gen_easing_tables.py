@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Generate src/ui/eez-easing-tables.h, the sampled easing curves behind eez_ease*().
+
+Every curve of g_easingFuncs[] is sampled at 2^bits + 1 evenly spaced points over
+[0, 1] as Q14 (16384 = 1.0, room for the overshoot of Back and Elastic) and the
+runtime interpolates linearly between neighbours.  Elastic and Bounce get 1024
+intervals, the smooth curves 256, which keeps all of them within 2e-3 of the float
+formulas.  Linear and Circ are not tabulated: one is the identity, the other has a
+vertical tangent that a table can't follow, so eez-flow.cpp computes both directly.
+
+eez::easeFixed() uses every table.  The float eez_ease*() only use them for the
+curves that would call sin/pow (Sine, Expo, Elastic); the polynomial ones are cheaper
+as a few multiplications.
+
+    python tools/gen_easing_tables.py
+
+Rerun after changing the formulas here; they mirror core/util.cpp in eez-flow.cpp.
+"""
+
+import argparse
+import math
+import os
+
+ONE = 1 << 14
+
+C1 = 1.70158
+C2 = C1 * 1.525
+C3 = C1 + 1
+C4 = (2 * math.pi) / 3
+C5 = (2 * math.pi) / 4.5
+
+
+def out_bounce(x):
+    n1 = 7.5625
+    d1 = 2.75
+    if x < 1 / d1:
+        return n1 * x * x
+    if x < 2 / d1:
+        x -= 1.5 / d1
+        return n1 * x * x + 0.75
+    if x < 2.5 / d1:
+        x -= 2.25 / d1
+        return n1 * x * x + 0.9375
+    x -= 2.625 / d1
+    return n1 * x * x + 0.984375
+
+
+# (name, bits, formula) in g_easingFuncs[] order, bits 0 means not tabulated
+CURVES = [
+    ("linear", 0, None),
+    ("easeInQuad", 8, lambda x: x * x),
+    ("easeOutQuad", 8, lambda x: 1 - (1 - x) ** 2),
+    ("easeInOutQuad", 8, lambda x: 2 * x * x if x < 0.5 else 1 - (-2 * x + 2) ** 2 / 2),
+    ("easeInCubic", 8, lambda x: x ** 3),
+    ("easeOutCubic", 8, lambda x: 1 - (1 - x) ** 3),
+    ("easeInOutCubic", 8, lambda x: 4 * x ** 3 if x < 0.5 else 1 - (-2 * x + 2) ** 3 / 2),
+    ("easeInQuart", 8, lambda x: x ** 4),
+    ("easeOutQuart", 8, lambda x: 1 - (1 - x) ** 4),
+    ("easeInOutQuart", 8, lambda x: 8 * x ** 4 if x < 0.5 else 1 - (-2 * x + 2) ** 4 / 2),
+    ("easeInQuint", 8, lambda x: x ** 5),
+    ("easeOutQuint", 8, lambda x: 1 - (1 - x) ** 5),
+    ("easeInOutQuint", 8, lambda x: 16 * x ** 5 if x < 0.5 else 1 - (-2 * x + 2) ** 5 / 2),
+    ("easeInSine", 8, lambda x: 1 - math.cos(x * math.pi / 2)),
+    ("easeOutSine", 8, lambda x: math.sin(x * math.pi / 2)),
+    ("easeInOutSine", 8, lambda x: -(math.cos(math.pi * x) - 1) / 2),
+    ("easeInExpo", 8, lambda x: 0 if x == 0 else 2 ** (10 * x - 10)),
+    ("easeOutExpo", 8, lambda x: 1 if x == 1 else 1 - 2 ** (-10 * x)),
+    ("easeInOutExpo", 8, lambda x: 0 if x == 0 else 1 if x == 1 else
+        2 ** (20 * x - 10) / 2 if x < 0.5 else (2 - 2 ** (-20 * x + 10)) / 2),
+    ("easeInCirc", 0, None),
+    ("easeOutCirc", 0, None),
+    ("easeInOutCirc", 0, None),
+    ("easeInBack", 8, lambda x: C3 * x ** 3 - C1 * x * x),
+    ("easeOutBack", 8, lambda x: 1 + C3 * (x - 1) ** 3 + C1 * (x - 1) ** 2),
+    ("easeInOutBack", 8, lambda x: ((2 * x) ** 2 * ((C2 + 1) * 2 * x - C2)) / 2 if x < 0.5 else
+        ((2 * x - 2) ** 2 * ((C2 + 1) * (x * 2 - 2) + C2) + 2) / 2),
+    ("easeInElastic", 10, lambda x: 0 if x == 0 else 1 if x == 1 else
+        -2 ** (10 * x - 10) * math.sin((x * 10 - 10.75) * C4)),
+    ("easeOutElastic", 10, lambda x: 0 if x == 0 else 1 if x == 1 else
+        2 ** (-10 * x) * math.sin((x * 10 - 0.75) * C4) + 1),
+    ("easeInOutElastic", 10, lambda x: 0 if x == 0 else 1 if x == 1 else
+        -(2 ** (20 * x - 10) * math.sin((20 * x - 11.125) * C5)) / 2 if x < 0.5 else
+        (2 ** (-20 * x + 10) * math.sin((20 * x - 11.125) * C5)) / 2 + 1),
+    ("easeInBounce", 10, lambda x: 1 - out_bounce(1 - x)),
+    ("easeOutBounce", 10, out_bounce),
+    ("easeInOutBounce", 10, lambda x: (1 - out_bounce(1 - 2 * x)) / 2 if x < 0.5 else (1 + out_bounce(2 * x - 1)) / 2),
+]
+
+
+def main():
+    root = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("-o", "--output", default=os.path.join(root, "src", "ui", "eez-easing-tables.h"))
+    args = parser.parse_args()
+
+    lines = [
+        "// Generated by tools/gen_easing_tables.py, do not edit.",
+        "// Easing curves sampled over [0, 1] in Q14, see eez::ease() in eez-flow.cpp.",
+        "#pragma once",
+        "#include <stdint.h>",
+        "",
+        "#define EEZ_EASING_TABLE_ONE %d" % ONE,
+        "",
+    ]
+    total = 0
+    for name, bits, formula in CURVES:
+        if not bits:
+            continue
+        n = 1 << bits
+        samples = [int(round(formula(i / n) * ONE)) for i in range(n + 1)]
+        assert all(-32768 <= s <= 32767 for s in samples), name
+        total += len(samples) * 2
+        lines.append("static const int16_t g_%sTable[%d] = {" % (name, n + 1))
+        for i in range(0, len(samples), 16):
+            lines.append("    " + ", ".join(str(s) for s in samples[i:i + 16]) + ",")
+        lines.append("};")
+    lines.append("")
+    lines.append("struct EasingTable {")
+    lines.append("    const int16_t *samples;")
+    lines.append("    uint8_t bits;")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const EasingTable g_easingTables[%d] = {" % len(CURVES))
+    for name, bits, formula in CURVES:
+        if bits:
+            lines.append("    { g_%sTable, %d }," % (name, bits))
+        else:
+            lines.append("    { nullptr, 0 }, // %s" % name)
+    lines.append("};")
+    lines.append("")
+
+    with open(args.output, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+    print("%s: %d curves, %d bytes of samples" % (args.output, len(CURVES), total))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Pack the EEZ flow assets into a blob for the assets_a/assets_b flash partitions.
+
+The assets are taken from the assets[] array that EEZ Studio generates in src/ui/ui.c
+(or from a raw .bin), prefixed with the header src/assets/assets_partition.cpp expects.
+
+Flash over serial, e.g. into slot A:
+
+    python tools/pack_assets.py -o assets.bin
+    esptool.py --chip esp32s3 write_flash 0x310000 assets.bin
+
+or send assets.bin to the running panel and write it with assets_partition_update_*(),
+checking the printed payload sha256 with assets_partition_update_end_sha256().
+"""
+
+import argparse
+import hashlib
+import re
+import struct
+import sys
+import time
+import zlib
+
+MAGIC = 0x53415A45  # "EZAS"
+VERSION = 1
+HEADER_FORMAT = "<IHHIII8x"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT) + 4
+
+EEZ_HEADER_TAG = 0x5A45457E  # "~EEZ", uncompressed assets
+EEZ_HEADER_TAG_COMPRESSED = 0x7A65657E
+
+SLOT_SIZE = 0x20000
+
+
+def read_ui_c(path):
+    source = open(path, encoding="utf-8").read()
+    match = re.search(r"const\s+uint8_t\s+assets\s*\[\s*\d+\s*\]\s*=\s*\{(.*?)\};", source, re.S)
+    if not match:
+        sys.exit("%s: assets[] array not found" % path)
+    return bytes(int(value, 16) for value in re.findall(r"0x([0-9A-Fa-f]{2})", match.group(1)))
+
+
+def pack(payload, sequence):
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, HEADER_SIZE, sequence, len(payload), zlib.crc32(payload))
+    return header + struct.pack("<I", zlib.crc32(header)) + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", default="src/ui/ui.c", help="ui.c generated by EEZ Studio, or a raw assets .bin")
+    parser.add_argument("-o", "--output", default="assets.bin")
+    parser.add_argument("-s", "--sequence", type=int, default=int(time.time()),
+                        help="slot sequence number, the highest valid one is loaded (default: current time)")
+    args = parser.parse_args()
+
+    if args.input.endswith(".c"):
+        payload = read_ui_c(args.input)
+    else:
+        payload = open(args.input, "rb").read()
+
+    tag = struct.unpack_from("<I", payload)[0] if len(payload) >= 4 else 0
+    if tag == EEZ_HEADER_TAG_COMPRESSED:
+        sys.exit("compressed assets can't be memory mapped, disable compression in the EEZ project settings")
+    if tag != EEZ_HEADER_TAG:
+        sys.exit("%s: not an EEZ assets blob" % args.input)
+
+    blob = pack(payload, args.sequence & 0xFFFFFFFF)
+    if len(blob) > SLOT_SIZE:
+        sys.exit("assets are %d bytes, slot size is %d" % (len(blob), SLOT_SIZE))
+
+    open(args.output, "wb").write(blob)
+    print("%s: %d bytes of assets, sequence %d" % (args.output, len(payload), args.sequence))
+    print("payload sha256 %s" % hashlib.sha256(payload).hexdigest())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""Replace the Montserrat sizes the UI uses with fonts cut down to the characters it needs.
+
+LVGL's built-in Montserrat fonts carry the whole ASCII range plus the symbols at every
+enabled size.  This looks at what the project actually draws:
+
+  - the lv_font_montserrat_<size> references in src/ui/screens.c and styles.c,
+  - the string literals in those files,
+  - the strings in the flow assets (the assets[] array of src/ui/ui.c, LZ4 compressed
+    or not), which is where Flow labels and expressions keep their text,
+  - GLYPH_CACHE_NUMERIC (digits, sign, separators) for value readouts, plus --chars,
+
+and runs lv_font_conv (npm install -g lv_font_conv) once per size with just those
+characters.  The fonts keep their LVGL names, so screens.c doesn't change:
+
+    python tools/subset_fonts.py --font Montserrat-Medium.ttf --symbols FontAwesome5-Solid+Brands+Regular.woff
+
+writes src/fonts/lv_font_montserrat_<size>.c and include/lv_font_subset.h, which
+lv_conf.h picks up to turn the built-in sizes off.  Text that only exists at run time
+(values set from code, translations loaded later) must be covered with --chars, or it
+is drawn with placeholders.  Delete include/lv_font_subset.h to go back to the
+built-in fonts.  Rerun after changing texts in EEZ Studio.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+
+NUMERIC = "0123456789.,:-+% "
+
+EEZ_HEADER_TAG = 0x5A45457E  # "~EEZ", uncompressed assets
+EEZ_HEADER_TAG_COMPRESSED = 0x7A65657E
+
+# LV_FONT_DEFAULT renders arbitrary text, it keeps the full built-in font.
+DEFAULT_FONT_SIZE = 14
+
+# The symbol font LVGL's Montserrat fonts are built with covers this private use range.
+SYMBOLS_FIRST = 0xF000
+SYMBOLS_LAST = 0xF8FF
+
+
+def read_file(path):
+    try:
+        return open(path, encoding="utf-8").read()
+    except OSError:
+        return ""
+
+
+def c_strings(source):
+    strings = []
+    for literal in re.findall(r'"((?:[^"\\\n]|\\.)*)"', source):
+        if literal.endswith(".h"):
+            continue
+        # Decode the escapes the way the compiler would, keeping UTF-8 sequences intact.
+        raw = literal.encode("utf-8").decode("unicode_escape").encode("latin-1")
+        strings.append(raw.decode("utf-8", errors="ignore"))
+    return strings
+
+
+def lz4_decompress(data, size):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        token = data[i]
+        i += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                b = data[i]
+                i += 1
+                literals += b
+                if b != 255:
+                    break
+        out += data[i:i + literals]
+        i += literals
+        if i >= len(data):
+            break
+        offset = data[i] | (data[i + 1] << 8)
+        i += 2
+        length = (token & 0x0F) + 4
+        if (token & 0x0F) == 15:
+            while True:
+                b = data[i]
+                i += 1
+                length += b
+                if b != 255:
+                    break
+        for _ in range(length):
+            out.append(out[-offset])
+    if len(out) != size:
+        sys.exit("flow assets: LZ4 data decompressed to %d bytes, expected %d" % (len(out), size))
+    return bytes(out)
+
+
+def asset_strings(ui_c):
+    match = re.search(r"const\s+uint8_t\s+assets\s*\[\s*\d+\s*\]\s*=\s*\{(.*?)\};", read_file(ui_c), re.S)
+    if not match:
+        return []
+    blob = bytes(int(value, 16) for value in re.findall(r"0x([0-9A-Fa-f]{2})", match.group(1)))
+    if len(blob) < 12:
+        return []
+    tag = struct.unpack_from("<I", blob)[0]
+    try:
+        if tag == EEZ_HEADER_TAG_COMPRESSED:
+            blob = lz4_decompress(blob[12:], struct.unpack_from("<I", blob, 8)[0])
+        elif tag != EEZ_HEADER_TAG:
+            blob = lz4_decompress(blob[4:], tag)  # version 2 assets start with the decompressed size
+    except IndexError:
+        sys.exit("%s: assets[] is not a valid EEZ assets blob" % ui_c)
+    # Strings are stored NUL terminated; anything shorter than two characters is more
+    # likely part of a number than text.
+    strings = []
+    for run in re.findall(rb"[\x20-\x7e\xc2-\xf4][\x20-\x7e\x80-\xbf\xc2-\xf4]+(?=\x00)", blob):
+        try:
+            strings.append(run.decode("utf-8"))
+        except UnicodeDecodeError:
+            pass
+    return strings
+
+
+def ranges(codepoints):
+    out = []
+    for cp in sorted(codepoints):
+        if out and out[-1][1] == cp - 1:
+            out[-1][1] = cp
+        else:
+            out.append([cp, cp])
+    return ",".join("0x%X" % a if a == b else "0x%X-0x%X" % (a, b) for a, b in out)
+
+
+def main():
+    root = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--font", required=True, help="Montserrat .ttf/.woff (LVGL uses Montserrat Medium)")
+    parser.add_argument("--symbols", help="FontAwesome font for the LV_SYMBOL_* characters, if any are used")
+    parser.add_argument("--chars", default="", help="extra characters that only appear at run time")
+    parser.add_argument("--bpp", type=int, choices=[1, 2, 4, 8], default=4)
+    parser.add_argument("--sizes", help="comma separated sizes instead of the ones screens.c uses")
+    parser.add_argument("--lv-font-conv", default="lv_font_conv", help="lv_font_conv command")
+    parser.add_argument("-n", "--dry-run", action="store_true", help="only print what would be generated")
+    args = parser.parse_args()
+
+    ui = os.path.join(root, "src", "ui")
+    sources = [read_file(os.path.join(ui, name)) for name in ("screens.c", "styles.c")]
+
+    if args.sizes:
+        sizes = sorted(int(size) for size in args.sizes.split(","))
+    else:
+        sizes = sorted({int(size) for source in sources for size in re.findall(r"\blv_font_montserrat_(\d+)\b", source)})
+    sizes = [size for size in sizes if size != DEFAULT_FONT_SIZE]
+    if not sizes:
+        sys.exit("no Montserrat fonts referenced outside the default size %d" % DEFAULT_FONT_SIZE)
+
+    texts = [text for source in sources for text in c_strings(source)]
+    texts += asset_strings(os.path.join(ui, "ui.c"))
+    texts += [NUMERIC, args.chars]
+    codepoints = {ord(c) for text in texts for c in text if c >= " " and c != "\x7f"}
+
+    letters = {cp for cp in codepoints if not SYMBOLS_FIRST <= cp <= SYMBOLS_LAST}
+    symbols = codepoints - letters
+    if symbols and not args.symbols:
+        print("warning: %d symbol characters used but no --symbols font given" % len(symbols))
+    print("sizes %s, %d characters: %s" % (", ".join(map(str, sizes)), len(letters),
+                                           "".join(sorted(chr(cp) for cp in letters))))
+    if args.dry_run:
+        return
+
+    command = args.lv_font_conv.split()
+    if not shutil.which(command[0]):
+        sys.exit("%s not found: npm install -g lv_font_conv" % command[0])
+
+    fonts_dir = os.path.join(root, "src", "fonts")
+    os.makedirs(fonts_dir, exist_ok=True)
+    for size in sizes:
+        name = "lv_font_montserrat_%d" % size
+        cmd = command + ["--no-compress", "--no-prefilter", "--format", "lvgl", "--bpp", str(args.bpp),
+                         "--size", str(size), "--lv-font-name", name,
+                         "--font", args.font, "-r", ranges(letters)]
+        if symbols and args.symbols:
+            cmd += ["--font", args.symbols, "-r", ranges(symbols)]
+        output = os.path.join(fonts_dir, name + ".c")
+        cmd += ["-o", output]
+        subprocess.run(cmd, check=True)
+        # lv_font_conv guards the font with the upper case name, which is the lv_conf.h
+        # switch lv_font_subset.h sets to 0.
+        source = read_file(output)
+        source = re.sub(r"\b%s\b" % name.upper(), "LV_FONT_SUBSET_MONTSERRAT_%d" % size, source)
+        with open(output, "w", newline="\n") as f:
+            f.write(source)
+        print(output)
+
+    lines = [
+        "// Generated by tools/subset_fonts.py, do not edit.",
+        "// Subset Montserrat fonts in src/fonts replace these built-in sizes, see lv_conf.h.",
+        "#ifndef LV_FONT_SUBSET_H",
+        "#define LV_FONT_SUBSET_H",
+        "",
+    ]
+    lines += ["#define LV_FONT_MONTSERRAT_%d 0" % size for size in sizes]
+    lines += [
+        "",
+        "#define LV_FONT_SUBSET_DECLARE " + " ".join("LV_FONT_DECLARE(lv_font_montserrat_%d)" % size for size in sizes),
+        "",
+        "#endif",
+        "",
+    ]
+    header = os.path.join(root, "include", "lv_font_subset.h")
+    with open(header, "w", newline="\n") as f:
+        f.write("\n".join(lines))
+    print(header)
+
+
+if __name__ == "__main__":
+    main()